@@ -46,6 +46,12 @@ using std::shared_ptr;
 
 /** Block that does nothing.
  * Does not fall. But you can freeze it.
+ *
+ * If controllable it moves in the direction of the key actions of
+ * the player in control and repeats the move while the key is held.
+ * The repeats are timed with KeyActionEvent::getGameMillisec() so that the
+ * outcome is the same whether the input is dispatched in an input sub-tick
+ * or at the start of the next game tick.
  */
 class DumbBlockEvent : public Event, public LevelBlock, public BoardListener
 {
@@ -54,6 +60,13 @@ public:
 	{
 		Block m_oBlock;
 		NPoint m_oInitPos;
+		bool m_bControllable = false; /**< Whether the block can be moved by a player. Default is false. */
+		int32_t m_nControllerTeam = -1; /**< The level team that can control the block or -1 if any. Default is -1. */
+		int32_t m_nMoveLeftKeyActionId = -1; /**< The key action moving the block left or -1 if none. Default is -1. */
+		int32_t m_nMoveUpKeyActionId = -1; /**< The key action moving the block up or -1 if none. Default is -1. */
+		int32_t m_nMoveDownKeyActionId = -1; /**< The key action moving the block down or -1 if none. Default is -1. */
+		int32_t m_nMoveRightKeyActionId = -1; /**< The key action moving the block right or -1 if none. Default is -1. */
+		double m_fRepeatMillisec = 0.0; /**< The interval between the moves while a key is held or 0 if no repeat. Default is 0. */
 	};
 	struct Init : public Event::Init, public LocalInit
 	{
@@ -76,9 +89,10 @@ public:
 
 	int32_t blockPosZ() const noexcept override { return s_nZObjectZDumbBlockEvent; }
 
-	//	void handleKeyActionInput(const shared_ptr<stmi::Event>& refKeyActionEvent) {}
 	//	void handleXYInput(const shared_ptr<stmi::Event>& refXYEvent) {}
 	void handleInput(const shared_ptr<stmi::Event>& /*refEvent*/) noexcept override {}
+	void handleKeyActionInput(const KeyActionRing::Handle& oKeyAction) noexcept override;
+	bool isSubTickInputCapable() const noexcept override { return m_oData.m_bControllable; }
 	void handleTimer() noexcept override;
 	void fall() noexcept override;
 
@@ -105,6 +119,8 @@ public:
 	void boardPreModify(const TileCoords& oTileCoords) noexcept override;
 	void boardPostModify(const Coords& oCoords) noexcept override;
 
+	void onPlayerChanged() noexcept override;
+
 	enum {
 		LISTENER_GROUP_CANNOT_PLACE = 10
 		, LISTENER_GROUP_COULD_PLACE = 11
@@ -126,6 +142,8 @@ private:
 	};
 
 	bool validBlock() const noexcept;
+	bool keyActionToDir(int32_t nKeyActionId, Direction::VALUE& eDir) const noexcept;
+	void repeatHeldMove(double fUpToGameMillisec) noexcept;
 
 	void privateOnFreeze() noexcept;
 	void boardPreDeleteDown(int32_t nY, int32_t nX, int32_t nW) noexcept;
@@ -144,6 +162,11 @@ private:
 
 	DUMB_BLK_EVENT_STATE m_eState;
 
+	bool m_bKeyHeld;
+	Direction::VALUE m_eHeldDir;
+	double m_fHeldSinceGameMillisec;
+	int32_t m_nHeldRepeats;
+
 	static const int32_t s_nZObjectZDumbBlockEvent;
 private:
 	DumbBlockEvent() = delete;
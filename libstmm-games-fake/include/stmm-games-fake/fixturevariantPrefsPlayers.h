@@ -66,6 +66,8 @@ protected:
 			return 3;
 		} else if (dynamic_cast<FixtureVariantPrefsTeams<4>*>(this) != nullptr) {
 			return 4;
+		} else if (dynamic_cast<FixtureVariantPrefsTeams<8>*>(this) != nullptr) {
+			return 8;
 		}
 		return 2;
 	}
@@ -93,20 +95,17 @@ protected:
 		} else if (nTeam == 3) {
 			return getPrefsTotMates<3>();
 		} else {
-			assert(false);
-			return -1;
+			// Teams after the fourth always have one mate
+			assert(nTeam > 3);
+			return 1;
 		}
 	}
 	int32_t getPrefsTotPlayers()
 	{
 		const int32_t nTotTeams = getPrefsTotTeams();
-		int32_t nTotPlayers = getPrefsTotMates<0>();
-		if (nTotTeams > 1) {
-			nTotPlayers += getPrefsTotMates<1>();
-		} else if (nTotTeams > 2) {
-			nTotPlayers += getPrefsTotMates<2>();
-		} else if (nTotTeams > 3) {
-			nTotPlayers += getPrefsTotMates<3>();
+		int32_t nTotPlayers = 0;
+		for (int32_t nTeam = 0; nTeam < nTotTeams; ++nTeam) {
+			nTotPlayers += getPrefsTotMates(nTeam);
 		}
 		return nTotPlayers;
 	}
@@ -74,6 +74,9 @@ class FixtureVariantTeamsMax_Three
 class FixtureVariantTeamsMax_Four
 {
 };
+class FixtureVariantTeamsMax_Eight
+{
+};
 class FixtureVariantTeamsMax
 {
 public:
@@ -87,6 +90,8 @@ protected:
 			return 3;
 		} else if (dynamic_cast<FixtureVariantTeamsMax_Four*>(this) != nullptr) {
 			return 4;
+		} else if (dynamic_cast<FixtureVariantTeamsMax_Eight*>(this) != nullptr) {
+			return 8;
 		}
 		return 2;
 	}
@@ -26,11 +26,13 @@
 #include <stmm-games/util/direction.h>
 #include <stmm-games/event.h>
 #include <stmm-games/gameproxy.h>
+#include <stmm-games/keyactionevent.h>
 #include <stmm-games/level.h>
 #include <stmm-games/levelblock.h>
 #include <stmm-games/tile.h>
 
 #include <cassert>
+#include <cmath>
 //#include <iostream>
 #include <string>
 #include <utility>
@@ -53,8 +55,13 @@ DumbBlockEvent::DumbBlockEvent(Init&& oInit) noexcept
 , m_nBoardWidth(level().boardWidth())
 , m_nBoardHeight(level().boardHeight())
 , m_eState(DUMB_BLK_EVENT_STATE_ACTIVATE)
+, m_bKeyHeld(false)
+, m_eHeldDir(Direction::UP)
+, m_fHeldSinceGameMillisec(0.0)
+, m_nHeldRepeats(0)
 {
-	blockInitialSet(m_oData.m_oBlock, 0, m_oData.m_oInitPos, false, -1);
+	assert(m_oData.m_fRepeatMillisec >= 0.0);
+	blockInitialSet(m_oData.m_oBlock, 0, m_oData.m_oInitPos, m_oData.m_bControllable, m_oData.m_nControllerTeam);
 }
 
 void DumbBlockEvent::reInit(Init&& oInit) noexcept
@@ -64,7 +71,12 @@ void DumbBlockEvent::reInit(Init&& oInit) noexcept
 	m_nBoardWidth = level().boardWidth();
 	m_nBoardHeight = level().boardHeight();
 	m_eState = DUMB_BLK_EVENT_STATE_ACTIVATE;
-	blockInitialSet(m_oData.m_oBlock, 0, m_oData.m_oInitPos, false, -1);
+	m_bKeyHeld = false;
+	m_eHeldDir = Direction::UP;
+	m_fHeldSinceGameMillisec = 0.0;
+	m_nHeldRepeats = 0;
+	assert(m_oData.m_fRepeatMillisec >= 0.0);
+	blockInitialSet(m_oData.m_oBlock, 0, m_oData.m_oInitPos, m_oData.m_bControllable, m_oData.m_nControllerTeam);
 }
 bool DumbBlockEvent::validBlock() const noexcept
 {
@@ -140,6 +152,68 @@ void DumbBlockEvent::onAdded() noexcept
 }
 void DumbBlockEvent::handleTimer() noexcept
 {
+	repeatHeldMove(level().game().gameElapsedMillisec());
+}
+void DumbBlockEvent::handleKeyActionInput(const KeyActionRing::Handle& oKeyAction) noexcept
+{
+	const KeyActionEvent& oEvent = oKeyAction.get();
+	if (!m_oData.m_bControllable) {
+		return; //--------------------------------------------------------------
+	}
+	Direction::VALUE eDir;
+	if (!keyActionToDir(oEvent.getKeyAction(), eDir)) {
+		return; //--------------------------------------------------------------
+	}
+	// Not the time of dispatch, which in an input sub-tick precedes the game tick
+	const double fGameMillisec = oEvent.getGameMillisec();
+	if (oEvent.getType() == stmi::Event::AS_KEY_PRESS) {
+		// Finish the repeats of the previously held key
+		repeatHeldMove(fGameMillisec);
+		m_bKeyHeld = true;
+		m_eHeldDir = eDir;
+		m_fHeldSinceGameMillisec = fGameMillisec;
+		m_nHeldRepeats = 0;
+		move(eDir);
+	} else if (m_bKeyHeld && (eDir == m_eHeldDir)) {
+		// Release or cancel
+		repeatHeldMove(fGameMillisec);
+		m_bKeyHeld = false;
+	}
+}
+bool DumbBlockEvent::keyActionToDir(int32_t nKeyActionId, Direction::VALUE& eDir) const noexcept
+{
+	if (nKeyActionId < 0) {
+		return false; //--------------------------------------------------------
+	}
+	if (nKeyActionId == m_oData.m_nMoveLeftKeyActionId) {
+		eDir = Direction::LEFT;
+	} else if (nKeyActionId == m_oData.m_nMoveUpKeyActionId) {
+		eDir = Direction::UP;
+	} else if (nKeyActionId == m_oData.m_nMoveDownKeyActionId) {
+		eDir = Direction::DOWN;
+	} else if (nKeyActionId == m_oData.m_nMoveRightKeyActionId) {
+		eDir = Direction::RIGHT;
+	} else {
+		return false; //--------------------------------------------------------
+	}
+	return true;
+}
+void DumbBlockEvent::repeatHeldMove(double fUpToGameMillisec) noexcept
+{
+	if ((!m_bKeyHeld) || (m_oData.m_fRepeatMillisec <= 0.0)) {
+		return; //--------------------------------------------------------------
+	}
+	const double fHeldMillisec = fUpToGameMillisec - m_fHeldSinceGameMillisec;
+	const int32_t nRepeats = static_cast<int32_t>(std::floor(fHeldMillisec / m_oData.m_fRepeatMillisec));
+	while (m_nHeldRepeats < nRepeats) {
+		++m_nHeldRepeats;
+		move(m_eHeldDir);
+	}
+}
+void DumbBlockEvent::onPlayerChanged() noexcept
+{
+	// The release of the held key would go to the new controller's block
+	m_bKeyHeld = false;
 }
 bool DumbBlockEvent::canMove(Direction::VALUE eDir) noexcept
 {
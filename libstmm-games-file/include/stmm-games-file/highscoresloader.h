@@ -54,6 +54,7 @@ public:
 	virtual shared_ptr<Highscore> getHighscore(const std::string& sGameName, const AppPreferences& oPreferences
 												, const shared_ptr<HighscoresDefinition>& refHighscoresDefinition) const noexcept = 0;
 	/** Persist the highscores for a game.
+	 * The implementation might complete the write asynchronously.
 	 * @param sGameName The game name. Cannot be empty.
 	 * @param oPreferences The preferences.
 	 * @param oHighscore The highscore.
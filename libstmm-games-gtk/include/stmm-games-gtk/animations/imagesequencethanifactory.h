@@ -32,6 +32,8 @@
 #include <cairomm/refptr.h>
 
 #include <memory>                      // for shared_ptr
+#include <utility>
+#include <vector>
 
 #include <stdint.h>
 
@@ -52,6 +54,13 @@ public:
 	shared_ptr<ThemeAnimation> create(const shared_ptr<StdThemeContext>& refThemeContext, const shared_ptr<LevelAnimation>& refLevelAnimation) noexcept override;
 
 	shared_ptr<ThemeAnimation> createAny(const shared_ptr<StdThemeContext>& refThemeContext, const shared_ptr<LevelAnimation>& refLevelAnimation) noexcept;
+
+	/** Rasterizes the frames for animations of the size of a tile.
+	 * @param nW The tile width. Must be positive.
+	 * @param nH The tile height. Must be positive.
+	 */
+	void registerTileSize(int32_t nW, int32_t nH) noexcept override;
+	void unregisterTileSize(int32_t nW, int32_t nH) noexcept override;
 private:
 	class ImageSeqThAni : public ThemeAnimation
 	{
@@ -63,30 +72,48 @@ private:
 		bool isStarted(int32_t nViewTick, int32_t nTotViewTicks) noexcept override;
 		bool isDone(int32_t nViewTick, int32_t nTotViewTicks) noexcept override;
 		void draw(int32_t nViewTick, int32_t nTotViewTicks, const Cairo::RefPtr<Cairo::Context>& refCc) noexcept override;
+		NRect getRect(int32_t nViewTick, int32_t nTotViewTicks) noexcept override;
 		void onRemoved() noexcept override;
 	private:
 		int32_t calcBestPic(int32_t nViewTick, int32_t nTotViewTicks) const noexcept;
-		FRect calcPicSize(int32_t nBestPic) const noexcept;
 		void getRectAndBestPic(int32_t nViewTick, int32_t nTotViewTicks
-								, NRect& oPixRect, int32_t& nBestPic) noexcept;
+								, NRect& oPixRect, NSize& oRefPixSize, int32_t& nBestPic) noexcept;
+		void releaseRefPixSize() noexcept;
 	private:
+		double m_fDuration;
 		double m_fInverseDuration;
 		shared_ptr<DynAnimation> m_refAnimation;
 
 		int32_t m_nLastPicDrawn;
-		int32_t m_nCachePic;
-		FRect m_oCacheRelRect;
+		// The size of the animation in pixels for which the frames are cached
+		// by the factory or (0,0) if none
+		NSize m_oRefPixSize;
 
 		shared_ptr<LevelAnimation> m_refModel;
 		int32_t m_nZ;
 
 		shared_ptr<StdThemeContext> m_refThemeContext;
-		ImageSequenceThAniFactory* m_p1Owner;
+		ImageSequenceThAniFactory* m_p1Owner = nullptr;
+
+		static constexpr double s_fViewTickTolerance = 1e-6;
 	};
 
+	// The position and size of a frame relative to the animation's rectangle
+	const FRect& getFrameRelRect(int32_t nIdx) noexcept;
+	// The size of a frame in pixels
+	NSize getFramePixSize(int32_t nIdx, NSize oRefPixSize) noexcept;
+	// Adds (or releases) the cached sizes of all the frames of an animation
+	// with size oRefPixSize (in pixels), shared by all the instances
+	void addRefPixSize(NSize oRefPixSize) noexcept;
+	void releaseRefPixSize(NSize oRefPixSize) noexcept;
+
 	Recycler<ImageSequenceThAniFactory::ImageSeqThAni> m_oImageSeqThAnis;
 
 	shared_ptr<DynAnimation> m_refDynAnimation;
+	// Lazily calculated, Size: m_refDynAnimation->getTotImages()
+	std::vector<FRect> m_aFrameRelRects;
+	// Value: (animation size in pixels, ref count)
+	std::vector<std::pair<NSize, int32_t>> m_aRefPixSizes;
 private:
 	ImageSequenceThAniFactory() = delete;
 	ImageSequenceThAniFactory(const ImageSequenceThAniFactory& oSource) = delete;
@@ -24,6 +24,7 @@
 #include "stdthemeanimationfactory.h"
 
 #include "themeanimation.h"
+#include "gtkutil/textcache.h"
 
 #include <stmm-games/util/basictypes.h>
 #include <stmm-games/util/recycler.h>
@@ -31,7 +32,6 @@
 #include <glibmm/refptr.h>
 
 #include <pangomm/fontdescription.h>
-#include <pangomm/layout.h>
 
 #include <memory>
 #include <vector>
@@ -75,6 +75,7 @@ private:
 		bool isStarted(int32_t nViewTick, int32_t nTotViewTicks) noexcept override;
 		bool isDone(int32_t nViewTick, int32_t nTotViewTicks) noexcept override;
 		void draw(int32_t nViewTick, int32_t nTotViewTicks, const Cairo::RefPtr<Cairo::Context>& refCc) noexcept override;
+		NRect getRect(int32_t nViewTick, int32_t nTotViewTicks) noexcept override;
 		void onRemoved() noexcept override;
 	private:
 		void reInitCommon() noexcept;
@@ -91,7 +92,7 @@ private:
 		int32_t m_nZ;
 
 		shared_ptr<StdThemeContext> m_refThemeContext;
-		Glib::RefPtr<Pango::Layout> m_refFontLayout;
+		TextCache m_oTextCache;
 		PlainTextThAniFactory* m_p1Owner;
 	};
 
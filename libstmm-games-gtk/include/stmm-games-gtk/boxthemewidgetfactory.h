@@ -391,6 +391,7 @@ class BoxThemeWidgetFactory : public StdThemeWidgetFactory
 {
 public:
 	BoxThemeWidgetFactory(StdTheme* p1Owner) noexcept;
+	bool supports(const shared_ptr<GameWidget>& refGameWidget) noexcept override;
 	shared_ptr<ThemeWidget> create(const shared_ptr<GameWidget>& refGameWidget
 									, double fTileWHRatio, const Glib::RefPtr<Pango::Context>& refFontContext) noexcept override;
 private:
@@ -406,6 +407,13 @@ BoxThemeWidgetFactory<TOwnerFactory, TBoxThemeWidget, TBoxWidget>::BoxThemeWidge
 	static_assert(std::is_base_of<BoxWidget, TBoxWidget>::value, "");
 }
 
+template<class TOwnerFactory, class TBoxThemeWidget, class TBoxWidget>
+bool BoxThemeWidgetFactory<TOwnerFactory, TBoxThemeWidget, TBoxWidget>::supports(const shared_ptr<GameWidget>& refGameWidget) noexcept
+{
+	assert(refGameWidget);
+	return (modelCast<TBoxWidget>(refGameWidget.get()) != nullptr);
+}
+
 template<class TOwnerFactory, class TBoxThemeWidget, class TBoxWidget>
 shared_ptr<ThemeWidget> BoxThemeWidgetFactory<TOwnerFactory, TBoxThemeWidget, TBoxWidget>::create(
 													const shared_ptr<GameWidget>& refGameWidget
@@ -422,7 +430,7 @@ shared_ptr<ThemeWidget> BoxThemeWidgetFactory<TOwnerFactory, TBoxThemeWidget, TB
 	}
 	GameWidget* p0GameWidget = refGameWidget.get();
 	assert(p0GameWidget != nullptr);
-	TBoxWidget* p0BoxWidget = dynamic_cast<TBoxWidget*>(p0GameWidget);
+	TBoxWidget* p0BoxWidget = modelCast<TBoxWidget>(p0GameWidget);
 	if (p0BoxWidget == nullptr) {
  		return shared_ptr<ThemeWidget>{}; //------------------------------------
  	}
@@ -25,6 +25,7 @@
 #include <stmm-games/util/randomparts.h>
 
 #include <memory>
+#include <vector>
 
 #include <stdint.h>
 
@@ -98,12 +99,42 @@ public:
 	 * @return The image data.
 	 */
 	const DynImage& getImageByIdx(int32_t nIdx) noexcept;
+
+	/** The image to show at each view tick of an animation.
+	 * For each view interval the image with the highest priority (the last
+	 * if more than one) is chosen among those the interval spans.
+	 *
+	 * The tables are shared by all the instances of the animation. The last
+	 * few used are kept and only recalculated when the parameters change,
+	 * for example when the game interval does.
+	 * @param fDuration The duration of the animation in milliseconds. Must be positive.
+	 * @param fGameInterval The game interval in milliseconds. Must be positive.
+	 * @param nTotViewTicks The number of view ticks in a game interval. Must be positive.
+	 * @return The image indexes. The value at index nViewTick is for the view interval
+	 *         that starts nViewTick * fGameInterval / nTotViewTicks milliseconds
+	 *         after the start of the animation. Empty if the animation has too many view ticks.
+	 */
+	const std::vector<int32_t>& getViewTickImageIdxs(double fDuration, double fGameInterval, int32_t nTotViewTicks) noexcept;
 private:
 	// fElapsed  0.0 is start, 1.0 is end of animation
 	const DynImage& getImage(double fElapsed, int32_t& nIdx) noexcept;
+	void calcViewTickImageIdxs(double fDuration, double fGameInterval, int32_t nTotViewTicks
+								, std::vector<int32_t>& aImageIdxs) noexcept;
 private:
 	RandomParts< DynImage > m_oDynImages;
 
+	struct ViewTickTable
+	{
+		double m_fDuration;
+		double m_fGameInterval;
+		int32_t m_nTotViewTicks;
+		std::vector<int32_t> m_aImageIdxs;
+	};
+	// Most recently used first
+	std::vector<ViewTickTable> m_aViewTickTables;
+	static constexpr int32_t s_nMaxViewTickTables = 4;
+	static constexpr int32_t s_nMaxViewTickTableSize = 4096;
+
 private:
 	DynAnimation(const DynAnimation& oSource) = delete;
 	DynAnimation& operator=(const DynAnimation& oSource) = delete;
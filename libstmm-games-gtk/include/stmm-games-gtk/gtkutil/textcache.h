@@ -0,0 +1,142 @@
+/*
+ * Copyright © 2019-2020  Stefano Marsili, <stemars@gmx.ch>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>
+ */
+/*
+ * File:   textcache.h
+ */
+
+#ifndef STMG_TEXT_CACHE_H
+#define STMG_TEXT_CACHE_H
+
+#include <stmm-games/util/basictypes.h>
+
+#include <cairomm/refptr.h>
+#include <cairomm/surface.h>
+#include <glibmm/refptr.h>
+#include <pangomm/fontdescription.h>
+#include <pangomm/layout.h>
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <stdint.h>
+
+namespace Cairo { class Context; }
+namespace Pango { class Context; }
+
+namespace stmg
+{
+
+/** Cache of rendered text.
+ * Keeps the surfaces of the most recently drawn strings rendered with a given
+ * font, color and scale, so that the same text is only laid out once.
+ * When full, the least recently used string is evicted.
+ *
+ * Strings made only of characters of the glyph strip (digits and some
+ * separators) are composed from a strip of pre-rendered glyphs instead,
+ * so that changing numeric values (scores, timers) don't need a Pango
+ * layout at all. The glyphs are placed using their fractional advances
+ * and the kerning of each pair, as measured once with Pango, and snapped
+ * to device pixels.
+ *
+ * The strip is rendered again each time the scale changes, callers should
+ * therefore pass a scale that doesn't depend on the text.
+ */
+class TextCache
+{
+public:
+	TextCache() noexcept;
+	/** Sets the font and color of the text.
+	 * Clears the cache.
+	 * @param refFontContext The font context. Cannot be null.
+	 * @param oFont The font.
+	 * @param fR1 The red component. From 0.0 to 1.0.
+	 * @param fG1 The green component. From 0.0 to 1.0.
+	 * @param fB1 The blue component. From 0.0 to 1.0.
+	 */
+	void reInit(const Glib::RefPtr<Pango::Context>& refFontContext, const Pango::FontDescription& oFont
+				, double fR1, double fG1, double fB1) noexcept;
+	/** Clears all the cached surfaces and sizes.
+	 */
+	void clear() noexcept;
+	/** The natural (unscaled) size of a text in pixels.
+	 * For strings that are not composed from the glyph strip this is the
+	 * size returned by Pango::Layout::get_pixel_size().
+	 * @param sText The UTF-8 text.
+	 * @return The size. Can be 0 if the text is empty.
+	 */
+	NSize getTextSize(const std::string& sText) noexcept;
+	/** Draws a text.
+	 * @param refCc The context. Cannot be null.
+	 * @param sText The UTF-8 text.
+	 * @param fX The x of the top left corner of the text.
+	 * @param fY The y of the top left corner of the text.
+	 * @param fScale The scale of the text relative to its natural size. Must be positive.
+	 * @param fAlpha1 The alpha. From 0.0 to 1.0.
+	 */
+	void draw(const Cairo::RefPtr<Cairo::Context>& refCc, const std::string& sText
+				, double fX, double fY, double fScale, double fAlpha1) noexcept;
+private:
+	struct TextEntry
+	{
+		std::string m_sText;
+		NSize m_oSize;
+		double m_fScale = 0.0; // The scale the surface was rendered with
+		Cairo::RefPtr<Cairo::ImageSurface> m_refSurf; // Lazily created
+	};
+	struct Glyph
+	{
+		double m_fAdvance = 0.0; // Natural advance in pixels
+		int32_t m_nSlotX = 0; // Position in m_refStripSurf
+		int32_t m_nSlotW = 0; // Width in m_refStripSurf including the margins
+	};
+	bool isStripText(const std::string& sText) const noexcept;
+	void initStrip() noexcept;
+	double getStripKerning(int32_t nGlyphIdx, int32_t nNextGlyphIdx) const noexcept;
+	double getStripTextWidth(const std::string& sText) const noexcept;
+	void renderStrip(double fScale) noexcept;
+	TextEntry& getTextEntry(const std::string& sText) noexcept;
+	Cairo::RefPtr<Cairo::ImageSurface> renderText(const std::string& sText, NSize oSize, double fScale) noexcept;
+private:
+	Glib::RefPtr<Pango::Layout> m_refLayout;
+	double m_fR1;
+	double m_fG1;
+	double m_fB1;
+	std::list<TextEntry> m_oTexts; // The most recently used first
+	std::unordered_map<std::string, std::list<TextEntry>::iterator> m_oTextIdx; // Key: TextEntry::m_sText
+	// Glyph strip
+	bool m_bStripInitialized;
+	std::vector<int32_t> m_aGlyphIdx; // Size: 128, Key: ASCII char, Value: index into m_aGlyphs or -1
+	std::vector<Glyph> m_aGlyphs;
+	// Size: m_aGlyphs.size() squared, Index: nGlyphIdx * m_aGlyphs.size() + nNextGlyphIdx,
+	// Value: adjustment in pixels of the advance of nGlyphIdx when followed by nNextGlyphIdx
+	std::vector<double> m_aKernings;
+	int32_t m_nStripH; // Natural height of the glyphs
+	double m_fStripScale; // The scale m_refStripSurf was rendered with
+	Cairo::RefPtr<Cairo::ImageSurface> m_refStripSurf;
+
+	static constexpr int32_t s_nMaxCachedTexts = 64;
+	static const char* const s_p0StripChars;
+private:
+	TextCache(const TextCache& oSource) = delete;
+	TextCache& operator=(const TextCache& oSource) = delete;
+};
+
+} // namespace stmg
+
+#endif	/* STMG_TEXT_CACHE_H */
@@ -39,10 +39,11 @@
 #include <stmm-games/util/intset.h>
 #include <stmm-games/util/namedindex.h>
 
-#include <unordered_map>
 #include <memory>
 #include <map>
 #include <string>
+#include <typeinfo>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -137,6 +138,11 @@ public:
 	 * @return The image or null if not defined.
 	 */
 	const shared_ptr<Image>& getImageByFileName(const std::string& sImgFileName) noexcept;
+	/** Loads the images created so far.
+	 * The images are otherwise loaded when first drawn or measured.
+	 * Can be called from another thread as long as the theme isn't used concurrently.
+	 */
+	void loadImages() noexcept;
 	/** The image by string image id.
 	 * This will load the image if necessary.
 	 * @param sImgId The image string id. Cannot be empty. Example: "ball".
@@ -466,6 +472,12 @@ private:
 						, const Tile& oTile, int32_t nPlayer, const std::vector<double>& aAniElapsed) noexcept;
 
 	shared_ptr<ThemeAnimation> createAnimation(const shared_ptr<StdThemeContext>& refCtx, const shared_ptr<LevelAnimation>& refLevelAnimation) noexcept;
+	// fills aFactories with the anonymous factories supporting the model (in registration order)
+	void resolveAnimationFactories(const shared_ptr<LevelAnimation>& refLevelAnimation
+									, std::vector< StdThemeAnimationFactory* >& aFactories) noexcept;
+	// fills aFactories with the anonymous factories supporting the model (in registration order)
+	void resolveWidgetFactories(const shared_ptr<GameWidget>& refGameWidget
+								, std::vector< StdThemeWidgetFactory* >& aFactories) noexcept;
 	shared_ptr<ThemeSound> createSound(StdThemeContext* p0Ctx, int32_t nSoundIdx, const std::vector<shared_ptr<stmi::PlaybackCapability>>& aPlaybacks
 										, FPoint oXYPosition, double fZPosition, bool bRelative
 										, double fVolume, bool bLoop) noexcept;
@@ -536,9 +548,14 @@ private:
 	// All the factories that should be checked when model animation doesn't
 	// define a factory name.
 	std::vector< StdThemeAnimationFactory* > m_aAnonymousModelAnimationFactories;
-	// "Fast" search by typeid of model. Filled lazily as animations are created.
-	// Key: typeid(LavelAnimation).hash_code(), Value: vector of factories supporting that class
-	std::unordered_map< size_t, std::vector< StdThemeAnimationFactory* > > m_oAnimationTypeIdFactories;
+	struct ClassIdAnimationFactories
+	{
+		bool m_bResolved = false; // Whether m_aFactories was filled
+		std::vector< StdThemeAnimationFactory* > m_aFactories; // The anonymous factories supporting the class
+	};
+	// Dispatch table by class id of model. Filled lazily as animations are created.
+	// Index: LevelAnimation::getClassId()
+	std::vector< ClassIdAnimationFactories > m_aAnimationClassIdFactories;
 
 	// All the widget factories.
 	// Size: m_oNamed.widgets().size(), Index: m_oNamed.widgets().getIndex(sName)
@@ -546,6 +563,14 @@ private:
 	// All the factories that should be checked when model widget doesn't
 	// define a factory name.
 	std::vector< StdThemeWidgetFactory* > m_aAnonymousModelWidgetFactories;
+	struct ClassIdWidgetFactories
+	{
+		bool m_bResolved = false; // Whether m_aFactories was filled
+		std::vector< StdThemeWidgetFactory* > m_aFactories; // The anonymous factories supporting the class
+	};
+	// Dispatch table by class id of model. Filled lazily as widgets are created.
+	// Index: GameWidget::getClassId()
+	std::vector< ClassIdWidgetFactories > m_aWidgetClassIdFactories;
 
 	std::map<std::string, shared_ptr<TileAni> > m_oTileAniIds; // Key: sTileAniId
 
@@ -21,10 +21,12 @@
 #ifndef STMG_STD_THEME_ANIMATION_FACTORY_H
 #define STMG_STD_THEME_ANIMATION_FACTORY_H
 
+#include <stmm-games/levelanimation.h>
 
 #include <memory>
 
-namespace stmg { class LevelAnimation; }
+#include <stdint.h>
+
 namespace stmg { class ThemeAnimation; }
 
 namespace stmg
@@ -61,6 +63,21 @@ public:
 	virtual shared_ptr<ThemeAnimation> create(const shared_ptr<StdThemeContext>& refThemeContext
 											, const shared_ptr<LevelAnimation>& refLevelAnimation) noexcept = 0;
 
+	/** Register tile size.
+	 * Make sure to unregisterTileSize() when done with this size.
+	 *
+	 * This method should be implemented to cache images for frequently used sizes.
+	 * @param nW The tile width. Must be positive.
+	 * @param nH The tile height. Must be positive.
+	 */
+	virtual void registerTileSize(int32_t nW, int32_t nH) noexcept;
+	/** Unregister tile size.
+	 * Called when a tile size no longer needed. See registerTileSize().
+	 * @param nW The tile width. Must be positive.
+	 * @param nH The tile height. Must be positive.
+	 */
+	virtual void unregisterTileSize(int32_t nW, int32_t nH) noexcept;
+
 	/** Clears the owner passed in the constructor.
 	 * Makes the instance unusable.
 	 */
@@ -74,6 +91,20 @@ protected:
 	 * @return The owner StdTheme.
 	 */
 	inline const StdTheme* owner() const noexcept { return m_p1Owner; }
+	/** Casts the model to a LevelAnimation subclass.
+	 * Doesn't use RTTI: the model's class id is compared to the one of
+	 * TLevelAnimation and of its registered subclasses (see ClassIds::isA()).
+	 * @param refLevelAnimation The model. Cannot be null.
+	 * @return The cast model or null if not a TLevelAnimation.
+	 */
+	template <class TLevelAnimation>
+	static shared_ptr<TLevelAnimation> modelCast(const shared_ptr<LevelAnimation>& refLevelAnimation) noexcept
+	{
+		if (! ClassIds<LevelAnimation>::isA(refLevelAnimation->getClassId(), LevelAnimation::classId<TLevelAnimation>())) {
+			return shared_ptr<TLevelAnimation>{}; //----------------------------
+		}
+		return std::static_pointer_cast<TLevelAnimation>(refLevelAnimation);
+	}
 private:
 	StdTheme* m_p1Owner;
 private:
@@ -21,10 +21,11 @@
 #ifndef STMG_STD_THEME_WIDGET_FACTORY_H
 #define STMG_STD_THEME_WIDGET_FACTORY_H
 
+#include <stmm-games/gamewidget.h>
+
 #include <memory>
 //#include <iostream>
 
-namespace stmg { class GameWidget; }
 namespace stmg { class ThemeWidget; }
 
 namespace Glib { template <class T_CppObject> class RefPtr; }
@@ -47,7 +48,14 @@ public:
 	 * @param p1Owner The owner. Cannot be null.
 	 */
 	explicit StdThemeWidgetFactory(StdTheme* p1Owner) noexcept;
+	/** Tells whether the factory supports the model widget.
+	 * Tells whether the class of the model (not the actual model instance) is supported.
+	 * @param refGameWidget The model. Cannot be null.
+	 * @return Whether the factory can create a theme widget for the model class.
+	 */
+	virtual bool supports(const shared_ptr<GameWidget>& refGameWidget) noexcept = 0;
 	/** Creates a theme widget for a game widget.
+	 * The creation may fail even if supports() returns true.
 	 * @param refGameWidget The model. Cannot be null.
 	 * @param fTileWHRatio The tile weight to height ratio.
 	 * @param refFontContext The pango font context. Cannot be null.
@@ -69,6 +77,20 @@ protected:
 	 * @return The owner StdTheme.
 	 */
 	inline const StdTheme* owner() const noexcept { return m_p1Owner; }
+	/** Casts the model to a GameWidget subclass.
+	 * Doesn't use RTTI: the model's class id is compared to the one of
+	 * TGameWidget and of its registered subclasses (see ClassIds::isA()).
+	 * @param p0GameWidget The model. Cannot be null.
+	 * @return The cast model or null if not a TGameWidget.
+	 */
+	template <class TGameWidget>
+	static TGameWidget* modelCast(GameWidget* p0GameWidget) noexcept
+	{
+		if (! ClassIds<GameWidget>::isA(p0GameWidget->getClassId(), GameWidget::classId<TGameWidget>())) {
+			return nullptr; //--------------------------------------------------
+		}
+		return static_cast<TGameWidget*>(p0GameWidget);
+	}
 private:
 	StdTheme* m_p1Owner;
 private:
@@ -21,6 +21,8 @@
 #ifndef STMG_THEME_ANIMATION_H
 #define STMG_THEME_ANIMATION_H
 
+#include <stmm-games/util/basictypes.h>
+
 #include <stdint.h>
 
 namespace Cairo { class Context; }
@@ -33,9 +35,15 @@ class ThemeAnimation
 {
 public:
 	virtual ~ThemeAnimation() noexcept = default;
-		// Calculates the bounding rect in pixels of what is drawn by draw(...)
-		// Returns width 0 if the drawing is all over the place
-	//	virtual NRect getRect(int32_t nViewTick, int32_t nTotViewTicks) = 0;
+	/** The bounding rectangle of what draw() draws at a view tick.
+	 * Used by the view to skip animations that aren't visible.
+	 * The default implementation returns an empty rectangle.
+	 * @param nViewTick The view tick. Is &gt;= 0 and &lt; nTotViewTicks.
+	 * @param nTotViewTicks The total number of view ticks for the game interval. Is &gt; 0.
+	 * @return The rectangle in pixels or a rectangle with non positive width or height
+	 *         if not known (the drawing could be all over the place).
+	 */
+	virtual NRect getRect(int32_t nViewTick, int32_t nTotViewTicks) noexcept;
 	/** Get the z value at a view tick.
 	 * @param nViewTick The view tick. Is &gt;= 0 and &lt; nTotViewTicks.
 	 * @param nTotViewTicks The total number of view ticks for the game interval. Is &gt; 0.
@@ -71,6 +71,12 @@ public:
 	 * @return The theme or null if could not load (error string is set in ThemeInfo).
 	 */
 	virtual shared_ptr<Theme> getTheme(const std::string& sThemeName) noexcept = 0;
+	/** Hint that a theme is likely to be requested soon.
+	 * The loader can use this to load the theme in the background so that
+	 * a subsequent getTheme() returns immediately. The default does nothing.
+	 * @param sThemeName The name of the theme. Cannot be empty.
+	 */
+	virtual void prepareTheme(const std::string& /*sThemeName*/) noexcept {}
 	/** The default theme name.
 	 * @return The theme name. Can be empty.
 	 */
@@ -95,6 +95,7 @@ class ActionsBoxThWidgetFactory : public BoxThemeWidgetFactory<ActionsBoxThWidge
 {
 public:
 	using BoxThemeWidgetFactory<ActionsBoxThWidgetFactory, ActionsBoxThWidget, ActionsBoxWidget>::BoxThemeWidgetFactory;
+	using BoxThemeWidgetFactory<ActionsBoxThWidgetFactory, ActionsBoxThWidget, ActionsBoxWidget>::supports;
 	using BoxThemeWidgetFactory<ActionsBoxThWidgetFactory, ActionsBoxThWidget, ActionsBoxWidget>::create;
 };
 
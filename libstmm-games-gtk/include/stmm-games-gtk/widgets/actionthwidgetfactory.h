@@ -79,6 +79,7 @@ public:
 	ActionThWidgetFactory(StdTheme* p1Owner
 							, const TileColor& oTextColor, const TileAlpha& oTextAlpha, const TileFont& oTextFont
 							, const Frame& oFrame) noexcept;
+	bool supports(const shared_ptr<GameWidget>& refGameWidget) noexcept override;
 	shared_ptr<ThemeWidget> create(const shared_ptr<GameWidget>& refGameWidget
 									, double fTileWHRatio
 									, const Glib::RefPtr<Pango::Context>& refFontContext) noexcept override;
@@ -55,6 +55,7 @@ class BackgroundThWidgetFactory : public StdThemeWidgetFactory
 {
 public:
 	explicit BackgroundThWidgetFactory(StdTheme* p1Owner) noexcept;
+	bool supports(const shared_ptr<GameWidget>& refGameWidget) noexcept override;
 	shared_ptr<ThemeWidget> create(const shared_ptr<GameWidget>& refGameWidget
 									, double fTileWHRatio, const Glib::RefPtr<Pango::Context>& refFontContext) noexcept override;
 private:
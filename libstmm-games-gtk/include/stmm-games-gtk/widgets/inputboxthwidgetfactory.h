@@ -83,6 +83,7 @@ class InputBoxThWidgetFactory : public BoxThemeWidgetFactory<InputBoxThWidgetFac
 {
 public:
 	using BoxThemeWidgetFactory<InputBoxThWidgetFactory, InputBoxThWidget, InputBoxWidget>::BoxThemeWidgetFactory;
+	using BoxThemeWidgetFactory<InputBoxThWidgetFactory, InputBoxThWidget, InputBoxWidget>::supports;
 	using BoxThemeWidgetFactory<InputBoxThWidgetFactory, InputBoxThWidget, InputBoxWidget>::create;
 private:
 };
@@ -66,6 +66,7 @@ public:
 	 */
 	LevelShowThWidgetFactory(StdTheme* p1Owner, const Frame& oFrame, double fMinTop, double fMinBottom, double fMinLeft, double fMinRight) noexcept;
 	//
+	bool supports(const shared_ptr<GameWidget>& refGameWidget) noexcept override;
 	shared_ptr<ThemeWidget> create(const shared_ptr<GameWidget>& refGameWidget
 									, double fTileWHRatio, const Glib::RefPtr<Pango::Context>& refFontContext) noexcept override;
 private:
@@ -27,6 +27,7 @@
 #include "widgetimpl/mutablethwidgetimpl.h"
 #include "widgetimpl/relsizedthwidgetimpl.h"
 #include "gtkutil/frame.h"
+#include "gtkutil/textcache.h"
 #include "gtkutil/tilesizing.h"
 
 #include <stmm-games/widgets/previewwidget.h>
@@ -36,7 +37,6 @@
 #include <glibmm/refptr.h>
 #include <pangomm/context.h>
 #include <pangomm/fontdescription.h>
-#include <pangomm/layout.h>
 
 #include <memory>
 #include <string>
@@ -71,6 +71,7 @@ public:
 						, const TileColor& oTextColor, const TileAlpha& oTextAlpha, const TileFont& oTextFont
 						, const Frame& oFrame, const TileSizing& oTileSizing) noexcept;
 
+	bool supports(const shared_ptr<GameWidget>& refGameWidget) noexcept override;
 	shared_ptr<ThemeWidget> create(const shared_ptr<GameWidget>& refGameWidget
 									, double fTileWHRatio, const Glib::RefPtr<Pango::Context>& refFontContext) noexcept override;
 private:
@@ -125,7 +126,7 @@ private:
 		MutableThWidgetImpl<PreviewTWidget> m_oMutaTW;
 		RelSizedThemeWidgetImpl<PreviewTWidget> m_oSizedTW;
 		Glib::RefPtr<Pango::Context> m_refFontContext;
-		Glib::RefPtr<Pango::Layout> m_refFontLayout;
+		TextCache m_oTextCache;
 		int32_t m_nPixCanvasX;
 		int32_t m_nPixCanvasY;
 		int32_t m_nPixCanvasW;
@@ -57,6 +57,7 @@ public:
 							, const TileColor& oNormalColor, const TileColor& oDangerColor
 							, const Frame& oFrame) noexcept;
 
+	bool supports(const shared_ptr<GameWidget>& refGameWidget) noexcept override;
 	shared_ptr<ThemeWidget> create(const shared_ptr<GameWidget>& refGameWidget
 									, double fTileWHRatio, const Glib::RefPtr<Pango::Context>& refFontContext) noexcept override;
 private:
@@ -88,7 +89,8 @@ private:
 		void reInitCommon(double fTileWHRatio) noexcept;
 		void drawBase(const Cairo::RefPtr<Cairo::Context>& refCc) noexcept;
 		void drawVariable(const Cairo::RefPtr<Cairo::Context>& refCc) noexcept;
-		bool isChanged() const noexcept { return m_p0ProgressWidget->isChanged(); }
+		bool isChanged() const noexcept;
+		int32_t getClampedValue() const noexcept;
 		NSize getMinSize(int32_t nLayoutConfig) const noexcept;
 	private:
 		void calcCanvas() noexcept;
@@ -112,6 +114,8 @@ private:
 		int32_t m_nThresholdValue;
 		bool m_bThresholdValid;
 		bool m_bDangerBelow;
+		int32_t m_nDrawnValue; // The clamped value of the last drawVariable()
+		int32_t m_nNextChangeMillisec; // When the variable changes next by time or -1
 	};
 private:
 	Recycler<ProgressTWidget> m_oProgressTWidgets;
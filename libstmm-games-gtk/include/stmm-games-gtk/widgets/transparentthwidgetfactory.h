@@ -53,6 +53,7 @@ class TransparentThWidgetFactory : public StdThemeWidgetFactory
 public:
 	explicit TransparentThWidgetFactory(StdTheme* p1Owner) noexcept;
 
+	bool supports(const shared_ptr<GameWidget>& refGameWidget) noexcept override;
 	shared_ptr<ThemeWidget> create(const shared_ptr<GameWidget>& refGameWidget
 									, double fTileWHRatio, const Glib::RefPtr<Pango::Context>& refFontContext) noexcept override;
 private:
@@ -25,6 +25,7 @@
 #include "widgetimpl/mutablethwidgetimpl.h"
 #include "widgetimpl/relsizedthwidgetimpl.h"
 #include "gtkutil/frame.h"
+#include "gtkutil/textcache.h"
 #include "themewidget.h"
 
 #include <stmm-games/widgets/varwidget.h>
@@ -70,6 +71,7 @@ public:
 						, const shared_ptr<Image>& refValueBgImg
 						, const Frame& oFrame) noexcept;
 
+	bool supports(const shared_ptr<GameWidget>& refGameWidget) noexcept override;
 	shared_ptr<ThemeWidget> create(const shared_ptr<GameWidget>& refGameWidget
 									, double fTileWHRatio, const Glib::RefPtr<Pango::Context>& refFontContext) noexcept override;
 private:
@@ -100,7 +102,7 @@ private:
 	private:
 		void drawBase(const Cairo::RefPtr<Cairo::Context>& refCc) noexcept;
 		void drawVariable(const Cairo::RefPtr<Cairo::Context>& refCc) noexcept;
-		bool isChanged() const noexcept { return m_p0VarWidget->isChanged(); }
+		bool isChanged() const noexcept;
 		NSize getMinSize(int32_t nLayoutConfig) const noexcept;
 		double getTextMaxValueWHRatio(int32_t nDigits) noexcept;
 	private:
@@ -120,6 +122,10 @@ private:
 		int32_t m_nTitleFontPixW;
 		int32_t m_nTitleFontPixH;
 		Glib::RefPtr<Pango::Layout> m_refValueFontLayout;
+		// The value changes often: it's drawn from cached surfaces
+		TextCache m_oValueTextCache;
+		int32_t m_nDrawnValue; // The value of the last drawVariable()
+		int32_t m_nNextChangeMillisec; // When the drawn value changes next by time or -1
 		int32_t m_nPixCanvasX;
 		int32_t m_nPixCanvasY;
 		int32_t m_nPixCanvasW;
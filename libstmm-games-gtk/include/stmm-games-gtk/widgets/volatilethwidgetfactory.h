@@ -54,6 +54,7 @@ class VolatileThWidgetFactory : public StdThemeWidgetFactory
 public:
 	explicit VolatileThWidgetFactory(StdTheme* p1Owner) noexcept;
 
+	bool supports(const shared_ptr<GameWidget>& refGameWidget) noexcept override;
 	shared_ptr<ThemeWidget> create(const shared_ptr<GameWidget>& refGameWidget
 									, double fTileWHRatio, const Glib::RefPtr<Pango::Context>& refFontContext) noexcept override;
 private:
@@ -29,11 +29,14 @@
 #include <stmm-games/util/recycler.h>
 
 #include <cairomm/context.h>
+#include <cairomm/enums.h>
+#include <cairomm/matrix.h>
+#include <cairomm/pattern.h>
 #include <cairomm/refptr.h>
+#include <cairomm/surface.h>
 
 #include <cassert>
 //#include <iostream>
-#include <cmath>
 #include <algorithm>
 #include <vector>
 
@@ -132,29 +135,28 @@ void BackgroundThAniFactory::BackgroundThAni::draw(int32_t nViewTick, int32_t nT
 	if ((nImgPixW <= 0) || (nImgPixH <= 0)) {
 		return; // -------------------------------------------------------------
 	}
-	const int32_t nTLx = std::floor(1.0 * (nAniPixX - nImgPixX) / nImgPixW);
-	const int32_t nTLy = std::floor(1.0 * (nAniPixY - nImgPixY) / nImgPixH);
-	const int32_t nBRx = std::floor(1.0 * (nAniPixX + nAniPixW - 1 - nImgPixX) / nImgPixW);
-	const int32_t nBRy = std::floor(1.0 * (nAniPixY + nAniPixH - 1 - nImgPixY) / nImgPixH);
-//std::cout << "BackgroundThAni::draw nAniPixX=" << nAniPixX << "  nAniPixY=" << nAniPixY << "  nAniPixW=" << nAniPixW << "  nAniPixH=" << nAniPixH << '\n';
-//std::cout << "BackgroundThAni::draw nImgPixX=" << nImgPixX << "  nImgPixY=" << nImgPixY << "  nImgPixW=" << nImgPixW << "  nImgPixH=" << nImgPixH << '\n';
-//std::cout << "BackgroundThAni::draw nTLx=" << nTLx << "  nTLy=" << nTLy << "  nBRx=" << nBRx << "  nBRy=" << nBRy << '\n';
-
-	if (m_oCachedSize.m_nW == 0) {
+	if (!(m_oCachedSize == NSize{nImgPixW, nImgPixH})) {
+		// The tile size or the image size changed
+		if (m_oCachedSize.m_nW != 0) {
+			m_refCachedImage->releaseCachedSize(m_oCachedSize);
+		}
 		m_oCachedSize = NSize{nImgPixW, nImgPixH};
 		m_refCachedImage->addCachedSize(m_oCachedSize.m_nW, m_oCachedSize.m_nH);
 	}
+	// The image is rasterized only once per size, the repetitions
+	// are painted with a single fill of a repeating pattern
+	const Cairo::RefPtr<Cairo::Surface>& refSurf = m_refCachedImage->getAsCachedSurface(nImgPixW, nImgPixH);
+	assert(refSurf);
+	Cairo::RefPtr<Cairo::SurfacePattern> refPattern = Cairo::SurfacePattern::create(refSurf);
+	refPattern->set_extend(Cairo::EXTEND_REPEAT);
+	// The pattern matrix maps user space to pattern space
+	refPattern->set_matrix(Cairo::translation_matrix(- nImgPixX, - nImgPixY));
+//std::cout << "BackgroundThAni::draw nAniPixX=" << nAniPixX << "  nAniPixY=" << nAniPixY << "  nAniPixW=" << nAniPixW << "  nAniPixH=" << nAniPixH << '\n';
+//std::cout << "BackgroundThAni::draw nImgPixX=" << nImgPixX << "  nImgPixY=" << nImgPixY << "  nImgPixW=" << nImgPixW << "  nImgPixH=" << nImgPixH << '\n';
 	refCc->save();
+	refCc->set_source(refPattern);
 	refCc->rectangle(nAniPixX, nAniPixY, nAniPixW, nAniPixH);
-	refCc->clip();
-	for (int32_t nIx = nTLx; nIx <= nBRx; ++nIx) {
-		const int32_t nDestPixX = nImgPixX + nIx * nImgPixW;
-		for (int32_t nIy = nTLy; nIy <= nBRy; ++nIy) {
-			const int32_t nDestPixY = nImgPixY + nIy * nImgPixH;
-//std::cout << "      ::draw nDestPixX=" << nDestPixX << "  nDestPixY=" << nDestPixY << "  nImgPixW=" << nImgPixW << "  nImgPixH=" << nImgPixH << '\n';
-			m_refCachedImage->draw(refCc, nDestPixX, nDestPixY, nImgPixW, nImgPixH);
-		}
-	}
+	refCc->fill();
 	refCc->restore();
 }
 int32_t BackgroundThAniFactory::BackgroundThAni::getZ(int32_t /*nViewTick*/, int32_t /*nTotViewTicks*/) noexcept
@@ -187,7 +189,7 @@ BackgroundThAniFactory::BackgroundThAniFactory(StdTheme* p1Owner) noexcept
 bool BackgroundThAniFactory::supports(const shared_ptr<LevelAnimation>& refLevelAnimation) noexcept
 {
 	assert(refLevelAnimation);
-	return (nullptr != dynamic_cast<BackgroundAnimation*>(refLevelAnimation.get()));
+	return (modelCast<BackgroundAnimation>(refLevelAnimation) != nullptr);
 }
 shared_ptr<ThemeAnimation> BackgroundThAniFactory::create(const shared_ptr<StdThemeContext>& refThemeContext, const shared_ptr<LevelAnimation>& refLevelAnimation) noexcept
 {
@@ -195,7 +197,7 @@ shared_ptr<ThemeAnimation> BackgroundThAniFactory::create(const shared_ptr<StdTh
 	assert(refThemeContext);
 	assert(refLevelAnimation);
 
-	auto refModel = std::dynamic_pointer_cast<BackgroundAnimation>(refLevelAnimation);
+	auto refModel = modelCast<BackgroundAnimation>(refLevelAnimation);
 	if (!refModel) {
 		return shared_ptr<ThemeAnimation>{};
 	}
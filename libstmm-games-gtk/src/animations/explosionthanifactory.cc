@@ -45,7 +45,7 @@ ExplosionThAniFactory::ExplosionThAniFactory(StdTheme* p1Owner, ImageSequenceThA
 bool ExplosionThAniFactory::supports(const shared_ptr<LevelAnimation>& refLevelAnimation) noexcept
 {
 	assert(refLevelAnimation);
-	return (nullptr != dynamic_cast<ExplosionAnimation*>(refLevelAnimation.get()));
+	return (modelCast<ExplosionAnimation>(refLevelAnimation) != nullptr);
 }
 shared_ptr<ThemeAnimation> ExplosionThAniFactory::create(const shared_ptr<StdThemeContext>& refThemeContext
 														, const shared_ptr<LevelAnimation>& refLevelAnimation) noexcept
@@ -53,7 +53,7 @@ shared_ptr<ThemeAnimation> ExplosionThAniFactory::create(const shared_ptr<StdThe
 	assert(refThemeContext);
 	assert(refLevelAnimation);
 
-	auto refModel = std::dynamic_pointer_cast<ExplosionAnimation>(refLevelAnimation);
+	auto refModel = modelCast<ExplosionAnimation>(refLevelAnimation);
 	if (!refModel) {
 		return shared_ptr<ThemeAnimation>{};
 	}
@@ -30,10 +30,15 @@
 #include <stmm-games/util/basictypes.h>
 #include <stmm-games/util/recycler.h>
 
+#include <cairomm/context.h>
+#include <cairomm/surface.h>
+
 #include <cassert>
 //#include <iostream>
 #include <algorithm>
+#include <cmath>
 #include <limits>
+#include <utility>
 #include <vector>
 
 namespace stmg { class StdTheme; }
@@ -52,6 +57,19 @@ int32_t ImageSequenceThAniFactory::ImageSeqThAni::calcBestPic(int32_t nViewTick,
 	assert(fGameInterval > 0.0);
 	const double fViewInterval = fGameInterval / nTotViewTicks;
 	assert(fViewInterval > 0.0);
+
+	// When the animation started at the beginning of a view tick (the usual case)
+	// use the precomputed table
+	const double fViewTicks = fElapsed / fViewInterval;
+	const double fRoundedViewTicks = std::round(fViewTicks);
+	if ((fRoundedViewTicks >= 0.0) && (std::abs(fViewTicks - fRoundedViewTicks) < s_fViewTickTolerance)) {
+		const std::vector<int32_t>& aImageIdxs = m_refAnimation->getViewTickImageIdxs(m_fDuration, fGameInterval, nTotViewTicks);
+		const int32_t nViewTickIdx = static_cast<int32_t>(fRoundedViewTicks);
+		if (nViewTickIdx < static_cast<int32_t>(aImageIdxs.size())) {
+			return aImageIdxs[nViewTickIdx]; //--------------------------------
+		}
+	}
+
 	const double fStartMillisec = fElapsed; // + nViewTick * fViewInterval;
 	const double fStart01 = m_fInverseDuration * fStartMillisec;
 	const double fStop01 = m_fInverseDuration * (fStartMillisec + fViewInterval);
@@ -79,40 +97,12 @@ int32_t ImageSequenceThAniFactory::ImageSeqThAni::calcBestPic(int32_t nViewTick,
 	}
 	return nBestPic;
 }
-FRect ImageSequenceThAniFactory::ImageSeqThAni::calcPicSize(int32_t nBestPic) const noexcept
-{
-	const DynAnimation::DynImage& oDynImage = m_refAnimation->getImageByIdx(nBestPic);
-	const bool bWidthDefined = (oDynImage.m_oRelRect.m_fW > 0.0);
-	const bool bHeightDefined = (oDynImage.m_oRelRect.m_fH > 0.0);
-	if (bWidthDefined && bHeightDefined) {
-		return oDynImage.m_oRelRect; //-----------------------------------------
-	}
-	FRect oRelRect = oDynImage.m_oRelRect;
-	const shared_ptr<Image>& refImg = oDynImage.m_refImage;
-	const NSize oNatSize = refImg->getNaturalSize();
-	if (bWidthDefined) {
-		oRelRect.m_fH = (oRelRect.m_fW * oNatSize.m_nH) / oNatSize.m_nW;
-	} else if (bHeightDefined) {
-		oRelRect.m_fW = (oRelRect.m_fH * oNatSize.m_nW) / oNatSize.m_nH;
-	} else if (oNatSize.m_nW > oNatSize.m_nH) {
-		oRelRect.m_fW = 1.0;
-		oRelRect.m_fH = 1.0 * oNatSize.m_nH / oNatSize.m_nW;
-		oRelRect.m_fY += (1.0 - oRelRect.m_fH) / 2;
-	} else {
-		oRelRect.m_fH = 1.0;
-		oRelRect.m_fW = 1.0 * oNatSize.m_nW / oNatSize.m_nH;
-		oRelRect.m_fX += (1.0 - oRelRect.m_fW) / 2;
-	}
-	return oRelRect;
-}
 void ImageSequenceThAniFactory::ImageSeqThAni::getRectAndBestPic(int32_t nViewTick, int32_t nTotViewTicks
-																, NRect& oPixRect, int32_t& nBestPic) noexcept
+																, NRect& oPixRect, NSize& oRefPixSize, int32_t& nBestPic) noexcept
 {
 	nBestPic = calcBestPic(nViewTick, nTotViewTicks);
-	if (nBestPic != m_nCachePic) {
-		m_nCachePic = nBestPic;
-		m_oCacheRelRect = calcPicSize(nBestPic);
-	}
+	const FRect& oRelRect = m_p1Owner->getFrameRelRect(nBestPic);
+
 	const NSize oTileSize = m_refThemeContext->getTileSize();
 	const int32_t& nTileW = oTileSize.m_nW;
 	const int32_t& nTileH = oTileSize.m_nH;
@@ -125,10 +115,20 @@ void ImageSequenceThAniFactory::ImageSeqThAni::getRectAndBestPic(int32_t nViewTi
 	const double fCenterPosY = oPos.m_fY + 0.5 * fRefH;
 	const int32_t nPixRefW = fRefW * nTileW;
 	const int32_t nPixRefH = fRefH * nTileH;
-	oPixRect.m_nW = m_oCacheRelRect.m_fW * nPixRefW;
-	oPixRect.m_nH = m_oCacheRelRect.m_fH * nPixRefH;
-	oPixRect.m_nX = fCenterPosX * nTileW - 0.5 * m_oCacheRelRect.m_fW * nPixRefW + m_oCacheRelRect.m_fX * nPixRefW;
-	oPixRect.m_nY = fCenterPosY * nTileH - 0.5 * m_oCacheRelRect.m_fH * nPixRefH + m_oCacheRelRect.m_fY * nPixRefH;
+	oRefPixSize = NSize{nPixRefW, nPixRefH};
+	oPixRect.m_nW = oRelRect.m_fW * nPixRefW;
+	oPixRect.m_nH = oRelRect.m_fH * nPixRefH;
+	oPixRect.m_nX = fCenterPosX * nTileW - 0.5 * oRelRect.m_fW * nPixRefW + oRelRect.m_fX * nPixRefW;
+	oPixRect.m_nY = fCenterPosY * nTileH - 0.5 * oRelRect.m_fH * nPixRefH + oRelRect.m_fY * nPixRefH;
+}
+void ImageSequenceThAniFactory::ImageSeqThAni::releaseRefPixSize() noexcept
+{
+	if (m_oRefPixSize.m_nW == 0) {
+		return; //--------------------------------------------------------------
+	}
+	assert(m_p1Owner != nullptr);
+	m_p1Owner->releaseRefPixSize(m_oRefPixSize);
+	m_oRefPixSize = NSize{0, 0};
 }
 void ImageSequenceThAniFactory::ImageSeqThAni::draw(int32_t nViewTick, int32_t nTotViewTicks
 													, const Cairo::RefPtr<Cairo::Context>& refCc) noexcept
@@ -147,18 +147,48 @@ void ImageSequenceThAniFactory::ImageSeqThAni::draw(int32_t nViewTick, int32_t n
 	}
 
 	NRect oRect;
+	NSize oRefPixSize;
 	int32_t nBestPic;
-	getRectAndBestPic(nViewTick, nTotViewTicks, oRect, nBestPic);
+	getRectAndBestPic(nViewTick, nTotViewTicks, oRect, oRefPixSize, nBestPic);
+	if ((oRect.m_nW <= 0) || (oRect.m_nH <= 0)) {
+		m_nLastPicDrawn = nBestPic;
+		return; //--------------------------------------------------------------
+	}
+	if (!(oRefPixSize == m_oRefPixSize)) {
+		// Add the new size before releasing the old one so that
+		// the frames aren't rasterized again if shared with other instances
+		p0Factory->addRefPixSize(oRefPixSize);
+		releaseRefPixSize();
+		m_oRefPixSize = oRefPixSize;
+	}
 
 	const shared_ptr<Image>& refImg = m_refAnimation->getImageByIdx(nBestPic).m_refImage;
 
 	refCc->save();
-
-	refImg->draw(refCc, oRect.m_nX, oRect.m_nY, oRect.m_nW, oRect.m_nH);
+	const Cairo::RefPtr<Cairo::Surface>& refSurf = refImg->getAsCachedSurface(oRect.m_nW, oRect.m_nH);
+	if (refSurf) {
+		refCc->set_source(refSurf, oRect.m_nX, oRect.m_nY);
+		refCc->rectangle(oRect.m_nX, oRect.m_nY, oRect.m_nW, oRect.m_nH);
+		refCc->fill();
+	} else {
+		refImg->draw(refCc, oRect.m_nX, oRect.m_nY, oRect.m_nW, oRect.m_nH);
+	}
 	refCc->restore();
 
 	m_nLastPicDrawn = nBestPic;
 }
+NRect ImageSequenceThAniFactory::ImageSeqThAni::getRect(int32_t nViewTick, int32_t nTotViewTicks) noexcept
+{
+	assert(m_refModel);
+	if (m_p1Owner == nullptr) {
+		return NRect{}; //------------------------------------------------------
+	}
+	NRect oRect;
+	NSize oRefPixSize;
+	int32_t nBestPic;
+	getRectAndBestPic(nViewTick, nTotViewTicks, oRect, oRefPixSize, nBestPic);
+	return oRect;
+}
 int32_t ImageSequenceThAniFactory::ImageSeqThAni::getZ(int32_t /*nViewTick*/, int32_t /*nTotViewTicks*/) noexcept
 {
 	return m_nZ;
@@ -180,6 +210,7 @@ bool ImageSequenceThAniFactory::ImageSeqThAni::isDone(int32_t nViewTick, int32_t
 void ImageSequenceThAniFactory::ImageSeqThAni::onRemoved() noexcept
 {
 	m_refModel.reset();
+	releaseRefPixSize();
 }
 
 ImageSequenceThAniFactory::ImageSequenceThAniFactory(StdTheme* p1Owner, const shared_ptr<DynAnimation>& refDyn) noexcept
@@ -191,7 +222,7 @@ ImageSequenceThAniFactory::ImageSequenceThAniFactory(StdTheme* p1Owner, const sh
 bool ImageSequenceThAniFactory::supports(const shared_ptr<LevelAnimation>& refLevelAnimation) noexcept
 {
 	assert(refLevelAnimation);
-	return (nullptr != dynamic_cast<ImageSequenceAnimation*>(refLevelAnimation.get()));
+	return (modelCast<ImageSequenceAnimation>(refLevelAnimation) != nullptr);
 }
 shared_ptr<ThemeAnimation> ImageSequenceThAniFactory::create(const shared_ptr<StdThemeContext>& refThemeContext
 															, const shared_ptr<LevelAnimation>& refLevelAnimation) noexcept
@@ -199,7 +230,7 @@ shared_ptr<ThemeAnimation> ImageSequenceThAniFactory::create(const shared_ptr<St
 	assert(refThemeContext);
 	assert(refLevelAnimation);
 
-	auto refModel = std::dynamic_pointer_cast<ImageSequenceAnimation>(refLevelAnimation);
+	auto refModel = modelCast<ImageSequenceAnimation>(refLevelAnimation);
 	if (!refModel) {
 		return shared_ptr<ThemeAnimation>{};
 	}
@@ -220,7 +251,8 @@ shared_ptr<ThemeAnimation> ImageSequenceThAniFactory::createAny(const shared_ptr
 	refNew->m_nZ = refLevelAnimation->getZ();
 
 	refNew->m_nLastPicDrawn = -1;
-	refNew->m_nCachePic = -1;
+	// A recycled instance might not have been removed
+	refNew->releaseRefPixSize();
 
 	double fInverseDuration = 1.0;
 	const double fDuration = refLevelAnimation->getDuration();
@@ -234,10 +266,109 @@ shared_ptr<ThemeAnimation> ImageSequenceThAniFactory::createAny(const shared_ptr
 		fInverseDuration = 1.0 / fDuration;
 	}
 	refNew->m_fInverseDuration = fInverseDuration;
+	refNew->m_fDuration = 1.0 / fInverseDuration;
 
 	refNew->m_refThemeContext = refThemeContext;
 
 	return refNew;
 }
 
+const FRect& ImageSequenceThAniFactory::getFrameRelRect(int32_t nIdx) noexcept
+{
+	const int32_t nTotImages = m_refDynAnimation->getTotImages();
+	assert((nIdx >= 0) && (nIdx < nTotImages));
+	if (m_aFrameRelRects.empty()) {
+		m_aFrameRelRects.resize(nTotImages);
+		for (int32_t nCurIdx = 0; nCurIdx < nTotImages; ++nCurIdx) {
+			const DynAnimation::DynImage& oDynImage = m_refDynAnimation->getImageByIdx(nCurIdx);
+			FRect& oRelRect = m_aFrameRelRects[nCurIdx];
+			oRelRect = oDynImage.m_oRelRect;
+			const bool bWidthDefined = (oRelRect.m_fW > 0.0);
+			const bool bHeightDefined = (oRelRect.m_fH > 0.0);
+			if (bWidthDefined && bHeightDefined) {
+				continue; // for nCurIdx
+			}
+			const NSize oNatSize = oDynImage.m_refImage->getNaturalSize();
+			if (bWidthDefined) {
+				oRelRect.m_fH = (oRelRect.m_fW * oNatSize.m_nH) / oNatSize.m_nW;
+			} else if (bHeightDefined) {
+				oRelRect.m_fW = (oRelRect.m_fH * oNatSize.m_nW) / oNatSize.m_nH;
+			} else if (oNatSize.m_nW > oNatSize.m_nH) {
+				oRelRect.m_fW = 1.0;
+				oRelRect.m_fH = 1.0 * oNatSize.m_nH / oNatSize.m_nW;
+				oRelRect.m_fY += (1.0 - oRelRect.m_fH) / 2;
+			} else {
+				oRelRect.m_fH = 1.0;
+				oRelRect.m_fW = 1.0 * oNatSize.m_nW / oNatSize.m_nH;
+				oRelRect.m_fX += (1.0 - oRelRect.m_fW) / 2;
+			}
+		}
+	}
+	return m_aFrameRelRects[nIdx];
+}
+NSize ImageSequenceThAniFactory::getFramePixSize(int32_t nIdx, NSize oRefPixSize) noexcept
+{
+	const FRect& oRelRect = getFrameRelRect(nIdx);
+	// Must be calculated the same way as in ImageSeqThAni::getRectAndBestPic()
+	NSize oPixSize;
+	oPixSize.m_nW = oRelRect.m_fW * oRefPixSize.m_nW;
+	oPixSize.m_nH = oRelRect.m_fH * oRefPixSize.m_nH;
+	return oPixSize;
+}
+void ImageSequenceThAniFactory::addRefPixSize(NSize oRefPixSize) noexcept
+{
+	auto itFind = std::find_if(m_aRefPixSizes.begin(), m_aRefPixSizes.end(), [&](const std::pair<NSize, int32_t>& oPair)
+		{
+			return (oPair.first == oRefPixSize);
+		});
+	if (itFind != m_aRefPixSizes.end()) {
+		++(itFind->second);
+		return; //--------------------------------------------------------------
+	}
+	m_aRefPixSizes.push_back(std::make_pair(oRefPixSize, 1));
+	// Rasterize the frames now rather than when first drawn
+	const int32_t nTotImages = m_refDynAnimation->getTotImages();
+	for (int32_t nIdx = 0; nIdx < nTotImages; ++nIdx) {
+		const NSize oPixSize = getFramePixSize(nIdx, oRefPixSize);
+		if ((oPixSize.m_nW <= 0) || (oPixSize.m_nH <= 0)) {
+			continue; // for nIdx
+		}
+		const shared_ptr<Image>& refImg = m_refDynAnimation->getImageByIdx(nIdx).m_refImage;
+		refImg->addCachedSize(oPixSize);
+		refImg->getAsCachedSurface(oPixSize.m_nW, oPixSize.m_nH);
+	}
+}
+void ImageSequenceThAniFactory::releaseRefPixSize(NSize oRefPixSize) noexcept
+{
+	auto itFind = std::find_if(m_aRefPixSizes.begin(), m_aRefPixSizes.end(), [&](const std::pair<NSize, int32_t>& oPair)
+		{
+			return (oPair.first == oRefPixSize);
+		});
+	if (itFind == m_aRefPixSizes.end()) {
+		return; //--------------------------------------------------------------
+	}
+	if (itFind->second > 1) {
+		--(itFind->second);
+		return; //--------------------------------------------------------------
+	}
+	m_aRefPixSizes.erase(itFind);
+	const int32_t nTotImages = m_refDynAnimation->getTotImages();
+	for (int32_t nIdx = 0; nIdx < nTotImages; ++nIdx) {
+		const NSize oPixSize = getFramePixSize(nIdx, oRefPixSize);
+		if ((oPixSize.m_nW <= 0) || (oPixSize.m_nH <= 0)) {
+			continue; // for nIdx
+		}
+		m_refDynAnimation->getImageByIdx(nIdx).m_refImage->releaseCachedSize(oPixSize);
+	}
+}
+void ImageSequenceThAniFactory::registerTileSize(int32_t nW, int32_t nH) noexcept
+{
+	// Most animations (for example board tile explosions) are one tile in size
+	addRefPixSize(NSize{nW, nH});
+}
+void ImageSequenceThAniFactory::unregisterTileSize(int32_t nW, int32_t nH) noexcept
+{
+	releaseRefPixSize(NSize{nW, nH});
+}
+
 } // namespace stmg
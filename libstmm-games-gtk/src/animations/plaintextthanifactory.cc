@@ -35,6 +35,7 @@
 
 #include <cassert>
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <string>
 
@@ -83,6 +84,7 @@ bool PlainTextThAniFactory::PlainTextThAni::isDone(int32_t nViewTick, int32_t nT
 void PlainTextThAniFactory::PlainTextThAni::onRemoved() noexcept
 {
 	m_refModel.reset();
+	m_oTextCache.clear();
 }
 
 void PlainTextThAniFactory::PlainTextThAni::getRectAndScale(FRect& oRect, double& fScale, double& fPixHLine) noexcept
@@ -168,12 +170,6 @@ void PlainTextThAniFactory::PlainTextThAni::draw(int32_t nViewTick, int32_t nTot
 
 	const bool bCenter = p0Factory->m_bCenter;
 
-	refCc->save();
-	refCc->set_source_rgba(p0Factory->m_fR1, p0Factory->m_fG1, p0Factory->m_fB1, fA1);
-
-	refCc->translate(oFRect.m_fX, oFRect.m_fY);
-	refCc->scale(fScale, fScale);
-
 //if (nViewTick == 0) {
 //std::cout << "-----------------------" << '\n';
 //std::cout << "     nTileH = " << nTileH << '\n';
@@ -201,20 +197,30 @@ void PlainTextThAniFactory::PlainTextThAni::draw(int32_t nViewTick, int32_t nTot
 			const NSize& oTextSize = m_aTextSize[nIdx];
 			const int32_t nTextW = oTextSize.m_nW;
 
-			m_refFontLayout->set_text(sStr);
-			refCc->save();
-			if (bCenter) {
-				refCc->translate((m_fWidest - nTextW) / 2, fDisplY);
-			} else {
-				refCc->translate(0, fDisplY);
-			}
-			m_refFontLayout->show_in_cairo_context(refCc);
-			refCc->restore();
+			const double fDisplX = (bCenter ? (m_fWidest - nTextW) / 2 : 0.0);
+			m_oTextCache.draw(refCc, sStr, oFRect.m_fX + fScale * fDisplX, oFRect.m_fY + fScale * fDisplY, fScale, fA1);
 		}
 		fDisplY += fPixHLine / fScale;
 		++nIdx;
 	}
-	refCc->restore();
+}
+
+NRect PlainTextThAniFactory::PlainTextThAni::getRect(int32_t /*nViewTick*/, int32_t /*nTotViewTicks*/) noexcept
+{
+	assert(m_refModel);
+	if ((m_fWidest <= 0.0) || (m_fHighest <= 0.0)) {
+		return NRect{}; //------------------------------------------------------
+	}
+	FRect oFRect;
+	double fScale;
+	double fPixHLine;
+	getRectAndScale(oFRect, fScale, fPixHLine);
+	NRect oRect;
+	oRect.m_nX = static_cast<int32_t>(std::floor(oFRect.m_fX));
+	oRect.m_nY = static_cast<int32_t>(std::floor(oFRect.m_fY));
+	oRect.m_nW = static_cast<int32_t>(std::ceil(oFRect.m_fX + oFRect.m_fW)) - oRect.m_nX;
+	oRect.m_nH = static_cast<int32_t>(std::ceil(oFRect.m_fY + oFRect.m_fH)) - oRect.m_nY;
+	return oRect;
 }
 
 PlainTextThAniFactory::PlainTextThAniFactory(StdTheme* p1Owner, bool bCenter
@@ -244,7 +250,7 @@ PlainTextThAniFactory::PlainTextThAniFactory(StdTheme* p1Owner, bool bCenter
 bool PlainTextThAniFactory::supports(const shared_ptr<LevelAnimation>& refLevelAnimation) noexcept
 {
 	assert(refLevelAnimation);
-	return (nullptr != dynamic_cast<TextAnimation*>(refLevelAnimation.get()));
+	return (modelCast<TextAnimation>(refLevelAnimation) != nullptr);
 }
 
 shared_ptr<ThemeAnimation> PlainTextThAniFactory::create(const shared_ptr<StdThemeContext>& refThemeContext, const shared_ptr<LevelAnimation>& refLevelAnimation) noexcept
@@ -252,7 +258,7 @@ shared_ptr<ThemeAnimation> PlainTextThAniFactory::create(const shared_ptr<StdThe
 	assert(refThemeContext);
 	assert(refLevelAnimation);
 
-	auto refModel = std::dynamic_pointer_cast<TextAnimation>(refLevelAnimation);
+	auto refModel = modelCast<TextAnimation>(refLevelAnimation);
 	if (!refModel) {
 		return shared_ptr<ThemeAnimation>{}; //---------------------------------
 	}
@@ -303,8 +309,7 @@ shared_ptr<ThemeAnimation> PlainTextThAniFactory::create(const shared_ptr<StdThe
 //std::cout << "                ::create   p0NewThAni->m_fFadeOut=" << p0NewThAni->m_fFadeOut << '\n';
 	const Glib::RefPtr<Pango::Context>& refFontContext = refThemeContext->getFontContext();
 	assert(refFontContext);
-	p0NewThAni->m_refFontLayout = Pango::Layout::create(refFontContext);
-	p0NewThAni->m_refFontLayout->set_font_description(*m_refFont);
+	p0NewThAni->m_oTextCache.reInit(refFontContext, *m_refFont, m_fR1, m_fG1, m_fB1);
 
 	const std::vector<std::string>& aLines = refModel->getText();
 
@@ -315,15 +320,13 @@ shared_ptr<ThemeAnimation> PlainTextThAniFactory::create(const shared_ptr<StdThe
 	p0NewThAni->m_aTextSize.clear();
 	for (const auto& sStr : aLines) {
 //std::cout << "     m_aLines[" << nIdx<< "] = '" << sStr << "'" << '\n';
+		//get the text dimensions
+		const NSize oTextSize = p0NewThAni->m_oTextCache.getTextSize(sStr);
+		// also empty lines get an entry since draw() indexes by line
+		p0NewThAni->m_aTextSize.push_back(oTextSize);
 		if (!sStr.empty()) {
-			p0NewThAni->m_refFontLayout->set_text(sStr);
-			int32_t nTextW;
-			int32_t nTextH;
-			//get the text dimensions
-			p0NewThAni->m_refFontLayout->get_pixel_size(nTextW, nTextH);
-			p0NewThAni->m_aTextSize.push_back(NSize{nTextW, nTextH});
-			fWidest = std::max<double>(fWidest, nTextW);
-			fHighest = std::max<double>(fHighest, nTextH);
+			fWidest = std::max<double>(fWidest, oTextSize.m_nW);
+			fHighest = std::max<double>(fHighest, oTextSize.m_nH);
 		}
 	}
 	p0NewThAni->m_fWidest = fWidest;
@@ -177,7 +177,7 @@ StaticGridThAniFactory::StaticGridThAniFactory(StdTheme* p1Owner, double fOpacit
 bool StaticGridThAniFactory::supports(const shared_ptr<LevelAnimation>& refLevelAnimation) noexcept
 {
 	assert(refLevelAnimation);
-	return (nullptr != dynamic_cast<StaticGridAnimation*>(refLevelAnimation.get()));
+	return (modelCast<StaticGridAnimation>(refLevelAnimation) != nullptr);
 }
 shared_ptr<ThemeAnimation> StaticGridThAniFactory::create(const shared_ptr<StdThemeContext>& refThemeContext
 														, const shared_ptr<LevelAnimation>& refLevelAnimation) noexcept
@@ -185,7 +185,7 @@ shared_ptr<ThemeAnimation> StaticGridThAniFactory::create(const shared_ptr<StdTh
 	assert(refThemeContext);
 	assert(refLevelAnimation);
 
-	auto refModel = std::dynamic_pointer_cast<StaticGridAnimation>(refLevelAnimation);
+	auto refModel = modelCast<StaticGridAnimation>(refLevelAnimation);
 	if (!refModel) {
 		return shared_ptr<ThemeAnimation>{};
 	}
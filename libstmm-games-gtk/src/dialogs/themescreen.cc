@@ -340,6 +340,10 @@ void ThemeScreen::onThemeSelectionChanged() noexcept
 		bSelectedThemeNameChanged = true;
 	}
 	if (bSelectedThemeNameChanged) {
+		if (!m_sSelectedThemeName.empty()) {
+			// Most likely the user will confirm it
+			m_oThemeLoader.prepareTheme(m_sSelectedThemeName);
+		}
 		regenerateThemeInfos();
 	}
 }
@@ -61,6 +61,7 @@
 #include <memory>
 #include <string>
 #include <algorithm>
+#include <chrono>
 //#include <iterator>
 #include <type_traits>
 
@@ -887,7 +888,12 @@ void GameWindow::callbackNextViewTick() noexcept
 		m_p0GameGtkDrawingArea->beforeGameTick();
 
 		// game logic
-		m_refGame->handleTimer(); // might change GameInterval
+		// The input events are time stamped by the device manager with the
+		// steady clock in microseconds: the game needs the same time base to
+		// know when a key action happened within the game interval
+		const int64_t nTimeUsec = std::chrono::duration_cast<std::chrono::microseconds>(
+											std::chrono::steady_clock::now().time_since_epoch()).count();
+		m_refGame->handleTimer(nTimeUsec); // might change GameInterval
 
 		m_oGT.m_fGameInterval = m_refGame->gameNextInterval();
 		const double fNewViewInterval = (m_oGT.m_fGameInterval / m_oGT.m_nTotViewTicks);
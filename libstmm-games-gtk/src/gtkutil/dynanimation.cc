@@ -26,6 +26,7 @@
 #include <cassert>
 //#include <iostream>
 #include <algorithm>
+#include <limits>
 #include <utility>
 
 namespace stmg { class Image; }
@@ -62,6 +63,7 @@ void DynAnimation::addImage(int32_t nNaturalDuration, DynImage&& oDynImage) noex
 {
 	assert(oDynImage.m_refImage);
 	m_oDynImages.addRandomPart(nNaturalDuration, std::move(oDynImage));
+	m_aViewTickTables.clear();
 }
 
 const DynAnimation::DynImage& DynAnimation::getImage(double fElapsed) noexcept
@@ -111,5 +113,60 @@ int32_t DynAnimation::getNaturalDuration() const noexcept
 {
 	return m_oDynImages.getRandomRange();
 }
+const std::vector<int32_t>& DynAnimation::getViewTickImageIdxs(double fDuration, double fGameInterval, int32_t nTotViewTicks) noexcept
+{
+	assert(fDuration > 0.0);
+	assert(fGameInterval > 0.0);
+	assert(nTotViewTicks > 0);
+	auto itFind = std::find_if(m_aViewTickTables.begin(), m_aViewTickTables.end(), [&](const ViewTickTable& oTable)
+		{
+			return (oTable.m_fDuration == fDuration) && (oTable.m_fGameInterval == fGameInterval)
+					&& (oTable.m_nTotViewTicks == nTotViewTicks);
+		});
+	if (itFind == m_aViewTickTables.end()) {
+		if (static_cast<int32_t>(m_aViewTickTables.size()) < s_nMaxViewTickTables) {
+			m_aViewTickTables.emplace_back();
+		}
+		// Recycle the least recently used
+		itFind = m_aViewTickTables.end() - 1;
+		itFind->m_fDuration = fDuration;
+		itFind->m_fGameInterval = fGameInterval;
+		itFind->m_nTotViewTicks = nTotViewTicks;
+		calcViewTickImageIdxs(fDuration, fGameInterval, nTotViewTicks, itFind->m_aImageIdxs);
+	}
+	std::rotate(m_aViewTickTables.begin(), itFind, itFind + 1);
+	return m_aViewTickTables.front().m_aImageIdxs;
+}
+void DynAnimation::calcViewTickImageIdxs(double fDuration, double fGameInterval, int32_t nTotViewTicks
+										, std::vector<int32_t>& aImageIdxs) noexcept
+{
+	aImageIdxs.clear();
+	const double fViewInterval = fGameInterval / nTotViewTicks;
+	if (fDuration / fViewInterval >= s_nMaxViewTickTableSize) {
+		return; //--------------------------------------------------------------
+	}
+	const double fInverseDuration = 1.0 / fDuration;
+	const int32_t nTotImages = getTotImages();
+	for (int32_t nViewTick = 0; ; ++nViewTick) {
+		const double fStartMillisec = nViewTick * fViewInterval;
+		const double fStart01 = fInverseDuration * fStartMillisec;
+		if (fStart01 > 1.0) {
+			break; // for nViewTick
+		}
+		const double fStop01 = fInverseDuration * (fStartMillisec + fViewInterval);
+		const int32_t nStopPic = ((fStop01 >= 1.0) ? nTotImages - 1 : getImageIdx(fStop01));
+		int32_t nBestPic = -1;
+		int32_t nBestPriority = std::numeric_limits<int32_t>::lowest();
+		for (int32_t nCurPic = getImageIdx(fStart01); nCurPic <= nStopPic; ++nCurPic) {
+			const int32_t nPriority = getImageByIdx(nCurPic).m_nPriority;
+			if (nPriority >= nBestPriority) {
+				nBestPriority = nPriority;
+				nBestPic = nCurPic;
+			}
+		}
+		assert(nBestPic >= 0);
+		aImageIdxs.push_back(nBestPic);
+	}
+}
 
 } // namespace stmg
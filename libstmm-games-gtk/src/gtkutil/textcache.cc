@@ -0,0 +1,271 @@
+/*
+ * Copyright © 2019-2020  Stefano Marsili, <stemars@gmx.ch>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>
+ */
+/*
+ * File:   textcache.cc
+ */
+
+#include "gtkutil/textcache.h"
+
+#include <cairomm/context.h>
+#include <cairomm/enums.h>
+
+#include <cassert>
+#include <algorithm>
+#include <cmath>
+
+namespace stmg
+{
+
+// Rounds a user space position to the nearest device pixel
+static void snapToDevicePixel(const Cairo::RefPtr<Cairo::Context>& refCc, double& fX, double& fY) noexcept
+{
+	refCc->user_to_device(fX, fY);
+	fX = std::round(fX);
+	fY = std::round(fY);
+	refCc->device_to_user(fX, fY);
+}
+
+constexpr int32_t TextCache::s_nMaxCachedTexts;
+const char* const TextCache::s_p0StripChars = "0123456789 +-.,:/%";
+
+TextCache::TextCache() noexcept
+: m_fR1(0.0)
+, m_fG1(0.0)
+, m_fB1(0.0)
+, m_bStripInitialized(false)
+, m_nStripH(0)
+, m_fStripScale(0.0)
+{
+}
+void TextCache::reInit(const Glib::RefPtr<Pango::Context>& refFontContext, const Pango::FontDescription& oFont
+						, double fR1, double fG1, double fB1) noexcept
+{
+	assert(refFontContext);
+	m_refLayout = Pango::Layout::create(refFontContext);
+	m_refLayout->set_font_description(oFont);
+	m_fR1 = fR1;
+	m_fG1 = fG1;
+	m_fB1 = fB1;
+	clear();
+}
+void TextCache::clear() noexcept
+{
+	m_oTexts.clear();
+	m_oTextIdx.clear();
+	m_bStripInitialized = false;
+	m_aGlyphIdx.clear();
+	m_aGlyphs.clear();
+	m_aKernings.clear();
+	m_nStripH = 0;
+	m_fStripScale = 0.0;
+	m_refStripSurf = Cairo::RefPtr<Cairo::ImageSurface>{};
+}
+bool TextCache::isStripText(const std::string& sText) const noexcept
+{
+	assert(m_bStripInitialized);
+	for (const char c : sText) {
+		const auto nC = static_cast<unsigned char>(c);
+		if ((nC >= m_aGlyphIdx.size()) || (m_aGlyphIdx[nC] < 0)) {
+			return false; //----------------------------------------------------
+		}
+	}
+	return true;
+}
+void TextCache::initStrip() noexcept
+{
+	assert(m_refLayout);
+	m_aGlyphIdx.assign(128, -1);
+	m_aGlyphs.clear();
+	m_nStripH = 0;
+	// The advances are measured in Pango units so that rounding errors don't add up
+	for (const char* p0C = s_p0StripChars; *p0C != 0; ++p0C) {
+		m_refLayout->set_text(std::string(1, *p0C));
+		int32_t nW;
+		int32_t nH;
+		m_refLayout->get_size(nW, nH);
+		m_aGlyphIdx[static_cast<unsigned char>(*p0C)] = static_cast<int32_t>(m_aGlyphs.size());
+		Glyph oGlyph;
+		oGlyph.m_fAdvance = 1.0 * nW / PANGO_SCALE;
+		m_aGlyphs.push_back(oGlyph);
+		m_nStripH = std::max(m_nStripH, static_cast<int32_t>(std::ceil(1.0 * nH / PANGO_SCALE)));
+	}
+	// The kerning of a pair is what the pair's layout width differs from the sum of the advances
+	const int32_t nTotGlyphs = static_cast<int32_t>(m_aGlyphs.size());
+	m_aKernings.assign(nTotGlyphs * nTotGlyphs, 0.0);
+	int32_t nGlyphIdx = 0;
+	for (const char* p0C = s_p0StripChars; *p0C != 0; ++p0C, ++nGlyphIdx) {
+		int32_t nNextGlyphIdx = 0;
+		for (const char* p0NextC = s_p0StripChars; *p0NextC != 0; ++p0NextC, ++nNextGlyphIdx) {
+			m_refLayout->set_text(std::string{*p0C, *p0NextC});
+			int32_t nW;
+			int32_t nH;
+			m_refLayout->get_size(nW, nH);
+			m_aKernings[nGlyphIdx * nTotGlyphs + nNextGlyphIdx] = 1.0 * nW / PANGO_SCALE
+								- m_aGlyphs[nGlyphIdx].m_fAdvance - m_aGlyphs[nNextGlyphIdx].m_fAdvance;
+		}
+	}
+	m_bStripInitialized = true;
+}
+double TextCache::getStripKerning(int32_t nGlyphIdx, int32_t nNextGlyphIdx) const noexcept
+{
+	return m_aKernings[nGlyphIdx * static_cast<int32_t>(m_aGlyphs.size()) + nNextGlyphIdx];
+}
+double TextCache::getStripTextWidth(const std::string& sText) const noexcept
+{
+	double fW = 0.0;
+	int32_t nPrevGlyphIdx = -1;
+	for (const char c : sText) {
+		const int32_t nGlyphIdx = m_aGlyphIdx[static_cast<unsigned char>(c)];
+		if (nPrevGlyphIdx >= 0) {
+			fW += getStripKerning(nPrevGlyphIdx, nGlyphIdx);
+		}
+		fW += m_aGlyphs[nGlyphIdx].m_fAdvance;
+		nPrevGlyphIdx = nGlyphIdx;
+	}
+	return fW;
+}
+void TextCache::renderStrip(double fScale) noexcept
+{
+	assert(m_bStripInitialized);
+	// Each glyph gets a slot with a one pixel margin on both sides
+	int32_t nStripW = 0;
+	for (Glyph& oGlyph : m_aGlyphs) {
+		oGlyph.m_nSlotX = nStripW + 1;
+		oGlyph.m_nSlotW = static_cast<int32_t>(std::ceil(oGlyph.m_fAdvance * fScale)) + 2;
+		nStripW += oGlyph.m_nSlotW;
+	}
+	const int32_t nStripH = static_cast<int32_t>(std::ceil(m_nStripH * fScale)) + 1;
+	m_refStripSurf = Cairo::ImageSurface::create(Cairo::FORMAT_ARGB32, std::max(1, nStripW), std::max(1, nStripH));
+	Cairo::RefPtr<Cairo::Context> refCc = Cairo::Context::create(m_refStripSurf);
+	refCc->set_source_rgb(m_fR1, m_fG1, m_fB1);
+	int32_t nIdx = 0;
+	for (const char* p0C = s_p0StripChars; *p0C != 0; ++p0C, ++nIdx) {
+		refCc->save();
+		refCc->translate(m_aGlyphs[nIdx].m_nSlotX, 0);
+		refCc->scale(fScale, fScale);
+		m_refLayout->set_text(std::string(1, *p0C));
+		m_refLayout->show_in_cairo_context(refCc);
+		refCc->restore();
+	}
+	m_fStripScale = fScale;
+}
+TextCache::TextEntry& TextCache::getTextEntry(const std::string& sText) noexcept
+{
+	auto itFind = m_oTextIdx.find(sText);
+	if (itFind != m_oTextIdx.end()) {
+		// most recently used
+		m_oTexts.splice(m_oTexts.begin(), m_oTexts, itFind->second);
+		return m_oTexts.front(); //---------------------------------------------
+	}
+	if (static_cast<int32_t>(m_oTexts.size()) >= s_nMaxCachedTexts) {
+		// Evict the least recently used
+		m_oTextIdx.erase(m_oTexts.back().m_sText);
+		m_oTexts.pop_back();
+	}
+	m_oTexts.emplace_front();
+	TextEntry& oEntry = m_oTexts.front();
+	oEntry.m_sText = sText;
+	m_oTextIdx.emplace(sText, m_oTexts.begin());
+	m_refLayout->set_text(sText);
+	m_refLayout->get_pixel_size(oEntry.m_oSize.m_nW, oEntry.m_oSize.m_nH);
+	return oEntry;
+}
+NSize TextCache::getTextSize(const std::string& sText) noexcept
+{
+	if (sText.empty()) {
+		return NSize{0, 0}; //--------------------------------------------------
+	}
+	if (!m_bStripInitialized) {
+		initStrip();
+	}
+	if (isStripText(sText)) {
+		NSize oSize;
+		oSize.m_nW = static_cast<int32_t>(std::ceil(getStripTextWidth(sText)));
+		oSize.m_nH = m_nStripH;
+		return oSize; //--------------------------------------------------------
+	}
+	return getTextEntry(sText).m_oSize;
+}
+Cairo::RefPtr<Cairo::ImageSurface> TextCache::renderText(const std::string& sText, NSize oSize, double fScale) noexcept
+{
+	const int32_t nSurfW = static_cast<int32_t>(std::ceil(oSize.m_nW * fScale)) + 1;
+	const int32_t nSurfH = static_cast<int32_t>(std::ceil(oSize.m_nH * fScale)) + 1;
+	Cairo::RefPtr<Cairo::ImageSurface> refSurf = Cairo::ImageSurface::create(Cairo::FORMAT_ARGB32, nSurfW, nSurfH);
+	Cairo::RefPtr<Cairo::Context> refCc = Cairo::Context::create(refSurf);
+	refCc->set_source_rgb(m_fR1, m_fG1, m_fB1);
+	refCc->scale(fScale, fScale);
+	m_refLayout->set_text(sText);
+	m_refLayout->show_in_cairo_context(refCc);
+	return refSurf;
+}
+void TextCache::draw(const Cairo::RefPtr<Cairo::Context>& refCc, const std::string& sText
+					, double fX, double fY, double fScale, double fAlpha1) noexcept
+{
+	assert(m_refLayout);
+	if (sText.empty() || (fScale <= 0.0)) {
+		return; //--------------------------------------------------------------
+	}
+	if (!m_bStripInitialized) {
+		initStrip();
+	}
+	if (isStripText(sText)) {
+		if ((!m_refStripSurf) || (m_fStripScale != fScale)) {
+			renderStrip(fScale);
+		}
+		const double fGlyphH = m_refStripSurf->get_height();
+		double fCurX = 0.0;
+		int32_t nPrevGlyphIdx = -1;
+		for (const char c : sText) {
+			const int32_t nGlyphIdx = m_aGlyphIdx[static_cast<unsigned char>(c)];
+			const Glyph& oGlyph = m_aGlyphs[nGlyphIdx];
+			if (nPrevGlyphIdx >= 0) {
+				fCurX += getStripKerning(nPrevGlyphIdx, nGlyphIdx);
+			}
+			// The strip was rendered with integer slot positions, placing the
+			// glyphs at device pixels keeps them as sharp as in the strip
+			double fGlyphX = fX + fCurX * fScale;
+			double fGlyphY = fY;
+			snapToDevicePixel(refCc, fGlyphX, fGlyphY);
+			refCc->save();
+			refCc->rectangle(fGlyphX - 1, fGlyphY, oGlyph.m_nSlotW, fGlyphH);
+			refCc->clip();
+			refCc->set_source(m_refStripSurf, fGlyphX - oGlyph.m_nSlotX, fGlyphY);
+			refCc->paint_with_alpha(fAlpha1);
+			refCc->restore();
+			fCurX += oGlyph.m_fAdvance;
+			nPrevGlyphIdx = nGlyphIdx;
+		}
+		return; //--------------------------------------------------------------
+	}
+	TextEntry& oEntry = getTextEntry(sText);
+	if ((oEntry.m_oSize.m_nW <= 0) || (oEntry.m_oSize.m_nH <= 0)) {
+		return; //--------------------------------------------------------------
+	}
+	if ((!oEntry.m_refSurf) || (oEntry.m_fScale != fScale)) {
+		oEntry.m_refSurf = renderText(sText, oEntry.m_oSize, fScale);
+		oEntry.m_fScale = fScale;
+	}
+	snapToDevicePixel(refCc, fX, fY);
+	refCc->save();
+	refCc->rectangle(fX, fY, oEntry.m_refSurf->get_width(), oEntry.m_refSurf->get_height());
+	refCc->clip();
+	refCc->set_source(oEntry.m_refSurf, fX, fY);
+	refCc->paint_with_alpha(fAlpha1);
+	refCc->restore();
+}
+
+} // namespace stmg
@@ -37,7 +37,6 @@
 #include <stmm-games/animations/explosionanimation.h>
 #include <stmm-games/util/recycler.h>
 #include <stmm-games/util/coords.h>
-#include <stmm-games/util/util.h>
 #include <stmm-games/util/direction.h>
 
 #include <stmm-input-au/playbackcapability.h>
@@ -48,6 +47,7 @@
 #include <vector>
 #include <cassert>
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <utility>
 
@@ -59,13 +59,12 @@ namespace stmg
 
 static const int32_t s_nZObjectZBoardTileDestruct = 20000;
 
-class PrivateExplosionAnimation : public ExplosionAnimation
+class StdLevelView::PrivateExplosionAnimation : public ExplosionAnimation
 {
 public:
 	using ExplosionAnimation::ExplosionAnimation;
 	using ExplosionAnimation::reInit;
 };
-static Recycler<PrivateExplosionAnimation, ExplosionAnimation> s_oBoardDestructRecycler;
 
 StdLevelView::StdLevelView() noexcept
 : m_p0StdView(nullptr)
@@ -89,6 +88,8 @@ StdLevelView::StdLevelView() noexcept
 , m_nSubshowH(-1)
 , m_nBoardSurfPixW(-1)
 , m_nBoardSurfPixH(-1)
+, m_nBoardOriginX(0)
+, m_nBoardOriginY(0)
 , m_nShowSurfPixW(-1)
 , m_nShowSurfPixH(-1)
 , m_nSubshowSurfPixW(-1)
@@ -160,7 +161,10 @@ void StdLevelView::reInit(bool bSubshows, const std::vector< shared_ptr<LevelSho
 		assert((m_nSubshowW > 0) && (m_nSubshowW <= m_nShowW));
 		assert((m_nSubshowH > 0) && (m_nSubshowH <= m_nShowH));
 	}
-	m_oTickTileAnis.clear();
+	m_aTickTileAniFlags.assign(m_nBoardW * m_nBoardH, false);
+	m_aTickTileAnis.clear();
+	m_nBoardOriginX = 0;
+	m_nBoardOriginY = 0;
 
 	// This is to make clear that onSizeChanged() has to be called
 	m_nTileW = -1;
@@ -321,6 +325,8 @@ void StdLevelView::recreateSurfs() noexcept
 	}
 
 	//
+	m_nBoardOriginX = 0;
+	m_nBoardOriginY = 0;
 	m_refBoardCc->save();
 	m_refBoardCc->set_source_rgba(0, 0, 0, 0); // transparency
 	m_refBoardCc->set_operator(Cairo::OPERATOR_SOURCE);
@@ -349,7 +355,7 @@ void StdLevelView::recreateSurfs() noexcept
 
 void StdLevelView::beforeGameTick() noexcept
 {
-	m_oTickTileAnis.clear();
+	clearTickTileAnis();
 }
 void StdLevelView::setSoundListenersToShowCenter() noexcept
 {
@@ -430,18 +436,16 @@ void StdLevelView::drawStepToBuffers(int32_t nViewTick, int32_t nTotViewTicks, b
 	assert((nViewTick >= 0) && (nViewTick < nTotViewTicks));
 
 	// Draw board`s animated tiles if any
-	if (!m_oTickTileAnis.empty())	{
+	if (!m_aTickTileAnis.empty())	{
 //std::cout << "StdLevelView::drawStep redraw animated tiles! gameTick=" << m_refLevel->game().gameElapsed() << " m_nViewTick=" << m_nViewTick << '\n';
-		for (auto it = m_oTickTileAnis.cbegin(); it != m_oTickTileAnis.end(); ++it) {
-			const int64_t nXY = *it;
-			const NPoint oXY = Util::unpackPointFromInt64(nXY);
+		for (const NPoint& oXY : m_aTickTileAnis) {
 			const int32_t nX = oXY.m_nX;
 			const int32_t nY = oXY.m_nY;
-//std::cout << "StdLevelView::drawStep    m_oTickTileAnis                    nX=" << nX << " nY=" << nY << '\n';
+//std::cout << "StdLevelView::drawStep    m_aTickTileAnis                    nX=" << nX << " nY=" << nY << '\n';
 			m_refBoardCc->save();
 			m_refBoardCc->set_operator(Cairo::OPERATOR_SOURCE);
 			m_refBoardCc->set_source_rgba(0, 0, 0, 0);
-			m_refBoardCc->rectangle(nX * m_nTileW, nY * m_nTileH, m_nTileW, m_nTileH);
+			m_refBoardCc->rectangle(boardSurfPixX(nX), boardSurfPixY(nY), m_nTileW, m_nTileH);
 			m_refBoardCc->fill();
 			drawBoard(m_refBoardCc, nX, nY, 1, 1, nViewTick, nTotViewTicks);
 			m_refBoardCc->restore();
@@ -494,13 +498,19 @@ void StdLevelView::drawStepToBuffers(int32_t nViewTick, int32_t nTotViewTicks, b
 				const int32_t nZR = refR->getZ(nViewTick, nTotViewTicks);
 				return (nZL < nZR);
 			});
+	// Only the visible parts of the show surface are drawn
+	calcShowVisibleRects(nViewTick, nTotViewTicks);
+	m_refShowCc->save();
+	for (const NRect& oRect : m_aShowVisibleRects) {
+		m_refShowCc->rectangle(oRect.m_nX, oRect.m_nY, oRect.m_nW, oRect.m_nH);
+	}
+	m_refShowCc->clip();
 	if (m_bSubshows) {
-		// clear the show area
+		// clear the (visible) show area
 		m_refShowCc->save();
 		m_refShowCc->set_operator(Cairo::OPERATOR_SOURCE);
-		m_refShowCc->rectangle(0, 0, m_nShowSurfPixW, m_nShowSurfPixH);
 		m_refShowCc->set_source_rgba(0, 0, 0, 0);
-		m_refShowCc->fill();
+		m_refShowCc->paint();
 		m_refShowCc->restore();
 	} else {
 		// draw the widget background
@@ -530,8 +540,7 @@ void StdLevelView::drawStepToBuffers(int32_t nViewTick, int32_t nTotViewTicks, b
 			// draw Board
 			m_refShowCc->save();
 			m_refShowCc->set_operator(Cairo::OPERATOR_OVER);
-			m_refShowCc->set_source(m_refBoardSurf, - fShowPosX, - fShowPosY);
-			m_refShowCc->paint();
+			paintBoardSurf(m_refShowCc, - fShowPosX, - fShowPosY);
 			m_refShowCc->restore();
 			bBoardDrawn = true;
 		}
@@ -540,7 +549,7 @@ void StdLevelView::drawStepToBuffers(int32_t nViewTick, int32_t nTotViewTicks, b
 		}
 		auto& refAniData = *itAniData;
 		auto& oAniData = *refAniData;
-		const bool bRemove = drawAniData(oAniData, m_refShowCc, fShowPosX, fShowPosY, nViewTick, nTotViewTicks);
+		const bool bRemove = drawAniData(oAniData, m_refShowCc, fShowPosX, fShowPosY, nViewTick, nTotViewTicks, true);
 		if (bRemove) {
 //std::cout << "StdLevelView::drawStepToBuffers  drawAniData() remove" << '\n';
 			itAniData = anidataRecycleKeepOrder(m_aAniDataNonSubshow, itAniData);
@@ -549,6 +558,7 @@ void StdLevelView::drawStepToBuffers(int32_t nViewTick, int32_t nTotViewTicks, b
 		}
 	}
 	}
+	m_refShowCc->restore();
 	if (m_bSubshows) {
 		const int32_t nTotLevelPlayers = static_cast<int32_t>(m_aSubshowData.size());
 		assert(nTotLevelPlayers > 0);
@@ -591,7 +601,7 @@ void StdLevelView::drawStepToBuffers(int32_t nViewTick, int32_t nTotViewTicks, b
 			while (itAniData != aAniData.end()) {
 				auto& refAniData = *itAniData;
 				auto& oAniData = *refAniData;
-				const bool bRemove = drawAniData(oAniData, refSubshowCc, fSubshowPosX, fSubshowPosY, nViewTick, nTotViewTicks);
+				const bool bRemove = drawAniData(oAniData, refSubshowCc, fSubshowPosX, fSubshowPosY, nViewTick, nTotViewTicks, false);
 				if (bRemove) {
 					itAniData = anidataRecycleKeepOrder(aAniData, itAniData);
 					//m_aAniDataRecycle.emplace_back(refAniData);
@@ -640,11 +650,98 @@ void StdLevelView::drawBuffers(const Cairo::RefPtr<Cairo::Context>& refCc) noexc
 		}
 	}
 }
+void StdLevelView::calcShowVisibleRects(int32_t nViewTick, int32_t nTotViewTicks) noexcept
+{
+	m_aShowVisibleRects.clear();
+	const NRect oShowRect{0, 0, m_nShowSurfPixW, m_nShowSurfPixH};
+	if ((oShowRect.m_nW <= 0) || (oShowRect.m_nH <= 0)) {
+		return; //--------------------------------------------------------------
+	}
+	if (!m_bSubshows) {
+		m_aShowVisibleRects.push_back(oShowRect);
+		return; //--------------------------------------------------------------
+	}
+	if ((m_nSubshowSurfPixW <= 0) || (m_nSubshowSurfPixH <= 0)) {
+		return; //--------------------------------------------------------------
+	}
+	const int32_t nTotLevelPlayers = static_cast<int32_t>(m_aSubshowData.size());
+	for (int32_t nLevelPlayer = 0; nLevelPlayer < nTotLevelPlayers; ++nLevelPlayer) {
+		const auto oSubshowPos = m_refLevel->subshowGet(nLevelPlayer).getPos(nViewTick, nTotViewTicks);
+		NRect oSubshowRect;
+		// One more pixel because of the fractional position
+		oSubshowRect.m_nX = static_cast<int32_t>(std::floor(oSubshowPos.m_fX * m_nTileW));
+		oSubshowRect.m_nY = static_cast<int32_t>(std::floor(oSubshowPos.m_fY * m_nTileH));
+		oSubshowRect.m_nW = m_nSubshowSurfPixW + 1;
+		oSubshowRect.m_nH = m_nSubshowSurfPixH + 1;
+		const NRect oRect = NRect::intersectionRect(oShowRect, oSubshowRect);
+		if ((oRect.m_nW > 0) && (oRect.m_nH > 0)) {
+			m_aShowVisibleRects.push_back(oRect);
+		}
+	}
+}
+bool StdLevelView::isShowRectVisible(const NRect& oRect) const noexcept
+{
+	if ((oRect.m_nW <= 0) || (oRect.m_nH <= 0)) {
+		return false; //--------------------------------------------------------
+	}
+	for (const NRect& oVisibleRect : m_aShowVisibleRects) {
+		if (NRect::doIntersect(oRect, oVisibleRect)) {
+			return true; //-----------------------------------------------------
+		}
+	}
+	return false;
+}
+NRect StdLevelView::getLevelBlockRect(LevelBlock& oLevelBlock, int32_t nViewTick, int32_t nTotViewTicks) const noexcept
+{
+	const FPoint oPos = oLevelBlock.blockVTPos(nViewTick, nTotViewTicks);
+	bool bFirst = true;
+	int32_t nMinX = 0;
+	int32_t nMinY = 0;
+	int32_t nMaxX = -1;
+	int32_t nMaxY = -1;
+	const std::vector<int32_t>& aBrickId = oLevelBlock.blockVTBrickIds(nViewTick, nTotViewTicks);
+	for (auto& nBrickId : aBrickId) {
+		if (!oLevelBlock.blockVTBrickVisible(nViewTick, nTotViewTicks, nBrickId)) {
+			continue; // for nBrickId
+		}
+		const NPoint oBrickRelPos = oLevelBlock.blockVTBrickPos(nViewTick, nTotViewTicks, nBrickId);
+		if (bFirst) {
+			bFirst = false;
+			nMinX = oBrickRelPos.m_nX;
+			nMinY = oBrickRelPos.m_nY;
+			nMaxX = oBrickRelPos.m_nX;
+			nMaxY = oBrickRelPos.m_nY;
+		} else {
+			nMinX = std::min(nMinX, oBrickRelPos.m_nX);
+			nMinY = std::min(nMinY, oBrickRelPos.m_nY);
+			nMaxX = std::max(nMaxX, oBrickRelPos.m_nX);
+			nMaxY = std::max(nMaxY, oBrickRelPos.m_nY);
+		}
+	}
+	if (bFirst) {
+		return NRect{}; //------------------------------------------------------
+	}
+	// Same rounding as in drawLevelBlock(), one more pixel to be safe
+	NRect oRect;
+	oRect.m_nX = static_cast<int32_t>((oPos.m_fX + nMinX) * m_nTileW) - 1;
+	oRect.m_nY = static_cast<int32_t>((oPos.m_fY + nMinY) * m_nTileH) - 1;
+	oRect.m_nW = (nMaxX - nMinX + 1) * m_nTileW + 2;
+	oRect.m_nH = (nMaxY - nMinY + 1) * m_nTileH + 2;
+	return oRect;
+}
 bool StdLevelView::drawAniData(AniData& oAniData, const Cairo::RefPtr<Cairo::Context>& refCc
 								, double fShowPixX, double fShowPixY
-								, int32_t nViewTick, int32_t nTotViewTicks) noexcept
+								, int32_t nViewTick, int32_t nTotViewTicks, bool bCull) noexcept
 {
 	if (oAniData.m_p0LevelBlock != nullptr) {
+		if (bCull) {
+			NRect oRect = getLevelBlockRect(*(oAniData.m_p0LevelBlock), nViewTick, nTotViewTicks);
+			oRect.m_nX -= static_cast<int32_t>(std::ceil(fShowPixX));
+			oRect.m_nY -= static_cast<int32_t>(std::ceil(fShowPixY));
+			if (!isShowRectVisible(oRect)) {
+				return false; //------------------------------------------------
+			}
+		}
 		refCc->translate(- fShowPixX, - fShowPixY);
 		drawLevelBlock(refCc, *(oAniData.m_p0LevelBlock), nViewTick, nTotViewTicks);
 		refCc->translate(+ fShowPixX, + fShowPixY);
@@ -657,6 +754,22 @@ bool StdLevelView::drawAniData(AniData& oAniData, const Cairo::RefPtr<Cairo::Con
 		return true; //--------------------------------------------------------
 	}
 	const auto eRefSys = oAniData.m_eRefSys;
+	if (bCull) {
+		NRect oRect = refAni->getRect(nViewTick, nTotViewTicks);
+		// If the rect is not known the animation is always drawn
+		if ((oRect.m_nW > 0) && (oRect.m_nH > 0)) {
+			if (eRefSys == LevelAnimation::REFSYS_BOARD) {
+				// One more pixel because of the fractional position
+				oRect.m_nX -= static_cast<int32_t>(std::ceil(fShowPixX));
+				oRect.m_nY -= static_cast<int32_t>(std::ceil(fShowPixY));
+				++oRect.m_nW;
+				++oRect.m_nH;
+			}
+			if (!isShowRectVisible(oRect)) {
+				return false; //------------------------------------------------
+			}
+		}
+	}
 	if (eRefSys == LevelAnimation::REFSYS_BOARD) {
 		refCc->translate(- fShowPixX, - fShowPixY);
 	}
@@ -746,11 +859,9 @@ void StdLevelView::drawBoard(const Cairo::RefPtr<Cairo::Context>& refCc, int32_t
 	const int32_t nTotTileAni = m_nThemeTotTileAnis;
 	m_aTileAniElapsed.resize(nTotTileAni);
 
-	const int32_t nTileW = m_nTileW;
-	const int32_t nTileH = m_nTileH;
-	const int32_t nAreaPixH = nTileH * nH;
-	refCc->translate(nX * nTileW, nY * nTileH);
+	// The cells are drawn at their (wrapped around) position in the board surface
 	for (int32_t nCurX = nX; nCurX < nX+nW; ++nCurX) {
+		const int32_t nPixX = boardSurfPixX(nCurX);
 		for (int32_t nCurY = nY; nCurY < nY+nH; ++nCurY) {
 			const Tile& oTile = m_refLevel->boardGetTile(nCurX, nCurY);
 //std::cout << "StdLevelView::drawBoard nX=" << nCurX << " nY=" << nCurY << "   "; m_refLevel->dumpTile(oTile);
@@ -759,13 +870,66 @@ void StdLevelView::drawBoard(const Cairo::RefPtr<Cairo::Context>& refCc, int32_t
 					const double fElapsed = m_refLevel->boardGetTileAniElapsed(nCurX, nCurY, nIdxAni, nViewTick, nTotViewTicks);
 					m_aTileAniElapsed[nIdxAni] = fElapsed;
 				}
+				const int32_t nPixY = boardSurfPixY(nCurY);
+				refCc->translate(nPixX, nPixY);
 				m_refThemeCtx->drawTile(m_nBoardPainterIdx, refCc, oTile, -1, m_aTileAniElapsed);
+				refCc->translate(-nPixX, -nPixY);
+			}
+		}
+	}
+}
+void StdLevelView::paintBoardSurf(const Cairo::RefPtr<Cairo::Context>& refCc, double fPixX, double fPixY) noexcept
+{
+	if ((m_nBoardOriginX == 0) && (m_nBoardOriginY == 0)) {
+		refCc->set_source(m_refBoardSurf, fPixX, fPixY);
+		refCc->paint();
+		return; //--------------------------------------------------------------
+	}
+	// The board surface is split at the origin into up to four rectangles
+	// that are painted at their board position
+	const int32_t nOriginPixX = m_nBoardOriginX * m_nTileW;
+	const int32_t nOriginPixY = m_nBoardOriginY * m_nTileH;
+	const int32_t nBoardPixW = m_nBoardW * m_nTileW;
+	const int32_t nBoardPixH = m_nBoardH * m_nTileH;
+	// Board x of surface x nOriginPixX and of surface x 0
+	const int32_t aBoardPixX[2] = {0, nBoardPixW - nOriginPixX};
+	const int32_t aBoardPixW[2] = {nBoardPixW - nOriginPixX, nOriginPixX};
+	const int32_t aBoardPixY[2] = {0, nBoardPixH - nOriginPixY};
+	const int32_t aBoardPixH[2] = {nBoardPixH - nOriginPixY, nOriginPixY};
+	for (int32_t nPartX = 0; nPartX < 2; ++nPartX) {
+		if (aBoardPixW[nPartX] <= 0) {
+			continue; // for nPartX
+		}
+		for (int32_t nPartY = 0; nPartY < 2; ++nPartY) {
+			if (aBoardPixH[nPartY] <= 0) {
+				continue; // for nPartY
 			}
-			refCc->translate(0, nTileH);
+			// surface x = (board x + nOriginPixX) modulo nBoardPixW
+			const double fSrcX = fPixX + aBoardPixX[nPartX] - ((nPartX == 0) ? nOriginPixX : 0);
+			const double fSrcY = fPixY + aBoardPixY[nPartY] - ((nPartY == 0) ? nOriginPixY : 0);
+			refCc->save();
+			refCc->rectangle(fPixX + aBoardPixX[nPartX], fPixY + aBoardPixY[nPartY], aBoardPixW[nPartX], aBoardPixH[nPartY]);
+			refCc->clip();
+			refCc->set_source(m_refBoardSurf, fSrcX, fSrcY);
+			refCc->paint();
+			refCc->restore();
 		}
-		refCc->translate(nTileW, -nAreaPixH);
 	}
 }
+void StdLevelView::boardSurfLinearize() noexcept
+{
+	if ((m_nBoardOriginX == 0) && (m_nBoardOriginY == 0)) {
+		return; //--------------------------------------------------------------
+	}
+	m_refBoard2Cc->save();
+	m_refBoard2Cc->set_operator(Cairo::OPERATOR_SOURCE);
+	paintBoardSurf(m_refBoard2Cc, 0, 0);
+	m_refBoard2Cc->restore();
+	m_refBoardSurf.swap(m_refBoard2Surf);
+	m_refBoardCc.swap(m_refBoard2Cc);
+	m_nBoardOriginX = 0;
+	m_nBoardOriginY = 0;
+}
 void StdLevelView::drawLevelBlock(const Cairo::RefPtr<Cairo::Context>& refCc, LevelBlock& oLevelBlock
 								, int32_t nViewTick, int32_t nTotViewTicks) noexcept
 {
@@ -915,17 +1079,34 @@ void StdLevelView::boardAnimateTiles(NRect oArea) noexcept
 //std::cout << "StdLevelView::boardAnimateTiles  nX=" << nX << "  nY=" << nY << "   nW=" << nW << "  nH=" << nH << '\n';
 	const int32_t nToNX = oArea.m_nX + oArea.m_nW;
 	const int32_t nToNY = oArea.m_nY + oArea.m_nH;
-	for (int32_t nCurX = oArea.m_nX; nCurX < nToNX; ++nCurX) {
-		for (int32_t nCurY = oArea.m_nY; nCurY < nToNY; ++nCurY) {
-			const int64_t nCurXY = Util::packPointToInt64(NPoint{nCurX, nCurY});
-			m_oTickTileAnis.insert(nCurXY);
+	for (int32_t nCurY = oArea.m_nY; nCurY < nToNY; ++nCurY) {
+		for (int32_t nCurX = oArea.m_nX; nCurX < nToNX; ++nCurX) {
+			addTickTileAni(nCurX, nCurY);
 		}
 	}
 }
 void StdLevelView::boardAnimateTile(NPoint oXY) noexcept
 {
-	const int64_t nXY = Util::packPointToInt64(NPoint{oXY.m_nX, oXY.m_nY});
-	m_oTickTileAnis.insert(nXY);
+	addTickTileAni(oXY.m_nX, oXY.m_nY);
+}
+void StdLevelView::addTickTileAni(int32_t nX, int32_t nY) noexcept
+{
+	assert((nX >= 0) && (nX < m_nBoardW));
+	assert((nY >= 0) && (nY < m_nBoardH));
+	const int32_t nIdx = nY * m_nBoardW + nX;
+	if (m_aTickTileAniFlags[nIdx]) {
+		return; //--------------------------------------------------------------
+	}
+	m_aTickTileAniFlags[nIdx] = true;
+	m_aTickTileAnis.push_back(NPoint{nX, nY});
+}
+void StdLevelView::clearTickTileAnis() noexcept
+{
+	// Only reset the set flags rather than the whole board
+	for (const NPoint& oXY : m_aTickTileAnis) {
+		m_aTickTileAniFlags[oXY.m_nY * m_nBoardW + oXY.m_nX] = false;
+	}
+	m_aTickTileAnis.clear();
 }
 void StdLevelView::reMoveTickAnimatedTiles(int32_t nRemoveX, int32_t nRemoveY, int32_t nRemoveW, int32_t nRemoveH
 										, int32_t nAreaX, int32_t nAreaY, int32_t nAreaW, int32_t nAreaH
@@ -935,26 +1116,34 @@ void StdLevelView::reMoveTickAnimatedTiles(int32_t nRemoveX, int32_t nRemoveY, i
 	const int32_t nRemoveNToY = nRemoveY + nRemoveH;
 	const int32_t nAreaNToX = nAreaX + nAreaW;
 	const int32_t nAreaNToY = nAreaY + nAreaH;
-	m_oTickTileAnisWork.clear();
-	for (auto& nXY : m_oTickTileAnis) {
-		const NPoint oXY = Util::unpackPointFromInt64(nXY);
+	for (const NPoint& oXY : m_aTickTileAnis) {
+		m_aTickTileAniFlags[oXY.m_nY * m_nBoardW + oXY.m_nX] = false;
+	}
+	// Shift (or remove) the positions in place
+	const int32_t nTotTickTileAnis = static_cast<int32_t>(m_aTickTileAnis.size());
+	int32_t nTo = 0;
+	for (int32_t nFrom = 0; nFrom < nTotTickTileAnis; ++nFrom) {
+		NPoint oXY = m_aTickTileAnis[nFrom];
 		const int32_t nX = oXY.m_nX;
 		const int32_t nY = oXY.m_nY;
 		if ((nX >= nRemoveX) && (nX < nRemoveNToX) && (nY >= nRemoveY) && (nY < nRemoveNToY)) {
-			continue; // for
+			continue; // for nFrom
 		}
 		if ((nX >= nAreaX) && (nX < nAreaNToX) && (nY >= nAreaY) && (nY < nAreaNToY)) {
-			const int32_t nNewX = nX + nDx;
-			const int32_t nNewY = nY + nDy;
-			assert((nNewX >= 0) && (nNewX < m_nBoardW));
-			assert((nNewY >= 0) && (nNewY < m_nBoardH));
-			const int64_t nNewXY = Util::packPointToInt64(NPoint{nNewX, nNewY});
-			m_oTickTileAnisWork.insert(nNewXY);
-		} else {
-			m_oTickTileAnisWork.insert(nXY);
+			oXY.m_nX = nX + nDx;
+			oXY.m_nY = nY + nDy;
+			assert((oXY.m_nX >= 0) && (oXY.m_nX < m_nBoardW));
+			assert((oXY.m_nY >= 0) && (oXY.m_nY < m_nBoardH));
+		}
+		const int32_t nIdx = oXY.m_nY * m_nBoardW + oXY.m_nX;
+		if (m_aTickTileAniFlags[nIdx]) {
+			continue; // for nFrom
 		}
+		m_aTickTileAniFlags[nIdx] = true;
+		m_aTickTileAnis[nTo] = oXY;
+		++nTo;
 	}
-	m_oTickTileAnisWork.swap(m_oTickTileAnis);
+	m_aTickTileAnis.resize(nTo);
 }
 
 void StdLevelView::boardPreScroll(Direction::VALUE /*eDir*/, const shared_ptr<TileRect>& /*refTiles*/) noexcept
@@ -962,10 +1151,56 @@ void StdLevelView::boardPreScroll(Direction::VALUE /*eDir*/, const shared_ptr<Ti
 }
 void StdLevelView::boardPostScroll(Direction::VALUE eDir) noexcept
 {
-	NRect oArea;
-	oArea.m_nW = m_nBoardW;
-	oArea.m_nH = m_nBoardH;
-	boardPostInsert(eDir, oArea);
+	// Instead of moving the whole board image the origin of the board surface
+	// is shifted so that the strip of the removed row (or column) becomes
+	// the one of the inserted row (or column), which is then redrawn.
+	const int32_t nDx = Direction::deltaX(eDir);
+	const int32_t nDy = Direction::deltaY(eDir);
+	m_nBoardOriginX = (m_nBoardOriginX - nDx + m_nBoardW) % m_nBoardW;
+	m_nBoardOriginY = (m_nBoardOriginY - nDy + m_nBoardH) % m_nBoardH;
+	int32_t nInsertX = 0;
+	int32_t nInsertY = 0;
+	int32_t nInsertW = m_nBoardW;
+	int32_t nInsertH = m_nBoardH;
+	int32_t nRemoveX = 0;
+	int32_t nRemoveY = 0;
+	switch (eDir) {
+	case Direction::DOWN:
+	{
+		nInsertH = 1;
+		nRemoveY = m_nBoardH - 1;
+	} break;
+	case Direction::UP:
+	{
+		nInsertY = m_nBoardH - 1;
+		nInsertH = 1;
+	} break;
+	case Direction::RIGHT:
+	{
+		nInsertW = 1;
+		nRemoveX = m_nBoardW - 1;
+	} break;
+	case Direction::LEFT:
+	{
+		nInsertX = m_nBoardW - 1;
+		nInsertW = 1;
+	} break;
+	default:
+	{
+		assert(false);
+	} break;
+	}
+	Cairo::RefPtr<Cairo::Context>& refCc = m_refBoardCc;
+	refCc->save();
+	refCc->set_operator(Cairo::OPERATOR_SOURCE);
+	refCc->rectangle(boardSurfPixX(nInsertX), boardSurfPixY(nInsertY), nInsertW * m_nTileW, nInsertH * m_nTileH);
+	refCc->set_source_rgba(0, 0, 0, 0);
+	refCc->fill();
+	drawBoard(refCc, nInsertX, nInsertY, nInsertW, nInsertH, 0, 1);
+	refCc->restore();
+
+	reMoveTickAnimatedTiles(nRemoveX, nRemoveY, nInsertW, nInsertH,  0, 0, m_nBoardW, m_nBoardH,  nDx, nDy);
+//m_refLevel->dump(true, true, false, false, false);
 }
 void StdLevelView::boardPreInsert(Direction::VALUE /*eDir*/, NRect /*oArea*/, const shared_ptr<TileRect>& /*refTiles*/) noexcept
 {
@@ -979,6 +1214,12 @@ void StdLevelView::boardPostInsert(Direction::VALUE eDir, NRect oArea) noexcept
 	const int32_t nDx = Direction::deltaX(eDir);
 	const int32_t nDy = Direction::deltaY(eDir);
 //std::cout << "StdLevelView::boardPostInsert(" << nX << "," << nY << "," << nW << "," << nH << ")   nDx=" << nDx << " nDy=" << nDy << '\n';
+	if ((nX == 0) && (nY == 0) && (nW == m_nBoardW) && (nH == m_nBoardH)) {
+		boardPostScroll(eDir);
+		return; //--------------------------------------------------------------
+	}
+	// The partial insert works on unshifted surfaces
+	boardSurfLinearize();
 
 	Cairo::RefPtr<Cairo::Context>& refCc = m_refBoard2Cc;
 
@@ -1002,7 +1243,7 @@ void StdLevelView::boardPostInsert(Direction::VALUE eDir, NRect oArea) noexcept
 		}
 		boardInsertRedrawAndRemove(refCc, nX, nY, nW, nH, nDx, nDy
 									, nX, nY, 1, nH
-									, nX + nW + 1, nY, 1, nH
+									, nX + nW - 1, nY, 1, nH
 									, (eDir == Direction::RIGHT));
 	} else {
 		assert(false);
@@ -1152,11 +1393,10 @@ void StdLevelView::boardPostModify(const Coords& oCoords) noexcept
 }
 void StdLevelView::redrawBoardPos(int32_t nX, int32_t nY) noexcept
 {
-	const int64_t nXY = Util::packPointToInt64(NPoint{nX, nY});
-	if (m_oTickTileAnis.find(nXY) == m_oTickTileAnis.end()) {
+	if (!isTickTileAni(nX, nY)) {
 		// only draw if it's not redrawn during view ticks
-		const int32_t nPixX = nX * m_nTileW;
-		const int32_t nPixY = nY * m_nTileH;
+		const int32_t nPixX = boardSurfPixX(nX);
+		const int32_t nPixY = boardSurfPixY(nY);
 		const int32_t nPixW = 1 * m_nTileW;
 		const int32_t nPixH = 1 * m_nTileH;
 
@@ -1184,8 +1424,8 @@ void StdLevelView::boardPreDestroy(const Coords& oCoords) noexcept
 	for (Coords::const_iterator it = oCoords.begin(); it != oCoords.end(); it.next()) {
 		const int32_t nX = it.x();
 		const int32_t nY = it.y();
-		const int32_t nPixX = nX * m_nTileW;
-		const int32_t nPixY = nY * m_nTileH;
+		const int32_t nPixX = boardSurfPixX(nX);
+		const int32_t nPixY = boardSurfPixY(nY);
 		const int32_t nPixW = 1 * m_nTileW;
 		const int32_t nPixH = 1 * m_nTileH;
 		const Tile& oTile = m_refLevel->boardGetTile(nX, nY);
@@ -1200,7 +1440,7 @@ void StdLevelView::boardPreDestroy(const Coords& oCoords) noexcept
 			oExplosionInit.m_nZ = s_nZObjectZBoardTileDestruct;
 			oExplosionInit.m_oTile = oTile;
 			oExplosionInit.m_nLevelPlayer = -1;
-			s_oBoardDestructRecycler.create(refBoardExplosion, std::move(oExplosionInit));
+			m_oBoardDestructRecycler.create(refBoardExplosion, std::move(oExplosionInit));
 			m_refLevel->animationAddScrolled(refBoardExplosion, 0.0);
 //std::cout << "StdLevelView::boardPreDestroy nX=" << nX << "  nY=" << nY << '\n';
 		}
@@ -1270,8 +1510,7 @@ void StdLevelView::dump(bool bTickTileAnis) const noexcept
 {
 	if (bTickTileAnis) {
 		std::cout << "StdLevelView::dump()  TickTileAnis (nX,nY)" << '\n';
-		for (auto& nXY : m_oTickTileAnis) {
-			const NPoint oXY = Util::unpackPointFromInt64(nXY);
+		for (const NPoint& oXY : m_aTickTileAnis) {
 			const int32_t nX = oXY.m_nX;
 			const int32_t nY = oXY.m_nY;
 			std::cout << "    (" << nX << "," << nY << ")";
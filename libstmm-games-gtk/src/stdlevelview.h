@@ -27,12 +27,12 @@
 #include <stmm-games/levelblock.h>
 #include <stmm-games/levelview.h>
 #include <stmm-games/util/direction.h>
+#include <stmm-games/util/recycler.h>
 
 #include <cairomm/context.h>
 #include <cairomm/surface.h>
 #include <cairomm/refptr.h>
 
-#include <unordered_set>
 #include <unordered_map>
 #include <memory>
 #include <vector>
@@ -41,6 +41,7 @@
 
 namespace stmg { struct FPoint; }
 namespace stmg { class Coords; }
+namespace stmg { class ExplosionAnimation; }
 namespace stmg { class Game; }
 namespace stmg { class Level; }
 namespace stmg { class LevelShowThemeWidget; }
@@ -141,8 +142,14 @@ private:
 		}
 	};
 	// return true if to be removed
+	// If bCull is true the animation or level block is only drawn if it intersects m_aShowVisibleRects
 	bool drawAniData(AniData& oAniData, const Cairo::RefPtr<Cairo::Context>& refCc, double fShowPixX, double fShowPixY
-					, int32_t nViewTick, int32_t nTotViewTicks) noexcept;
+					, int32_t nViewTick, int32_t nTotViewTicks, bool bCull) noexcept;
+	// Sets m_aShowVisibleRects
+	void calcShowVisibleRects(int32_t nViewTick, int32_t nTotViewTicks) noexcept;
+	bool isShowRectVisible(const NRect& oRect) const noexcept;
+	// The bounding rect in pixels of the visible bricks relative to the board
+	NRect getLevelBlockRect(LevelBlock& oLevelBlock, int32_t nViewTick, int32_t nTotViewTicks) const noexcept;
 
 	void drawBoard(const Cairo::RefPtr<Cairo::Context>& cr) noexcept;
 	void drawBoard(const Cairo::RefPtr<Cairo::Context>& cr, int32_t nX, int32_t nY, int32_t nW, int32_t nH
@@ -151,6 +158,26 @@ private:
 	// if position is tile-animated does nothing
 	void redrawBoardPos(int32_t nX, int32_t nY) noexcept;
 
+	// The pixel position of a board cell within m_refBoardSurf
+	int32_t boardSurfPixX(int32_t nX) const noexcept
+	{
+		return ((nX + m_nBoardOriginX) % m_nBoardW) * m_nTileW;
+	}
+	int32_t boardSurfPixY(int32_t nY) const noexcept
+	{
+		return ((nY + m_nBoardOriginY) % m_nBoardH) * m_nTileH;
+	}
+	// Paints m_refBoardSurf so that board cell (0,0) is at (fPixX, fPixY)
+	void paintBoardSurf(const Cairo::RefPtr<Cairo::Context>& refCc, double fPixX, double fPixY) noexcept;
+	// Copies m_refBoardSurf to m_refBoard2Surf with origin (0,0) and swaps the two
+	void boardSurfLinearize() noexcept;
+
+	inline bool isTickTileAni(int32_t nX, int32_t nY) const noexcept
+	{
+		return m_aTickTileAniFlags[nY * m_nBoardW + nX];
+	}
+	void addTickTileAni(int32_t nX, int32_t nY) noexcept;
+	void clearTickTileAnis() noexcept;
 	void reMoveTickAnimatedTiles(int32_t nRemoveX, int32_t nRemoveY, int32_t nRemoveW, int32_t nRemoveH
 									, int32_t nAreaX, int32_t nAreaY, int32_t nAreaW, int32_t nAreaH
 									, int32_t nDx, int32_t nDy) noexcept;
@@ -214,6 +241,11 @@ private:
 
 	int32_t m_nBoardSurfPixW;
 	int32_t m_nBoardSurfPixH;
+	// The board surface wraps around: board cell (nX, nY) is drawn at tile position
+	// ((nX + m_nBoardOriginX) % m_nBoardW, (nY + m_nBoardOriginY) % m_nBoardH)
+	// so that scrolling only moves the origin and redraws the inserted row or column.
+	int32_t m_nBoardOriginX;
+	int32_t m_nBoardOriginY;
 	int32_t m_nShowSurfPixW;
 	int32_t m_nShowSurfPixH;
 	int32_t m_nSubshowSurfPixW; // If not in subshow mode this is -1
@@ -238,7 +270,7 @@ private:
 	shared_ptr<LevelShowThemeWidget> m_refLevelShowTW;
 
 	// This surface only contains the tiles (also their tileani)
-	// on a (0,0,0,0) surface
+	// on a (0,0,0,0) surface, shifted by m_nBoardOriginX and m_nBoardOriginY
 	// Size: m_nBoardSurfPixW x m_nBoardSurfPixH
 	Cairo::RefPtr<Cairo::ImageSurface> m_refBoardSurf; // >= (m_nBoardSurfPixW x m_nBoardSurfPixH)
 	Cairo::RefPtr<Cairo::Context> m_refBoardCc;
@@ -256,9 +288,19 @@ private:
 	Cairo::RefPtr<Cairo::Context> m_refShowCc;
 
 	std::vector<double> m_aTileAniElapsed; // utility array to pass params
-
-	std::unordered_set<int64_t> m_oTickTileAnis;
-	std::unordered_set<int64_t> m_oTickTileAnisWork;
+	// The areas of m_refShowSurf that are visible in the current view tick.
+	// If not in subshow mode the whole show, otherwise the area of each subshow.
+	std::vector<NRect> m_aShowVisibleRects;
+
+	// The board cells to redraw at each view tick of the current game tick.
+	// Flag index: nY * m_nBoardW + nX, Size: m_nBoardW * m_nBoardH
+	std::vector<bool> m_aTickTileAniFlags;
+	// The positions with a set flag in m_aTickTileAniFlags, in no particular order
+	std::vector<NPoint> m_aTickTileAnis;
+
+	class PrivateExplosionAnimation;
+	// Per instance so that views of different games don't share state
+	Recycler<PrivateExplosionAnimation, ExplosionAnimation> m_oBoardDestructRecycler;
 
 private:
 	StdLevelView(const StdLevelView& oSource) = delete;
@@ -109,6 +109,16 @@ void StdTheme::registerTileSize(int32_t nW, int32_t nH, bool bUn) noexcept
 			}
 		}
 	}
+	for (auto& refAnimationFactory : m_aNamedAnimationFactories) {
+		if (!refAnimationFactory) {
+			continue; // for refAnimationFactory
+		}
+		if (bUn) {
+			refAnimationFactory->unregisterTileSize(nW, nH);
+		} else {
+			refAnimationFactory->registerTileSize(nW, nH);
+		}
+	}
 }
 
 bool StdTheme::addKnownImageFile(const std::string& sImgFileName, const File& oFile) noexcept
@@ -193,6 +203,14 @@ const shared_ptr<Image>& StdTheme::getImageByFileName(const std::string& sImgFil
 	refImage = std::make_shared<Image>(oImageFile);
 	return refImage;
 }
+void StdTheme::loadImages() noexcept
+{
+	for (const auto& refImage : m_aImageByFileIdxs) {
+		if (refImage) {
+			refImage->load();
+		}
+	}
+}
 const shared_ptr<Image>& StdTheme::getImageById(const std::string& sImgId) noexcept
 {
 	const std::string& sImgFile = getImageIdFileName(sImgId);
@@ -595,6 +613,7 @@ void StdTheme::addAnimationFactory(const std::string& sName, unique_ptr<StdTheme
 	}
 	if (bAnonymousAnimations) {
 		m_aAnonymousModelAnimationFactories.push_back(refAnimationFactory.get());
+		m_aAnimationClassIdFactories.clear();
 	}
 	m_aNamedAnimationFactories[nIdx] = std::move(refAnimationFactory);
 }
@@ -622,44 +641,36 @@ shared_ptr<ThemeAnimation> StdTheme::createAnimation(const shared_ptr<StdThemeCo
 	}
 //m_p1Owner->m_oNamed.animations().dump();
 //std::cout << "      LevelAnimation  -> NO NAME" << '\n';
-	LevelAnimation* p0LevelAnimation = refLevelAnimation.operator->();
-	const auto nIdType = typeid(*p0LevelAnimation).hash_code();
-//std::cout << "                 ::createAnimation() typeid(*p0LevelAnimation).name=" << typeid(*p0LevelAnimation).name() << '\n';
-	std::unordered_map< size_t, std::vector<StdThemeAnimationFactory*> >& oTypeIdFactories = m_oAnimationTypeIdFactories;
-	auto itTypeFactories = oTypeIdFactories.find(nIdType);
-	const bool bTypeFactories = (itTypeFactories != oTypeIdFactories.end());
-	if (bTypeFactories) {
-		// Beware! It's just the hash_code that is the same, the id might actually differ!
-//std::cout << "                 ::createAnimation() typeid factories  nIdType=" << nIdType << '\n';
-		std::vector<StdThemeAnimationFactory*>& aFactories = itTypeFactories->second;
-		for (auto& p0F : aFactories) {
-			shared_ptr<ThemeAnimation> refAnimation = p0F->create(refCtx, refLevelAnimation);
-			if (refAnimation) {
-				return refAnimation; //-----------------------------------------
-			}
-		}
-	}
-	std::vector< StdThemeAnimationFactory* >& aAnonymFactories = m_aAnonymousModelAnimationFactories;
-//std::cout << "                 ::createAnimation() all" << '\n';
-	for (auto& p0Factory : aAnonymFactories) {
-//std::cout << "                 ::createAnimation() factory" << '\n';
+	const int32_t nClassId = refLevelAnimation->getClassId();
+	assert(nClassId >= 0);
+	if (nClassId >= static_cast<int32_t>(m_aAnimationClassIdFactories.size())) {
+		m_aAnimationClassIdFactories.resize(nClassId + 1);
+	}
+	ClassIdAnimationFactories& oClassIdFactories = m_aAnimationClassIdFactories[nClassId];
+	if (! oClassIdFactories.m_bResolved) {
+		// Done only once per class
+//std::cout << "                 ::createAnimation() resolve nClassId=" << nClassId << '\n';
+		resolveAnimationFactories(refLevelAnimation, oClassIdFactories.m_aFactories);
+		oClassIdFactories.m_bResolved = true;
+	}
+	for (auto& p0Factory : oClassIdFactories.m_aFactories) {
 		shared_ptr<ThemeAnimation> refAnimation = p0Factory->create(refCtx, refLevelAnimation);
-		const bool bCreated = refAnimation.operator bool();
-		if (bCreated || p0Factory->supports(refLevelAnimation)) {
-			if (bTypeFactories) {
-				std::vector<StdThemeAnimationFactory*>& aFactories = itTypeFactories->second;
-				aFactories.push_back(p0Factory);
-			} else {
-				std::vector<StdThemeAnimationFactory*> aFactories( {p0Factory} );
-				oTypeIdFactories.insert(std::make_pair(nIdType, std::move(aFactories)));
-			}
-			if (bCreated) {
-				return refAnimation; //-----------------------------------------
-			}
+		if (refAnimation) {
+			return refAnimation; //---------------------------------------------
 		}
 	}
 	return shared_ptr<ThemeAnimation>();
 }
+void StdTheme::resolveAnimationFactories(const shared_ptr<LevelAnimation>& refLevelAnimation
+										, std::vector< StdThemeAnimationFactory* >& aFactories) noexcept
+{
+	assert(aFactories.empty());
+	for (auto& p0Factory : m_aAnonymousModelAnimationFactories) {
+		if (p0Factory->supports(refLevelAnimation)) {
+			aFactories.push_back(p0Factory);
+		}
+	}
+}
 int32_t StdTheme::getCachedFileIdFromCapaAndSoundIdx(int32_t nSoundIdx, int32_t nCapaId) noexcept
 {
 	int32_t nFileId = -1;
@@ -788,6 +799,7 @@ void StdTheme::addWidgetFactory(const std::string& sName, unique_ptr<StdThemeWid
 	}
 	if (bAnonymousWidgets) {
 		m_aAnonymousModelWidgetFactories.push_back(refWidgetFactory.get());
+		m_aWidgetClassIdFactories.clear();
 	}
 	m_aNamedWidgetFactories[nIdx] = std::move(refWidgetFactory);
 }
@@ -812,8 +824,20 @@ shared_ptr<ThemeWidget> StdTheme::createWidget(const shared_ptr<GameWidget>& ref
 		auto& refWidgetFactory = m_aNamedWidgetFactories[nNameIdx];
 		return refWidgetFactory->create(refGameWidget, fTileWHRatio, refFontContext); // --------- exit
 	}
-	std::vector< StdThemeWidgetFactory* >& aAnonymFactories = m_aAnonymousModelWidgetFactories;
-	for (auto& p0Factory : aAnonymFactories) {
+	const int32_t nClassId = refGameWidget->getClassId();
+	assert(nClassId >= 0);
+	if (nClassId >= static_cast<int32_t>(m_aWidgetClassIdFactories.size())) {
+		m_aWidgetClassIdFactories.resize(nClassId + 1);
+	}
+	ClassIdWidgetFactories& oClassIdFactories = m_aWidgetClassIdFactories[nClassId];
+	if (! oClassIdFactories.m_bResolved) {
+		// Done only once per class
+		resolveWidgetFactories(refGameWidget, oClassIdFactories.m_aFactories);
+		oClassIdFactories.m_bResolved = true;
+	}
+	// The factories are in registration order, the first one that
+	// succeeds wins
+	for (auto& p0Factory : oClassIdFactories.m_aFactories) {
 		shared_ptr<ThemeWidget> refWidget = p0Factory->create(refGameWidget, fTileWHRatio, refFontContext);
 		if (refWidget) {
 			return refWidget; //------------------------------------------------
@@ -824,6 +848,16 @@ shared_ptr<ThemeWidget> StdTheme::createWidget(const shared_ptr<GameWidget>& ref
 				<< typeid(oGameWidget).name() << "'" << '\n';
 	return shared_ptr<ThemeWidget>{};
 }
+void StdTheme::resolveWidgetFactories(const shared_ptr<GameWidget>& refGameWidget
+									, std::vector< StdThemeWidgetFactory* >& aFactories) noexcept
+{
+	assert(aFactories.empty());
+	for (auto& p0Factory : m_aAnonymousModelWidgetFactories) {
+		if (p0Factory->supports(refGameWidget)) {
+			aFactories.push_back(p0Factory);
+		}
+	}
+}
 void StdTheme::removeCapability(int32_t nCapabilityId) noexcept
 {
 	// clear cache
@@ -30,6 +30,12 @@ StdThemeAnimationFactory::StdThemeAnimationFactory(StdTheme* p1Owner) noexcept
 {
 	assert(p1Owner != nullptr);
 }
+void StdThemeAnimationFactory::registerTileSize(int32_t /*nW*/, int32_t /*nH*/) noexcept
+{
+}
+void StdThemeAnimationFactory::unregisterTileSize(int32_t /*nW*/, int32_t /*nH*/) noexcept
+{
+}
 void StdThemeAnimationFactory::clearOwner() noexcept
 {
 	m_p1Owner = nullptr;
@@ -23,4 +23,9 @@
 namespace stmg
 {
 
+NRect ThemeAnimation::getRect(int32_t /*nViewTick*/, int32_t /*nTotViewTicks*/) noexcept
+{
+	return NRect{};
+}
+
 } // namespace stmg
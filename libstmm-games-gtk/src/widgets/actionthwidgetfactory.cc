@@ -71,6 +71,11 @@ ActionThWidgetFactory::ActionThWidgetFactory(StdTheme* p1Owner
 	const std::string& sFontDesc = p1Owner->getFontDesc(nFontIdx);
 	m_refFont = std::make_unique<Pango::FontDescription>(sFontDesc);
 }
+bool ActionThWidgetFactory::supports(const shared_ptr<GameWidget>& refGameWidget) noexcept
+{
+	assert(refGameWidget);
+	return (modelCast<ActionWidget>(refGameWidget.get()) != nullptr);
+}
 shared_ptr<ThemeWidget> ActionThWidgetFactory::create(const shared_ptr<GameWidget>& refGameWidget
 													, double fTileWHRatio, const Glib::RefPtr<Pango::Context>& refFontContext) noexcept
 {
@@ -79,7 +84,7 @@ shared_ptr<ThemeWidget> ActionThWidgetFactory::create(const shared_ptr<GameWidge
 	assert(refFontContext);
 	GameWidget* p0GameWidget = refGameWidget.get();
 	assert(p0GameWidget != nullptr);
-	ActionWidget* p0ActionWidget = dynamic_cast<ActionWidget*>(p0GameWidget);
+	ActionWidget* p0ActionWidget = modelCast<ActionWidget>(p0GameWidget);
 	if (p0ActionWidget == nullptr) {
  		return shared_ptr<ThemeWidget>{}; //------------------------------------
  	}
@@ -52,6 +52,11 @@ BackgroundThWidgetFactory::BackgroundThWidgetFactory(StdTheme* p1Owner) noexcept
 : StdThemeWidgetFactory(p1Owner)
 {
 }
+bool BackgroundThWidgetFactory::supports(const shared_ptr<GameWidget>& refGameWidget) noexcept
+{
+	assert(refGameWidget);
+	return (modelCast<BackgroundWidget>(refGameWidget.get()) != nullptr);
+}
 shared_ptr<ThemeWidget> BackgroundThWidgetFactory::create(const shared_ptr<GameWidget>& refGameWidget
 														, double fTileWHRatio, const Glib::RefPtr<Pango::Context>& refFontContext) noexcept
 {
@@ -64,7 +69,7 @@ shared_ptr<ThemeWidget> BackgroundThWidgetFactory::create(const shared_ptr<GameW
 	}
 	GameWidget* p0GameWidget = refGameWidget.get();
 	assert(p0GameWidget != nullptr);
-	BackgroundWidget* p0BackgroundWidget = dynamic_cast<BackgroundWidget*>(p0GameWidget);
+	BackgroundWidget* p0BackgroundWidget = modelCast<BackgroundWidget>(p0GameWidget);
 	if (p0BackgroundWidget == nullptr) {
 		return shared_ptr<ThemeWidget>{}; //------------------------------------
 	}
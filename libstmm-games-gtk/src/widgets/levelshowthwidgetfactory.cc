@@ -62,6 +62,11 @@ LevelShowThWidgetFactory::LevelShowThWidgetFactory(StdTheme* p1Owner, const Fram
 	assert(fMinLeft >= 0.0);
 	assert(fMinRight >= 0.0);
 }
+bool LevelShowThWidgetFactory::supports(const shared_ptr<GameWidget>& refGameWidget) noexcept
+{
+	assert(refGameWidget);
+	return (modelCast<LevelShowWidget>(refGameWidget.get()) != nullptr);
+}
 shared_ptr<ThemeWidget> LevelShowThWidgetFactory::create(const shared_ptr<GameWidget>& refGameWidget
 														, double fTileWHRatio
 														, const Glib::RefPtr<Pango::Context>& /*refFontContext*/) noexcept
@@ -70,7 +75,7 @@ shared_ptr<ThemeWidget> LevelShowThWidgetFactory::create(const shared_ptr<GameWi
 	assert(fTileWHRatio > 0);
 	GameWidget* p0GameWidget = refGameWidget.get();
 	assert(p0GameWidget != nullptr);
-	LevelShowWidget* p0LevelShowWidget = dynamic_cast<LevelShowWidget*>(p0GameWidget);
+	LevelShowWidget* p0LevelShowWidget = modelCast<LevelShowWidget>(p0GameWidget);
 	if (p0LevelShowWidget == nullptr) {
  		return shared_ptr<ThemeWidget>{};
  	}
@@ -22,7 +22,6 @@
 
 #include "stdtheme.h"
 #include "themecontext.h"
-#include "gtkutil/ccsave.h"
 
 #include <stmm-games/block.h>
 #include <stmm-games/gamewidget.h>
@@ -75,6 +74,11 @@ PreviewThWidgetFactory::PreviewThWidgetFactory(StdTheme* p1Owner
 	const std::string& sFontDesc = p1Owner->getFontDesc(nFontIdx);
 	m_refFont = std::make_unique<Pango::FontDescription>(sFontDesc);
 }
+bool PreviewThWidgetFactory::supports(const shared_ptr<GameWidget>& refGameWidget) noexcept
+{
+	assert(refGameWidget);
+	return (modelCast<PreviewWidget>(refGameWidget.get()) != nullptr);
+}
 shared_ptr<ThemeWidget> PreviewThWidgetFactory::create(const shared_ptr<GameWidget>& refGameWidget
 														, double fTileWHRatio
 														, const Glib::RefPtr<Pango::Context>& refFontContext) noexcept
@@ -84,7 +88,7 @@ shared_ptr<ThemeWidget> PreviewThWidgetFactory::create(const shared_ptr<GameWidg
 	assert(refFontContext);
 	GameWidget* p0GameWidget = refGameWidget.get();
 	assert(p0GameWidget != nullptr);
-	PreviewWidget* p0PreviewWidget = dynamic_cast<PreviewWidget*>(p0GameWidget);
+	PreviewWidget* p0PreviewWidget = modelCast<PreviewWidget>(p0GameWidget);
 	if (p0PreviewWidget == nullptr) {
  		return shared_ptr<ThemeWidget>{};
  	}
@@ -134,8 +138,7 @@ void PreviewThWidgetFactory::PreviewTWidget::reInitCommon(const Glib::RefPtr<Pan
 	m_nPainterIdx = m_p0PreviewWidget->getPainterIdx();
 
 	m_refFontContext = refFontContext;
-	m_refFontLayout = Pango::Layout::create(refFontContext);
-	m_refFontLayout->set_font_description(*(m_p1Owner->m_refFont));
+	m_oTextCache.reInit(refFontContext, *(m_p1Owner->m_refFont), m_p1Owner->m_fR1, m_p1Owner->m_fG1, m_p1Owner->m_fB1);
 
 	m_refPreviewTc.reset();
 }
@@ -304,39 +307,22 @@ void PreviewThWidgetFactory::PreviewTWidget::drawText(const Cairo::RefPtr<Cairo:
 //std::cout << "PreviewThWidgetFactory::PreviewTWidget::drawText(" << (int64_t)this << ")  nX=" << nX << "  nY=" << nY << " nW=" << nW << "  nH=" << nH << '\n';
 //	p1Owner->drawText(refCc, m_refFontLayout, oColor, oAlpha, oFont, 0.5, nX, nY, nW, nH, sText);
 
-	//
-	m_refFontLayout->set_text(sText);
-	//
-	int32_t nTextFontPixW;
-	int32_t nTextFontPixH;
-	m_refFontLayout->get_pixel_size(nTextFontPixW, nTextFontPixH);
-
-	CCSave oCCSave(refCc);
-	double fTransX = nX + 0.5 * nW;
-	double fTransY = nY + 0.5 * nH;
-	refCc->translate(fTransX, fTransY);
-
-	// !! Currently text only drawn if no image !!
-	refCc->set_source_rgba(m_p1Owner->m_fR1, m_p1Owner->m_fG1, m_p1Owner->m_fB1, m_p1Owner->m_fA1);
+	const NSize oTextFontPixSize = m_oTextCache.getTextSize(sText);
+	const int32_t nTextFontPixW = oTextFontPixSize.m_nW;
+	const int32_t nTextFontPixH = oTextFontPixSize.m_nH;
+	if ((nTextFontPixW <= 0) || (nTextFontPixH <= 0)) {
+		return; //--------------------------------------------------------------
+	}
 
 	const double fRatioX = (1.0 * nW) / nTextFontPixW;
 	const double fRatioY = (1.0 * nH) / nTextFontPixH;
 	const double fRatioM = std::min<double>(fRatioX, fRatioY);
 	const double fRatio = fRatioM * 1.0; //TODO
-//if ((s.size() > 1) && (s[0] > '9')) {
-//std::cout << "StdTheme::drawText()  nPixX=" << nPixX << "  nPixY=" << nPixY << '\n';
-//std::cout << "StdTheme::drawText()  fTransX=" << fTransX << "  fTransY=" << fTransY << '\n';
-//std::cout << "StdTheme::drawText() s=" << s << "  nTextW=" << nTextW << "  nTextH=" << nTextH << '\n';
-//std::cout << "StdTheme::drawText() fRatio=" << fRatio << "  fRatioX=" << fRatioX << "  fRatioY=" << fRatioY << '\n';
-//}
-
-	refCc->scale(fRatio, fRatio);
 
-	fTransY = - 0.5 * nTextFontPixH;
-	fTransX = - 0.5 * nTextFontPixW;
-	refCc->translate(fTransX, fTransY);
-
-	m_refFontLayout->show_in_cairo_context(refCc);
+	// !! Currently text only drawn if no image !!
+	const double fTextX = nX + 0.5 * nW - fRatio * 0.5 * nTextFontPixW;
+	const double fTextY = nY + 0.5 * nH - fRatio * 0.5 * nTextFontPixH;
+	m_oTextCache.draw(refCc, sText, fTextX, fTextY, fRatio, m_p1Owner->m_fA1);
 }
 void PreviewThWidgetFactory::PreviewTWidget::drawPreviewBlock(const Cairo::RefPtr<Cairo::Context>& refCc, StdTheme* p0StdTheme
 															, const Block& oBlock, int32_t nShape
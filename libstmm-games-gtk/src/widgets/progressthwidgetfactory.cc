@@ -24,6 +24,7 @@
 
 #include <stmm-games/tile.h>
 #include <stmm-games/variable.h>
+#include <stmm-games/gameproxy.h>
 #include <stmm-games/gamewidget.h>
 #include <stmm-games/util/intset.h>
 #include <stmm-games/widgets/progresswidget.h>
@@ -58,6 +59,11 @@ ProgressThWidgetFactory::ProgressThWidgetFactory(StdTheme* p1Owner
 {
 	assert(p1Owner != nullptr);
 }
+bool ProgressThWidgetFactory::supports(const shared_ptr<GameWidget>& refGameWidget) noexcept
+{
+	assert(refGameWidget);
+	return (modelCast<ProgressWidget>(refGameWidget.get()) != nullptr);
+}
 shared_ptr<ThemeWidget> ProgressThWidgetFactory::create(const shared_ptr<GameWidget>& refGameWidget
 												, double fTileWHRatio
 												, const Glib::RefPtr<Pango::Context>& /*refFontContext*/) noexcept
@@ -67,7 +73,7 @@ shared_ptr<ThemeWidget> ProgressThWidgetFactory::create(const shared_ptr<GameWid
 	assert(fTileWHRatio > 0);
 	GameWidget* p0GameWidget = refGameWidget.get();
 	assert(p0GameWidget != nullptr);
-	ProgressWidget* p0ProgressWidget = dynamic_cast<ProgressWidget*>(p0GameWidget);
+	ProgressWidget* p0ProgressWidget = modelCast<ProgressWidget>(p0GameWidget);
 	if (p0ProgressWidget == nullptr) {
  		return shared_ptr<ThemeWidget>{};
  	}
@@ -119,6 +125,8 @@ void ProgressThWidgetFactory::ProgressTWidget::reInitCommon(double fTileWHRatio)
 	m_nThresholdValue = m_p0ProgressWidget->getThresholdValue();
 	m_bThresholdValid = ((m_nThresholdValue >= m_nMinValue) && (m_nThresholdValue <= m_nMaxValue));
 	m_bDangerBelow = m_p0ProgressWidget->getDangerBelow();
+	m_nDrawnValue = m_nMinValue;
+	m_nNextChangeMillisec = -1;
 }
 
 void ProgressThWidgetFactory::ProgressTWidget::dump(int32_t
@@ -195,6 +203,27 @@ void ProgressThWidgetFactory::ProgressTWidget::drawBase(const Cairo::RefPtr<Cair
 	const Frame& oFrame = p0Factory->m_oFrame;
 	oFrame.draw(refCc, 0, 0, m_oMutaTW.getPixW(), m_oMutaTW.getPixH());
 }
+int32_t ProgressThWidgetFactory::ProgressTWidget::getClampedValue() const noexcept
+{
+	const int32_t nValue = m_p0ProgressWidget->variable().get();
+	if (nValue < m_nMinValue) {
+		return m_nMinValue; //--------------------------------------------------
+	} else if (nValue > m_nMaxValue) {
+		return m_nMaxValue; //--------------------------------------------------
+	}
+	return nValue;
+}
+bool ProgressThWidgetFactory::ProgressTWidget::isChanged() const noexcept
+{
+	if ((m_nNextChangeMillisec < 0) || (m_p0ProgressWidget->game().gameElapsedMillisec() < m_nNextChangeMillisec)) {
+		// The passing time didn't change the drawn value, only setting it can have
+		if (! m_p0ProgressWidget->isChanged()) {
+			return false; //----------------------------------------------------
+		}
+	}
+	// Out of range values are all drawn the same
+	return (getClampedValue() != m_nDrawnValue);
+}
 void ProgressThWidgetFactory::ProgressTWidget::drawVariable(const Cairo::RefPtr<Cairo::Context>& refCc) noexcept
 {
 	ProgressThWidgetFactory*& p0Factory = m_p1Owner;
@@ -202,16 +231,9 @@ void ProgressThWidgetFactory::ProgressTWidget::drawVariable(const Cairo::RefPtr<
 	StdTheme* p0StdTheme = p0Factory->owner();
 	assert(p0StdTheme != nullptr);
 
-	const Variable& oVar = m_p0ProgressWidget->variable();
-	const int32_t nValue = [&](int32_t nVal)
-	{
-		if (nVal < m_nMinValue) {
-			return m_nMinValue;
-		} else if (nVal > m_nMaxValue) {
-			return m_nMaxValue;
-		}
-		return nVal;
-	}(oVar.get());
+	const int32_t nValue = getClampedValue();
+	m_nDrawnValue = nValue;
+	m_nNextChangeMillisec = m_p0ProgressWidget->variable().getNextChangeMillisec();
 
 	bool bDanger = false;
 	if (m_bThresholdValid) {
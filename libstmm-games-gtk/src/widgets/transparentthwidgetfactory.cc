@@ -47,6 +47,11 @@ TransparentThWidgetFactory::TransparentThWidgetFactory(StdTheme* p1Owner) noexce
 {
 	assert(p1Owner != nullptr);
 }
+bool TransparentThWidgetFactory::supports(const shared_ptr<GameWidget>& refGameWidget) noexcept
+{
+	assert(refGameWidget);
+	return (modelCast<TransparentWidget>(refGameWidget.get()) != nullptr);
+}
 shared_ptr<ThemeWidget> TransparentThWidgetFactory::create(const shared_ptr<GameWidget>& refGameWidget
 															, double /*fTileWHRatio*/
 															, const Glib::RefPtr<Pango::Context>& refFontContext) noexcept
@@ -57,7 +62,7 @@ shared_ptr<ThemeWidget> TransparentThWidgetFactory::create(const shared_ptr<Game
 	assert(refFontContext);
 	GameWidget* p0GameWidget = refGameWidget.get();
 	assert(p0GameWidget != nullptr);
-	TransparentWidget* p0TransparentWidget = dynamic_cast<TransparentWidget*>(p0GameWidget);
+	TransparentWidget* p0TransparentWidget = modelCast<TransparentWidget>(p0GameWidget);
 	if (p0TransparentWidget == nullptr) {
  		return shared_ptr<ThemeWidget>{};
  	}
@@ -25,6 +25,7 @@
 #include "gtkutil/image.h"
 
 #include <stmm-games/variable.h>
+#include <stmm-games/gameproxy.h>
 #include <stmm-games/util/util.h>
 #include <stmm-games/gamewidget.h>
 #include <stmm-games/tile.h>
@@ -37,6 +38,7 @@
 
 #include <cassert>
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <vector>
 
@@ -48,6 +50,8 @@ namespace stmg { class SegmentedFunction; }
 namespace stmg
 {
 
+static constexpr double s_fValueShrinkStep = 0.875;
+
 VarThWidgetFactory::VarThWidgetFactory(StdTheme* p1Owner, bool bTitlePreValue
 									, const TileColor& oTitleColor, const TileAlpha& oTitleAlpha, const TileFont& oTitleFont
 									, const shared_ptr<Image>& refTitleBgImg
@@ -86,6 +90,11 @@ VarThWidgetFactory::VarThWidgetFactory(StdTheme* p1Owner, bool bTitlePreValue
 	m_refValueFont = std::make_unique<Pango::FontDescription>(sFontDesc);
 	}
 }
+bool VarThWidgetFactory::supports(const shared_ptr<GameWidget>& refGameWidget) noexcept
+{
+	assert(refGameWidget);
+	return (modelCast<VarWidget>(refGameWidget.get()) != nullptr);
+}
 shared_ptr<ThemeWidget> VarThWidgetFactory::create(const shared_ptr<GameWidget>& refGameWidget
 												, double fTileWHRatio
 												, const Glib::RefPtr<Pango::Context>& refFontContext) noexcept
@@ -96,7 +105,7 @@ shared_ptr<ThemeWidget> VarThWidgetFactory::create(const shared_ptr<GameWidget>&
 	assert(refFontContext);
 	GameWidget* p0GameWidget = refGameWidget.get();
 	assert(p0GameWidget != nullptr);
-	VarWidget* p0VarWidget = dynamic_cast<VarWidget*>(p0GameWidget);
+	VarWidget* p0VarWidget = modelCast<VarWidget>(p0GameWidget);
 	if (p0VarWidget == nullptr) {
  		return shared_ptr<ThemeWidget>{}; //------------------------------------
  	}
@@ -147,6 +156,11 @@ void VarThWidgetFactory::VarTWidget::reInitCommon(const Glib::RefPtr<Pango::Cont
 	m_refTitleFontLayout->set_text(m_sConstTitle);
 	m_refTitleFontLayout->get_pixel_size(m_nTitleFontPixW, m_nTitleFontPixH);
 
+	m_oValueTextCache.reInit(refFontContext, *(m_p1Owner->m_refValueFont)
+							, m_p1Owner->m_fValueR1, m_p1Owner->m_fValueG1, m_p1Owner->m_fValueB1);
+	m_nDrawnValue = 0;
+	m_nNextChangeMillisec = -1;
+
 	const int32_t nValueDigits = m_p0VarWidget->getValueDigits();
 	m_fMaxValueWHRatio = getTextMaxValueWHRatio(nValueDigits);
 
@@ -366,41 +380,49 @@ void VarThWidgetFactory::VarTWidget::drawBase(const Cairo::RefPtr<Cairo::Context
 
 	m_refTitleFontLayout->show_in_cairo_context(refCc);
 }
+bool VarThWidgetFactory::VarTWidget::isChanged() const noexcept
+{
+	const Variable& oVar = m_p0VarWidget->variable();
+	if ((m_nNextChangeMillisec < 0) || (m_p0VarWidget->game().gameElapsedMillisec() < m_nNextChangeMillisec)) {
+		// The passing time didn't change the drawn value, only setting it can have
+		if (! oVar.isChanged()) {
+			return false; //----------------------------------------------------
+		}
+	}
+	return (oVar.get() != m_nDrawnValue);
+}
 void VarThWidgetFactory::VarTWidget::drawVariable(const Cairo::RefPtr<Cairo::Context>& refCc) noexcept
 {
 	const Variable& oVar = m_p0VarWidget->variable();
+	m_nDrawnValue = oVar.get();
+	m_nNextChangeMillisec = oVar.getNextChangeMillisec();
 	const std::string sValue = oVar.toFormattedString();
 
 	if (sValue.empty()) {
 		return; //--------------------------------------------------------------
 	}
 
-	m_refValueFontLayout->set_text(sValue);
-	//
-	int32_t nValueFontPixW;
-	int32_t nValueFontPixH;
-	m_refValueFontLayout->get_pixel_size(nValueFontPixW, nValueFontPixH);
-
-	CCSave oCCSave(refCc);
-	double fTransX = m_nPixValueTextX + m_fValueAlign * m_nPixValueTextW;
-	double fTransY = m_nPixValueTextY + 0.5 * m_nPixValueTextH;
-	refCc->translate(fTransX, fTransY);
-
-	refCc->set_source_rgba(m_p1Owner->m_fValueR1, m_p1Owner->m_fValueG1, m_p1Owner->m_fValueB1, m_p1Owner->m_fValueA1);
+	const NSize oValueFontPixSize = m_oValueTextCache.getTextSize(sValue);
+	const int32_t nValueFontPixW = oValueFontPixSize.m_nW;
+	const int32_t nValueFontPixH = oValueFontPixSize.m_nH;
+	if ((nValueFontPixW <= 0) || (nValueFontPixH <= 0)) {
+		return; //--------------------------------------------------------------
+	}
 
-	//TODO should be precalculated in calcCanvas
-	const double fRatioX = (1.0 * m_nPixValueTextW) / nValueFontPixW;
+	// The scale depends on the height of the value area only so that the value
+	// text cache doesn't have to render its glyphs again when the value changes.
+	// Values too wide for the area are shrunk in steps so that few scales are used.
 	const double fRatioY = (1.0 * m_nPixValueTextH) / nValueFontPixH;
-	const double fRatioM = std::min<double>(fRatioX, fRatioY);
-	const double fRatio = fRatioM * 1.0; //TODO
-
-	refCc->scale(fRatio, fRatio);
-
-	fTransX = - m_fValueAlign * nValueFontPixW;
-	fTransY = - 0.5 * nValueFontPixH;
-	refCc->translate(fTransX, fTransY);
+	double fRatio = fRatioY;
+	if (fRatio * nValueFontPixW > m_nPixValueTextW) {
+		const double fRatioX = (1.0 * m_nPixValueTextW) / nValueFontPixW;
+		const double fTotSteps = std::ceil(std::log(fRatioX / fRatioY) / std::log(s_fValueShrinkStep));
+		fRatio = fRatioY * std::pow(s_fValueShrinkStep, fTotSteps);
+	}
 
-	m_refValueFontLayout->show_in_cairo_context(refCc);
+	const double fTextX = m_nPixValueTextX + m_fValueAlign * m_nPixValueTextW - fRatio * m_fValueAlign * nValueFontPixW;
+	const double fTextY = m_nPixValueTextY + 0.5 * m_nPixValueTextH - fRatio * 0.5 * nValueFontPixH;
+	m_oValueTextCache.draw(refCc, sValue, fTextX, fTextY, fRatio, m_p1Owner->m_fValueA1);
 }
 
 } // namespace stmg
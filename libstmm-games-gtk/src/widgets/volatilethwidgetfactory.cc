@@ -50,6 +50,11 @@ VolatileThWidgetFactory::VolatileThWidgetFactory(StdTheme* p1Owner) noexcept
 : StdThemeWidgetFactory(p1Owner)
 {
 }
+bool VolatileThWidgetFactory::supports(const shared_ptr<GameWidget>& refGameWidget) noexcept
+{
+	assert(refGameWidget);
+	return (modelCast<VolatileWidget>(refGameWidget.get()) != nullptr);
+}
 shared_ptr<ThemeWidget> VolatileThWidgetFactory::create(const shared_ptr<GameWidget>& refGameWidget
 														, double fTileWHRatio, const Glib::RefPtr<Pango::Context>& refFontContext) noexcept
 {
@@ -63,7 +68,7 @@ shared_ptr<ThemeWidget> VolatileThWidgetFactory::create(const shared_ptr<GameWid
 	}
 	GameWidget* p0GameWidget = refGameWidget.get();
 	assert(p0GameWidget != nullptr);
-	VolatileWidget* p0VolatileWidget = dynamic_cast<VolatileWidget*>(p0GameWidget);
+	VolatileWidget* p0VolatileWidget = modelCast<VolatileWidget>(p0GameWidget);
 	if (p0VolatileWidget == nullptr) {
 		return shared_ptr<ThemeWidget>{}; //------------------------------------
 	}
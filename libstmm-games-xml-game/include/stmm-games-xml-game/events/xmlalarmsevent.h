@@ -23,6 +23,8 @@
 
 #include "xmleventparser.h"
 
+#include <stmm-games/events/alarmsevent.h>
+
 #include <memory>
 #include <string>
 
@@ -46,7 +48,7 @@ public:
 
 	Event* parseEvent(GameCtx& oCtx, const xmlpp::Element* p0Element) override;
 
-	//TODO void recycleEvents(std::unique_ptr<Event>& refEvent) override;
+	void recycleEvents(std::unique_ptr<Event>& refEvent) override;
 	int32_t parseEventMsgName(ConditionalCtx& oCtx, const xmlpp::Element* p0Element, const std::string& sAttr
 							, const std::string& sMsgName) override;
 	int32_t parseEventListenerGroupName(GameCtx& oCtx, const xmlpp::Element* p0Element, const std::string& sAttr
@@ -55,6 +57,8 @@ private:
 	unique_ptr<Event> parseEventAlarms(GameCtx& oCtx, const xmlpp::Element* p0Element);
 	void parseEventAlarmsStage(GameCtx& oCtx, const xmlpp::Element* p0Element, bool bPerc, int32_t& nValue, int32_t& nRepeat);
 
+private:
+	EventRecycler<AlarmsEvent> m_oRecycler;
 private:
 	XmlAlarmsEventParser(const XmlAlarmsEventParser& oSource) = delete;
 	XmlAlarmsEventParser& operator=(const XmlAlarmsEventParser& oSource) = delete;
@@ -50,7 +50,7 @@ public:
 
 	Event* parseEvent(GameCtx& oCtx, const xmlpp::Element* p0Element) override;
 
-	//TODO void recycleEvents(std::unique_ptr<Event>& refEvent) override;
+	void recycleEvents(std::unique_ptr<Event>& refEvent) override;
 	int32_t parseEventMsgName(ConditionalCtx& oCtx, const xmlpp::Element* p0Element, const std::string& sAttr
 							, const std::string& sMsgName) override;
 	int32_t parseEventListenerGroupName(GameCtx& oCtx, const xmlpp::Element* p0Element, const std::string& sAttr
@@ -76,6 +76,8 @@ private:
 								, std::vector<int32_t>& aValues, int32_t nFromIdx, int32_t nSize
 								, ARRAY_VALUE_TYPE eValueType);
 
+private:
+	EventRecycler<ArrayEvent> m_oRecycler;
 private:
 	XmlArrayEventParser(const XmlArrayEventParser& oSource) = delete;
 	XmlArrayEventParser& operator=(const XmlArrayEventParser& oSource) = delete;
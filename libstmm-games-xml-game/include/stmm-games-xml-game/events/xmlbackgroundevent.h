@@ -48,7 +48,7 @@ public:
 
 	Event* parseEvent(GameCtx& oCtx, const xmlpp::Element* p0Element) override;
 
-	//TODO void recycleEvents(std::unique_ptr<Event>& refEvent) override;
+	void recycleEvents(std::unique_ptr<Event>& refEvent) override;
 	int32_t parseEventMsgName(ConditionalCtx& oCtx, const xmlpp::Element* p0Element, const std::string& sAttr
 							, const std::string& sMsgName) override;
 	int32_t parseEventListenerGroupName(GameCtx& oCtx, const xmlpp::Element* p0Element, const std::string& sAttr
@@ -57,6 +57,8 @@ private:
 	unique_ptr<Event> parseEventBackground(GameCtx& oCtx, const xmlpp::Element* p0Element);
 	void parseEventBackgroundImage(GameCtx& oCtx, const xmlpp::Element* p0Element, BackgroundEvent::PatternImage& oPatternImage);
 
+private:
+	EventRecycler<BackgroundEvent> m_oRecycler;
 private:
 	XmlBackgroundEventParser(const XmlBackgroundEventParser& oSource) = delete;
 	XmlBackgroundEventParser& operator=(const XmlBackgroundEventParser& oSource) = delete;
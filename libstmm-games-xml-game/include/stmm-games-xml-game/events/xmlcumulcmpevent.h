@@ -23,6 +23,8 @@
 
 #include "xmleventparser.h"
 
+#include <stmm-games/events/cumulcmpevent.h>
+
 #include <memory>
 #include <string>
 
@@ -46,7 +48,7 @@ public:
 
 	Event* parseEvent(GameCtx& oCtx, const xmlpp::Element* p0Element) override;
 
-	//TODO void recycleEvents(std::unique_ptr<Event>& refEvent) override;
+	void recycleEvents(std::unique_ptr<Event>& refEvent) override;
 	int32_t parseEventMsgName(ConditionalCtx& oCtx, const xmlpp::Element* p0Element, const std::string& sAttr
 							, const std::string& sMsgName) override;
 	int32_t parseEventListenerGroupName(GameCtx& oCtx, const xmlpp::Element* p0Element, const std::string& sAttr
@@ -54,6 +56,8 @@ public:
 private:
 	unique_ptr<Event> parseEventCumulCmp(GameCtx& oCtx, const xmlpp::Element* p0Element);
 
+private:
+	EventRecycler<CumulCmpEvent> m_oRecycler;
 private:
 	XmlCumulCmpEventParser(const XmlCumulCmpEventParser& oSource) = delete;
 	XmlCumulCmpEventParser& operator=(const XmlCumulCmpEventParser& oSource) = delete;
@@ -23,6 +23,8 @@
 
 #include "xmleventparser.h"
 
+#include <stmm-games/events/logevent.h>
+
 #include <memory>
 
 namespace stmg { class Event; }
@@ -41,10 +43,12 @@ public:
 
 	Event* parseEvent(GameCtx& oCtx, const xmlpp::Element* p0Element) override;
 
-	//TODO void recycleEvents(std::unique_ptr<Event>& refEvent) override;
+	void recycleEvents(std::unique_ptr<Event>& refEvent) override;
 private:
 	unique_ptr<Event> parseEventLog(GameCtx& oCtx, const xmlpp::Element* p0Element);
 
+private:
+	EventRecycler<LogEvent> m_oRecycler;
 private:
 	XmlLogEventParser(const XmlLogEventParser& oSource) = delete;
 	XmlLogEventParser& operator=(const XmlLogEventParser& oSource) = delete;
@@ -23,6 +23,8 @@
 
 #include "xmleventparser.h"
 
+#include <stmm-games/events/othersevent.h>
+
 #include <memory>
 
 namespace stmg { class Event; }
@@ -41,10 +43,12 @@ public:
 
 	Event* parseEvent(GameCtx& oCtx, const xmlpp::Element* p0Element) override;
 
-	//TODO void recycleEvents(std::unique_ptr<Event>& refEvent) override;
+	void recycleEvents(std::unique_ptr<Event>& refEvent) override;
 private:
 	unique_ptr<Event> parseEventOthersSender(GameCtx& oCtx, const xmlpp::Element* p0Element);
 
+private:
+	EventRecycler<OthersSenderEvent> m_oRecycler;
 private:
 	XmlOthersSenderEventParser(const XmlOthersSenderEventParser& oSource) = delete;
 	XmlOthersSenderEventParser& operator=(const XmlOthersSenderEventParser& oSource) = delete;
@@ -58,10 +62,12 @@ public:
 
 	Event* parseEvent(GameCtx& oCtx, const xmlpp::Element* p0Element) override;
 
-	//TODO void recycleEvents(std::unique_ptr<Event>& refEvent) override;
+	void recycleEvents(std::unique_ptr<Event>& refEvent) override;
 private:
 	unique_ptr<Event> parseEventOthersReceiver(GameCtx& oCtx, const xmlpp::Element* p0Element);
 
+private:
+	EventRecycler<OthersReceiverEvent> m_oRecycler;
 private:
 	XmlOthersReceiverEventParser(const XmlOthersReceiverEventParser& oSource) = delete;
 	XmlOthersReceiverEventParser& operator=(const XmlOthersReceiverEventParser& oSource) = delete;
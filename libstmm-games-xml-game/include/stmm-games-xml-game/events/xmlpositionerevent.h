@@ -23,6 +23,8 @@
 
 #include "xmleventparser.h"
 
+#include <stmm-games/events/positionerevent.h>
+
 #include <stmm-games-xml-base/xmlcommonparser.h>
 
 #include <memory>
@@ -47,12 +49,14 @@ public:
 
 	Event* parseEvent(GameCtx& oCtx, const xmlpp::Element* p0Element) override;
 
-	//TODO void recycleEvents(std::unique_ptr<Event>& refEvent) override;
+	void recycleEvents(std::unique_ptr<Event>& refEvent) override;
 	int32_t parseEventMsgName(ConditionalCtx& oCtx, const xmlpp::Element* p0Element, const std::string& sAttr
 							, const std::string& sMsgName) override;
 private:
 	unique_ptr<Event> parseEventPositioner(GameCtx& oCtx, const xmlpp::Element* p0Element);
 
+private:
+	EventRecycler<PositionerEvent> m_oRecycler;
 private:
 	XmlPositionerEventParser(const XmlPositionerEventParser& oSource) = delete;
 	XmlPositionerEventParser& operator=(const XmlPositionerEventParser& oSource) = delete;
@@ -23,6 +23,8 @@
 
 #include "xmleventparser.h"
 
+#include <stmm-games/events/randomevent.h>
+
 #include <memory>
 #include <string>
 
@@ -45,7 +47,7 @@ public:
 
 	Event* parseEvent(GameCtx& oCtx, const xmlpp::Element* p0Element) override;
 
-	//TODO void recycleEvents(std::unique_ptr<Event>& refEvent) override;
+	void recycleEvents(std::unique_ptr<Event>& refEvent) override;
 	int32_t parseEventMsgName(ConditionalCtx& oCtx, const xmlpp::Element* p0Element, const std::string& sAttr
 							, const std::string& sMsgName) override;
 	int32_t parseEventListenerGroupName(GameCtx& oCtx, const xmlpp::Element* p0Element, const std::string& sAttr
@@ -53,6 +55,8 @@ public:
 private:
 	unique_ptr<Event> parseEventRandom(GameCtx& oCtx, const xmlpp::Element* p0Element);
 
+private:
+	EventRecycler<RandomEvent> m_oRecycler;
 private:
 	XmlRandomEventParser(const XmlRandomEventParser& oSource) = delete;
 	XmlRandomEventParser& operator=(const XmlRandomEventParser& oSource) = delete;
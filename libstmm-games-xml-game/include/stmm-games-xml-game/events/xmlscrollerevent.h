@@ -44,6 +44,8 @@ public:
 
 	Event* parseEvent(GameCtx& oCtx, const xmlpp::Element* p0Element) override;
 
+	void recycleEvents(std::unique_ptr<Event>& refEvent) override;
+
 	int32_t parseEventMsgName(ConditionalCtx& oCtx, const xmlpp::Element* p0Element, const std::string& sAttr
 							, const std::string& sMsgName) override;
 	int32_t parseEventListenerGroupName(GameCtx& oCtx, const xmlpp::Element* p0Element, const std::string& sAttr
@@ -60,6 +62,8 @@ private:
 	void parseRemover(GameCtx& oCtx, const xmlpp::Element* p0Element, ScrollerEvent::Init& oInit);
 	void parseInhibitor(GameCtx& oCtx, const xmlpp::Element* p0Element, ScrollerEvent::Init& oInit);
 
+private:
+	EventRecycler<ScrollerEvent> m_oRecycler;
 private:
 	XmlScrollerEventParser(const XmlScrollerEventParser& oSource) = delete;
 	XmlScrollerEventParser& operator=(const XmlScrollerEventParser& oSource) = delete;
@@ -23,6 +23,8 @@
 
 #include "xmleventparser.h"
 
+#include <stmm-games/events/selectevent.h>
+
 #include <memory>
 
 namespace stmg { class Event; }
@@ -42,10 +44,12 @@ public:
 
 	Event* parseEvent(GameCtx& oCtx, const xmlpp::Element* p0Element) override;
 
-	//TODO void recycleEvents(std::unique_ptr<Event>& refEvent) override;
+	void recycleEvents(std::unique_ptr<Event>& refEvent) override;
 private:
 	unique_ptr<Event> parseEventSelect(GameCtx& oCtx, const xmlpp::Element* p0Element);
 
+private:
+	EventRecycler<SelectEvent> m_oRecycler;
 private:
 	XmlSelectEventParser(const XmlSelectEventParser& oSource) = delete;
 	XmlSelectEventParser& operator=(const XmlSelectEventParser& oSource) = delete;
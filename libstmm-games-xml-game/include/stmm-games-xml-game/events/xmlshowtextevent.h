@@ -23,6 +23,8 @@
 
 #include "xmleventparser.h"
 
+#include <stmm-games/events/showtextevent.h>
+
 #include <memory>
 #include <string>
 
@@ -45,12 +47,14 @@ public:
 
 	Event* parseEvent(GameCtx& oCtx, const xmlpp::Element* p0Element) override;
 
-	//TODO void recycleEvents(std::unique_ptr<Event>& refEvent) override;
+	void recycleEvents(std::unique_ptr<Event>& refEvent) override;
 	int32_t parseEventMsgName(ConditionalCtx& oCtx, const xmlpp::Element* p0Element, const std::string& sAttr
 							, const std::string& sMsgName) override;
 private:
 	unique_ptr<Event> parseEventShowText(GameCtx& oCtx, const xmlpp::Element* p0Element);
 
+private:
+	EventRecycler<ShowTextEvent> m_oRecycler;
 private:
 	XmlShowTextEventParser(const XmlShowTextEventParser& oSource) = delete;
 	XmlShowTextEventParser& operator=(const XmlShowTextEventParser& oSource) = delete;
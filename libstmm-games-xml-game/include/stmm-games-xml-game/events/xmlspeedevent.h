@@ -46,7 +46,7 @@ public:
 
 	Event* parseEvent(GameCtx& oCtx, const xmlpp::Element* p0Element) override;
 
-	//TODO void recycleEvents(std::unique_ptr<Event>& refEvent) override;
+	void recycleEvents(std::unique_ptr<Event>& refEvent) override;
 	int32_t parseEventListenerGroupName(GameCtx& oCtx, const xmlpp::Element* p0Element, const std::string& sAttr
 										, const std::string& sListenerGroupName) override;
 private:
@@ -55,6 +55,8 @@ private:
 	void parseEventSpeedChanger(GameCtx& oCtx, const xmlpp::Element* p0Element, bool bPerc
 				, bool& bInterval, int32_t& nIntervalChange, bool& bFallTicks, int32_t& nFallTicksChange);
 
+private:
+	EventRecycler<SpeedEvent> m_oRecycler;
 private:
 	XmlSpeedEventParser(const XmlSpeedEventParser& oSource) = delete;
 	XmlSpeedEventParser& operator=(const XmlSpeedEventParser& oSource) = delete;
@@ -23,6 +23,8 @@
 
 #include "xmleventparser.h"
 
+#include <stmm-games/events/staticgridevent.h>
+
 #include <stmm-games-xml-base/xmlcommonparser.h>
 
 #include <stmm-games/animations/staticgridanimation.h>
@@ -49,7 +51,7 @@ public:
 
 	Event* parseEvent(GameCtx& oCtx, const xmlpp::Element* p0Element) override;
 
-	//TODO void recycleEvents(std::unique_ptr<Event>& refEvent) override;
+	void recycleEvents(std::unique_ptr<Event>& refEvent) override;
 	int32_t parseEventMsgName(ConditionalCtx& oCtx, const xmlpp::Element* p0Element, const std::string& sAttr
 							, const std::string& sMsgName) override;
 	int32_t parseEventListenerGroupName(GameCtx& oCtx, const xmlpp::Element* p0Element, const std::string& sAttr
@@ -59,6 +61,8 @@ private:
 	void parseEventStaticGridImage(GameCtx& oCtx, const xmlpp::Element* p0Element, StaticGridAnimation::LocalInit& oAniInit
 									, StaticGridAnimation::ImageSpan& oImageSpan);
 
+private:
+	EventRecycler<StaticGridEvent> m_oRecycler;
 private:
 	XmlStaticGridEventParser(const XmlStaticGridEventParser& oSource) = delete;
 	XmlStaticGridEventParser& operator=(const XmlStaticGridEventParser& oSource) = delete;
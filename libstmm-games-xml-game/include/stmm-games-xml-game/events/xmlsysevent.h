@@ -23,6 +23,8 @@
 
 #include "xmleventparser.h"
 
+#include <stmm-games/events/sysevent.h>
+
 #include <memory>
 #include <string>
 
@@ -44,12 +46,14 @@ public:
 
 	Event* parseEvent(GameCtx& oCtx, const xmlpp::Element* p0Element) override;
 
-	//TODO void recycleEvents(std::unique_ptr<Event>& refEvent) override;
+	void recycleEvents(std::unique_ptr<Event>& refEvent) override;
 	int32_t parseEventListenerGroupName(GameCtx& oCtx, const xmlpp::Element* p0Element, const std::string& sAttr
 										, const std::string& sListenerGroupName) override;
 private:
 	unique_ptr<Event> parseEventSys(GameCtx& oCtx, const xmlpp::Element* p0Element);
 
+private:
+	EventRecycler<SysEvent> m_oRecycler;
 private:
 	XmlSysEventParser(const XmlSysEventParser& oSource) = delete;
 	XmlSysEventParser& operator=(const XmlSysEventParser& oSource) = delete;
@@ -23,6 +23,8 @@
 
 #include "xmleventparser.h"
 
+#include <stmm-games/events/tileanimatorevent.h>
+
 #include <stmm-games-xml-base/xmlcommonparser.h>
 
 #include <memory>
@@ -47,13 +49,15 @@ public:
 
 	Event* parseEvent(GameCtx& oCtx, const xmlpp::Element* p0Element) override;
 
-	//TODO void recycleEvents(std::unique_ptr<Event>& refEvent) override;
+	void recycleEvents(std::unique_ptr<Event>& refEvent) override;
 	int32_t parseEventListenerGroupName(GameCtx& oCtx, const xmlpp::Element* p0Element, const std::string& sAttr
 										, const std::string& sListenerGroupName) override;
 private:
 	unique_ptr<Event> parseEventTileAnimator(GameCtx& oCtx, const xmlpp::Element* p0Element);
 	unique_ptr<TileSelector> parseEventTileAnimatorSelect(GameCtx& oCtx, const xmlpp::Element* p0Element);
 
+private:
+	EventRecycler<TileAnimatorEvent> m_oRecycler;
 private:
 	XmlTileAnimatorEventParser(const XmlTileAnimatorEventParser& oSource) = delete;
 	XmlTileAnimatorEventParser& operator=(const XmlTileAnimatorEventParser& oSource) = delete;
@@ -23,6 +23,8 @@
 
 #include "xmleventparser.h"
 
+#include <stmm-games/events/variableevent.h>
+
 #include <memory>
 #include <string>
 
@@ -45,7 +47,7 @@ public:
 
 	Event* parseEvent(GameCtx& oCtx, const xmlpp::Element* p0Element) override;
 
-	//TODO void recycleEvents(std::unique_ptr<Event>& refEvent) override;
+	void recycleEvents(std::unique_ptr<Event>& refEvent) override;
 	int32_t parseEventMsgName(ConditionalCtx& oCtx, const xmlpp::Element* p0Element, const std::string& sAttr
 							, const std::string& sMsgName) override;
 	int32_t parseEventListenerGroupName(GameCtx& oCtx, const xmlpp::Element* p0Element, const std::string& sAttr
@@ -53,6 +55,8 @@ public:
 private:
 	unique_ptr<Event> parseEventVariable(GameCtx& oCtx, const xmlpp::Element* p0Element);
 
+private:
+	EventRecycler<VariableEvent> m_oRecycler;
 private:
 	XmlVariableEventParser(const XmlVariableEventParser& oSource) = delete;
 	XmlVariableEventParser& operator=(const XmlVariableEventParser& oSource) = delete;
@@ -73,6 +73,11 @@ public:
 	 * @return The maximum or -1 if not defined.
 	 */
 	int32_t getMaxViewTicks() const { return m_nMaxViewTicks; }
+	/** Whether input can be dispatched between game ticks.
+	 * See Game::Init::m_bLowLatencyInput.
+	 * @return Whether low latency input mode. Default is false.
+	 */
+	bool getLowLatencyInput() const { return m_bLowLatencyInput; }
 	/** Get additional time in milliseconds for highscores to appear when game ended.
 	 * @return The additional time in milliseconds.
 	 */
@@ -95,6 +100,7 @@ private:
 	double m_fMinGameInterval;
 	double m_fInitialGameInterval;
 	int32_t m_nMaxViewTicks;
+	bool m_bLowLatencyInput;
 	int32_t m_nAdditionalHighscoresWait;
 	double m_fSoundScaleX;
 	double m_fSoundScaleY;
@@ -25,6 +25,9 @@
 
 #include <memory>
 #include <string>
+#include <vector>
+#include <typeinfo>
+#include <utility>
 
 #include <stdint.h>
 
@@ -67,6 +70,8 @@ public:
 	virtual Event* parseEvent(GameCtx& oCtx, const xmlpp::Element* p0Element) = 0;
 
 	/** Recycle the event if it is of a type created by this instance.
+	 * Called by the game parser for the events of the levels it recycles.
+	 * Subclasses usually implement it with an EventRecycler.
 	 * The default implementation is empty.
 	 * @param refEvent The event. Cannot be null. If recycled is null after function call.
 	 */
@@ -106,6 +111,58 @@ public:
 												, const std::string& sListenerGroupName);
 
 protected:
+	/** Recycling factory for the events created by a parser.
+	 * The events are instances of a private subclass of T so that recycle()
+	 * only takes back the events that were created by this instance.
+	 *
+	 * T must have a constructor T(T::Init&& oInit) and a (possibly protected)
+	 * member function reInit(T::Init&& oInit).
+	 */
+	template <class T>
+	class EventRecycler final
+	{
+	public:
+		EventRecycler() noexcept = default;
+		/** Reinitialize a recycled event or construct a new one.
+		 * @param oInit The initialization data.
+		 * @return The event. Not null.
+		 */
+		unique_ptr<T> create(typename T::Init&& oInit) noexcept
+		{
+			if (m_aRecycled.empty()) {
+				return unique_ptr<T>(new PrivateEvent(std::move(oInit))); //---
+			}
+			unique_ptr<PrivateEvent> refEvent = std::move(m_aRecycled.back());
+			m_aRecycled.pop_back();
+			refEvent->reInit(std::move(oInit));
+			return refEvent;
+		}
+		/** Take ownership of the event if it was created by this instance.
+		 * @param refEvent The event. Cannot be null. If recycled is null after the call.
+		 */
+		void recycle(unique_ptr<Event>& refEvent) noexcept
+		{
+			if (typeid(*refEvent) != typeid(PrivateEvent)) {
+				return; //------------------------------------------------------
+			}
+			m_aRecycled.emplace_back(static_cast<PrivateEvent*>(refEvent.release()));
+		}
+	private:
+		class PrivateEvent : public T
+		{
+		public:
+			using T::T;
+			void reInit(typename T::Init&& oInit) noexcept
+			{
+				T::reInit(std::move(oInit));
+			}
+		};
+		std::vector< unique_ptr<PrivateEvent> > m_aRecycled;
+	private:
+		EventRecycler(const EventRecycler& oSource) = delete;
+		EventRecycler& operator=(const EventRecycler& oSource) = delete;
+	};
+
 	/** Return named block.
 	 * @param oCtx The context.
 	 * @param sName The block name. Cannot be empty.
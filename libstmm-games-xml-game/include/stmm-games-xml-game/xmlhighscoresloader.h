@@ -28,6 +28,8 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <mutex>
 
 #include <stdint.h>
 
@@ -40,12 +42,32 @@ namespace xmlpp { class Element; }
 namespace stmg
 {
 
+using std::unique_ptr;
+
 class XmlGameFiles;
+class HighscoresJournal;
 
+/** Highscores loader based on xml files.
+ * The highscores of a game are loaded lazily the first time they are requested
+ * and are then kept in memory. Callers always get copies.
+ *
+ * If the highscores file (or its journal) is changed on disk by someone else,
+ * for example another instance of the application, it is parsed again by a
+ * background thread. Until the new highscores are available the ones in memory
+ * are returned.
+ *
+ * Updates are appended to a journal file next to the highscores file by a
+ * background thread. When the journal has grown enough the highscores file is
+ * rewritten (atomically) with all the highscores and the journal is removed.
+ */
 class XmlHighscoresLoader : public HighscoresLoader
 {
 public:
 	XmlHighscoresLoader(const shared_ptr<AppConfig>& refAppConfig, const shared_ptr<XmlGameFiles>& refXmlGameFiles);
+	/** Destructor.
+	 * Waits for the pending writes to complete.
+	 */
+	virtual ~XmlHighscoresLoader();
 
 	shared_ptr<Highscore> getHighscore(const std::string& sGameName, const AppPreferences& oPreferences
 										, const shared_ptr<HighscoresDefinition>& refHighscoresDefinition) const noexcept override;
@@ -53,7 +75,63 @@ public:
 
 	std::vector<shared_ptr<Highscore>> getHighscores(const std::string& sGameName
 													, const shared_ptr<HighscoresDefinition>& refHighscoresDefinition) const noexcept override;
+
+	/** Wait for all the pending highscores writes to complete.
+	 */
+	void flush() noexcept;
 private:
+	// The state of the highscores file and its journal on disk
+	struct FileStamp
+	{
+		int64_t m_nFileMTimeNsec = -1; // -1 if file doesn't exist
+		int64_t m_nFileSize = -1;
+		int64_t m_nJournalMTimeNsec = -1; // -1 if journal doesn't exist
+		int64_t m_nJournalSize = -1;
+		bool operator==(const FileStamp& oOther) const noexcept
+		{
+			return (m_nFileMTimeNsec == oOther.m_nFileMTimeNsec) && (m_nFileSize == oOther.m_nFileSize)
+					&& (m_nJournalMTimeNsec == oOther.m_nJournalMTimeNsec) && (m_nJournalSize == oOther.m_nJournalSize);
+		}
+		bool operator!=(const FileStamp& oOther) const noexcept { return !operator==(oOther); }
+	};
+	// The result of a background parse
+	struct Reload
+	{
+		std::mutex m_oMutex;
+		bool m_bDone = false; // Protected by m_oMutex
+		std::vector<shared_ptr<Highscore>> m_aHighscores; // Protected by m_oMutex
+		int32_t m_nJournalEntries = 0; // Protected by m_oMutex
+		FileStamp m_oStamp; // Protected by m_oMutex
+	};
+	// The state of the files after the last write of this instance
+	struct OwnWrites
+	{
+		std::mutex m_oMutex;
+		FileStamp m_oStamp; // Protected by m_oMutex, set by the background thread after each write
+	};
+	struct GameHighscores
+	{
+		std::vector<shared_ptr<Highscore>> m_aHighscores; // The (lazily) loaded highscores of all codes
+		int32_t m_nJournalEntries = 0; // The number of entries in the journal file
+		FileStamp m_oStamp; // The stamp of the files when m_aHighscores was loaded
+		shared_ptr<OwnWrites> m_refOwnWrites; // Non null if the files were written by this instance since m_oStamp
+		shared_ptr<Reload> m_refReload; // Non null while a background parse is pending
+	};
+	// If bWaitReload is true and a background parse is pending waits for it to complete
+	GameHighscores& getGameHighscores(const shared_ptr<HighscoresDefinition>& refHighscoresDefinition
+									, const File& oHSFile, const std::string& sGameName, bool bWaitReload) const;
+	void checkGameHighscores(const shared_ptr<HighscoresDefinition>& refHighscoresDefinition
+							, const File& oHSFile, const std::string& sGameName, bool bWaitReload
+							, GameHighscores& oGameHighscores) const;
+	static FileStamp getFileStamp(const File& oHSFile);
+	int32_t loadJournal(const shared_ptr<HighscoresDefinition>& refHighscoresDefinition
+						, const std::string& sJournalPath, std::vector<shared_ptr<Highscore>>& aHighscores) const;
+	shared_ptr<Highscore> parseJournalHighscores(const shared_ptr<HighscoresDefinition>& refHighscoresDefinition
+												, const std::vector<std::string>& aFields) const;
+	static std::string createJournalLine(const Highscore& oHighscore);
+	static std::string createXmlGameHighscores(const std::string& sAppName, const std::string& sGameName
+												, const std::vector<shared_ptr<Highscore>>& aHighscores);
+	static std::string getJournalPath(const File& oHSFile);
 	std::vector<shared_ptr<Highscore>> parseGameHighscores(const shared_ptr<HighscoresDefinition>& refHighscoresDefinition
 															, const File& oHSFile, const std::string& sGameName
 															, bool bAll, const std::string& sCode, const std::string& sTitle) const;
@@ -66,11 +144,14 @@ private:
 								, const xmlpp::Element* p0ScoreElement) const;
 	int32_t findHighscoreWithCode(const std::vector<shared_ptr<Highscore>>& aHighscores
 								, const std::string& sCode) const;
-	void writeHighscores(xmlpp::Element* p0RootElement, const Highscore& oHighscore);
+	static void writeHighscores(xmlpp::Element* p0RootElement, const Highscore& oHighscore);
 private:
 	const shared_ptr<AppConfig> m_refAppConfig;
 	const shared_ptr<XmlGameFiles> m_refXmlGameFiles;
 
+	mutable std::unordered_map<std::string, GameHighscores> m_oGameHighscores; // Key: game name
+	unique_ptr<HighscoresJournal> m_refHighscoresJournal;
+
 private:
 	XmlHighscoresLoader() = delete;
 	XmlHighscoresLoader(const XmlHighscoresLoader& oSource) = delete;
@@ -42,16 +42,40 @@ namespace xmlpp { class Element; }
 namespace stmg
 {
 
+using std::unique_ptr;
+
 class XmlGameFiles;
+class DebouncedFileWriter;
 
+/** Preferences loader using xml files.
+ * The preferences file is written in a background thread. Bursts of updates
+ * are coalesced in a single write.
+ */
 class XmlPreferencesLoader : public AllPreferencesLoader
 {
 public:
 	XmlPreferencesLoader(const shared_ptr<StdConfig>& refStdConfig, const shared_ptr<XmlGameFiles>& refXmlGameFiles);
+	/** Destructor.
+	 * Waits for the pending write to complete.
+	 */
+	virtual ~XmlPreferencesLoader() noexcept;
 
 	shared_ptr<AllPreferences> getPreferences() const noexcept override;
 	shared_ptr<AllPreferences> getPreferencesCopy(const shared_ptr<AllPreferences>& refAllPreferences) const noexcept override;
+	/** Persist an AllPreferences instance.
+	 * The instance is serialized in the calling thread but the file is written
+	 * later in a background thread. A failure of that write is reported
+	 * by the next call to this function or to flush().
+	 * @param refAllPreferences The instance to persist. Cannot be null.
+	 * @return Whether the instance could be serialized and queued for writing
+	 *         and no earlier background write failed.
+	 */
 	bool updatePreferences(const shared_ptr<AllPreferences>& refAllPreferences) noexcept override;
+	/** Wait for the pending write to complete.
+	 * @return Whether the background writes since the last call to this function
+	 *         or to updatePreferences() succeeded.
+	 */
+	bool flush() noexcept;
 private:
 	bool parseXmlGameAllPreferences(const shared_ptr<AllPreferences>& refPrefs
 									, const xmlpp::Element* p0RootElement) const;
@@ -84,6 +108,7 @@ private:
 private:
 	const shared_ptr<StdConfig> m_refStdConfig;
 	const shared_ptr<XmlGameFiles> m_refXmlGameFiles;
+	unique_ptr<DebouncedFileWriter> m_refPreferencesWriter;
 
 private:
 	XmlPreferencesLoader() = delete;
@@ -0,0 +1,140 @@
+/*
+ * Copyright © 2019-2020  Stefano Marsili, <stemars@gmx.ch>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>
+ */
+/*
+ * File:   debouncedfilewriter.cc
+ */
+
+#include "debouncedfilewriter.h"
+
+#include "xmlutilfile.h"
+
+#include <iostream>
+#include <cassert>
+#include <exception>
+#include <utility>
+
+namespace stmg
+{
+
+DebouncedFileWriter::DebouncedFileWriter(int32_t nDelayMillisec) noexcept
+: m_oDelay(nDelayMillisec)
+, m_bBusy(false)
+, m_nFlushing(0)
+, m_bTerminate(false)
+, m_bWriteFailed(false)
+{
+	assert(nDelayMillisec >= 0);
+}
+DebouncedFileWriter::~DebouncedFileWriter() noexcept
+{
+	{
+		std::lock_guard<std::mutex> oLock(m_oMutex);
+		m_bTerminate = true;
+	}
+	m_oStateChanged.notify_all();
+	if (m_oWorker.joinable()) {
+		m_oWorker.join();
+	}
+}
+void DebouncedFileWriter::post(const std::string& sPath, std::string&& sContent) noexcept
+{
+	assert(! sPath.empty());
+	std::unique_lock<std::mutex> oLock(m_oMutex);
+	if ((! m_sPendingPath.empty()) && (m_sPendingPath != sPath)) {
+		oLock.unlock();
+		flush();
+		oLock.lock();
+	}
+	m_sPendingPath = sPath;
+	m_sPendingContent = std::move(sContent);
+	m_oPendingDeadline = std::chrono::steady_clock::now() + m_oDelay;
+	if (! m_oWorker.joinable()) {
+		m_oWorker = std::thread(&DebouncedFileWriter::run, this);
+	}
+	oLock.unlock();
+	m_oStateChanged.notify_all();
+}
+void DebouncedFileWriter::flush() noexcept
+{
+	std::unique_lock<std::mutex> oLock(m_oMutex);
+	++m_nFlushing;
+	m_oStateChanged.notify_all();
+	m_oStateChanged.wait(oLock, [&]()
+	{
+		return m_sPendingPath.empty() && !m_bBusy;
+	});
+	--m_nFlushing;
+}
+bool DebouncedFileWriter::fetchWriteFailed() noexcept
+{
+	std::lock_guard<std::mutex> oLock(m_oMutex);
+	const bool bWriteFailed = m_bWriteFailed;
+	m_bWriteFailed = false;
+	return bWriteFailed;
+}
+void DebouncedFileWriter::run() noexcept
+{
+	std::unique_lock<std::mutex> oLock(m_oMutex);
+	do {
+		m_oStateChanged.wait(oLock, [&]()
+		{
+			return m_bTerminate || !m_sPendingPath.empty();
+		});
+		if (m_sPendingPath.empty()) {
+			// terminate only when the pending content was written
+			break; // do ------
+		}
+		// Wait until no content was posted for the delay (posts move the deadline)
+		while ((! m_bTerminate) && (m_nFlushing == 0)
+				&& (std::chrono::steady_clock::now() < m_oPendingDeadline)) {
+			m_oStateChanged.wait_until(oLock, m_oPendingDeadline);
+		}
+		const std::string sPath = std::move(m_sPendingPath);
+		const std::string sContent = std::move(m_sPendingContent);
+		m_sPendingPath.clear();
+		m_sPendingContent.clear();
+		m_bBusy = true;
+		oLock.unlock();
+		const bool bOk = doWrite(sPath, sContent);
+		oLock.lock();
+		if (! bOk) {
+			m_bWriteFailed = true;
+		}
+		m_bBusy = false;
+		m_oStateChanged.notify_all();
+	} while (true);
+}
+bool DebouncedFileWriter::doWrite(const std::string& sPath, const std::string& sContent) noexcept
+{
+	const auto nPos = sPath.rfind('/');
+	if ((nPos != std::string::npos) && (nPos > 0)) {
+		try {
+			XmlUtilGame::makePath(sPath.substr(0, nPos));
+		} catch (const std::exception& ex) {
+			std::cout << "Could not create directory of file '" << sPath << "'";
+			std::cout << ": " << ex.what() << '\n';
+			return false; //----------------------------------------------------
+		}
+	}
+	if (! XmlUtilGame::writeFileAtomically(sPath, sContent)) {
+		std::cout << "Could not write file '" << sPath << "'" << '\n';
+		return false; //--------------------------------------------------------
+	}
+	return true;
+}
+
+} // namespace stmg
@@ -0,0 +1,94 @@
+/*
+ * Copyright © 2019-2020  Stefano Marsili, <stemars@gmx.ch>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>
+ */
+/*
+ * File:   debouncedfilewriter.h
+ */
+
+#ifndef STMG_DEBOUNCED_FILE_WRITER_H
+#define STMG_DEBOUNCED_FILE_WRITER_H
+
+#include <string>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include <stdint.h>
+
+namespace stmg
+{
+
+/** Background writer that coalesces bursts of writes to a file.
+ * The content is written in a worker thread once no new content was posted
+ * for a given delay. Content posted while waiting replaces the pending one, so
+ * only the last content of a burst is written.
+ *
+ * The file is replaced atomically (write to a temporary file and rename).
+ * Missing directories of the file path are created.
+ * The worker thread is only started when the first content is posted.
+ */
+class DebouncedFileWriter
+{
+public:
+	/** Constructor.
+	 * @param nDelayMillisec The time without new posts after which the content is written. Must be &gt;= 0.
+	 */
+	explicit DebouncedFileWriter(int32_t nDelayMillisec) noexcept;
+	/** Destructor.
+	 * Writes the pending content without waiting for the delay.
+	 */
+	~DebouncedFileWriter() noexcept;
+
+	/** Post the new content of a file.
+	 * If content for another file is pending it is written first.
+	 * @param sPath The file path. Cannot be empty.
+	 * @param sContent The content.
+	 */
+	void post(const std::string& sPath, std::string&& sContent) noexcept;
+	/** Write the pending content without waiting for the delay.
+	 * Returns when the file was written.
+	 */
+	void flush() noexcept;
+	/** Whether a write failed since the last call.
+	 * The writes still in progress or pending are not considered: call flush() first
+	 * to include them.
+	 * @return Whether at least one write failed.
+	 */
+	bool fetchWriteFailed() noexcept;
+private:
+	void run() noexcept;
+	bool doWrite(const std::string& sPath, const std::string& sContent) noexcept;
+private:
+	const std::chrono::milliseconds m_oDelay;
+	std::mutex m_oMutex;
+	std::condition_variable m_oStateChanged;
+	std::string m_sPendingPath; // Protected by m_oMutex, empty if nothing pending
+	std::string m_sPendingContent; // Protected by m_oMutex
+	std::chrono::steady_clock::time_point m_oPendingDeadline; // Protected by m_oMutex
+	bool m_bBusy; // Protected by m_oMutex
+	int32_t m_nFlushing; // Protected by m_oMutex, the number of threads waiting in flush()
+	bool m_bTerminate; // Protected by m_oMutex
+	bool m_bWriteFailed; // Protected by m_oMutex
+	std::thread m_oWorker;
+private:
+	DebouncedFileWriter(const DebouncedFileWriter& oSource) = delete;
+	DebouncedFileWriter& operator=(const DebouncedFileWriter& oSource) = delete;
+};
+
+} // namespace stmg
+
+#endif	/* STMG_DEBOUNCED_FILE_WRITER_H */
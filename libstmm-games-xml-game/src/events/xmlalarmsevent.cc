@@ -60,6 +60,10 @@ Event* XmlAlarmsEventParser::parseEvent(GameCtx& oCtx, const xmlpp::Element* p0E
 {
 	return integrateAndAdd(oCtx, parseEventAlarms(oCtx, p0Element), p0Element);
 }
+void XmlAlarmsEventParser::recycleEvents(std::unique_ptr<Event>& refEvent)
+{
+	m_oRecycler.recycle(refEvent);
+}
 unique_ptr<Event> XmlAlarmsEventParser::parseEventAlarms(GameCtx& oCtx, const xmlpp::Element* p0Element)
 {
 //std::cout << "XmlAlarmsEventParser::parseEventAlarms" << '\n';
@@ -103,7 +107,7 @@ unique_ptr<Event> XmlAlarmsEventParser::parseEventAlarms(GameCtx& oCtx, const xm
 		}
 	});
 	oCtx.removeChecker(p0Element, false, true);
-	auto refAlarmsEvent = std::make_unique<AlarmsEvent>(std::move(oAInit));
+	auto refAlarmsEvent = m_oRecycler.create(std::move(oAInit));
 	return refAlarmsEvent;
 }
 void XmlAlarmsEventParser::parseEventAlarmsStage(GameCtx& oCtx, const xmlpp::Element* p0Element, bool bPerc, int32_t& nValue, int32_t& nRepeat)
@@ -72,6 +72,10 @@ Event* XmlArrayEventParser::parseEvent(GameCtx& oCtx, const xmlpp::Element* p0El
 {
 	return integrateAndAdd(oCtx, parseEventArray(oCtx, p0Element), p0Element);
 }
+void XmlArrayEventParser::recycleEvents(std::unique_ptr<Event>& refEvent)
+{
+	m_oRecycler.recycle(refEvent);
+}
 unique_ptr<Event> XmlArrayEventParser::parseEventArray(GameCtx& oCtx, const xmlpp::Element* p0Element)
 {
 //std::cout << "XmlArrayEventParser::parseEventArray" << '\n';
@@ -128,7 +132,7 @@ unique_ptr<Event> XmlArrayEventParser::parseEventArray(GameCtx& oCtx, const xmlp
 	parseEventArrayArray(oCtx, p0ArrayElement, oAInit, eValueType);
 
 	oCtx.removeChecker(p0Element, false, true);
-	auto refArrayEvent = std::make_unique<ArrayEvent>(std::move(oAInit));
+	auto refArrayEvent = m_oRecycler.create(std::move(oAInit));
 	return refArrayEvent;
 }
 std::tuple<int32_t, int32_t, int32_t> XmlArrayEventParser::parseVariableAndOwner(GameCtx& oCtx, const xmlpp::Element* p0Element, bool bMandatory)
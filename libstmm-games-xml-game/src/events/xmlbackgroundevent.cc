@@ -84,6 +84,10 @@ Event* XmlBackgroundEventParser::parseEvent(GameCtx& oCtx, const xmlpp::Element*
 {
 	return integrateAndAdd(oCtx, parseEventBackground(oCtx, p0Element), p0Element);
 }
+void XmlBackgroundEventParser::recycleEvents(std::unique_ptr<Event>& refEvent)
+{
+	m_oRecycler.recycle(refEvent);
+}
 
 unique_ptr<Event> XmlBackgroundEventParser::parseEventBackground(GameCtx& oCtx, const xmlpp::Element* p0Element)
 {
@@ -224,7 +228,7 @@ unique_ptr<Event> XmlBackgroundEventParser::parseEventBackground(GameCtx& oCtx,
 		throw XmlCommonErrors::errorElementExpected(oCtx, p0Element, s_sEventBackgroundImageNodeName);
 	}
 	oCtx.removeChecker(p0Element, true);
-	return std::make_unique<BackgroundEvent>(std::move(oBEInit));
+	return m_oRecycler.create(std::move(oBEInit));
 }
 void XmlBackgroundEventParser::parseEventBackgroundImage(GameCtx& oCtx, const xmlpp::Element* p0Element, BackgroundEvent::PatternImage& oPatternImage)
 {
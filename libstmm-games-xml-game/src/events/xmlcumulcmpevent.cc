@@ -67,6 +67,10 @@ Event* XmlCumulCmpEventParser::parseEvent(GameCtx& oCtx, const xmlpp::Element* p
 {
 	return integrateAndAdd(oCtx, parseEventCumulCmp(oCtx, p0Element), p0Element);
 }
+void XmlCumulCmpEventParser::recycleEvents(std::unique_ptr<Event>& refEvent)
+{
+	m_oRecycler.recycle(refEvent);
+}
 unique_ptr<Event> XmlCumulCmpEventParser::parseEventCumulCmp(GameCtx& oCtx, const xmlpp::Element* p0Element)
 {
 //std::cout << "XmlGameParser::parseEventCumulCmp" << '\n';
@@ -134,7 +138,7 @@ unique_ptr<Event> XmlCumulCmpEventParser::parseEventCumulCmp(GameCtx& oCtx, cons
 	}
 
 	oCtx.removeChecker(p0Element, true);
-	auto refCumulCmpEvent = std::make_unique<CumulCmpEvent>(std::move(oCCInit));
+	auto refCumulCmpEvent = m_oRecycler.create(std::move(oCCInit));
 	return refCumulCmpEvent;
 }
 int32_t XmlCumulCmpEventParser::parseEventMsgName(ConditionalCtx& oCtx, const xmlpp::Element* p0Element, const std::string& sAttr
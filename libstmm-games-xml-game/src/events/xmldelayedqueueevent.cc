@@ -51,6 +51,10 @@ Event* XmlDelayedQueueEventParser::parseEvent(GameCtx& oCtx, const xmlpp::Elemen
 {
 	return integrateAndAdd(oCtx, parseEventDelayedQueue(oCtx, p0Element), p0Element);
 }
+void XmlDelayedQueueEventParser::recycleEvents(std::unique_ptr<Event>& refEvent)
+{
+	m_oRecycler.recycle(refEvent);
+}
 unique_ptr<Event> XmlDelayedQueueEventParser::parseEventDelayedQueue(GameCtx& oCtx, const xmlpp::Element* p0Element)
 {
 //std::cout << "XmlDelayedQueueEventParser::parseEventDelayedQueue" << '\n';
@@ -78,7 +82,7 @@ unique_ptr<Event> XmlDelayedQueueEventParser::parseEventDelayedQueue(GameCtx& oC
 	}
 
 	oCtx.removeChecker(p0Element, true);
-	auto refDelayedQueueEvent = std::make_unique<DelayedQueueEvent>(std::move(oDQInit));
+	auto refDelayedQueueEvent = m_oRecycler.create(std::move(oDQInit));
 	return refDelayedQueueEvent;
 }
 int32_t XmlDelayedQueueEventParser::parseEventMsgName(ConditionalCtx& oCtx, const xmlpp::Element* p0Element, const std::string& sAttr
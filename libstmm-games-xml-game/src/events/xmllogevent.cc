@@ -54,6 +54,10 @@ Event* XmlLogEventParser::parseEvent(GameCtx& oCtx, const xmlpp::Element* p0Elem
 {
 	return integrateAndAdd(oCtx, parseEventLog(oCtx, p0Element), p0Element);
 }
+void XmlLogEventParser::recycleEvents(std::unique_ptr<Event>& refEvent)
+{
+	m_oRecycler.recycle(refEvent);
+}
 unique_ptr<Event> XmlLogEventParser::parseEventLog(GameCtx& oCtx, const xmlpp::Element* p0Element)
 {
 //std::cout << "XmlLogEventParser::parseEventLog" << '\n';
@@ -83,7 +87,7 @@ unique_ptr<Event> XmlLogEventParser::parseEventLog(GameCtx& oCtx, const xmlpp::E
 	}
 	parseEventBase(oCtx, p0Element, oLInit);
 	oCtx.removeChecker(p0Element, true);
-	auto refLogEvent = std::make_unique<LogEvent>(std::move(oLInit));
+	auto refLogEvent = m_oRecycler.create(std::move(oLInit));
 	return refLogEvent;
 }
 
@@ -47,6 +47,10 @@ Event* XmlOthersSenderEventParser::parseEvent(GameCtx& oCtx, const xmlpp::Elemen
 {
 	return integrateAndAdd(oCtx, parseEventOthersSender(oCtx, p0Element), p0Element);
 }
+void XmlOthersSenderEventParser::recycleEvents(std::unique_ptr<Event>& refEvent)
+{
+	m_oRecycler.recycle(refEvent);
+}
 unique_ptr<Event> XmlOthersSenderEventParser::parseEventOthersSender(GameCtx& oCtx, const xmlpp::Element* p0Element)
 {
 //std::cout << "XmlOthersEventParser::parseEventOthersSender" << '\n';
@@ -54,7 +58,7 @@ unique_ptr<Event> XmlOthersSenderEventParser::parseEventOthersSender(GameCtx& oC
 	OthersSenderEvent::Init oOSInit;
 	parseEventBase(oCtx, p0Element, oOSInit);
 	oCtx.removeChecker(p0Element, true);
-	auto refOthersSenderEvent = std::make_unique<OthersSenderEvent>(std::move(oOSInit));
+	auto refOthersSenderEvent = m_oRecycler.create(std::move(oOSInit));
 	return refOthersSenderEvent;
 }
 
@@ -68,6 +72,10 @@ Event* XmlOthersReceiverEventParser::parseEvent(GameCtx& oCtx, const xmlpp::Elem
 {
 	return integrateAndAdd(oCtx, parseEventOthersReceiver(oCtx, p0Element), p0Element);
 }
+void XmlOthersReceiverEventParser::recycleEvents(std::unique_ptr<Event>& refEvent)
+{
+	m_oRecycler.recycle(refEvent);
+}
 unique_ptr<Event> XmlOthersReceiverEventParser::parseEventOthersReceiver(GameCtx& oCtx, const xmlpp::Element* p0Element)
 {
 //std::cout << "XmlOthersEventParser::parseEventOthersReceiver" << '\n';
@@ -75,7 +83,7 @@ unique_ptr<Event> XmlOthersReceiverEventParser::parseEventOthersReceiver(GameCtx
 	OthersReceiverEvent::Init oORInit;
 	parseEventBase(oCtx, p0Element, oORInit);
 	oCtx.removeChecker(p0Element, true);
-	auto refOthersReceiverEvent = std::make_unique<OthersReceiverEvent>(std::move(oORInit));
+	auto refOthersReceiverEvent = m_oRecycler.create(std::move(oORInit));
 	return refOthersReceiverEvent;
 }
 
@@ -60,6 +60,10 @@ Event* XmlPositionerEventParser::parseEvent(GameCtx& oCtx, const xmlpp::Element*
 {
 	return integrateAndAdd(oCtx, parseEventPositioner(oCtx, p0Element), p0Element);
 }
+void XmlPositionerEventParser::recycleEvents(std::unique_ptr<Event>& refEvent)
+{
+	m_oRecycler.recycle(refEvent);
+}
 
 unique_ptr<Event> XmlPositionerEventParser::parseEventPositioner(GameCtx& oCtx, const xmlpp::Element* p0Element)
 {
@@ -100,7 +104,7 @@ unique_ptr<Event> XmlPositionerEventParser::parseEventPositioner(GameCtx& oCtx,
 																, true, 1, false, -1);
 	}
 	oCtx.removeChecker(p0Element, true);
-	return std::make_unique<PositionerEvent>(std::move(oInit));
+	return m_oRecycler.create(std::move(oInit));
 }
 int32_t XmlPositionerEventParser::parseEventMsgName(ConditionalCtx& oCtx, const xmlpp::Element* p0Element, const std::string& sAttr
 																	, const std::string& sMsgName)
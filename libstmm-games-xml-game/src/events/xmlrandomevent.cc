@@ -56,6 +56,10 @@ Event* XmlRandomEventParser::parseEvent(GameCtx& oCtx, const xmlpp::Element* p0E
 {
 	return integrateAndAdd(oCtx, parseEventRandom(oCtx, p0Element), p0Element);
 }
+void XmlRandomEventParser::recycleEvents(std::unique_ptr<Event>& refEvent)
+{
+	m_oRecycler.recycle(refEvent);
+}
 unique_ptr<Event> XmlRandomEventParser::parseEventRandom(GameCtx& oCtx, const xmlpp::Element* p0Element)
 {
 //std::cout << "XmlRandomEventParser::parseEventRandom" << '\n';
@@ -95,7 +99,7 @@ unique_ptr<Event> XmlRandomEventParser::parseEventRandom(GameCtx& oCtx, const xm
 
 	oCtx.removeChecker(p0Element, true);
 
-	auto refRandomEvent = std::make_unique<RandomEvent>(std::move(oRInit));
+	auto refRandomEvent = m_oRecycler.create(std::move(oRInit));
 	return refRandomEvent;
 }
 int32_t XmlRandomEventParser::parseEventMsgName(ConditionalCtx& oCtx, const xmlpp::Element* p0Element, const std::string& sAttr
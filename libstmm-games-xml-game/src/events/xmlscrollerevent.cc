@@ -73,6 +73,10 @@ Event* XmlScrollerEventParser::parseEvent(GameCtx& oCtx, const xmlpp::Element* p
 {
 	return parseEventScroller(oCtx, p0Element);
 }
+void XmlScrollerEventParser::recycleEvents(std::unique_ptr<Event>& refEvent)
+{
+	m_oRecycler.recycle(refEvent);
+}
 
 Event* XmlScrollerEventParser::parseEventScroller(GameCtx& oCtx, const xmlpp::Element* p0Element)
 {
@@ -125,7 +129,7 @@ Event* XmlScrollerEventParser::parseEventScroller(GameCtx& oCtx, const xmlpp::El
 	}
 
 	oCtx.removeChecker(p0Element, true);
-	auto refScrollerEvent = std::make_unique<ScrollerEvent>(std::move(oInit));
+	auto refScrollerEvent = m_oRecycler.create(std::move(oInit));
 	return integrateAndAdd(oCtx, std::move(refScrollerEvent), p0Element);
 }
 void XmlScrollerEventParser::parseNewRowChecker(GameCtx& oCtx, const xmlpp::Element* p0Element, ScrollerEvent::Init& oInit)
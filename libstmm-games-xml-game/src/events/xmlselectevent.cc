@@ -50,6 +50,10 @@ Event* XmlSelectEventParser::parseEvent(GameCtx& oCtx, const xmlpp::Element* p0E
 {
 	return integrateAndAdd(oCtx, parseEventSelect(oCtx, p0Element), p0Element);
 }
+void XmlSelectEventParser::recycleEvents(std::unique_ptr<Event>& refEvent)
+{
+	m_oRecycler.recycle(refEvent);
+}
 unique_ptr<Event> XmlSelectEventParser::parseEventSelect(GameCtx& oCtx, const xmlpp::Element* p0Element)
 {
 //std::cout << "XmlOthersEventParser::parseEventSelect" << '\n';
@@ -91,7 +95,7 @@ unique_ptr<Event> XmlSelectEventParser::parseEventSelect(GameCtx& oCtx, const xm
 	//
 	oCtx.removeChecker(p0Element, true);
 
-	auto refSelectEvent = std::make_unique<SelectEvent>(std::move(oOSInit));
+	auto refSelectEvent = m_oRecycler.create(std::move(oOSInit));
 	return refSelectEvent;
 }
 
@@ -78,6 +78,10 @@ Event* XmlShowTextEventParser::parseEvent(GameCtx& oCtx, const xmlpp::Element* p
 {
 	return integrateAndAdd(oCtx, parseEventShowText(oCtx, p0Element), p0Element);
 }
+void XmlShowTextEventParser::recycleEvents(std::unique_ptr<Event>& refEvent)
+{
+	m_oRecycler.recycle(refEvent);
+}
 unique_ptr<Event> XmlShowTextEventParser::parseEventShowText(GameCtx& oCtx, const xmlpp::Element* p0Element)
 {
 //std::cout << "XmlShowTextEventParser::parseEventShowText" << '\n';
@@ -413,7 +417,7 @@ unique_ptr<Event> XmlShowTextEventParser::parseEventShowText(GameCtx& oCtx, cons
 	oCtx.removeChecker(p0Element, true);
 	oSTInit.m_aSobstLines = std::move(aSobstLines);
 	oSTInit.m_aSobsts = std::move(aSobsts);
-	return std::make_unique<ShowTextEvent>(std::move(oSTInit));
+	return m_oRecycler.create(std::move(oSTInit));
 }
 int32_t XmlShowTextEventParser::parseEventMsgName(ConditionalCtx& oCtx, const xmlpp::Element* p0Element, const std::string& sAttr
 												, const std::string& sMsgName)
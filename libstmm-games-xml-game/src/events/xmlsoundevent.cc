@@ -61,6 +61,10 @@ Event* XmlSoundEventParser::parseEvent(GameCtx& oCtx, const xmlpp::Element* p0El
 {
 	return integrateAndAdd(oCtx, parseEventSound(oCtx, p0Element), p0Element);
 }
+void XmlSoundEventParser::recycleEvents(std::unique_ptr<Event>& refEvent)
+{
+	m_oRecycler.recycle(refEvent);
+}
 unique_ptr<Event> XmlSoundEventParser::parseEventSound(GameCtx& oCtx, const xmlpp::Element* p0Element)
 {
 //std::cout << "XmlSoundEventParser::parseEventSound" << '\n';
@@ -120,7 +124,7 @@ unique_ptr<Event> XmlSoundEventParser::parseEventSound(GameCtx& oCtx, const xmlp
 	}
 
 	oCtx.removeChecker(p0Element, true);
-	auto refSoundEvent = std::make_unique<SoundEvent>(std::move(oSInit));
+	auto refSoundEvent = m_oRecycler.create(std::move(oSInit));
 	return refSoundEvent;
 }
 int32_t XmlSoundEventParser::parseEventMsgName(ConditionalCtx& oCtx, const xmlpp::Element* p0Element, const std::string& sAttr
@@ -58,6 +58,10 @@ Event* XmlSpeedEventParser::parseEvent(GameCtx& oCtx, const xmlpp::Element* p0El
 {
 	return integrateAndAdd(oCtx, parseEventSpeed(oCtx, p0Element), p0Element);
 }
+void XmlSpeedEventParser::recycleEvents(std::unique_ptr<Event>& refEvent)
+{
+	m_oRecycler.recycle(refEvent);
+}
 unique_ptr<Event> XmlSpeedEventParser::parseEventSpeed(GameCtx& oCtx, const xmlpp::Element* p0Element)
 {
 //std::cout << "XmlSpeedEventParser::parseEventSpeed" << '\n';
@@ -76,7 +80,7 @@ unique_ptr<Event> XmlSpeedEventParser::parseEventSpeed(GameCtx& oCtx, const xmlp
 		throw XmlCommonErrors::errorElementExpected(oCtx, p0Element, s_sEventSpeedChangeNodeName);
 	}
 	oCtx.removeChecker(p0Element, true);
-	auto refSpeedEvent = std::make_unique<SpeedEvent>(std::move(oSInit));
+	auto refSpeedEvent = m_oRecycler.create(std::move(oSInit));
 	return refSpeedEvent;
 }
 
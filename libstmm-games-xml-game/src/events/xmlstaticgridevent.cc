@@ -83,6 +83,10 @@ Event* XmlStaticGridEventParser::parseEvent(GameCtx& oCtx, const xmlpp::Element*
 {
 	return integrateAndAdd(oCtx, parseEventStaticGrid(oCtx, p0Element), p0Element);
 }
+void XmlStaticGridEventParser::recycleEvents(std::unique_ptr<Event>& refEvent)
+{
+	m_oRecycler.recycle(refEvent);
+}
 
 unique_ptr<Event> XmlStaticGridEventParser::parseEventStaticGrid(GameCtx& oCtx, const xmlpp::Element* p0Element)
 {
@@ -212,7 +216,7 @@ unique_ptr<Event> XmlStaticGridEventParser::parseEventStaticGrid(GameCtx& oCtx,
 		throw XmlCommonErrors::errorElementExpected(oCtx, p0Element, s_sEventStaticGridImageNodeName);
 	}
 	oCtx.removeChecker(p0Element, true);
-	return std::make_unique<StaticGridEvent>(std::move(oSGEInit));
+	return m_oRecycler.create(std::move(oSGEInit));
 }
 void XmlStaticGridEventParser::parseEventStaticGridImage(GameCtx& oCtx, const xmlpp::Element* p0Element, StaticGridAnimation::LocalInit& oAniInit
 														, StaticGridAnimation::ImageSpan& oImageSpan)
@@ -56,6 +56,10 @@ Event* XmlSysEventParser::parseEvent(GameCtx& oCtx, const xmlpp::Element* p0Elem
 {
 	return integrateAndAdd(oCtx, parseEventSys(oCtx, p0Element), p0Element);
 }
+void XmlSysEventParser::recycleEvents(std::unique_ptr<Event>& refEvent)
+{
+	m_oRecycler.recycle(refEvent);
+}
 unique_ptr<Event> XmlSysEventParser::parseEventSys(GameCtx& oCtx, const xmlpp::Element* p0Element)
 {
 //std::cout << "XmlGameParser::parseEventSys" << '\n';
@@ -87,7 +91,7 @@ unique_ptr<Event> XmlSysEventParser::parseEventSys(GameCtx& oCtx, const xmlpp::E
 	}
 	oCtx.removeChecker(p0Element, true);
 
-	auto refSysEvent = std::make_unique<SysEvent>(std::move(oSInit));
+	auto refSysEvent = m_oRecycler.create(std::move(oSInit));
 	return refSysEvent;
 }
 
@@ -87,6 +87,10 @@ Event* XmlTileAnimatorEventParser::parseEvent(GameCtx& oCtx, const xmlpp::Elemen
 {
 	return integrateAndAdd(oCtx, parseEventTileAnimator(oCtx, p0Element), p0Element);
 }
+void XmlTileAnimatorEventParser::recycleEvents(std::unique_ptr<Event>& refEvent)
+{
+	m_oRecycler.recycle(refEvent);
+}
 
 unique_ptr<Event> XmlTileAnimatorEventParser::parseEventTileAnimator(GameCtx& oCtx, const xmlpp::Element* p0Element)
 {
@@ -164,7 +168,7 @@ unique_ptr<Event> XmlTileAnimatorEventParser::parseEventTileAnimator(GameCtx& oC
 
 	oCtx.removeChecker(p0Element, false, true);
 
-	return std::make_unique<TileAnimatorEvent>(std::move(oInit));
+	return m_oRecycler.create(std::move(oInit));
 }
 unique_ptr<TileSelector> XmlTileAnimatorEventParser::parseEventTileAnimatorSelect(GameCtx& oCtx, const xmlpp::Element* p0Element)
 {
@@ -54,6 +54,10 @@ Event* XmlVariableEventParser::parseEvent(GameCtx& oCtx, const xmlpp::Element* p
 {
 	return integrateAndAdd(oCtx, parseEventVariable(oCtx, p0Element), p0Element);
 }
+void XmlVariableEventParser::recycleEvents(std::unique_ptr<Event>& refEvent)
+{
+	m_oRecycler.recycle(refEvent);
+}
 unique_ptr<Event> XmlVariableEventParser::parseEventVariable(GameCtx& oCtx, const xmlpp::Element* p0Element)
 {
 //std::cout << "XmlVariableEventParser::parseEventVariable" << '\n';
@@ -96,7 +100,7 @@ unique_ptr<Event> XmlVariableEventParser::parseEventVariable(GameCtx& oCtx, cons
 															, false, -1, false, -1);
 	}
 	oCtx.removeChecker(p0Element, true);
-	auto refVariableEvent = std::make_unique<VariableEvent>(std::move(oVInit));
+	auto refVariableEvent = m_oRecycler.create(std::move(oVInit));
 	return refVariableEvent;
 }
 int32_t XmlVariableEventParser::parseEventMsgName(ConditionalCtx& oCtx, const xmlpp::Element* p0Element, const std::string& sAttr
@@ -0,0 +1,271 @@
+/*
+ * Copyright © 2019-2020  Stefano Marsili, <stemars@gmx.ch>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>
+ */
+/*
+ * File:   highscoresjournal.cc
+ */
+
+#include "highscoresjournal.h"
+
+#include "xmlutilfile.h"
+
+#include <iostream>
+#include <fstream>
+#include <cassert>
+#include <exception>
+#include <utility>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace stmg
+{
+
+namespace Private
+{
+// Removes a truncated last line (without newline) left by an interrupted append
+// so that the next entry isn't joined to it
+static bool truncateFragment(int nFD) noexcept
+{
+	const off_t nSize = ::lseek(nFD, 0, SEEK_END);
+	if (nSize < 0) {
+		return false; //--------------------------------------------------------
+	}
+	char aBuf[256];
+	off_t nEnd = nSize;
+	while (nEnd > 0) {
+		const off_t nStart = ((nEnd > static_cast<off_t>(sizeof(aBuf))) ? nEnd - static_cast<off_t>(sizeof(aBuf)) : 0);
+		const auto nToRead = static_cast<size_t>(nEnd - nStart);
+		const auto nRead = ::pread(nFD, aBuf, nToRead, nStart);
+		if (nRead < 0) {
+			if (errno == EINTR) {
+				continue; // while ------
+			}
+			return false; //----------------------------------------------------
+		}
+		if (static_cast<size_t>(nRead) != nToRead) {
+			return false; //----------------------------------------------------
+		}
+		for (auto nIdx = nToRead; nIdx > 0; --nIdx) {
+			if (aBuf[nIdx - 1] == '\n') {
+				const off_t nNewSize = nStart + static_cast<off_t>(nIdx);
+				return (nNewSize == nSize) || (::ftruncate(nFD, nNewSize) == 0); //-
+			}
+		}
+		nEnd = nStart;
+	}
+	// no complete line
+	return (nSize == 0) || (::ftruncate(nFD, 0) == 0);
+}
+} // namespace Private
+
+HighscoresJournal::HighscoresJournal() noexcept
+: m_bBusy(false)
+, m_bTerminate(false)
+{
+}
+HighscoresJournal::~HighscoresJournal() noexcept
+{
+	{
+		std::lock_guard<std::mutex> oLock(m_oMutex);
+		m_bTerminate = true;
+	}
+	m_oJobsChanged.notify_all();
+	if (m_oWorker.joinable()) {
+		m_oWorker.join();
+	}
+}
+void HighscoresJournal::append(const std::string& sJournalPath, std::string&& sLine) noexcept
+{
+	assert(! sJournalPath.empty());
+	assert((! sLine.empty()) && (sLine.back() == '\n'));
+	post(Job{"", sJournalPath, std::move(sLine), {}, {}});
+}
+void HighscoresJournal::compact(const std::string& sPath, const std::string& sJournalPath
+								, std::function<std::string()>&& oSerializer) noexcept
+{
+	assert(! sPath.empty());
+	assert(! sJournalPath.empty());
+	assert(oSerializer);
+	post(Job{sPath, sJournalPath, "", std::move(oSerializer), {}});
+}
+void HighscoresJournal::execute(std::function<void()>&& oTask) noexcept
+{
+	assert(oTask);
+	post(Job{"", "", "", {}, std::move(oTask)});
+}
+void HighscoresJournal::flush() noexcept
+{
+	std::unique_lock<std::mutex> oLock(m_oMutex);
+	m_oJobsChanged.wait(oLock, [&]()
+	{
+		return m_aJobs.empty() && !m_bBusy;
+	});
+}
+bool HighscoresJournal::isIdle() noexcept
+{
+	std::lock_guard<std::mutex> oLock(m_oMutex);
+	return m_aJobs.empty() && !m_bBusy;
+}
+void HighscoresJournal::post(Job&& oJob) noexcept
+{
+	{
+		std::lock_guard<std::mutex> oLock(m_oMutex);
+		m_aJobs.push_back(std::move(oJob));
+		if (! m_oWorker.joinable()) {
+			m_oWorker = std::thread(&HighscoresJournal::run, this);
+		}
+	}
+	m_oJobsChanged.notify_all();
+}
+void HighscoresJournal::run() noexcept
+{
+	std::unique_lock<std::mutex> oLock(m_oMutex);
+	do {
+		m_oJobsChanged.wait(oLock, [&]()
+		{
+			return m_bTerminate || !m_aJobs.empty();
+		});
+		if (m_aJobs.empty()) {
+			// terminate only when all jobs are done
+			break; // do ------
+		}
+		Job oJob = std::move(m_aJobs.front());
+		m_aJobs.pop_front();
+		m_bBusy = true;
+		oLock.unlock();
+		if (oJob.m_oTask) {
+			oJob.m_oTask();
+		} else if (oJob.m_sPath.empty()) {
+			doAppend(oJob);
+		} else {
+			doCompact(oJob);
+		}
+		oLock.lock();
+		m_bBusy = false;
+		m_oJobsChanged.notify_all();
+	} while (true);
+}
+void HighscoresJournal::doAppend(const Job& oJob) noexcept
+{
+	const int nFD = ::open(oJob.m_sJournalPath.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+	if (nFD < 0) {
+		std::cout << "Could not open highscores journal '" << oJob.m_sJournalPath << "'" << '\n';
+		return; //--------------------------------------------------------------
+	}
+	// A single write so that a crash can at most leave a truncated last line
+	// (without newline) which is ignored when the journal is loaded
+	// and removed before the next append
+	const bool bOk = Private::truncateFragment(nFD) && XmlUtilGame::writeAll(nFD, oJob.m_sLine) && (::fdatasync(nFD) == 0);
+	::close(nFD);
+	if (! bOk) {
+		std::cout << "Could not append to highscores journal '" << oJob.m_sJournalPath << "'" << '\n';
+	}
+}
+void HighscoresJournal::doCompact(const Job& oJob) noexcept
+{
+	std::string sContent;
+	try {
+		sContent = oJob.m_oSerializer();
+	} catch (const std::exception& ex) {
+		std::cout << "Exception caught";
+		std::cout << " compacting highscores '" << oJob.m_sPath << "'";
+		std::cout << ": " << ex.what() << '\n';
+		return; //--------------------------------------------------------------
+	}
+	if (! XmlUtilGame::writeFileAtomically(oJob.m_sPath, sContent)) {
+		std::cout << "Could not write highscores file '" << oJob.m_sPath << "'" << '\n';
+		return; //--------------------------------------------------------------
+	}
+	// The main file now contains all the journal's entries
+	::unlink(oJob.m_sJournalPath.c_str());
+}
+
+int32_t HighscoresJournal::replay(const std::string& sJournalPath
+								, const std::function<void(std::vector<std::string>&& aFields)>& oApplyEntry) noexcept
+{
+	assert(! sJournalPath.empty());
+	assert(oApplyEntry);
+	std::ifstream oJournal(sJournalPath);
+	if (! oJournal.is_open()) {
+		// no journal
+		return 0; //------------------------------------------------------------
+	}
+	int32_t nEntries = 0;
+	std::string sLine;
+	while (std::getline(oJournal, sLine)) {
+		if (oJournal.eof()) {
+			// The last line has no newline: it was interrupted while being written
+			break; // while ------
+		}
+		++nEntries;
+		oApplyEntry(splitLine(sLine));
+	}
+	return nEntries;
+}
+std::vector<std::string> HighscoresJournal::splitLine(const std::string& sLine) noexcept
+{
+	std::vector<std::string> aFields;
+	std::string sField;
+	bool bEscape = false;
+	for (const char c : sLine) {
+		if (bEscape) {
+			bEscape = false;
+			switch (c) {
+			case 't': sField.push_back('\t'); break;
+			case 'n': sField.push_back('\n'); break;
+			case 'r': sField.push_back('\r'); break;
+			default: sField.push_back(c); break;
+			}
+		} else if (c == '\\') {
+			bEscape = true;
+		} else if (c == '\t') {
+			aFields.push_back(std::move(sField));
+			sField.clear();
+		} else {
+			sField.push_back(c);
+		}
+	}
+	aFields.push_back(std::move(sField));
+	return aFields;
+}
+std::string HighscoresJournal::joinLine(const std::vector<std::string>& aFields) noexcept
+{
+	assert(! aFields.empty());
+	std::string sLine;
+	bool bFirst = true;
+	for (const auto& sField : aFields) {
+		if (bFirst) {
+			bFirst = false;
+		} else {
+			sLine.push_back('\t');
+		}
+		for (const char c : sField) {
+			switch (c) {
+			case '\t': sLine.append("\\t"); break;
+			case '\n': sLine.append("\\n"); break;
+			case '\r': sLine.append("\\r"); break;
+			case '\\': sLine.append("\\\\"); break;
+			default: sLine.push_back(c); break;
+			}
+		}
+	}
+	sLine.push_back('\n');
+	return sLine;
+}
+
+} // namespace stmg
@@ -0,0 +1,134 @@
+/*
+ * Copyright © 2019-2020  Stefano Marsili, <stemars@gmx.ch>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>
+ */
+/*
+ * File:   highscoresjournal.h
+ */
+
+#ifndef STMG_HIGHSCORES_JOURNAL_H
+#define STMG_HIGHSCORES_JOURNAL_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include <stdint.h>
+
+namespace stmg
+{
+
+/** Background writer for highscores files.
+ * Jobs are executed in a worker thread in the order they were posted.
+ * The worker thread is only started when the first job is posted.
+ *
+ * A journal is a text file to which lines are appended. A compaction replaces
+ * the main file atomically (write to a temporary file and rename) and then
+ * removes the journal. If the process crashes between the two steps the journal
+ * is just replayed once too many when loading, which must be harmless.
+ */
+class HighscoresJournal
+{
+public:
+	HighscoresJournal() noexcept;
+	/** Destructor.
+	 * Waits for all pending jobs to complete.
+	 */
+	~HighscoresJournal() noexcept;
+
+	/** Post an append job.
+	 * @param sJournalPath The journal file path. Cannot be empty.
+	 * @param sLine The line to append. Must end with a newline.
+	 */
+	void append(const std::string& sJournalPath, std::string&& sLine) noexcept;
+	/** Post a compaction job.
+	 * The serializer is called in the worker thread and must therefore only work
+	 * on copies of the data.
+	 * @param sPath The main file path. Cannot be empty.
+	 * @param sJournalPath The journal file path to remove once the main file is written. Cannot be empty.
+	 * @param oSerializer Returns the new content of the main file. Cannot be null.
+	 *                    Can throw, in which case the main file and the journal are left untouched.
+	 */
+	void compact(const std::string& sPath, const std::string& sJournalPath
+				, std::function<std::string()>&& oSerializer) noexcept;
+	/** Post a generic job.
+	 * Can be used to read files in the worker thread after the preceding
+	 * writes have completed.
+	 * @param oTask The task. Cannot be null. Must not throw.
+	 */
+	void execute(std::function<void()>&& oTask) noexcept;
+	/** Wait for all pending jobs to complete.
+	 */
+	void flush() noexcept;
+	/** Whether there are no pending jobs.
+	 * @return Whether idle.
+	 */
+	bool isIdle() noexcept;
+
+	/** Replay a journal file.
+	 * The complete lines are passed to the callback in the order they were appended.
+	 * A last line without newline was interrupted while being appended and is ignored.
+	 *
+	 * Doesn't wait for pending jobs: either call flush() first or call it
+	 * from a job posted with execute().
+	 * @param sJournalPath The journal file path. Cannot be empty.
+	 * @param oApplyEntry Called with the unescaped fields of each line. Cannot be null. Must not throw.
+	 * @return The number of complete lines, 0 if the journal doesn't exist.
+	 */
+	static int32_t replay(const std::string& sJournalPath
+						, const std::function<void(std::vector<std::string>&& aFields)>& oApplyEntry) noexcept;
+	/** Split a journal line in its fields.
+	 * @param sLine The line without the terminating newline.
+	 * @return The unescaped fields.
+	 */
+	static std::vector<std::string> splitLine(const std::string& sLine) noexcept;
+	/** Join fields into a journal line.
+	 * Fields are escaped and separated by tabs.
+	 * @param aFields The fields. Can contain any character. Cannot be empty.
+	 * @return The line including the terminating newline.
+	 */
+	static std::string joinLine(const std::vector<std::string>& aFields) noexcept;
+private:
+	struct Job
+	{
+		std::string m_sPath; // empty if append job
+		std::string m_sJournalPath;
+		std::string m_sLine;
+		std::function<std::string()> m_oSerializer;
+		std::function<void()> m_oTask; // non null if generic job
+	};
+	void post(Job&& oJob) noexcept;
+	void run() noexcept;
+	void doAppend(const Job& oJob) noexcept;
+	void doCompact(const Job& oJob) noexcept;
+private:
+	std::mutex m_oMutex;
+	std::condition_variable m_oJobsChanged;
+	std::deque<Job> m_aJobs; // Protected by m_oMutex
+	bool m_bBusy; // Protected by m_oMutex
+	bool m_bTerminate; // Protected by m_oMutex
+	std::thread m_oWorker;
+private:
+	HighscoresJournal(const HighscoresJournal& oSource) = delete;
+	HighscoresJournal& operator=(const HighscoresJournal& oSource) = delete;
+};
+
+} // namespace stmg
+
+#endif	/* STMG_HIGHSCORES_JOURNAL_H */
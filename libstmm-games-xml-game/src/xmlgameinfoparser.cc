@@ -67,6 +67,7 @@ static const std::string s_sGameTestingAttr = "testing";
 static const std::string s_sGameMinGameIntervalAttr = "minInterval";
 static const std::string s_sGameInitialGameIntervalAttr = "initialInterval";
 static const std::string s_sGameMaxViewTicksAttr = "maxViewTicks";
+static const std::string s_sGameLowLatencyInputAttr = "lowLatencyInput";
 static const std::string s_sGameAdditionalHighscoresWaitAttr = "additionalHighscoresWait";
 static const std::string s_sGameSoundScaleXAttr = "soundScaleX";
 static const std::string s_sGameSoundScaleYAttr = "soundScaleY";
@@ -277,6 +278,11 @@ const GameLoader::GameInfo& XmlGameInfoParser::parseGameInfo(GameInfoCtx& oCtx,
 		oCtx.m_nMaxViewTicks = XmlUtil::strToNumber<int32_t>(oCtx, p0RootElement, s_sGameMaxViewTicksAttr, sMaxViewTicks
 															, false, true, 1, false, -1.0);
 	}
+	oCtx.m_bLowLatencyInput = false;
+	const auto oPairLowLatencyInput = XmlCommonParser::getAttributeValue(oCtx, p0RootElement, s_sGameLowLatencyInputAttr);
+	if (oPairLowLatencyInput.first) {
+		oCtx.m_bLowLatencyInput = XmlUtil::strToBool(oCtx, p0RootElement, s_sGameLowLatencyInputAttr, oPairLowLatencyInput.second);
+	}
 	oCtx.m_nAdditionalHighscoresWait = -1;
 	const auto oPairAdditionalHighscoresWait = XmlCommonParser::getAttributeValue(oCtx, p0RootElement, s_sGameAdditionalHighscoresWaitAttr);
 	if (oPairAdditionalHighscoresWait.first) {
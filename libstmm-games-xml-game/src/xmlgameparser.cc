@@ -124,6 +124,7 @@ XmlGameParser::XmlGameParser()
 , m_oXmlLayoutParser(m_oXmlTraitsParser, m_oXmlImageParser)
 , m_oXmlGameInitParser(m_oXmlGameInfoParser, m_oXmlLayoutParser)
 , m_oXmlBlockParser(m_oXmlTraitsParser)
+, m_p0CurGamePool(nullptr)
 {
 	m_oXmlLayoutParser.m_p0XmlGameParser = this;
 }
@@ -229,6 +230,7 @@ std::tuple<shared_ptr<Game>, bool, GameLoader::GameInfo> XmlGameParser::parseGam
 	if (nMaxViewTicks > 0) {
 		oGameInit.m_nMaxViewTicks = nMaxViewTicks;
 	}
+	oGameInit.m_bLowLatencyInput = oCtx.getLowLatencyInput();
 	const int32_t nAdditionalHighscoresWait = oCtx.getAdditionalHighscoresWait();
 	if (nAdditionalHighscoresWait >= 0) {
 		oGameInit.m_nAdditionalHighscoresWait = nAdditionalHighscoresWait;
@@ -257,7 +259,10 @@ std::tuple<shared_ptr<Game>, bool, GameLoader::GameInfo> XmlGameParser::parseGam
 	oGameInit.m_refHighscoresDefinition = oNewGameInfo.m_refHighscoresDefinition;
 //std::cout << "XmlGameParser::parseGame --->Highscore adr: " << reinterpret_cast<int64_t>(refHighscore.get()) << '\n';
 //std::cout << "XmlGameParser::parseGame --->HighscoreDefinition adr: " << reinterpret_cast<int64_t>(oGameInit.m_refHighscoresDefinition.get()) << '\n';
-	auto refGame = std::make_shared<Game>(std::move(oGameInit), *this, oLevelInit);
+	shared_ptr<Game> refGame;
+	m_p0CurGamePool = &(m_oGamePools[oGameInit.m_sName]);
+	m_p0CurGamePool->m_oGames.create(refGame, std::move(oGameInit), *this, oLevelInit);
+	m_p0CurGamePool = nullptr;
 
 	GameCtx oGameCtx(oCtx.appPreferences(), oFile, *refGame, oCtx.getGameConstraints());
 	oGameCtx.addChecker(p0RootElement);
@@ -280,8 +285,29 @@ shared_ptr<Level> XmlGameParser::createLevel(Game* p0Game, int32_t nLevel
 											, const shared_ptr<AppPreferences>& refPreferences
 											, const Level::Init& oInit) noexcept
 {
-	//TODO recycling
-	return std::make_shared<Level>(p0Game, nLevel, refPreferences, oInit);
+	assert(m_p0CurGamePool != nullptr);
+	auto& aLevels = m_p0CurGamePool->m_aLevels;
+	for (auto& refLevel : aLevels) {
+		if (refLevel.use_count() == 1) {
+			recycleLevelEvents(*refLevel);
+			refLevel->reInit(p0Game, nLevel, refPreferences, oInit);
+			return refLevel; //-------------------------------------------------
+		}
+	}
+	aLevels.push_back(std::make_shared<PrivateLevel>(p0Game, nLevel, refPreferences, oInit));
+	return aLevels.back();
+}
+void XmlGameParser::recycleLevelEvents(PrivateLevel& oLevel) noexcept
+{
+	auto aEvents = oLevel.extractAllEvents();
+	for (auto& refEvent : aEvents) {
+		for (auto& refXmlEventParser : m_aXmlEventParsers) {
+			refXmlEventParser->recycleEvents(refEvent);
+			if (!refEvent) {
+				break; // for refXmlEventParser
+			}
+		}
+	}
 }
 bool XmlGameParser::getBlock(GameCtx& oCtx, const std::string& sName, Block& oBlock)
 {
@@ -36,6 +36,7 @@
 #include <stmm-games/event.h>
 #include <stmm-games/level.h>
 #include <stmm-games/game.h>
+#include <stmm-games/util/recycler.h>
 
 #include <vector>
 #include <map>
@@ -127,6 +128,9 @@ private:
 	shared_ptr<Level> createLevel(Game* p0Game, int32_t nLevel
 								, const shared_ptr<AppPreferences>& refPreferences
 								, const Level::Init& oInit) noexcept override;
+	class PrivateLevel;
+	// Hands the events of a retired level to the event parsers
+	void recycleLevelEvents(PrivateLevel& oLevel) noexcept;
 private:
 	// attributes used by more than one event type
 	int32_t parseEventAttrRepeat(GameCtx& oCtx, const xmlpp::Element* p0EventElement);
@@ -185,6 +189,29 @@ private:
 	XmlLayoutParser m_oXmlLayoutParser;
 	XmlGameInitParser m_oXmlGameInitParser;
 	XmlBlockParser m_oXmlBlockParser;
+
+	// The instances of the games with the same name, reinitialized
+	// when no longer used so that restarting a game doesn't reallocate them
+	class PrivateLevel : public Level
+	{
+	public:
+		using Level::Level;
+		void reInit(Game* p0Game, int32_t nLevel, const shared_ptr<AppPreferences>& refPreferences, const Init& oInit) noexcept
+		{
+			Level::reInit(p0Game, nLevel, refPreferences, oInit);
+		}
+		std::vector< unique_ptr<Event> > extractAllEvents() noexcept
+		{
+			return Level::extractAllEvents();
+		}
+	};
+	struct GamePool
+	{
+		Recycler<Game> m_oGames;
+		std::vector< shared_ptr<PrivateLevel> > m_aLevels;
+	};
+	std::map<std::string, GamePool> m_oGamePools; // Key: game name
+	GamePool* m_p0CurGamePool; // Set while the game is created
 private:
 	XmlGameParser(const XmlGameParser& oSource) = delete;
 	XmlGameParser& operator=(const XmlGameParser& oSource) = delete;
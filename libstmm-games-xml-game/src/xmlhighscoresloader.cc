@@ -22,6 +22,7 @@
 
 #include "xmlutilfile.h"
 #include "xmlgamefiles.h"
+#include "highscoresjournal.h"
 
 #include <stmm-games-file/file.h>
 
@@ -43,6 +44,9 @@
 #include <list>
 #include <stdexcept>
 #include <utility>
+#include <mutex>
+
+#include <sys/stat.h>
 
 namespace stmg
 {
@@ -83,14 +87,31 @@ static const std::string s_sHighscoresScoreValueNodeName = "Value";
 static const std::string s_sHighscoresScoreValueValueAttr = "value";
 static const std::string s_sHighscoresScoreValueFormatAttr = "format";
 
+// The journal has one line per updated Highscore:
+//   HS <code> <title> { <team> { <value> <format> } }
+// where fields are separated by tabs and the number of values of a score
+// is given by the HighscoresDefinition
+static const std::string s_sJournalFileExt = ".journal";
+static const std::string s_sJournalHighscoresTag = "HS";
+// After this number of journal entries the highscores file is rewritten
+static constexpr const int32_t s_nMaxJournalEntries = 16;
+
 XmlHighscoresLoader::XmlHighscoresLoader(const shared_ptr<AppConfig>& refAppConfig
 										, const shared_ptr<XmlGameFiles>& refXmlGameFiles)
 : m_refAppConfig(refAppConfig)
 , m_refXmlGameFiles(refXmlGameFiles)
+, m_refHighscoresJournal(std::make_unique<HighscoresJournal>())
 {
 	assert(refAppConfig);
 	assert(refXmlGameFiles);
 }
+XmlHighscoresLoader::~XmlHighscoresLoader()
+{
+}
+void XmlHighscoresLoader::flush() noexcept
+{
+	m_refHighscoresJournal->flush();
+}
 shared_ptr<Highscore> XmlHighscoresLoader::getHighscore(const std::string& sGameName, const AppPreferences& oPreferences
 														, const shared_ptr<HighscoresDefinition>& refHighscoresDefinition) const noexcept
 {
@@ -108,10 +129,14 @@ shared_ptr<Highscore> XmlHighscoresLoader::getHighscore(const std::string& sGame
 		return shared_ptr<Highscore>{}; //--------------------------------------
 	}
 
-	auto aHSs = parseGameHighscores(refHighscoresDefinition, oHSFile, sGameName
-									, false, oPairCode.second, oPairTitle.second);
-	assert(aHSs.size() == 1);
-	return std::move(aHSs[0]);
+	const GameHighscores& oGameHighscores = getGameHighscores(refHighscoresDefinition, oHSFile, sGameName, false);
+	const int32_t nIdx = findHighscoreWithCode(oGameHighscores.m_aHighscores, oPairCode.second);
+	if (nIdx < 0) {
+		// create new highscores
+		return std::make_shared<Highscore>(refHighscoresDefinition, oPairCode.second, oPairTitle.second); //--
+	}
+	// The caller might modify it, return a copy
+	return std::make_shared<Highscore>(*oGameHighscores.m_aHighscores[nIdx]);
 }
 std::vector<shared_ptr<Highscore>> XmlHighscoresLoader::getHighscores(const std::string& sGameName
 																	, const shared_ptr<HighscoresDefinition>& refHighscoresDefinition) const noexcept
@@ -121,7 +146,187 @@ std::vector<shared_ptr<Highscore>> XmlHighscoresLoader::getHighscores(const std:
 	if ((!oHSFile.isDefined()) || oHSFile.isBuffered()) {
 		return std::vector<shared_ptr<Highscore>>{}; //--------------------------------------
 	}
-	return parseGameHighscores(refHighscoresDefinition, oHSFile, sGameName, true, "", "");
+	const GameHighscores& oGameHighscores = getGameHighscores(refHighscoresDefinition, oHSFile, sGameName, false);
+	std::vector<shared_ptr<Highscore>> aHighscores;
+	aHighscores.reserve(oGameHighscores.m_aHighscores.size());
+	for (const auto& refHighscore : oGameHighscores.m_aHighscores) {
+		aHighscores.push_back(std::make_shared<Highscore>(*refHighscore));
+	}
+	return aHighscores;
+}
+XmlHighscoresLoader::GameHighscores& XmlHighscoresLoader::getGameHighscores(
+											const shared_ptr<HighscoresDefinition>& refHighscoresDefinition
+											, const File& oHSFile, const std::string& sGameName, bool bWaitReload) const
+{
+	auto itFind = m_oGameHighscores.find(sGameName);
+	if (itFind != m_oGameHighscores.end()) {
+		GameHighscores& oGameHighscores = itFind->second;
+		checkGameHighscores(refHighscoresDefinition, oHSFile, sGameName, bWaitReload, oGameHighscores);
+		return oGameHighscores; //----------------------------------------------
+	}
+	// The game's highscores are loaded the first time they're needed
+	GameHighscores& oGameHighscores = m_oGameHighscores[sGameName];
+	// Taken before parsing so that changes made meanwhile are detected later
+	oGameHighscores.m_oStamp = getFileStamp(oHSFile);
+	oGameHighscores.m_aHighscores = parseGameHighscores(refHighscoresDefinition, oHSFile, sGameName, true, "", "");
+	oGameHighscores.m_nJournalEntries = loadJournal(refHighscoresDefinition, getJournalPath(oHSFile)
+													, oGameHighscores.m_aHighscores);
+	return oGameHighscores;
+}
+void XmlHighscoresLoader::checkGameHighscores(const shared_ptr<HighscoresDefinition>& refHighscoresDefinition
+											, const File& oHSFile, const std::string& sGameName, bool bWaitReload
+											, GameHighscores& oGameHighscores) const
+{
+	if (oGameHighscores.m_refReload) {
+		if (bWaitReload) {
+			m_refHighscoresJournal->flush();
+		}
+		Reload& oReload = *oGameHighscores.m_refReload;
+		{
+			std::lock_guard<std::mutex> oLock(oReload.m_oMutex);
+			if (! oReload.m_bDone) {
+				// Keep using the highscores in memory until the new ones are parsed
+				return; //------------------------------------------------------
+			}
+			oGameHighscores.m_aHighscores = std::move(oReload.m_aHighscores);
+			oGameHighscores.m_nJournalEntries = oReload.m_nJournalEntries;
+			oGameHighscores.m_oStamp = oReload.m_oStamp;
+		}
+		oGameHighscores.m_refReload.reset();
+		return; //--------------------------------------------------------------
+	}
+	if (! m_refHighscoresJournal->isIdle()) {
+		// Own writes pending: the files might be in an intermediate state
+		return; //--------------------------------------------------------------
+	}
+	const FileStamp oStamp = getFileStamp(oHSFile);
+	if (oStamp == oGameHighscores.m_oStamp) {
+		return; //--------------------------------------------------------------
+	}
+	if (oGameHighscores.m_refOwnWrites) {
+		bool bOwnStamp;
+		{
+			std::lock_guard<std::mutex> oLock(oGameHighscores.m_refOwnWrites->m_oMutex);
+			bOwnStamp = (oStamp == oGameHighscores.m_refOwnWrites->m_oStamp);
+		}
+		oGameHighscores.m_refOwnWrites.reset();
+		if (bOwnStamp) {
+			// The files are as this instance last wrote them
+			oGameHighscores.m_oStamp = oStamp;
+			return; //----------------------------------------------------------
+		}
+	}
+	// Changed by someone else: parse again in the background
+	auto refReload = std::make_shared<Reload>();
+	oGameHighscores.m_refReload = refReload;
+	// The journal's destructor waits for the task, which therefore can't outlive this
+	m_refHighscoresJournal->execute([this, refReload, refHighscoresDefinition, oHSFile, sGameName]()
+	{
+		const FileStamp oNewStamp = getFileStamp(oHSFile);
+		auto aHighscores = parseGameHighscores(refHighscoresDefinition, oHSFile, sGameName, true, "", "");
+		const int32_t nJournalEntries = loadJournal(refHighscoresDefinition, getJournalPath(oHSFile), aHighscores);
+		std::lock_guard<std::mutex> oLock(refReload->m_oMutex);
+		refReload->m_aHighscores = std::move(aHighscores);
+		refReload->m_nJournalEntries = nJournalEntries;
+		refReload->m_oStamp = oNewStamp;
+		refReload->m_bDone = true;
+	});
+	if (bWaitReload) {
+		checkGameHighscores(refHighscoresDefinition, oHSFile, sGameName, true, oGameHighscores);
+	}
+}
+XmlHighscoresLoader::FileStamp XmlHighscoresLoader::getFileStamp(const File& oHSFile)
+{
+	FileStamp oStamp;
+	struct stat oStat;
+	if (::stat(oHSFile.getFullPath().c_str(), &oStat) == 0) {
+		oStamp.m_nFileMTimeNsec = static_cast<int64_t>(oStat.st_mtim.tv_sec) * 1000000000 + oStat.st_mtim.tv_nsec;
+		oStamp.m_nFileSize = oStat.st_size;
+	}
+	if (::stat(getJournalPath(oHSFile).c_str(), &oStat) == 0) {
+		oStamp.m_nJournalMTimeNsec = static_cast<int64_t>(oStat.st_mtim.tv_sec) * 1000000000 + oStat.st_mtim.tv_nsec;
+		oStamp.m_nJournalSize = oStat.st_size;
+	}
+	return oStamp;
+}
+std::string XmlHighscoresLoader::getJournalPath(const File& oHSFile)
+{
+	return oHSFile.getFullPath() + s_sJournalFileExt;
+}
+int32_t XmlHighscoresLoader::loadJournal(const shared_ptr<HighscoresDefinition>& refHighscoresDefinition
+										, const std::string& sJournalPath, std::vector<shared_ptr<Highscore>>& aHighscores) const
+{
+	return HighscoresJournal::replay(sJournalPath, [&](std::vector<std::string>&& aFields)
+	{
+		auto refHighscore = parseJournalHighscores(refHighscoresDefinition, aFields);
+		if (! refHighscore) {
+			std::cout << "Invalid entry in highscores journal '" << sJournalPath << "'" << '\n';
+			return; //----------------------------------------------------------
+		}
+		// Later entries override both the file and earlier entries
+		const int32_t nIdx = findHighscoreWithCode(aHighscores, refHighscore->getCodeString());
+		if (nIdx < 0) {
+			aHighscores.push_back(std::move(refHighscore));
+		} else {
+			aHighscores[nIdx] = std::move(refHighscore);
+		}
+	});
+}
+shared_ptr<Highscore> XmlHighscoresLoader::parseJournalHighscores(const shared_ptr<HighscoresDefinition>& refHighscoresDefinition
+																, const std::vector<std::string>& aFields) const
+{
+	if ((aFields.size() < 3) || (aFields[0] != s_sJournalHighscoresTag)) {
+		return {}; //-----------------------------------------------------------
+	}
+	const std::string& sCode = aFields[1];
+	if (! refHighscoresDefinition->isValidCode(sCode)) {
+		return {}; //-----------------------------------------------------------
+	}
+	const std::string& sTitle = aFields[2];
+	const int32_t nTotScoreValues = static_cast<int32_t>(refHighscoresDefinition->getScoreElements().size());
+	const int32_t nScoreFields = 1 + 2 * nTotScoreValues;
+	const int32_t nTotFields = static_cast<int32_t>(aFields.size());
+	if (((nTotFields - 3) % nScoreFields) != 0) {
+		return {}; //-----------------------------------------------------------
+	}
+	std::vector<Highscore::Score> aScores;
+	for (int32_t nField = 3; nField < nTotFields; nField += nScoreFields) {
+		Highscore::Score oScore;
+		oScore.m_sTeam = aFields[nField];
+		if (oScore.m_sTeam.empty()) {
+			return {}; //-------------------------------------------------------
+		}
+		for (int32_t nValueField = nField + 1; nValueField < nField + nScoreFields; nValueField += 2) {
+			const auto oPairValue = Util::strToNumber<int32_t>(aFields[nValueField], false, false, -1, false, -1);
+			const auto oPairFormat = Util::strToNumber<int32_t>(aFields[nValueField + 1], false, false, -1, false, -1);
+			if ((! oPairValue.second.empty()) || (! oPairFormat.second.empty())) {
+				return {}; //---------------------------------------------------
+			}
+			auto eFormat = static_cast<Variable::VARIABLE_FORMAT>(oPairFormat.first);
+			oScore.m_aValues.push_back(Variable::Value::create(oPairValue.first, eFormat));
+		}
+		if (static_cast<int32_t>(aScores.size()) < refHighscoresDefinition->getMaxScores()) {
+			aScores.push_back(std::move(oScore));
+		}
+	}
+	return std::make_shared<Highscore>(refHighscoresDefinition, sCode, sTitle, aScores);
+}
+std::string XmlHighscoresLoader::createJournalLine(const Highscore& oHighscore)
+{
+	std::vector<std::string> aFields;
+	aFields.push_back(s_sJournalHighscoresTag);
+	aFields.push_back(oHighscore.getCodeString());
+	aFields.push_back(oHighscore.getTitleString());
+	const int32_t nTotScores = oHighscore.getTotScores();
+	for (int32_t nPos = 0; nPos < nTotScores; ++nPos) {
+		const Highscore::Score& oScore = oHighscore.getScore(nPos);
+		aFields.push_back(oScore.m_sTeam);
+		for (const auto& oValue : oScore.m_aValues) {
+			aFields.push_back(std::to_string(oValue.get()));
+			aFields.push_back(std::to_string(static_cast<int32_t>(oValue.getFormat())));
+		}
+	}
+	return HighscoresJournal::joinLine(aFields);
 }
 std::vector<shared_ptr<Highscore>> XmlHighscoresLoader::parseGameHighscores(
 											const shared_ptr<HighscoresDefinition>& refHighscoresDefinition
@@ -301,7 +506,7 @@ Highscore::Score XmlHighscoresLoader::parseScore(const shared_ptr<HighscoresDefi
 	}
 	return oScore;
 }
-bool XmlHighscoresLoader::updateHighscore(const std::string& sGameName, const AppPreferences& oPreferences
+bool XmlHighscoresLoader::updateHighscore(const std::string& sGameName, const AppPreferences& /*oPreferences*/
 										, const Highscore& oHighscore) noexcept
 {
 //std::cout << "XmlHighscoresLoader::updateHighscore sGameName=" << sGameName << '\n';
@@ -310,39 +515,65 @@ bool XmlHighscoresLoader::updateHighscore(const std::string& sGameName, const Ap
 	if ((!oHSFile.isDefined()) || oHSFile.isBuffered()) {
 		return false; //--------------------------------------------------------
 	}
-	auto aHighscores = parseGameHighscores(refHighscoresDefinition, oHSFile, sGameName, true, "", "");
+	// Changes made by others must not be lost, wait for them to be loaded
+	GameHighscores& oGameHighscores = getGameHighscores(refHighscoresDefinition, oHSFile, sGameName, true);
+	auto& aHighscores = oGameHighscores.m_aHighscores;
 //std::cout << "XmlHighscoresLoader::updateHighscore old aHighscores.size()=" << aHighscores.size() << '\n';
 
-	const auto& sCode = oHighscore.getCodeString();
-	const int32_t nIdx = findHighscoreWithCode(aHighscores, sCode);
+	// The stored instances are never modified (only replaced) so that they
+	// can be safely shared with the compaction job
+	auto refNewHighscore = std::make_shared<Highscore>(oHighscore);
+	const int32_t nIdx = findHighscoreWithCode(aHighscores, oHighscore.getCodeString());
 	if (nIdx >= 0) {
-		// erase the old highscores for the sCode
-		aHighscores.erase(aHighscores.begin() + nIdx);
-	}
-	// Recreate the whole document
-	xmlpp::DomParser oParser;
-	xmlpp::Document* p0Document = oParser.get_document();
-	if (p0Document == nullptr) {
-		return false; //--------------------------------------------------------
-	}
-	xmlpp::Element* p0RootElement = p0Document->create_root_node(s_sGameHighscoresNodeName);
-	p0RootElement->set_attribute(s_sGameHighscoresAppNameAttr, oPreferences.getAppConfig()->getAppName());
-	p0RootElement->set_attribute(s_sGameHighscoresGameNameAttr, sGameName);
-	for (const auto& refHighscore : aHighscores) {
-		writeHighscores(p0RootElement, *refHighscore);
+		aHighscores[nIdx] = std::move(refNewHighscore);
+	} else {
+		aHighscores.push_back(std::move(refNewHighscore));
 	}
-	writeHighscores(p0RootElement, oHighscore);
 
-//std::cout << "XmlHighscoresLoader::updateHighscore File=" << oHSFile.getFullPath() << '\n';
 	try {
 		XmlUtilGame::makePath(oHSFile);
-		p0Document->write_to_file_formatted(oHSFile.getFullPath());
-	} catch (const xmlpp::exception& ) {
+	} catch (const std::runtime_error& ) {
 		return false; //--------------------------------------------------------
 	}
-//std::cout << "XmlHighscoresLoader::updateHighscore File=" << oHSFile.getFullPath() << "  SUCCESS" << '\n';
+	const std::string sJournalPath = getJournalPath(oHSFile);
+	if (oGameHighscores.m_nJournalEntries < s_nMaxJournalEntries) {
+		m_refHighscoresJournal->append(sJournalPath, createJournalLine(oHighscore));
+		++oGameHighscores.m_nJournalEntries;
+	} else {
+		// Rewrite the whole file in the background
+		m_refHighscoresJournal->compact(oHSFile.getFullPath(), sJournalPath
+										, [sAppName = m_refAppConfig->getAppName(), sGameName, aHighscores]()
+										{
+											return createXmlGameHighscores(sAppName, sGameName, aHighscores);
+										});
+		oGameHighscores.m_nJournalEntries = 0;
+	}
+	if (! oGameHighscores.m_refOwnWrites) {
+		oGameHighscores.m_refOwnWrites = std::make_shared<OwnWrites>();
+	}
+	// Executed right after the write so that the files written by someone
+	// else later can be told apart from this instance's
+	m_refHighscoresJournal->execute([refOwnWrites = oGameHighscores.m_refOwnWrites, oHSFile]()
+	{
+		const FileStamp oStamp = getFileStamp(oHSFile);
+		std::lock_guard<std::mutex> oLock(refOwnWrites->m_oMutex);
+		refOwnWrites->m_oStamp = oStamp;
+	});
+//std::cout << "XmlHighscoresLoader::updateHighscore File=" << oHSFile.getFullPath() << "  QUEUED" << '\n';
 	return true;
 }
+std::string XmlHighscoresLoader::createXmlGameHighscores(const std::string& sAppName, const std::string& sGameName
+														, const std::vector<shared_ptr<Highscore>>& aHighscores)
+{
+	xmlpp::Document oDocument;
+	xmlpp::Element* p0RootElement = oDocument.create_root_node(s_sGameHighscoresNodeName);
+	p0RootElement->set_attribute(s_sGameHighscoresAppNameAttr, sAppName);
+	p0RootElement->set_attribute(s_sGameHighscoresGameNameAttr, sGameName);
+	for (const auto& refHighscore : aHighscores) {
+		writeHighscores(p0RootElement, *refHighscore);
+	}
+	return oDocument.write_to_string_formatted().raw();
+}
 void XmlHighscoresLoader::writeHighscores(xmlpp::Element* p0RootElement, const Highscore& oHighscore)
 {
 	xmlpp::Element* p0HighscoresElement = p0RootElement->add_child(s_sHighscoresNodeName);
@@ -21,8 +21,7 @@
 #include "xmlpreferencesloader.h"
 
 #include "xmlgamefiles.h"
-
-#include "xmlutilfile.h"
+#include "debouncedfilewriter.h"
 
 #include <stmm-games-file/allpreferences.h>
 #include <stmm-games-file/file.h>
@@ -119,16 +118,30 @@ static const std::string s_sPreferencesPlayedHistoryNodeName = "PlayedHistory";
 static const std::string s_sPreferencesPlayedHistoryGameNodeName = "Game";
 static const std::string s_sPreferencesPlayedHistoryGameNameAttr = "name";
 
+// Bursts of updates within this time are written once
+static constexpr const int32_t s_nPreferencesWriteDelayMillisec = 500;
+
 XmlPreferencesLoader::XmlPreferencesLoader(const shared_ptr<StdConfig>& refStdConfig
 										, const shared_ptr<XmlGameFiles>& refXmlGameFiles)
 : m_refStdConfig(refStdConfig)
 , m_refXmlGameFiles(refXmlGameFiles)
+, m_refPreferencesWriter(std::make_unique<DebouncedFileWriter>(s_nPreferencesWriteDelayMillisec))
 {
 	assert(refStdConfig);
 	assert(refXmlGameFiles);
 }
+XmlPreferencesLoader::~XmlPreferencesLoader() noexcept
+{
+}
+bool XmlPreferencesLoader::flush() noexcept
+{
+	m_refPreferencesWriter->flush();
+	return ! m_refPreferencesWriter->fetchWriteFailed();
+}
 shared_ptr<AllPreferences> XmlPreferencesLoader::getPreferences() const noexcept
 {
+	// Make sure the file is up to date
+	m_refPreferencesWriter->flush();
 	// Create default initialized instance
 	auto refAllPrefs = std::make_shared<AllPreferences>(m_refStdConfig);
 	refAllPrefs->setEditMode(true);
@@ -485,6 +498,8 @@ bool XmlPreferencesLoader::updatePreferences(const shared_ptr<AllPreferences>& r
 {
 	assert(refAllPreferences);
 	assert(refAllPreferences->getStdConfig() == m_refStdConfig);
+	// The previous (background) write is reported here
+	const bool bPreviousWriteFailed = m_refPreferencesWriter->fetchWriteFailed();
 	const File oPrefsFile = m_refXmlGameFiles->getPreferencesFile();
 	if ((!oPrefsFile.isDefined()) || oPrefsFile.isBuffered()) {
 		return false; //--------------------------------------------------------
@@ -504,14 +519,14 @@ bool XmlPreferencesLoader::updatePreferences(const shared_ptr<AllPreferences>& r
 	writeTeams(refAllPreferences, p0RootElement);
 	writePlayedHistory(refAllPreferences, p0RootElement);
 
-//std::cout << "XmlHighscoresLoader::updateHighscore File=" << oHSFile.getFullPath() << '\n';
+	std::string sContent;
 	try {
-		XmlUtilGame::makePath(oPrefsFile);
-		p0Document->write_to_file_formatted(oPrefsFile.getFullPath());
+		sContent = p0Document->write_to_string_formatted();
 	} catch (const xmlpp::exception& ) {
 		return false; //--------------------------------------------------------
 	}
-	return true;
+	m_refPreferencesWriter->post(oPrefsFile.getFullPath(), std::move(sContent));
+	return ! bPreviousWriteFailed;
 }
 void XmlPreferencesLoader::writeOptions(const shared_ptr<AllPreferences>& refAllPreferences, const OwnerType& eOwnerType
 										, const shared_ptr<StdPreferences::Team>& refTeam, const shared_ptr<StdPreferences::Player>& refMate
@@ -28,6 +28,9 @@
 #include <stdexcept>
 
 #include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdio.h>
 #include <sys/stat.h>
 
 namespace stmg
@@ -89,6 +92,40 @@ void makePath(const File& oFile)
 	makePath(sFile.substr(0, nPos));
 }
 
+bool writeAll(int nFD, const std::string& sData) noexcept
+{
+	const char* p0Data = sData.c_str();
+	std::string::size_type nToWrite = sData.size();
+	while (nToWrite > 0) {
+		const auto nWritten = ::write(nFD, p0Data, nToWrite);
+		if (nWritten < 0) {
+			if (errno == EINTR) {
+				continue; // while ------
+			}
+			return false; //----------------------------------------------------
+		}
+		p0Data += nWritten;
+		nToWrite -= static_cast<std::string::size_type>(nWritten);
+	}
+	return true;
+}
+
+bool writeFileAtomically(const std::string& sPath, const std::string& sContent) noexcept
+{
+	const std::string sTempPath = sPath + ".tmp";
+	const int nFD = ::open(sTempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (nFD < 0) {
+		return false; //--------------------------------------------------------
+	}
+	const bool bOk = writeAll(nFD, sContent) && (::fsync(nFD) == 0);
+	::close(nFD);
+	if ((! bOk) || (::rename(sTempPath.c_str(), sPath.c_str()) != 0)) {
+		::unlink(sTempPath.c_str());
+		return false; //--------------------------------------------------------
+	}
+	return true;
+}
+
 } // namespace XmlUtilGame
 
 } // namespace stmg
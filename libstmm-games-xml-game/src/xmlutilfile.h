@@ -40,6 +40,22 @@ void makePath(const std::string& sPath);
  * @param oFile The file. Must be defined and not buffered.
  */
 void makePath(const File& oFile);
+/** Write all the data to a file descriptor.
+ * Writes interrupted by a signal are resumed.
+ * @param nFD The file descriptor. Must be open for writing.
+ * @param sData The data.
+ * @return Whether all the data was written.
+ */
+bool writeAll(int nFD, const std::string& sData) noexcept;
+/** Replace the content of a file atomically.
+ * The content is written to a temporary file (the path with ".tmp" appended),
+ * synced to disk and then renamed to the path. On failure the temporary
+ * file is removed and the file is left untouched.
+ * @param sPath The file path. Its directory must exist.
+ * @param sContent The new content of the file.
+ * @return Whether the file was replaced.
+ */
+bool writeFileAtomically(const std::string& sPath, const std::string& sContent) noexcept;
 
 } // namespace XmlUtilGame
 
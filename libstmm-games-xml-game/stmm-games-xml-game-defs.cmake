@@ -40,6 +40,10 @@ set(STMM_GAMES_XML_GAME_REQ_STMM_GAMES_FILE_VERSION "${STMM_GAMES_XML_GAME_REQ_S
 #    endif()
 #    # Beware! The prefix passed to pkg_check_modules(PREFIX ...) shouldn't contain underscores!
 #endif()
+if ("${CMAKE_SCRIPT_MODE_FILE}" STREQUAL "")
+    # The highscores are written by a background thread
+    find_package(Threads REQUIRED)
+endif()
 
 include("${PROJECT_SOURCE_DIR}/../libstmm-games-file/stmm-games-file-defs.cmake")
 include("${PROJECT_SOURCE_DIR}/../libstmm-games-xml-base/stmm-games-xml-base-defs.cmake")
@@ -64,6 +68,7 @@ list(APPEND STMMGAMESXMLGAME_INCLUDE_SDIRS "${STMMGAMESXMLGAME_EXTRA_INCLUDE_SDI
 
 # libs
 set(        STMMI_TEMP_EXTERNAL_LIBRARIES    "")
+list(APPEND STMMI_TEMP_EXTERNAL_LIBRARIES    "${CMAKE_THREAD_LIBS_INIT}")
 
 set(        STMMGAMESXMLGAME_EXTRA_LIBRARIES     "")
 list(APPEND STMMGAMESXMLGAME_EXTRA_LIBRARIES     "${STMMGAMESXMLBASE_LIBRARIES}")
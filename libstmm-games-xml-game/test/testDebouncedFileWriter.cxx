@@ -0,0 +1,164 @@
+/*
+ * Copyright © 2019-2020  Stefano Marsili, <stemars@gmx.ch>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see <http://www.gnu.org/licenses/>
+ */
+/*
+ * File:   testDebouncedFileWriter.cxx
+ */
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+
+#include "debouncedfilewriter.h"
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace stmg
+{
+
+namespace testing
+{
+
+namespace
+{
+// Long enough for the tests to never see a write caused by the delay
+constexpr int32_t s_nLongDelayMillisec = 60 * 1000;
+
+// A temporary directory with a file path in a sub directory, removed at the end
+class WriterDir
+{
+public:
+	WriterDir()
+	{
+		char aTemplate[] = "/tmp/stmg-testDebouncedFileWriter-XXXXXX";
+		const char* p0Dir = ::mkdtemp(aTemplate);
+		REQUIRE( p0Dir != nullptr );
+		m_sDir = p0Dir;
+		m_sSubDir = m_sDir + "/sub";
+		m_sPath = m_sSubDir + "/prefs.xml";
+	}
+	~WriterDir()
+	{
+		::unlink(m_sPath.c_str());
+		::rmdir(m_sSubDir.c_str());
+		::rmdir(m_sDir.c_str());
+	}
+	std::string m_sDir;
+	std::string m_sSubDir;
+	std::string m_sPath;
+};
+
+std::string readFile(const std::string& sPath)
+{
+	std::ifstream oFile(sPath);
+	std::ostringstream oContent;
+	oContent << oFile.rdbuf();
+	return oContent.str();
+}
+bool fileExists(const std::string& sPath)
+{
+	return (::access(sPath.c_str(), F_OK) == 0);
+}
+} // namespace
+
+TEST_CASE("testDebouncedFileWriter, Coalescing")
+{
+	WriterDir oDir;
+	DebouncedFileWriter oWriter(s_nLongDelayMillisec);
+	oWriter.post(oDir.m_sPath, "A");
+	oWriter.post(oDir.m_sPath, "B");
+	oWriter.post(oDir.m_sPath, "C");
+	// Nothing is written before the delay
+	REQUIRE_FALSE( fileExists(oDir.m_sPath) );
+	oWriter.flush();
+	// Only the last content of the burst
+	REQUIRE( readFile(oDir.m_sPath) == "C" );
+	REQUIRE_FALSE( oWriter.fetchWriteFailed() );
+	// Flushing without pending content doesn't block
+	oWriter.flush();
+	REQUIRE( readFile(oDir.m_sPath) == "C" );
+}
+
+TEST_CASE("testDebouncedFileWriter, WrittenAfterDelay")
+{
+	WriterDir oDir;
+	DebouncedFileWriter oWriter(10);
+	oWriter.post(oDir.m_sPath, "A");
+	// The write happens without flush()
+	const auto oGiveUp = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+	while ((readFile(oDir.m_sPath) != "A") && (std::chrono::steady_clock::now() < oGiveUp)) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+	REQUIRE( readFile(oDir.m_sPath) == "A" );
+}
+
+TEST_CASE("testDebouncedFileWriter, FinalFlush")
+{
+	WriterDir oDir;
+	{
+		DebouncedFileWriter oWriter(s_nLongDelayMillisec);
+		oWriter.post(oDir.m_sPath, "A");
+		oWriter.post(oDir.m_sPath, "B");
+		REQUIRE_FALSE( fileExists(oDir.m_sPath) );
+		// The destructor writes the pending content without waiting for the delay
+	}
+	REQUIRE( readFile(oDir.m_sPath) == "B" );
+	REQUIRE_FALSE( fileExists(oDir.m_sPath + ".tmp") );
+}
+
+TEST_CASE("testDebouncedFileWriter, OtherPathFlushesPending")
+{
+	WriterDir oDir;
+	const std::string sOtherPath = oDir.m_sDir + "/other.xml";
+	DebouncedFileWriter oWriter(s_nLongDelayMillisec);
+	oWriter.post(oDir.m_sPath, "A");
+	oWriter.post(sOtherPath, "B");
+	REQUIRE( readFile(oDir.m_sPath) == "A" );
+	oWriter.flush();
+	REQUIRE( readFile(sOtherPath) == "B" );
+	::unlink(sOtherPath.c_str());
+}
+
+TEST_CASE("testDebouncedFileWriter, WriteFailed")
+{
+	WriterDir oDir;
+	DebouncedFileWriter oWriter(s_nLongDelayMillisec);
+	// The sub directory can't be created because a file with its name is in the way
+	{
+		std::ofstream oFile(oDir.m_sSubDir);
+	}
+	oWriter.post(oDir.m_sPath, "A");
+	oWriter.flush();
+	REQUIRE( oWriter.fetchWriteFailed() );
+	// Reported once
+	REQUIRE_FALSE( oWriter.fetchWriteFailed() );
+	// A later successful write doesn't fail
+	::unlink(oDir.m_sSubDir.c_str());
+	oWriter.post(oDir.m_sPath, "B");
+	oWriter.flush();
+	REQUIRE_FALSE( oWriter.fetchWriteFailed() );
+	REQUIRE( readFile(oDir.m_sPath) == "B" );
+}
+
+} // namespace testing
+
+} // namespace stmg
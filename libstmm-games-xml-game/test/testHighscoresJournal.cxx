@@ -0,0 +1,199 @@
+/*
+ * Copyright © 2019-2020  Stefano Marsili, <stemars@gmx.ch>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see <http://www.gnu.org/licenses/>
+ */
+/*
+ * File:   testHighscoresJournal.cxx
+ */
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+
+#include "highscoresjournal.h"
+
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace stmg
+{
+
+namespace testing
+{
+
+namespace
+{
+// A temporary directory containing a main file and its journal, removed at the end
+class JournalDir
+{
+public:
+	JournalDir()
+	{
+		char aTemplate[] = "/tmp/stmg-testHighscoresJournal-XXXXXX";
+		const char* p0Dir = ::mkdtemp(aTemplate);
+		REQUIRE( p0Dir != nullptr );
+		m_sDir = p0Dir;
+		m_sPath = m_sDir + "/highscores.xml";
+		m_sJournalPath = m_sPath + ".journal";
+	}
+	~JournalDir()
+	{
+		::unlink(m_sJournalPath.c_str());
+		::unlink(m_sPath.c_str());
+		::rmdir(m_sDir.c_str());
+	}
+	std::string m_sDir;
+	std::string m_sPath;
+	std::string m_sJournalPath;
+};
+// The state of the entries: key is the first field, value is the second
+using Entries = std::map<std::string, std::string>;
+
+int32_t replayInto(const std::string& sJournalPath, Entries& oEntries)
+{
+	return HighscoresJournal::replay(sJournalPath, [&](std::vector<std::string>&& aFields)
+	{
+		// Called by a noexcept function: don't throw
+		CHECK( aFields.size() == 2 );
+		if (aFields.size() == 2) {
+			oEntries[aFields[0]] = aFields[1];
+		}
+	});
+}
+std::string readFile(const std::string& sPath)
+{
+	std::ifstream oFile(sPath);
+	std::ostringstream oContent;
+	oContent << oFile.rdbuf();
+	return oContent.str();
+}
+bool fileExists(const std::string& sPath)
+{
+	return (::access(sPath.c_str(), F_OK) == 0);
+}
+} // namespace
+
+TEST_CASE("testHighscoresJournal, JoinSplitLine")
+{
+	const std::vector<std::string> aFields{"HS", "a\tb", "c\\d\ne", ""};
+	const std::string sLine = HighscoresJournal::joinLine(aFields);
+	REQUIRE( sLine.back() == '\n' );
+	REQUIRE( sLine.find('\n') == sLine.size() - 1 );
+	REQUIRE( HighscoresJournal::splitLine(sLine.substr(0, sLine.size() - 1)) == aFields );
+}
+
+TEST_CASE("testHighscoresJournal, AppendReplay")
+{
+	JournalDir oDir;
+	Entries oEntries;
+	// No journal
+	REQUIRE( replayInto(oDir.m_sJournalPath, oEntries) == 0 );
+	REQUIRE( oEntries.empty() );
+	{
+		HighscoresJournal oJournal;
+		oJournal.append(oDir.m_sJournalPath, HighscoresJournal::joinLine({"A", "1"}));
+		oJournal.append(oDir.m_sJournalPath, HighscoresJournal::joinLine({"B", "2"}));
+		oJournal.append(oDir.m_sJournalPath, HighscoresJournal::joinLine({"A", "3"}));
+		oJournal.flush();
+		REQUIRE( oJournal.isIdle() );
+	}
+	REQUIRE( replayInto(oDir.m_sJournalPath, oEntries) == 3 );
+	// Later entries override earlier ones
+	REQUIRE( oEntries == (Entries{{"A", "3"}, {"B", "2"}}) );
+}
+
+TEST_CASE("testHighscoresJournal, TornLastRecord")
+{
+	JournalDir oDir;
+	{
+		std::ofstream oFile(oDir.m_sJournalPath);
+		oFile << HighscoresJournal::joinLine({"A", "1"});
+		// An append interrupted before its newline
+		oFile << "B\t2";
+	}
+	Entries oEntries;
+	REQUIRE( replayInto(oDir.m_sJournalPath, oEntries) == 1 );
+	REQUIRE( oEntries == (Entries{{"A", "1"}}) );
+
+	// The next append drops the fragment rather than joining it
+	HighscoresJournal oJournal;
+	oJournal.append(oDir.m_sJournalPath, HighscoresJournal::joinLine({"C", "3"}));
+	oJournal.flush();
+	REQUIRE( readFile(oDir.m_sJournalPath) == "A\t1\nC\t3\n" );
+	oEntries.clear();
+	REQUIRE( replayInto(oDir.m_sJournalPath, oEntries) == 2 );
+	REQUIRE( oEntries == (Entries{{"A", "1"}, {"C", "3"}}) );
+}
+
+TEST_CASE("testHighscoresJournal, CompactionRoundTrip")
+{
+	JournalDir oDir;
+	HighscoresJournal oJournal;
+	oJournal.append(oDir.m_sJournalPath, HighscoresJournal::joinLine({"A", "1"}));
+	oJournal.append(oDir.m_sJournalPath, HighscoresJournal::joinLine({"B", "2"}));
+	oJournal.append(oDir.m_sJournalPath, HighscoresJournal::joinLine({"A", "4"}));
+	oJournal.flush();
+	Entries oEntries;
+	REQUIRE( replayInto(oDir.m_sJournalPath, oEntries) == 3 );
+
+	// The main file gets the replayed state (here in the journal's own format)
+	oJournal.compact(oDir.m_sPath, oDir.m_sJournalPath, [oEntries]()
+	{
+		std::string sContent;
+		for (const auto& oPair : oEntries) {
+			sContent += HighscoresJournal::joinLine({oPair.first, oPair.second});
+		}
+		return sContent;
+	});
+	oJournal.flush();
+	REQUIRE_FALSE( fileExists(oDir.m_sJournalPath) );
+	REQUIRE_FALSE( fileExists(oDir.m_sPath + ".tmp") );
+	Entries oCompacted;
+	REQUIRE( replayInto(oDir.m_sPath, oCompacted) == 2 );
+	REQUIRE( oCompacted == oEntries );
+
+	// Appending after the compaction starts a new journal
+	oJournal.append(oDir.m_sJournalPath, HighscoresJournal::joinLine({"B", "5"}));
+	oJournal.flush();
+	REQUIRE( replayInto(oDir.m_sJournalPath, oCompacted) == 1 );
+	REQUIRE( oCompacted == (Entries{{"A", "4"}, {"B", "5"}}) );
+}
+
+TEST_CASE("testHighscoresJournal, FailedCompaction")
+{
+	JournalDir oDir;
+	HighscoresJournal oJournal;
+	oJournal.append(oDir.m_sJournalPath, HighscoresJournal::joinLine({"A", "1"}));
+	oJournal.compact(oDir.m_sPath, oDir.m_sJournalPath, []() -> std::string
+	{
+		throw std::runtime_error("Serializer failed");
+	});
+	oJournal.flush();
+	// Both files are left as they were
+	REQUIRE_FALSE( fileExists(oDir.m_sPath) );
+	Entries oEntries;
+	REQUIRE( replayInto(oDir.m_sJournalPath, oEntries) == 1 );
+	REQUIRE( oEntries == (Entries{{"A", "1"}}) );
+}
+
+} // namespace testing
+
+} // namespace stmg
@@ -27,10 +27,19 @@
 
 #include <stmm-games-gtk/themeloader.h>
 
+#include <stmm-games-file/file.h>
+
 #include <vector>
 #include <map>
+#include <list>
 #include <memory>
 #include <string>
+#include <utility>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include <stdint.h>
 
 namespace stmg { class AppConfig; }
 namespace stmg { class StdTheme; }
@@ -59,6 +68,10 @@ public:
 		std::vector<unique_ptr<XmlModifierParser>> m_aModifierParsers; /**< The modifier parsers. Cannot contain nulls. */
 		std::vector<unique_ptr<XmlThAnimationFactoryParser>> m_aThAnimationParsers; /**< The theme animation parsers. Cannot contain nulls. */
 		std::vector<unique_ptr<XmlThWidgetFactoryParser>> m_aThWidgetParsers; /**< The theme widget parsers. Cannot contain nulls. */
+		int32_t m_nMaxCachedThemes = 3; /**< The maximum number of parsed themes kept in memory. Must be positive. Default is 3. */
+		int64_t m_nMaxCachedBytes = 64 * 1024 * 1024; /**< The maximum size of the image and sound files of the cached themes.
+														 * The most recently used theme is kept even if bigger. Default is 64 MiB. */
+		bool m_bPrepareInBackground = true; /**< Whether prepareTheme() parses the theme in a worker thread. Default is true. */
 	};
 	/** Constructor.
 	 * @param oInit Inizialization data..
@@ -67,11 +80,26 @@ public:
 	// The following is needed because m_refXmlThemeParser destructor is inlined here
 	// by unique_ptr where it is an incomplete type
 	// https://stackoverflow.com/questions/6012157/is-stdunique-ptrt-required-to-know-the-full-definition-of-t
+	// Also waits for the theme being prepared in the background, if any.
 	virtual ~XmlThemeLoader();
 
 	const std::vector<std::string>& getThemeNames() noexcept override;
 	const ThemeInfo& getThemeInfo(const std::string& sThemeName) noexcept override;
+	/** Get the theme with the given name or a default one.
+	 * The parsed themes are kept in a least recently used cache bounded by
+	 * Init::m_nMaxCachedThemes and Init::m_nMaxCachedBytes.
+	 * If the theme is being prepared in the background waits for it.
+	 * @param sThemeName The name of the theme or empty if loader should choose.
+	 * @return The theme or null if could not load (error string is set in ThemeInfo).
+	 */
 	shared_ptr<Theme> getTheme(const std::string& sThemeName) noexcept override;
+	/** Parses the theme in a worker thread and adds it to the cache.
+	 * Only the most recently requested theme that hasn't started parsing yet
+	 * is kept. Does nothing if Init::m_bPrepareInBackground is false or the theme
+	 * is already cached.
+	 * @param sThemeName The name of the theme. Cannot be empty.
+	 */
+	void prepareTheme(const std::string& sThemeName) noexcept override;
 
 	const std::string& getDefaultThemeName() noexcept override;
 
@@ -97,7 +125,21 @@ private:
 
 	ExtThemeInfo& getExtThemeInfo(const std::string& sName);
 
-	void parseXmlTheme(StdTheme& oStdTheme);
+	// The theme names with their files in the order needed by parseXmlTheme()
+	std::vector< std::pair<std::string, File> > getSortedThemeFiles(const std::string& sThemeName);
+	// Can be called from the worker thread. Returns the total size of the
+	// known image and sound files. Must hold m_oParseMutex.
+	int64_t parseXmlTheme(const std::vector< std::pair<std::string, File> >& aSortedThemeFiles, StdTheme& oStdTheme);
+
+	shared_ptr<Theme> cacheGet(const std::string& sThemeName) noexcept;
+	void cacheAdd(const std::string& sThemeName, const shared_ptr<Theme>& refTheme, int64_t nBytes) noexcept;
+	// Moves the themes prepared in the background to the cache
+	void adoptPrepared() noexcept;
+	// Cancels or waits for the preparation of a theme
+	void waitPrepared(const std::string& sThemeName) noexcept;
+	void runPrepare() noexcept;
+	// Makes the font files of the parsed themes available to Pango
+	void registerFonts() noexcept;
 
 private:
 	const shared_ptr<AppConfig> m_refAppConfig;
@@ -117,11 +159,38 @@ private:
 	// The theme name and its extended theme names in a top down depth first order
 	std::vector<std::string> m_aPreSortedThemeNames; //helper used when loading Theme
 
-	std::string m_sCachedThemeName;
-	shared_ptr<Theme> m_refCachedTheme;
+	struct CachedTheme
+	{
+		std::string m_sThemeName;
+		shared_ptr<Theme> m_refTheme;
+		int64_t m_nBytes;
+	};
+	std::list<CachedTheme> m_oCachedThemes; // The most recently used first
+	int64_t m_nCachedBytes; // The sum of CachedTheme::m_nBytes
+	const int32_t m_nMaxCachedThemes;
+	const int64_t m_nMaxCachedBytes;
 
 	const std::string m_sDefaultThemeName;
 
+	const bool m_bPrepareInBackground;
+	// Held while parsing, the parsers and the disk files aren't thread safe
+	std::mutex m_oParseMutex;
+	struct PreparedTheme
+	{
+		std::string m_sThemeName;
+		std::vector< std::pair<std::string, File> > m_aSortedThemeFiles; // Only used by the request
+		shared_ptr<StdTheme> m_refStdTheme; // Null if error
+		std::string m_sErrorString;
+		int64_t m_nBytes = 0;
+	};
+	std::mutex m_oPrepareMutex;
+	std::condition_variable m_oPrepareChanged;
+	PreparedTheme m_oPrepareRequest; // Protected by m_oPrepareMutex, m_sThemeName empty if none
+	std::string m_sPreparingThemeName; // Protected by m_oPrepareMutex, the theme being parsed by the worker or empty
+	std::vector<PreparedTheme> m_aPrepared; // Protected by m_oPrepareMutex, the results not adopted yet
+	bool m_bPrepareTerminate; // Protected by m_oPrepareMutex
+	std::thread m_oPrepareWorker;
+
 private:
 	XmlThemeLoader() = delete;
 	XmlThemeLoader(const XmlThemeLoader& oSource) = delete;
@@ -22,6 +22,8 @@
 
 #include <string>
 #include <memory>
+#include <map>
+#include <vector>
 #include <cassert>
 #include <iostream>
 
@@ -34,29 +36,42 @@ namespace stmg
 
 unique_ptr<FontConfigLoader> FontConfigLoader::create() noexcept
 {
-	static_assert(NULL == nullptr, "");
-	//
+	auto refInstance = unique_ptr<FontConfigLoader>(new FontConfigLoader());
+	return refInstance;
+}
+FontConfigLoader::FontConfigLoader() noexcept
+: m_bInitialized(false)
+, m_bInitFailed(false)
+{
+}
+FontConfigLoader::~FontConfigLoader()
+{
+	//::FcFini();
+}
+bool FontConfigLoader::initFontConfig() noexcept
+{
+	if (m_bInitialized) {
+		return true; //---------------------------------------------------------
+	}
+	if (m_bInitFailed) {
+		return false; //--------------------------------------------------------
+	}
+	m_bInitFailed = true;
+	// Loads the default configuration using fontconfig's on-disk font caches
 	::FcBool bOk = ::FcInit();
 	if (bOk == FcFalse) {
 		std::cout << "Error: Could not initialize fontconfig" << '\n';
-		return unique_ptr<FontConfigLoader>{};
-	}
-	::FcConfig* p0TheFonts = ::FcInitLoadConfigAndFonts();
-	if (p0TheFonts == nullptr) {
-		std::cout << "Error: Could not load fontconfig fonts" << '\n';
-		return unique_ptr<FontConfigLoader>{};
+		return false; //--------------------------------------------------------
 	}
+	// Don't rescan the font directories while running
 	bOk = ::FcConfigSetRescanInterval(nullptr, 0);
 	if (bOk == FcFalse) {
 		std::cout << "Error: Could not set fontconfig rescan interval" << '\n';
-		return unique_ptr<FontConfigLoader>{};
+		return false; //--------------------------------------------------------
 	}
-	auto refInstance = unique_ptr<FontConfigLoader>(new FontConfigLoader());
-	return refInstance;
-}
-FontConfigLoader::~FontConfigLoader()
-{
-	//::FcFini();
+	m_bInitFailed = false;
+	m_bInitialized = true;
+	return true;
 }
 
 static std::string slantToString(int32_t nSlant) noexcept
@@ -94,91 +109,73 @@ static std::string weightToString(int32_t nWeight) noexcept
 	}
 }
 
-static std::string findAppFontFile(const std::string& sFontFilePath) noexcept
+static std::string queryFontFile(const std::string& sFontFilePath) noexcept
 {
 	static_assert(sizeof(int) <= sizeof(int32_t), "");
+	static_assert(NULL == nullptr, "");
 
-	::FcFontSet* p0AppFontSet = ::FcConfigGetFonts(nullptr, ::FcSetApplication);
-	if (p0AppFontSet == nullptr) {
+	// Doesn't need the fontconfig configuration
+	int nTotFaces = 0;
+	::FcPattern* p0Pattern = ::FcFreeTypeQuery(reinterpret_cast<const FcChar8*>(sFontFilePath.c_str()), 0, NULL, &nTotFaces);
+	if (p0Pattern == nullptr) {
 		return "";
 	}
-	const int32_t nTotAppFonts = p0AppFontSet->nfont;
-//std::cout << "App specific fonts: " << nTotAppFonts << "  (" << p0AppFontSet->sfont << ")" << '\n';
-	for (int32_t nIdx = 0; nIdx < nTotAppFonts; ++nIdx) {
-		::FcPattern* p0Pattern = p0AppFontSet->fonts[nIdx];
-//std::cout << "  Pattern " << nIdx << "  " << '\n';
 //::FcPatternPrint(p0Pattern);
-		::FcObjectSet* pObjectSet = ::FcObjectSetBuild(FC_FAMILY/*, FC_STYLE, FC_FULLNAME*/, FC_FILE
-														, FC_SLANT, FC_WEIGHT, NULL);
-		if (pObjectSet == nullptr) {
-			continue;
-		}
-		::FcFontSet* pFontSet = ::FcFontList(NULL, p0Pattern, pObjectSet);
-		if (pFontSet == nullptr) {
-			::FcObjectSetDestroy(pObjectSet);
-			continue;
-		}
-		std::string sFamily;
-		//std::string sStyle;
-		//std::string sFullName;
-		std::string sFilePath;
-		FcChar8* p0Family;
-		//FcChar8* p0Style;
-		//FcChar8* p0FullName;
-		FcChar8* p0FilePath;
-		int nSlant = 0;
-		int nWeight = 80;
-		//
-		const int32_t nPropIdx = 0;
-		if (::FcPatternGetString(pFontSet->fonts[nPropIdx], FC_FAMILY, 0, &p0Family) == FcResultMatch) {
-			sFamily = std::string{reinterpret_cast<const char*>(p0Family)};
-		}
-		//if (::FcPatternGetString(pFontSet->fonts[nPropIdx], FC_STYLE, 0, &p0Style) == FcResultMatch) {
-		//	sStyle = std::string{reinterpret_cast<const char*>(p0Style)};
-		//}
-		//if (::FcPatternGetString(pFontSet->fonts[nPropIdx], FC_FULLNAME, 0, &p0FullName) == FcResultMatch) {
-		//	sFullName = std::string{reinterpret_cast<const char*>(p0FullName)};
-		//}
-		if (::FcPatternGetInteger(pFontSet->fonts[nPropIdx], FC_SLANT, 0, &nSlant) == FcResultMatch) {
-			nSlant = nSlant;
-		}
-		if (::FcPatternGetInteger(pFontSet->fonts[nPropIdx], FC_WEIGHT, 0, &nWeight) == FcResultMatch) {
-			nWeight = nWeight;
-		}
-		if (::FcPatternGetString(pFontSet->fonts[nPropIdx], FC_FILE, 0, &p0FilePath) == FcResultMatch) {
-			sFilePath = std::string{reinterpret_cast<const char*>(p0FilePath)};
-		}
-		//
-		::FcObjectSetDestroy(pObjectSet);
-		::FcFontSetDestroy(pFontSet);
-		if (sFilePath == sFontFilePath) {
-			// found the font
-			const std::string sFontDesc = sFamily
-							+ " " + slantToString(nSlant)
-							+ " " + weightToString(nWeight);
-//std::cout << "      sFontDesc: " << sFontDesc << '\n';
-			return sFontDesc;
-		}
+	std::string sFamily;
+	FcChar8* p0Family;
+	int nSlant = 0;
+	int nWeight = 80;
+	if (::FcPatternGetString(p0Pattern, FC_FAMILY, 0, &p0Family) == FcResultMatch) {
+		sFamily = std::string{reinterpret_cast<const char*>(p0Family)};
 	}
-	return "";
+	int nValue;
+	if (::FcPatternGetInteger(p0Pattern, FC_SLANT, 0, &nValue) == FcResultMatch) {
+		nSlant = nValue;
+	}
+	if (::FcPatternGetInteger(p0Pattern, FC_WEIGHT, 0, &nValue) == FcResultMatch) {
+		nWeight = nValue;
+	}
+	::FcPatternDestroy(p0Pattern);
+	if (sFamily.empty()) {
+		return "";
+	}
+	const std::string sFontDesc = sFamily
+					+ " " + slantToString(nSlant)
+					+ " " + weightToString(nWeight);
+//std::cout << "      sFontDesc: " << sFontDesc << '\n';
+	return sFontDesc;
 }
 std::string FontConfigLoader::addAppFontFile(const std::string& sFontFilePath) noexcept
 {
-	const std::string sDefine = findAppFontFile(sFontFilePath);
-	if (! sDefine.empty()) {
+	const auto itFind = m_oFontFileDescs.find(sFontFilePath);
+	if (itFind != m_oFontFileDescs.end()) {
 		// was already added
-		return sDefine; //------------------------------------------------------
+		return itFind->second; //-----------------------------------------------
 	}
-
 //std::cout << "      Adding: " << sFontFilePath << '\n';
-
-	::FcBool bOk = ::FcConfigAppFontAddFile(nullptr, reinterpret_cast<const FcChar8*>(sFontFilePath.c_str()));
-	if (bOk == FcFalse) {
-		return ""; //-----------------------------------------------------------
+	std::string sDefine = queryFontFile(sFontFilePath);
+	if (! sDefine.empty()) {
+		m_aToRegister.push_back(sFontFilePath);
 	}
-	// find the just added font and return the description useful to Pango
-	return findAppFontFile(sFontFilePath);
+	m_oFontFileDescs.emplace(sFontFilePath, sDefine);
+	return sDefine;
+}
+bool FontConfigLoader::registerAppFontFiles() noexcept
+{
+	if (m_aToRegister.empty()) {
+		return true; //---------------------------------------------------------
+	}
+	if (! initFontConfig()) {
+		return false; //--------------------------------------------------------
+	}
+	for (const auto& sFontFilePath : m_aToRegister) {
+		const ::FcBool bOk = ::FcConfigAppFontAddFile(nullptr, reinterpret_cast<const FcChar8*>(sFontFilePath.c_str()));
+		if (bOk == FcFalse) {
+			std::cout << "Error: Could not add font file " << sFontFilePath << '\n';
+		}
+	}
+	m_aToRegister.clear();
+	return true;
 }
-
 
 } // namespace stmg
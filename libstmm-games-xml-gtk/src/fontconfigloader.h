@@ -23,6 +23,8 @@
 
 #include <string>
 #include <memory>
+#include <map>
+#include <vector>
 
 namespace stmg
 {
@@ -30,6 +32,12 @@ namespace stmg
 using std::unique_ptr;
 using std::shared_ptr;
 
+/** Theme font files loader.
+ * Fontconfig is only initialized when the first font files are registered,
+ * so that applications whose themes don't use font files don't pay for it.
+ * Font files are queried directly (without loading the fontconfig
+ * configuration) when added.
+ */
 class FontConfigLoader
 {
 public:
@@ -37,11 +45,23 @@ public:
 
 	// returns empty string if error, FontDescription string otherwise
 	// sFontFilePath must be absolute
+	// The font is only usable after registerAppFontFiles() is called
 	std::string addAppFontFile(const std::string& sFontFilePath) noexcept;
+	// Initializes fontconfig if necessary and registers the font files added
+	// since last call as application fonts
+	// returns false if fontconfig couldn't be initialized
+	bool registerAppFontFiles() noexcept;
 
 	~FontConfigLoader();
 protected:
-	FontConfigLoader() noexcept = default;
+	FontConfigLoader() noexcept;
+private:
+	bool initFontConfig() noexcept;
+private:
+	bool m_bInitialized;
+	bool m_bInitFailed;
+	std::map<std::string, std::string> m_oFontFileDescs; // Key: font file path, Value: font description or empty if invalid
+	std::vector<std::string> m_aToRegister; // The font file paths added but not registered yet
 private:
 	FontConfigLoader(const FontConfigLoader& oSource) = delete;
 	FontConfigLoader& operator=(const FontConfigLoader& oSource) = delete;
@@ -49,6 +49,7 @@
 #include <utility>
 #include <unordered_set>
 
+#include <sys/stat.h>
 #include <stdint.h>
 
 namespace stmg { class Theme; }
@@ -56,16 +57,45 @@ namespace stmg { class Theme; }
 namespace stmg
 {
 
+namespace Private
+{
+static int64_t fileSize(const File& oFile) noexcept
+{
+	if (oFile.isBuffered()) {
+		return oFile.getBufferSize(); //----------------------------------------
+	}
+	struct stat oStat;
+	if (::stat(oFile.getFullPath().c_str(), &oStat) != 0) {
+		return 0; //------------------------------------------------------------
+	}
+	return oStat.st_size;
+}
+static int64_t filesSize(const std::vector< std::pair<std::string, File> >& aFiles) noexcept
+{
+	int64_t nBytes = 0;
+	for (const auto& oPairThemeFile : aFiles) {
+		nBytes += fileSize(oPairThemeFile.second);
+	}
+	return nBytes;
+}
+} // namespace Private
+
 XmlThemeLoader::XmlThemeLoader(Init&& oInit)
 : m_refAppConfig(std::move(oInit.m_refAppConfig))
 , m_aAdditionalGameIds(oInit.m_aAdditionalGameIds)
 , m_refGameDiskFiles(std::move(oInit.m_refGameDiskFiles))
 , m_refXmlThemeParser(std::make_unique<XmlThemeParser>())
 , m_bInfosLoaded(false)
+, m_nCachedBytes(0)
+, m_nMaxCachedThemes(oInit.m_nMaxCachedThemes)
+, m_nMaxCachedBytes(oInit.m_nMaxCachedBytes)
 , m_sDefaultThemeName(std::move(oInit.m_sDefaultThemeName))
+, m_bPrepareInBackground(oInit.m_bPrepareInBackground)
+, m_bPrepareTerminate(false)
 {
 	assert(m_refAppConfig);
 	assert(m_refGameDiskFiles);
+	assert(m_nMaxCachedThemes > 0);
 	for (auto& refModifierParser : oInit.m_aModifierParsers) {
 		m_refXmlThemeParser->addXmlModifierParser(std::move(refModifierParser));
 	}
@@ -83,6 +113,15 @@ XmlThemeLoader::XmlThemeLoader(Init&& oInit)
 }
 XmlThemeLoader::~XmlThemeLoader()
 {
+	{
+		std::lock_guard<std::mutex> oLock(m_oPrepareMutex);
+		m_bPrepareTerminate = true;
+		m_oPrepareRequest.m_sThemeName.clear();
+	}
+	m_oPrepareChanged.notify_all();
+	if (m_oPrepareWorker.joinable()) {
+		m_oPrepareWorker.join();
+	}
 	// DO NOT REMOVE THIS!!! See header file!
 	// DO NOT REMOVE THIS!!! See header file!
 	// DO NOT REMOVE THIS!!! See header file!
@@ -292,20 +331,26 @@ shared_ptr<Theme> XmlThemeLoader::getTheme(const std::string& sName) noexcept
 //std::cout << "XmlThemeLoader::getTheme()    sErrorStr=" << sErrorStr << '\n';
 		return shared_ptr<Theme>(); //------------------------------------------
 	}
-	if (m_sCachedThemeName == sTheName) {
-		assert(m_refCachedTheme);
-		return m_refCachedTheme; //---------------------------------------------
+	waitPrepared(sTheName);
+	if (!sErrorStr.empty()) {
+		// Preparing in the background failed
+		return shared_ptr<Theme>(); //------------------------------------------
+	}
+	shared_ptr<Theme> refTheme = cacheGet(sTheName);
+	if (refTheme) {
+		registerFonts();
+		return refTheme; //-----------------------------------------------------
 	}
 
 	auto refStdTheme = std::make_shared<StdTheme>();
 	StdTheme& oStdTheme = *refStdTheme;
-	m_aPreSortedThemeNames.clear();
-	traverseAndAdd(sTheName);
+	const auto aSortedThemeFiles = getSortedThemeFiles(sTheName);
 	//load theme
-	shared_ptr<Theme> refTheme;
+	int64_t nBytes = 0;
 	try
 	{
-		parseXmlTheme(oStdTheme);
+		std::lock_guard<std::mutex> oLock(m_oParseMutex);
+		nBytes = parseXmlTheme(aSortedThemeFiles, oStdTheme);
 		refTheme = refStdTheme;
 	}
 	catch(const std::exception& oEx)
@@ -315,16 +360,171 @@ shared_ptr<Theme> XmlThemeLoader::getTheme(const std::string& sName) noexcept
 		std::cout << sErrorStr << '\n';
 		return shared_ptr<Theme>(); //------------------------------------------
 	}
-	m_sCachedThemeName = sTheName;
-	m_refCachedTheme = refTheme;
+	cacheAdd(sTheName, refTheme, nBytes);
+	registerFonts();
 	return refTheme;
 }
+void XmlThemeLoader::registerFonts() noexcept
+{
+	if (!m_refFontConfigLoader) {
+		return; //--------------------------------------------------------------
+	}
+	// The font files might have been added by the worker thread
+	std::lock_guard<std::mutex> oLock(m_oParseMutex);
+	// Initializes fontconfig the first time a theme with fonts is used
+	m_refFontConfigLoader->registerAppFontFiles();
+}
+void XmlThemeLoader::prepareTheme(const std::string& sThemeName) noexcept
+{
+	assert(!sThemeName.empty());
+	if (!m_bPrepareInBackground) {
+		return; //--------------------------------------------------------------
+	}
+	if (!m_bInfosLoaded) {
+		loadThemeInfos();
+	}
+	const auto itFindValid = std::find(m_aValidNames.begin(), m_aValidNames.end(), sThemeName);
+	if (itFindValid == m_aValidNames.end()) {
+		return; //--------------------------------------------------------------
+	}
+	adoptPrepared();
+	if (!getExtThemeInfo(sThemeName).m_sThemeErrorString.empty()) {
+		return; //--------------------------------------------------------------
+	}
+	const auto itFind = std::find_if(m_oCachedThemes.begin(), m_oCachedThemes.end(), [&](const CachedTheme& oCachedTheme)
+	{
+		return (oCachedTheme.m_sThemeName == sThemeName);
+	});
+	if (itFind != m_oCachedThemes.end()) {
+		return; //--------------------------------------------------------------
+	}
+	auto aSortedThemeFiles = getSortedThemeFiles(sThemeName);
+	{
+		std::lock_guard<std::mutex> oLock(m_oPrepareMutex);
+		if (m_sPreparingThemeName == sThemeName) {
+			// already being parsed, drop any other request
+			m_oPrepareRequest.m_sThemeName.clear();
+			return; //----------------------------------------------------------
+		}
+		m_oPrepareRequest.m_sThemeName = sThemeName;
+		m_oPrepareRequest.m_aSortedThemeFiles = std::move(aSortedThemeFiles);
+		if (!m_oPrepareWorker.joinable()) {
+			m_oPrepareWorker = std::thread(&XmlThemeLoader::runPrepare, this);
+		}
+	}
+	m_oPrepareChanged.notify_all();
+}
+void XmlThemeLoader::waitPrepared(const std::string& sThemeName) noexcept
+{
+	{
+		std::unique_lock<std::mutex> oLock(m_oPrepareMutex);
+		if (m_oPrepareRequest.m_sThemeName == sThemeName) {
+			// Not started yet: the caller parses it right away
+			m_oPrepareRequest.m_sThemeName.clear();
+		}
+		m_oPrepareChanged.wait(oLock, [&]()
+		{
+			return (m_sPreparingThemeName != sThemeName);
+		});
+	}
+	adoptPrepared();
+}
+void XmlThemeLoader::adoptPrepared() noexcept
+{
+	std::vector<PreparedTheme> aPrepared;
+	{
+		std::lock_guard<std::mutex> oLock(m_oPrepareMutex);
+		aPrepared.swap(m_aPrepared);
+	}
+	for (auto& oPrepared : aPrepared) {
+		if (oPrepared.m_refStdTheme) {
+			cacheAdd(oPrepared.m_sThemeName, oPrepared.m_refStdTheme, oPrepared.m_nBytes);
+		} else {
+			std::cout << oPrepared.m_sErrorString << '\n';
+			getExtThemeInfo(oPrepared.m_sThemeName).m_sThemeErrorString = std::move(oPrepared.m_sErrorString);
+		}
+	}
+}
+void XmlThemeLoader::runPrepare() noexcept
+{
+	std::unique_lock<std::mutex> oLock(m_oPrepareMutex);
+	do {
+		m_oPrepareChanged.wait(oLock, [&]()
+		{
+			return m_bPrepareTerminate || !m_oPrepareRequest.m_sThemeName.empty();
+		});
+		if (m_bPrepareTerminate) {
+			break; // do ------
+		}
+		PreparedTheme oPrepared = std::move(m_oPrepareRequest);
+		m_oPrepareRequest = PreparedTheme{};
+		m_sPreparingThemeName = oPrepared.m_sThemeName;
+		oLock.unlock();
+		auto refStdTheme = std::make_shared<StdTheme>();
+		try {
+			std::lock_guard<std::mutex> oParseLock(m_oParseMutex);
+			oPrepared.m_nBytes = parseXmlTheme(oPrepared.m_aSortedThemeFiles, *refStdTheme);
+			// Decode the images now rather than when first drawn
+			refStdTheme->loadImages();
+			oPrepared.m_refStdTheme = std::move(refStdTheme);
+		} catch (const std::exception& oEx) {
+			oPrepared.m_sErrorString = "Exception caught parsing theme '" + oPrepared.m_sThemeName + "'"
+										+ ": " + oEx.what();
+		}
+		oPrepared.m_aSortedThemeFiles.clear();
+		oLock.lock();
+		m_sPreparingThemeName.clear();
+		m_aPrepared.push_back(std::move(oPrepared));
+		m_oPrepareChanged.notify_all();
+	} while (true);
+}
+shared_ptr<Theme> XmlThemeLoader::cacheGet(const std::string& sThemeName) noexcept
+{
+	const auto itFind = std::find_if(m_oCachedThemes.begin(), m_oCachedThemes.end(), [&](const CachedTheme& oCachedTheme)
+	{
+		return (oCachedTheme.m_sThemeName == sThemeName);
+	});
+	if (itFind == m_oCachedThemes.end()) {
+		return shared_ptr<Theme>(); //------------------------------------------
+	}
+	// most recently used
+	m_oCachedThemes.splice(m_oCachedThemes.begin(), m_oCachedThemes, itFind);
+	return m_oCachedThemes.front().m_refTheme;
+}
+void XmlThemeLoader::cacheAdd(const std::string& sThemeName, const shared_ptr<Theme>& refTheme, int64_t nBytes) noexcept
+{
+	assert(refTheme);
+	if (cacheGet(sThemeName)) {
+		// Another instance was already added
+		return; //--------------------------------------------------------------
+	}
+	m_oCachedThemes.push_front(CachedTheme{sThemeName, refTheme, nBytes});
+	m_nCachedBytes += nBytes;
+	// Evict the least recently used but never the one just added
+	while ((m_oCachedThemes.size() > 1)
+			&& ((static_cast<int32_t>(m_oCachedThemes.size()) > m_nMaxCachedThemes) || (m_nCachedBytes > m_nMaxCachedBytes))) {
+		m_nCachedBytes -= m_oCachedThemes.back().m_nBytes;
+		m_oCachedThemes.pop_back();
+	}
+}
+std::vector< std::pair<std::string, File> > XmlThemeLoader::getSortedThemeFiles(const std::string& sThemeName)
+{
+	m_aPreSortedThemeNames.clear();
+	traverseAndAdd(sThemeName);
+	std::vector< std::pair<std::string, File> > aSortedThemeFiles;
+	aSortedThemeFiles.reserve(m_aPreSortedThemeNames.size());
+	for (const auto& sName : m_aPreSortedThemeNames) {
+		aSortedThemeFiles.emplace_back(sName, getExtThemeInfo(sName).m_oThemeFile);
+	}
+	return aSortedThemeFiles;
+}
 
-void XmlThemeLoader::parseXmlTheme(StdTheme& oStdTheme)
+int64_t XmlThemeLoader::parseXmlTheme(const std::vector< std::pair<std::string, File> >& aSortedThemeFiles, StdTheme& oStdTheme)
 {
-//std::cout << "XmlThemeLoader::parseXmlTheme()    sThemeName=" << m_aPreSortedThemeNames[0] << '\n';
+//std::cout << "XmlThemeLoader::parseXmlTheme()    sThemeName=" << aSortedThemeFiles[0].first << '\n';
 
-	const int32_t nTotThemes = static_cast<int32_t>(m_aPreSortedThemeNames.size());
+	const int32_t nTotThemes = static_cast<int32_t>(aSortedThemeFiles.size());
+	int64_t nBytes = 0;
 //std::cout << "XmlThemeLoader::parseXmlTheme()    nTotThemes=" << nTotThemes << '\n';
 	std::vector<xmlpp::DomParser> aDomParsers{static_cast<std::vector<xmlpp::DomParser>::size_type>(nTotThemes)};
 
@@ -336,7 +536,7 @@ void XmlThemeLoader::parseXmlTheme(StdTheme& oStdTheme)
 	aCtxs.reserve(nTotThemes);
 	{
 	for (int32_t nThemeNr = 0; nThemeNr < nTotThemes; ++nThemeNr) {
-		const std::string& sName = m_aPreSortedThemeNames[nThemeNr];
+		const std::string& sName = aSortedThemeFiles[nThemeNr].first;
 		xmlpp::DomParser& oDomParser = aDomParsers[nThemeNr];
 		//oDomParser.set_validate();
 		//We just want the text to be resolved/unescaped automatically.
@@ -344,7 +544,7 @@ void XmlThemeLoader::parseXmlTheme(StdTheme& oStdTheme)
 //if (nThemeNr > 0) {
 //std::cout << "XmlThemeLoader::parseXmlTheme()        extended theme sName=" << sName << '\n';
 //}
-		const File& oThemeFile = m_oNamedThemeInfos[sName].m_oThemeFile;
+		const File& oThemeFile = aSortedThemeFiles[nThemeNr].second;
 		assert(oThemeFile.isDefined());
 		assert(!oThemeFile.isBuffered());
 		const std::string& sFile = oThemeFile.getFullPath();
@@ -362,6 +562,7 @@ void XmlThemeLoader::parseXmlTheme(StdTheme& oStdTheme)
 		oThemeCtx.m_refThemeExtraData = refThemeExtraData;
 
 		const auto& aImageFiles = m_refGameDiskFiles->getThemeImageFiles(oThemeFile);
+		nBytes += Private::filesSize(aImageFiles);
 		for (auto& oPairThemeFile : aImageFiles) {
 			const std::string& sThemeFileName = oPairThemeFile.first;
 			const File& oThemeFile = oPairThemeFile.second;
@@ -370,6 +571,7 @@ void XmlThemeLoader::parseXmlTheme(StdTheme& oStdTheme)
 //std::cout << "XmlThemeLoader::parseXmlTheme()   image       sThemeFileName=" << sThemeFileName << '\n';
 		}
 		const auto& aSoundFiles = m_refGameDiskFiles->getThemeSoundFiles(oThemeFile);
+		nBytes += Private::filesSize(aSoundFiles);
 		for (auto& oPairThemeFile : aSoundFiles) {
 			const std::string& sThemeFileName = oPairThemeFile.first;
 			const File& oThemeFile = oPairThemeFile.second;
@@ -390,6 +592,7 @@ void XmlThemeLoader::parseXmlTheme(StdTheme& oStdTheme)
 		}
 	}
 	const auto& aDefaultImageFiles = m_refGameDiskFiles->getDefaultImageFiles();
+	nBytes += Private::filesSize(aDefaultImageFiles);
 	for (auto& oPairThemeFile : aDefaultImageFiles) {
 		const std::string& sThemeFileName = oPairThemeFile.first;
 		const File& oThemeFile = oPairThemeFile.second;
@@ -398,6 +601,7 @@ void XmlThemeLoader::parseXmlTheme(StdTheme& oStdTheme)
 //std::cout << "XmlThemeLoader::parseXmlTheme() common image         sThemeFileName=" << sThemeFileName << '\n';
 	}
 	const auto& aDefaultSoundFiles = m_refGameDiskFiles->getDefaultSoundFiles();
+	nBytes += Private::filesSize(aDefaultSoundFiles);
 	for (auto& oPairThemeFile : aDefaultSoundFiles) {
 		const std::string& sThemeFileName = oPairThemeFile.first;
 		const File& oThemeFile = oPairThemeFile.second;
@@ -467,6 +671,7 @@ void XmlThemeLoader::parseXmlTheme(StdTheme& oStdTheme)
 
 	}
 	} // Do not remove this! Segmentation fault!
+	return nBytes;
 }
 
 
@@ -43,6 +43,7 @@ public:
 	, m_oTile(oInit.m_oTile)
 	, m_nLevelPlayer(oInit.m_nLevelPlayer)
 	{
+		setClassId(this);
 	}
 	/** The tile that has to be exploded.
 	 * @return The tile. Can be empty.
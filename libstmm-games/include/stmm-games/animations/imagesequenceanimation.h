@@ -41,6 +41,7 @@ public:
 	explicit ImageSequenceAnimation(const Init& oInit) noexcept
 	: LevelAnimation(oInit)
 	{
+		setClassId(this);
 	}
 	Level& level() noexcept
 	{
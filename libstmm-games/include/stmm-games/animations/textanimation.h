@@ -50,6 +50,7 @@ public:
 	: LevelAnimation(oInit)
 	, m_oLocalData(std::move(oInit))
 	{
+		setClassId(this);
 	}
 
 	inline double getFontHeight() const noexcept { return m_oLocalData.m_fFontHeight; }
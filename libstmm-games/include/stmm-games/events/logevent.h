@@ -62,7 +62,8 @@ public:
 	void trigger(int32_t nMsg, int32_t nValue, Event* p0TriggeringEvent) noexcept override;
 
 public:
-	/** Holds information about the messages received by all instances of LogEvent.
+	/** Holds information about the messages received by all instances of LogEvent
+	 * within a thread.
 	 * Only the last MsgLog::s_nMaxLastBufferedEntries entries are buffered and
 	 * can be accessed with MsgLog::last(int32_t nBack). */
 	class MsgLog {
@@ -146,12 +147,13 @@ public:
 		MsgLog(MsgLog const&) = delete;
 		void operator=(MsgLog const&) = delete;
 	};
-	/** The log containing the entries from all instances.
-	 * @return The singleton log.
+	/** The log containing the entries from all instances in the current thread.
+	 * Games running on different threads have separate logs.
+	 * @return The thread's log.
 	 */
 	static MsgLog& msgLog() noexcept
 	{
-		static MsgLog s_oMsgLog;
+		static thread_local MsgLog s_oMsgLog;
 		return s_oMsgLog;
 	}
 
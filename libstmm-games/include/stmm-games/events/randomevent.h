@@ -29,6 +29,7 @@
 #include <vector>
 #include <limits>
 #include <memory>
+#include <mutex>
 
 #include <stdint.h>
 
@@ -144,7 +145,9 @@ private:
 		int32_t m_nFrom;
 		int32_t m_nTo;
 	};
+	// Shared by the RandomEvent instances of all games, guarded by s_oSharedRandomsMutex
 	static std::vector<SharedRandom> m_aSharedRandoms;
+	static std::mutex s_oSharedRandomsMutex;
 
 private:
 	RandomEvent() = delete;
@@ -136,7 +136,7 @@ private:
 			TextAnimation::reInit(std::move(oInit));
 		}
 	};
-	static Recycler<PrivateTextAnimation, TextAnimation> s_oTextAnimationRecycler;
+	Recycler<PrivateTextAnimation, TextAnimation> m_oTextAnimationRecycler;
 
 private:
 	ShowTextEvent() = delete;
@@ -28,12 +28,12 @@
 
 #include "utile/tileselector.h"
 
-#include "util/recycler.h"
 #include "util/basictypes.h"
 #include "util/direction.h"
 
 #include <memory>
 #include <vector>
+#include <deque>
 #include <unordered_map>
 #include <cassert>
 
@@ -144,7 +144,6 @@ private:
 	struct TileAni final : public TileAnimator
 	{
 		TileAni() = default;
-		void reInit() noexcept {} // this is for the recycler
 		friend class TileAnimatorEvent;
 		double getCommonElapsed(int32_t nAni, int32_t nViewTick, int32_t nTotViewTicks) const noexcept;
 		double getElapsed01(int32_t nHash, int32_t nX, int32_t nY, int32_t nAni, int32_t nViewTick, int32_t nTotTicks) const noexcept override;
@@ -158,19 +157,51 @@ private:
 		LevelBlock* m_p0LevelBlock; // Board if m_p0LevelBlock == null
 	};
 
-	shared_ptr<TileAnimatorEvent::TileAni> createTileAni(LevelBlock* p0LevelBlock) noexcept;
-	bool createTileAniBoard(int32_t nNotAniIdx, int32_t nGameTick, double fGameInterval, int32_t nX, int32_t nY) noexcept;
-	bool createTileAniBlock(int32_t nNotAniIdx, int32_t nGameTick, double fGameInterval, LevelBlock* p0LevelBlock, int32_t nBrick) noexcept;
+	enum ANI_STATE
+	{
+		  ANI_STATE_FREE = 0 /**< The slot is in the free list. */
+		, ANI_STATE_NOT = 1 /**< Selected but not animated: no tile animator set. */
+		, ANI_STATE_WAITING = 2 /**< Tile animator set, waiting in the wheel to (re)start. */
+		, ANI_STATE_RUNNING = 3 /**< Tile animator set and animating. */
+	};
+	// One slot per selected board cell or block brick.
+	// The slot's address is stable (the TileAni is passed to the level) and is reused through a free list.
+	struct AniSlot
+	{
+		TileAni m_oTileAni;
+		NPoint m_oPos; // if m_nX is negated it's the brick id and m_nY the block id, if positive position in board
+		ANI_STATE m_eState;
+		int32_t m_nIdx; // Index in m_aNotAnis, m_aRunningAnis or the wheel bucket, next free slot if ANI_STATE_FREE
+		int32_t m_nStartTick; // if ANI_STATE_WAITING the game tick the animation (re)starts
+	};
+
+	int32_t slotAlloc(NPoint oPos) noexcept;
+	// Removes from the list of its state and from the board or block lookup, doesn't touch the level
+	void slotFree(int32_t nSlot) noexcept;
+	void slotUnlink(int32_t nSlot) noexcept;
+	void slotToNot(int32_t nSlot) noexcept;
+	void slotToWaiting(int32_t nSlot, int32_t nStartTick) noexcept;
+	void slotToRunning(int32_t nSlot) noexcept;
+	// Returns -1 if no slot
+	int32_t& boardSlot(int32_t nX, int32_t nY) noexcept;
+	// Returns -1 if no slot
+	int32_t blockSlot(int32_t nLBId, int32_t nBrickId) const noexcept;
+	void blockSetSlot(int32_t nLBId, int32_t nBrickId, int32_t nSlot) noexcept;
+
+	bool createTileAni(int32_t nSlot, int32_t nGameTick, double fGameInterval) noexcept;
 
 	void blockAddSelectedBrick(LevelBlock& oLevelBlock, int32_t nBrickId, int32_t nBlockId) noexcept;
 	void blockAddSelected(LevelBlock& oBlock) noexcept;
 	// aDeleteBrickId is empty, remove all
 	void blockRemoveSelected(LevelBlock& oLevelBlock, const std::vector<int32_t>& aRemoveBrickId) noexcept;
+	void blockRemoveSelectedBrick(LevelBlock& oLevelBlock, int32_t nBrickId) noexcept;
 
 	void boardAddSelected(const NRect& oRect) noexcept;
 	void boardAddSelected(const Coords& oCoords) noexcept;
+	void boardAddSelected(int32_t nX, int32_t nY) noexcept;
 	void boardRemoveSelected(const NRect& oRect) noexcept;
 	void boardRemoveSelected(const Coords& oCoords) noexcept;
+	void boardRemoveSelected(int32_t nX, int32_t nY) noexcept;
 	void boardMoveSelected(const NRect& oRect, Direction::VALUE eDir) noexcept;
 
 private:
@@ -190,24 +221,29 @@ private:
 
 	int32_t m_nCounter;
 
-	// a board position in m_aNotAnisPos has no cell`s tile animator set
-	// m_aWaitingAnisPos (despite not animating yet, sort of reserved) and m_aRunningAnisPos do
+	// a slot in m_aNotAnis has no cell`s tile animator set
+	// waiting slots (despite not animating yet, sort of reserved) and running slots do
 
-	std::vector< NPoint > m_aNotAnisPos; // if m_nX is negated it's the brick id and m_nY the block id, if positive position in board
+	std::deque<AniSlot> m_aSlots;
+	int32_t m_nFreeSlot; // Head of the free slots list or -1
 
-	std::vector< NPoint > m_aWaitingAnisPos; // if m_nX is negated it's the brick id and m_nY the block id, if positive position in board
-	std::vector< int32_t > m_aWaitingAnisStart; // Value: start game tick, Size: m_aWaitingAnisPos.size()
-	std::vector< shared_ptr<TileAni> > m_aWaitingAnis; // Size: m_aWaitingAnisPos.size()
+	std::vector<int32_t> m_aNotAnis; // Value: slot index
+	std::vector<int32_t> m_aRunningAnis; // Value: slot index
 
-	std::vector< NPoint > m_aRunningAnisPos; // if m_nX is negated it's the brick id and m_nY the block id, if positive position in board
-	std::vector< shared_ptr<TileAni> > m_aRunningAnis; // Size: m_aPosRunningAnis.size()
+	// Timing wheel of the waiting slots, bucket is start tick modulo s_nWheelSize.
+	// A bucket can contain slots starting in a later round of the wheel.
+	std::vector< std::vector<int32_t> > m_aWaitingWheel; // Size: s_nWheelSize, Value: slot index
+	int32_t m_nTotWaiting;
+	int32_t m_nWheelTick; // The last game tick whose bucket was processed
 
-	Recycler<TileAni> m_oTileAniRecycler;
+	std::vector<int32_t> m_aBoardSlots; // Size: m_nBoardWidth * m_nBoardHeight, Value: slot index or -1
+	std::unordered_map<int32_t, std::vector<int32_t> > m_oBlockSlots; // Key: block id, Value: slot index or -1 (index: brick id)
 
 	// utility var to informListeners
 	int32_t m_nLastReportedRunningAnis;
 
 	static const int32_t s_nMaxTry;
+	static const int32_t s_nWheelSize; // must be power of 2
 private:
 	TileAnimatorEvent() = delete;
 	TileAnimatorEvent(const TileAnimatorEvent& oSource) = delete;
@@ -27,7 +27,11 @@
 
 #include "gameproxy.h"
 #include "named.h"
+#ifdef STMG_TICK_STATS
+#include "tickstats.h"
+#endif //STMG_TICK_STATS
 #include "ownertype.h"
+#include "keyactionring.h"
 #include "util/namedobjindex.h"
 #include "variable.h"
 
@@ -44,7 +48,6 @@
 
 namespace stmg { class AppPreferences; }
 namespace stmg { class HighscoresDefinition; }
-namespace stmg { class KeyActionEvent; }
 namespace stmg { class Layout; }
 namespace stmg { class LevelView; }
 namespace stmg { class GameSound; }
@@ -94,6 +97,7 @@ public:
 		double m_fSoundScaleZ = 1.0; /**< The z axis scale from tiles to sound coordinates. Default: 1. */
 		int32_t m_nBoardPainterIdx = -1; /**< The painter the view should use for drawing board tiles. Either a valid m_oNamed.painters() index or -1 if theme should use its default. Default: -1. */
 		int32_t m_nBlockPainterIdx = -1; /**< The painter the view should use for drawing block tiles. Either a valid m_oNamed.painters() index or -1 if theme should use its default. Default: -1. */
+		bool m_bLowLatencyInput = false; /**< Whether input can be dispatched between game ticks. See Game::handleInput(). Default: false. */
 	};
 	/** Constructor.
 	 * See Game::reInit().
@@ -225,6 +229,11 @@ public:
 	 */
 	const shared_ptr<Layout>& getLayout() const noexcept;
 	const shared_ptr<const Highscore>& getPreGameHighscore() const noexcept { return m_refPreGameHighscore; }
+#ifdef STMG_TICK_STATS
+	/** @see GameProxy::getTickStats().
+	 */
+	const TickStats& getTickStats() const noexcept { return m_oTickStats; }
+#endif //STMG_TICK_STATS
 	Highscore const& getInGameHighscore() const noexcept { return *m_refInGameHighscore; }
 
 	/** @see GameProxy::interrupt(GameProxy::INTERRUPT_TYPE eInterruptType).
@@ -256,6 +265,14 @@ public:
 	/** The game's input event handler.
 	 * Called by the device manager listener.
 	 * All input events go through here.
+	 *
+	 * Outside of a game tick the event is queued and dispatched at the start of
+	 * the next game tick. In low latency mode (see Game::Init::m_bLowLatencyInput)
+	 * the event is instead dispatched immediately in an input sub-tick if
+	 * no other event is queued and all the level blocks it would reach are
+	 * LevelBlock::isSubTickInputCapable(). Since nothing else happens between
+	 * game ticks, the outcome is the same as if the event had been dispatched
+	 * at the start of the next game tick.
 	 * @param refEvent The event. Cannot be null.
 	 */
 	void handleInput(const shared_ptr<stmi::Event>& refEvent) noexcept;
@@ -264,8 +281,28 @@ public:
 	 * This is the game tick.
 	 */
 	void handleTimer() noexcept;
+	/** The game progress function with the time of the game tick.
+	 * Same as handleTimer(), but allows key action events to know when
+	 * they happened within a game interval. See KeyActionEvent::getTickOffset().
+	 * @param nTimeUsec The time of the game tick in the same time base as
+	 * the input events (stmi::Event::getTimeUsec()) or -1 if not known.
+	 */
+	void handleTimer(int64_t nTimeUsec) noexcept;
 
+	/** Whether within a game tick.
+	 * Also true during an input sub-tick.
+	 * @return Whether in game tick.
+	 */
 	bool isInGameTick() const noexcept { return m_bInGameTick; }
+	/** Whether input is dispatched between two game ticks.
+	 * See handleInput(const shared_ptr<stmi::Event>&).
+	 * @return Whether in input sub-tick.
+	 */
+	bool isInInputSubTick() const noexcept { return m_bInInputSubTick; }
+	/** Whether low latency input mode is enabled.
+	 * @return Whether input can be dispatched between game ticks.
+	 */
+	bool isLowLatencyInput() const noexcept { return m_bLowLatencyInput; }
 
 	/** The game interval.
 	 * In a game tick the current interval cannot be changed. Levels can
@@ -286,6 +323,11 @@ public:
 	 * @return The elapsed time (milliseconds).
 	 */
 	double gameElapsedMillisec() const noexcept { return m_fElapsedTime; }
+	/** The elapsed time since the game start before the last game tick.
+	 * Within a game tick this is the elapsed time before the previous one.
+	 * @return The elapsed time (milliseconds).
+	 */
+	double gamePrevElapsedMillisec() const noexcept { return m_fPrevElapsedTime; }
 	/** The elapsed time since the game start in intervals.
 	 * @return The elapsed time (ticks).
 	 */
@@ -325,6 +367,11 @@ public:
 	void gameStatusTechnical(int32_t nBadLevel, const std::vector<std::string>& aIssue) noexcept;
 
 	/** Send a message to other level's receivers.
+	 * Within a game tick the message is put in the inbox of each other level
+	 * and delivered when the game loop next processes that level (in the same
+	 * game tick). Receiving levels are processed in the order they were sent to,
+	 * so that delivery is deterministic. Outside of a game tick the message is
+	 * delivered immediately.
 	 * @param nSenderLevel The sender level. Usually the level of the event calling this function.
 	 * @param nMsg The message.
 	 * @param nValue The value.
@@ -435,6 +482,9 @@ private:
 
 	void dispatchInputs() noexcept;
 	void dispatchInput(const shared_ptr<stmi::Event>& refEvent) noexcept;
+	bool canDispatchInSubTick(const shared_ptr<stmi::Event>& refEvent) noexcept;
+	void dispatchInputInSubTick(const shared_ptr<stmi::Event>& refEvent) noexcept;
+	double calcTickOffset(int64_t nTimeUsec) const noexcept;
 	void createKeyAction(int32_t nLevel, int32_t nLevelTeam, int32_t nMate
 						, int32_t nKeyActionId, stmi::Event::AS_KEY_INPUT_TYPE eType
 						, int64_t nXYGrabId, const shared_ptr<stmi::Event>& refEvent) noexcept;
@@ -512,15 +562,34 @@ private:
 	int32_t m_nRankFailed;
 
 	bool m_bInGameTick;
+	bool m_bInInputSubTick;
 	int32_t m_nTick;
 
+	// FIFO of the levels that have to be processed in the events phase of the
+	// current game tick, [m_nLevelWorklistNext, size) are still pending
+	std::vector<int32_t> m_aLevelWorklist;
+	int32_t m_nLevelWorklistNext;
+	std::vector<bool> m_aLevelInWorklist; // Size: m_aLevel.size()
+
+#ifdef STMG_TICK_STATS
+	TickStats m_oTickStats;
+#endif //STMG_TICK_STATS
+
 	double m_fNextInterval; // The next game interval to use just after the current game tick, in millisec
 	double m_fLastInterval; // The current game interval to be used by the view just after the current game tick, in millisec
 
 	double m_fElapsedTime; // From start of game, in millisec (Sum of all m_nInterval so far)
+	double m_fPrevElapsedTime; // The value of m_fElapsedTime before the last game tick, in millisec
 
 	std::vector< shared_ptr<stmi::Event> > m_aInputQueue;
-	std::vector< shared_ptr<KeyActionEvent> > m_aInputRecycle;
+	bool m_bLowLatencyInput;
+	// The time of the last game tick (in input events' time base) or -1 if not known
+	// and the interval that followed it, in millisec
+	int64_t m_nLastTickTimeUsec;
+	double m_fLastTickInterval;
+	// The key action events passed to the levels
+	KeyActionRing m_oKeyActionRing;
+	static constexpr int32_t s_nKeyActionRingCapacity = 64;
 
 	shared_ptr<Layout> m_refLayout;
 
@@ -536,6 +605,8 @@ private:
 	std::vector< std::vector< OpenKeyAction > > m_aOpenKeyActions; // Size: prefs().getAppConfig()->TODO ???
 
 	bool m_bIsEventAssignedToActivePlayer;
+private:
+	void levelWorklistAdd(int32_t nLevel) noexcept;
 private: // no implementation
 	Game() = delete;
 	Game(const Game& oSource) = delete;
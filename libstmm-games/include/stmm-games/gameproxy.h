@@ -30,6 +30,9 @@
 #include <stdint.h>
 
 namespace stmg { class Named; }
+#ifdef STMG_TICK_STATS
+namespace stmg { class TickStats; }
+#endif //STMG_TICK_STATS
 namespace stmg { class RandomSource; }
 namespace stmg { class Variable; }
 namespace stmg { class GameSound; }
@@ -94,6 +97,11 @@ public:
 	 * @return Whether in game tick.
 	 */
 	bool isInGameTick() const noexcept;
+	/** Tells whether input is being dispatched between game ticks.
+	 * When true isInGameTick() is also true.
+	 * @return Whether in input sub-tick.
+	 */
+	bool isInInputSubTick() const noexcept;
 	/** Tell game the preferred next interval of the level has changed.
 	 * The game interval is the time between game ticks.
 	 * @param nLevel The level the preferred game interval has changed. Must be valid.
@@ -309,6 +317,13 @@ public:
 	 * @return The game highscores. Is empty if game not ended.
 	 */
 	Highscore const& getInGameHighscore() const noexcept;
+#ifdef STMG_TICK_STATS
+	/** The game tick statistics.
+	 * Only available if built with tick statistics (see TickStats).
+	 * @return The statistics of the current game.
+	 */
+	TickStats const& getTickStats() const noexcept;
+#endif //STMG_TICK_STATS
 private:
 	friend class Level;
 	friend class Layout;
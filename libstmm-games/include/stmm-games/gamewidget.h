@@ -21,6 +21,8 @@
 #ifndef STMG_GAME_WIDGET_H
 #define STMG_GAME_WIDGET_H
 
+#include "util/classids.h"
+
 #include <memory>
 //#include <iostream>
 #include <array>
@@ -172,6 +174,21 @@ public:
 	 * @return The index in Named.widgets(), if -1 not defined.
 	 */
 	inline int32_t getViewWidgetNameIdx() const noexcept { return m_oData.m_nViewWidgetNameIdx; }
+	/** The class id of the widget.
+	 * It is the id of the most derived class that called setClassId() in its
+	 * constructor. It can be used by Theme to select (and static cast to) the
+	 * model class without RTTI.
+	 * @return The class id as of classId(). Non negative.
+	 */
+	inline int32_t getClassId() const noexcept { return m_nClassId; }
+	/** The class id of a GameWidget subclass.
+	 * @return The class id. Non negative.
+	 */
+	template <class TGameWidget>
+	static int32_t classId() noexcept
+	{
+		return ClassIds<GameWidget>::get<TGameWidget>();
+	}
 	/** The name of the widget.
 	 * @return The name. Can be empty.
 	 */
@@ -233,6 +250,22 @@ protected:
 	 * @param oData The initialization data.
 	 */
 	void reInit(Init&& oData) noexcept;
+	/** Sets the class id of the widget.
+	 * To be called from the constructor of subclasses that want to be
+	 * identified by getClassId(). Subclasses that don't call it have the id
+	 * of their nearest ancestor that did. The first call for a class also
+	 * registers that ancestor as the parent (see ClassIds::isA()).
+	 * @param p0This The `this` pointer of the subclass constructor. Cannot be null.
+	 */
+	template <class TGameWidget>
+	void setClassId(const TGameWidget* p0This) noexcept
+	{
+		static_cast<void>(p0This);
+		// Here m_nClassId still is the id set by the parent's constructor
+		static const bool s_bParentSet = (ClassIds<GameWidget>::setParent(classId<TGameWidget>(), m_nClassId), true);
+		static_cast<void>(s_bParentSet);
+		m_nClassId = classId<TGameWidget>();
+	}
 	/** The layout the widget belongs to.
 	 * @return The layout. Undefined if the widget wasn't added to the layout yet.
 	 */
@@ -273,6 +306,7 @@ private:
 	Layout* m_p0Layout;
 
 	Init m_oData;
+	int32_t m_nClassId;
 private:
 	GameWidget(const GameWidget& oSource) = delete;
 	GameWidget& operator=(const GameWidget& oSource) = delete;
@@ -44,23 +44,43 @@ public:
 
 	inline stmi::Event::AS_KEY_INPUT_TYPE getType() const noexcept { return m_eType; }
 	inline int32_t getKeyAction() const noexcept { return m_nKeyAction; }
+	/** When the key action happened within the game interval.
+	 * The value is relative to the game tick preceding the action: 0.0 means
+	 * at that game tick, 1.0 at the next. It is computed from getTimeUsec()
+	 * whether the action is dispatched in an input sub-tick or at the start
+	 * of the next game tick, so that a block can apply it at the same instant
+	 * in both cases.
+	 * @return The offset from 0.0 to 1.0 or -1.0 if the time of the game tick isn't known.
+	 */
+	inline double getTickOffset() const noexcept { return m_fTickOffset; }
+	/** The game time at which the key action happened.
+	 * Like getTickOffset() it doesn't depend on whether the action is
+	 * dispatched in an input sub-tick or at the start of the next game tick.
+	 * If the time of the game tick isn't known it's the time of the game
+	 * tick in which the action would be dispatched.
+	 * @return The game time in milliseconds (see GameProxy::gameElapsedMillisec()).
+	 */
+	inline double getGameMillisec() const noexcept { return m_fGameMillisec; }
 	//
 	shared_ptr<stmi::Capability> getCapability() const noexcept override { return m_refCapability.lock(); }
 	//
 	static const char* const s_sClassId;
 	static const stmi::Event::Class& getClass() noexcept;
 protected:
-	friend class Game;
+	friend class KeyActionRing;
 	void setType(stmi::Event::AS_KEY_INPUT_TYPE eType) noexcept;
 	void setKeyAction(int32_t nKeyAction) noexcept;
 	/** Sets the capability of the key action event.
-	 * @param refCapability Cannot be null.
+	 * @param refCapability Can be null.
 	 */
 	void setCapability(const shared_ptr<stmi::Capability>& refCapability) noexcept;
+	void setTickOffset(double fTickOffset, double fGameMillisec) noexcept;
 private:
 	stmi::Event::AS_KEY_INPUT_TYPE m_eType;
 	int32_t m_nKeyAction;
 	weak_ptr<stmi::Capability> m_refCapability;
+	double m_fTickOffset;
+	double m_fGameMillisec;
 	//
 	static RegisterClass<KeyActionEvent> s_oInstall;
 private:
@@ -0,0 +1,118 @@
+/*
+ * Copyright © 2019-2020  Stefano Marsili, <stemars@gmx.ch>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>
+ */
+/*
+ * File:   keyactionring.h
+ */
+
+#ifndef STMG_KEY_ACTION_RING_H
+#define STMG_KEY_ACTION_RING_H
+
+#include "keyactionevent.h"
+
+#include <stmm-input/event.h>
+
+#include <memory>
+#include <vector>
+
+#include <stdint.h>
+
+namespace stmi { class Capability; }
+
+namespace stmg
+{
+
+using std::shared_ptr;
+using std::unique_ptr;
+
+/** Fixed capacity store of key action events.
+ * The events are all created by the constructor and then overwritten
+ * in circular order: writing an event neither allocates nor touches
+ * reference counts. The events are handed out as handles that can be copied
+ * freely and that know whether their slot was overwritten in the meantime.
+ *
+ * A handle stays valid until capacity() more events are written, so
+ * at least until the end of the game tick if the ring is big enough for
+ * all the key actions of a tick.
+ */
+class KeyActionRing
+{
+public:
+	class Handle
+	{
+	public:
+		/** Constructs an invalid handle.
+		 */
+		Handle() noexcept;
+		/** Whether the event is still available.
+		 * @return Whether the slot of the event wasn't overwritten or cleared.
+		 */
+		bool isValid() const noexcept;
+		/** The key action event.
+		 * The handle must be valid. The returned reference is only
+		 * valid as long as the handle: copy the needed values out of it.
+		 * @return The event.
+		 */
+		const KeyActionEvent& get() const noexcept;
+		inline const KeyActionEvent* operator->() const noexcept { return &get(); }
+	private:
+		friend class KeyActionRing;
+		Handle(const KeyActionRing* p0Ring, int32_t nSlot, int64_t nSerial) noexcept;
+	private:
+		const KeyActionRing* m_p0Ring;
+		int32_t m_nSlot;
+		int64_t m_nSerial;
+	};
+	/** Constructor.
+	 * @param nCapacity The number of events. Must be positive.
+	 */
+	explicit KeyActionRing(int32_t nCapacity) noexcept;
+
+	/** The (fixed) number of events.
+	 * @return The capacity.
+	 */
+	int32_t capacity() const noexcept;
+	/** Invalidates all the handed out handles.
+	 */
+	void clear() noexcept;
+	/** Writes an event into the next slot.
+	 * The handles to the overwritten event become invalid.
+	 * @param nTimeUsec The time of the key action.
+	 * @param refCapability The capability that generated the key action. Can be null.
+	 * @param eType The type. Must be stmi::Event::AS_KEY_PRESS, AS_KEY_RELEASE or AS_KEY_RELEASE_CANCEL.
+	 * @param nKeyAction The key action id. Must be &gt;= 0.
+	 * @param fTickOffset See KeyActionEvent::getTickOffset().
+	 * @param fGameMillisec See KeyActionEvent::getGameMillisec().
+	 * @return The handle to the written event.
+	 */
+	Handle write(int64_t nTimeUsec, const shared_ptr<stmi::Capability>& refCapability
+				, stmi::Event::AS_KEY_INPUT_TYPE eType, int32_t nKeyAction
+				, double fTickOffset, double fGameMillisec) noexcept;
+private:
+	KeyActionRing() = delete;
+
+	// The events can't be copied or moved: each is allocated once by the constructor
+	std::vector< unique_ptr<KeyActionEvent> > m_aEvents;
+	// The serial of the event in the slot or 0 if cleared
+	std::vector<int64_t> m_aSerials;
+	int32_t m_nNextSlot;
+	int64_t m_nLastSerial; // Not reset by clear() so that old handles never become valid again
+};
+
+} // namespace stmg
+
+#endif	/* STMG_KEY_ACTION_RING_H */
+
@@ -53,7 +53,6 @@
 #include <stdint.h>
 
 namespace stmg { class Coords; }
-namespace stmg { class KeyActionEvent; }
 namespace stmg { class Named; }
 namespace stmg { class TileCoords; }
 namespace stmg { class TileRect; }
@@ -338,15 +337,34 @@ public:
 	 */
 	LevelBlock* blocksGet(int32_t nId) noexcept;
 	/** All the ids if the active level blocks.
-	 * @return The ids.
+	 * @return The ids in the order the blocks were added.
 	 */
 	std::vector<int32_t> blocksGetAllIds() noexcept;
 	/** All the active level blocks.
 	 * This is supposed to be called once and then changes tracked by installing a
 	 * BlocksListener.
-	 * @return The level blocks. Are all non null.
+	 * @return The level blocks in the order they were added. Are all non null.
 	 */
 	std::vector<LevelBlock*> blocksGetAll() noexcept;
+	/** Calls a function for each active level block.
+	 * Unlike blocksGetAll() doesn't allocate.
+	 * The function may add or remove level blocks: removed blocks that weren't
+	 * visited yet are skipped, added blocks are visited.
+	 * @param oFun The function with signature `void (LevelBlock& oLevelBlock)`.
+	 */
+	template<class Fun>
+	void blocksForEach(const Fun& oFun) noexcept
+	{
+		++m_nLevelBlocksIterating;
+		// The size might grow while iterating
+		for (std::size_t nIdx = 0; nIdx < m_aLevelBlocks.size(); ++nIdx) {
+			LevelBlock* p0LevelBlock = m_aLevelBlocks[nIdx];
+			if (p0LevelBlock != nullptr) {
+				oFun(*p0LevelBlock);
+			}
+		}
+		blocksIterationEnd();
+	}
 
 	/** Add a listener to events from other levels.
 	 * If the listener already is added this function does nothing.
@@ -713,13 +731,17 @@ private:
 
 	void eventsQueueSetDirty(bool bDirty) noexcept;
 	bool eventsQueueIsDirty() const noexcept;
-	void othersReceive(int32_t nSenderLevel, int32_t nMsg, int32_t nValue) noexcept;
+	void othersReceive(int32_t nSenderLevel, int32_t nMsg, int32_t nValue, int32_t nDepth) noexcept;
+	void othersInboxDeliver() noexcept;
+	int32_t othersDeliveringDepth() const noexcept { return m_nOthersNestedCalls; }
 
 	LevelBlock* getControlled(int32_t nLevelTeam, int32_t nMate) noexcept;
 	//TODO Game dispatches inputs for all levels after all handlePreTimer (and before handleTimer) in the order they came in
 	//TODO Make additional specialization handleXYInput()
 	void handleInput(int32_t nLevelTeam, int32_t nMate, const shared_ptr<stmi::Event>& refEvent) noexcept;
-	void handleKeyActionInput(int32_t nLevelTeam, int32_t nMate, const shared_ptr<KeyActionEvent>& refEvent) noexcept;
+	void handleKeyActionInput(int32_t nLevelTeam, int32_t nMate, const KeyActionRing::Handle& oKeyAction) noexcept;
+	// Whether the player's controlled block (if any) can receive input between game ticks
+	bool isSubTickInputCapable(int32_t nLevelTeam, int32_t nMate) const noexcept;
 
 	void handlePreTimer() noexcept;
 	void handleTimer() noexcept;
@@ -757,7 +779,19 @@ private:
 		void clearOnlyTileAnis(int32_t nTileAnis) noexcept;
 	};
 
-	inline int32_t calcIndex(int32_t nPosX, int32_t nPosY) const noexcept { return nPosX + nPosY * m_nW; }
+	// m_aBoard and m_aOwner are ring buffers in both directions so that
+	// boardScroll() only has to move the offsets
+	inline int32_t calcRingX(int32_t nPosX) const noexcept
+	{
+		const int32_t nRingX = nPosX + m_nOffsetX;
+		return ((nRingX >= m_nW) ? nRingX - m_nW : nRingX);
+	}
+	inline int32_t calcRingY(int32_t nPosY) const noexcept
+	{
+		const int32_t nRingY = nPosY + m_nOffsetY;
+		return ((nRingY >= m_nH) ? nRingY - m_nH : nRingY);
+	}
+	inline int32_t calcIndex(int32_t nPosX, int32_t nPosY) const noexcept { return calcRingX(nPosX) + calcRingY(nPosY) * m_nW; }
 
 	static bool orderLevelBlocks(LevelBlock* p0Lhs, LevelBlock* p0Rhs) noexcept
 	{
@@ -785,6 +819,8 @@ private:
 
 	void blockAddCommon(LevelBlock* p0LevelBlock) noexcept;
 	void blockRemoveCommon(LevelBlock* p0LevelBlock) noexcept;
+	void blocksIterationEnd() noexcept;
+	void blocksCompactIfSparse() noexcept;
 
 	void blockAddToControllable(LevelBlock* p0LevelBlock, int32_t nControllerTeam, int32_t nNotTeam) noexcept;
 	void blockAssignControlToLongestWaitingMate(LevelBlock* p0LevelBlock, int32_t nControllerTeam, int32_t nNotTeam) noexcept;
@@ -798,6 +834,7 @@ private:
 	template<class T>
 	void boardMoveVector(std::vector<T>& aVec, Direction::VALUE eDir, NRect oArea
 						, int32_t& nInsertX, int32_t& nInsertY) noexcept;
+	void boardMoveOffsets(Direction::VALUE eDir, int32_t& nInsertX, int32_t& nInsertY) noexcept;
 	void boardSetInserted(NRect oArea
 						, int32_t nInsertX, int32_t nInsertY, const shared_ptr<TileRect>& refTiles) noexcept;
 
@@ -816,8 +853,10 @@ private:
 	int32_t m_nW;
 	int32_t m_nH;
 	int32_t m_nTotTileAnis;
-	std::vector<Cell> m_aBoard; // size: m_nW * m_nH
-	std::vector<LevelBlock*> m_aOwner; // size: m_nW * m_nH
+	std::vector<Cell> m_aBoard; // size: m_nW * m_nH, use calcIndex()
+	std::vector<LevelBlock*> m_aOwner; // size: m_nW * m_nH, use calcIndex()
+	int32_t m_nOffsetX; // The ring buffer column of board x 0
+	int32_t m_nOffsetY; // The ring buffer row of board y 0
 
 	Private::ListenerStk<BoaBloListener> m_oBoaBloListenerStk;
 	Private::ListenerStk<BoardListener> m_oBoardListenerStk;
@@ -835,12 +874,18 @@ private:
 	std::list<Event*> m_oInactiveEvents;
 
 	std::vector< unique_ptr<Event> > m_aEvents;
-	NamedObjIndex<Event*> m_oEventIds;
+	AssignableNamedObjIndex<Event*> m_oEventIds;
 
 	LevelShow m_oShow;
 	bool m_bSubshowMode;
 
 	std::unordered_map<int32_t, LevelBlock*> m_oAllLevelBlocks; // key: LevelBlock::getId()
+	// The active level blocks in the order they were added (index: LevelBlock::m_nLevelBlockIdx).
+	// While iterating removed blocks leave a nullptr hole so that indexes stay valid,
+	// holes are compacted when no iteration is ongoing.
+	std::vector<LevelBlock*> m_aLevelBlocks;
+	int32_t m_nLevelBlocksHoles; // number of nullptr in m_aLevelBlocks
+	int32_t m_nLevelBlocksIterating; // nesting of m_aLevelBlocks iterations
 	struct MateData {
 		LevelBlock* m_p0Controlled; // LevelBlock* is element of TeamData::m_oOrderedControllable
 		int32_t m_nLastTimeInControl;
@@ -871,9 +916,17 @@ private:
 	std::vector<int32_t> m_aHelperMinTeam; // Size: m_nTotLevelPlayers
 	std::vector<int32_t> m_aHelperMinTeammate; // Size: m_nTotLevelPlayers
 
-	int32_t m_nOthersNestedCalls;
+	int32_t m_nOthersNestedCalls; // The depth of the others message being delivered or 0
 	bool m_bDirtyEvents;
 	std::list<Event*> m_oOthersListeners; // Value: can be nullptr temporarily until next others
+	struct OthersMsg
+	{
+		int32_t m_nMsg;
+		int32_t m_nValue;
+		int32_t m_nDepth; // 1 if sent by a level not itself delivering an others message
+	};
+	std::vector<OthersMsg> m_aOthersInbox; // The messages received from other levels not yet delivered
+	std::vector<OthersMsg> m_aOthersDelivering; // Swapped with m_aOthersInbox while delivering
 
 	std::vector<int32_t> m_aDelayedLevAniIds;
 	std::vector< shared_ptr<LevelAnimation> > m_aDelayedLevAnis; // When delay is smaller than gameTick, they become active
@@ -899,8 +952,9 @@ private:
 			TextAnimation::reInit(std::move(oInit));
 		}
 	};
-	static Recycler<PrivateTextAnimation, TextAnimation> s_oTextAnimationRecycler;
-	static Recycler<TileCoords> s_oTileCoordsRecycler;
+	// Per instance so that levels of different games can run on different threads
+	Recycler<PrivateTextAnimation, TextAnimation> m_oTextAnimationRecycler;
+	Recycler<TileCoords> m_oTileCoordsRecycler;
 
 	int32_t m_nTotGameEndedTeams;
 	static const std::string s_sGameOverPlayerOut;
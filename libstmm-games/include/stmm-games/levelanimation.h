@@ -23,7 +23,9 @@
 
 #include "util/direction.h"
 #include "util/basictypes.h"
+#include "util/classids.h"
 
+#include <atomic>
 #include <utility>
 
 #include <stdint.h>
@@ -54,10 +56,25 @@ public:
 	inline bool isActive() const noexcept { return (m_p0Level != nullptr); }
 	/** The optional view animation name index.
 	 * This value can be used to select the view that draws this animation model.
-	 * If not set only the (RTTI) type of the this animation object is taken into account.
+	 * If not set only the class of this animation object (see getClassId()) is taken into account.
 	 * @return The name index (or -1 if not set).
 	 */
 	inline int32_t getViewAnimationNameIdx() const noexcept { return m_nAnimationIdx; }
+	/** The class id of the animation.
+	 * It is the id of the most derived class that called setClassId() in its
+	 * constructor. It can be used by views to select (and static cast to) the
+	 * model class without RTTI.
+	 * @return The class id as of classId(). Non negative.
+	 */
+	inline int32_t getClassId() const noexcept { return m_nClassId; }
+	/** The class id of a LevelAnimation subclass.
+	 * @return The class id. Non negative.
+	 */
+	template <class TLevelAnimation>
+	static int32_t classId() noexcept
+	{
+		return ClassIds<LevelAnimation>::get<TLevelAnimation>();
+	}
 
 	/** Reference system extended enumeration.
 	 * In subshow mode animations can also be drawn in the subshow square and
@@ -140,6 +157,22 @@ protected:
 	 * See constructor.
 	 */
 	void reInit(const Init& oInit) noexcept;
+	/** Sets the class id of the animation.
+	 * To be called from the constructor of subclasses that want to be
+	 * identified by getClassId(). Subclasses that don't call it have the id
+	 * of their nearest ancestor that did. The first call for a class also
+	 * registers that ancestor as the parent (see ClassIds::isA()).
+	 * @param p0This The `this` pointer of the subclass constructor. Cannot be null.
+	 */
+	template <class TLevelAnimation>
+	void setClassId(const TLevelAnimation* p0This) noexcept
+	{
+		static_cast<void>(p0This);
+		// Here m_nClassId still is the id set by the parent's constructor
+		static const bool s_bParentSet = (ClassIds<LevelAnimation>::setParent(classId<TLevelAnimation>(), m_nClassId), true);
+		static_cast<void>(s_bParentSet);
+		m_nClassId = classId<TLevelAnimation>();
+	}
 
 public:
 	/** The duration in milliseconds.
@@ -217,9 +250,10 @@ private:
 	void setLevel(Level* p0Level) noexcept;
 private:
 	int32_t m_nId;
-	static int32_t s_nId;
+	static std::atomic<int32_t> s_nId;
 
 	int32_t m_nAnimationIdx;
+	int32_t m_nClassId;
 	double m_fDuration;
 	FPoint m_oPos;
 	int32_t m_nZ;
@@ -22,11 +22,13 @@
 #define STMG_LEVEL_BLOCK_H
 
 #include "block.h"
+#include "keyactionring.h"
 
 #include "util/coords.h"
 #include "util/direction.h"
 #include "util/basictypes.h"
 
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <list>
@@ -36,7 +38,6 @@
 
 #include <stdint.h>
 
-namespace stmg { class KeyActionEvent; }
 namespace stmg { class Tile; }
 namespace stmi { class Event; }
 
@@ -339,11 +340,27 @@ protected:
 	 * @param refEvent The received event. Cannot be null.
 	 */
 	virtual void handleInput(const shared_ptr<stmi::Event>& refEvent) noexcept;
-	/** KeyActionevent handler.
+	/** KeyActionEvent handler.
 	 * The base implementation does nothing.
-	 * @param refEvent The key action event. Cannot be null.
+	 *
+	 * The event is stored in the game's KeyActionRing and eventually overwritten:
+	 * if needed after this call either copy its values or keep a copy of the handle
+	 * and check KeyActionRing::Handle::isValid() before using it.
+	 * @param oKeyAction The handle to the key action event. Is valid.
+	 */
+	virtual void handleKeyActionInput(const KeyActionRing::Handle& oKeyAction) noexcept;
+	/** Whether the block can receive input between game ticks.
+	 * Only used if the game is in low latency input mode. The input is then
+	 * dispatched in an input sub-tick (see Game::isInInputSubTick()), as soon
+	 * as it is received. The block should only react by moving or rotating
+	 * (or other changes it would also do at the start of a game tick)
+	 * and use KeyActionEvent::getTickOffset() or KeyActionEvent::getGameMillisec()
+	 * to know when the action happened.
+	 *
+	 * The base implementation returns false.
+	 * @return Whether handleInput() and handleKeyActionInput() can be called between game ticks.
 	 */
-	virtual void handleKeyActionInput(const shared_ptr<KeyActionEvent>& refEvent) noexcept;
+	virtual bool isSubTickInputCapable() const noexcept;
 
 	/** Function called each game tick.
 	 * This function is called before LevelBlock::fall() if the block is falling on a
@@ -430,7 +447,7 @@ private:
 	void resetPrivateJustTileAnis(int32_t nTileAnis) noexcept;
 private:
 	const int32_t m_nId;
-	static int32_t s_nId;
+	static std::atomic<int32_t> s_nId;
 
 	Level* m_p0Level;
 
@@ -459,6 +476,7 @@ private:
 
 	int32_t m_nLastTimerCall;
 	int32_t m_nLastFallCall;
+	int32_t m_nLevelBlockIdx; // Index into Level::m_aLevelBlocks, accessed by Level
 
 	struct BrickAni {
 		TileAnimator* m_p0TileAnimator;
@@ -68,6 +68,13 @@ public:
 	{
 		return m_oListeners.empty();
 	}
+	/** The number of distinct listeners.
+	 * @return The number of listeners.
+	 */
+	inline int32_t getTotListeners() noexcept
+	{
+		return static_cast<int32_t>(m_oListeners.size());
+	}
 	/** Add a listener.
 	 * If the same listener is added more than once a reference count is increased.
 	 * Regardless of the reference count the listener "Pre" and "Post" functions
@@ -115,6 +122,14 @@ public:
 			it->second = nCount - 1;
 		}
 	}
+	/** Remove all the listeners regardless of their reference count.
+	 * Must not be called while a "Pre" or "Post" function is being called.
+	 */
+	void clear() noexcept
+	{
+		assert(m_oInUsePreCalled.empty());
+		m_oListeners.clear();
+	}
 	/** Opaque structure used to match pre and post action calls.
 	 */
 	struct PreCalled {
@@ -466,6 +466,10 @@ private:
 	const shared_ptr<Player>& getCapabilityPlayer(int32_t nCapabilityId) const noexcept;
 	bool getPlayerKeyActionFromCapabilityKey(int32_t nCapabilityId, stmi::HARDWARE_KEY eKey
 											, std::unordered_map<stmi::HARDWARE_KEY, std::pair< shared_ptr<Player>, int32_t > >::const_iterator& itFindKey) const noexcept;
+	struct KeyActionTableEntry;
+	// returns null if the capability key is not assigned to a key action. Only in runtime mode.
+	const KeyActionTableEntry* getKeyActionTableEntry(int32_t nCapabilityId, stmi::HARDWARE_KEY eKey) const noexcept;
+	void compileKeyActionTable() noexcept;
 	// BEWARE! When allocated a player is already counted in getTotPlayers()
 	// even though it isn't yet added to a team!
 	shared_ptr<Player> playerAlloc() noexcept;
@@ -574,6 +578,24 @@ private:
 	// - m_refStdConfig->isEventAssignedToActivePlayer() is true  and
 	// - there is exactly one human player
 	shared_ptr<Player> m_refDefaultPlayer;
+
+	// The key actions of m_aCapabilityClassData compiled for fast lookup when
+	// the game is running (runtime mode).
+	struct KeyActionTableEntry
+	{
+		int32_t m_nTeam = -1;
+		int32_t m_nMate = -1;
+		int32_t m_nKeyActionId = -1; // -1 if the hardware key isn't assigned
+	};
+	struct KeyActionTableCapability
+	{
+		int32_t m_nStart = 0; // Index of the first entry in m_aKeyActionTable
+		int32_t m_nTotKeys = 0; // Number of entries, index is stmi::HARDWARE_KEY
+	};
+	// Index: capability id (these are small sequential numbers)
+	std::vector<KeyActionTableCapability> m_aKeyActionTableCapabilities;
+	// The entries of all the capabilities with at least a key action
+	std::vector<KeyActionTableEntry> m_aKeyActionTable;
 private:
 	StdPreferences() = delete;
 };
@@ -0,0 +1,181 @@
+/*
+ * Copyright © 2019-2020  Stefano Marsili, <stemars@gmx.ch>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>
+ */
+/*
+ * File:   tickstats.h
+ */
+
+#ifndef STMG_TICK_STATS_H
+#define STMG_TICK_STATS_H
+
+#ifdef STMG_TICK_STATS
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <typeindex>
+
+#include <stdint.h>
+
+namespace stmg
+{
+
+/** Game tick statistics.
+ * Records the duration of the phases of each game tick, the number of times
+ * each Event subclass was triggered (and how long it took) and the number of
+ * listener dispatches of the Level's board and block actions.
+ *
+ * The class only exists if STMG_TICK_STATS is defined, which the cmake option
+ * BUILD_WITH_TICK_STATS does both for the library and its clients
+ * (through the target's compile definitions and the pkg-config Cflags).
+ * Otherwise neither the class nor Game::getTickStats() are compiled, so that
+ * a normal build carries no cost at all.
+ *
+ * Each Game has its own statistics rather than the thread recording to
+ * a buffer of its own: games running in parallel in different threads
+ * are kept apart and there is nothing to merge.
+ * Statistics are only recorded within Game::handleTimer(). The instance being
+ * recorded to is made current in a thread local variable for the duration
+ * of the game tick, so that recording doesn't need any locking. This also
+ * means the statistics should only be queried from the thread running the game,
+ * between game ticks.
+ */
+class TickStats
+{
+public:
+	/** The recorded phases of a game tick. */
+	enum PHASE
+	{
+		PHASE_INPUTS = 0 /**< Dispatching inputs to the levels. */
+		, PHASE_BLOCKS = 1 /**< Level::handleTimer(), calling LevelBlock::handleTimer() and fall(). */
+		, PHASE_EVENTS = 2 /**< Level::handleTimerEvents(), triggering the active events. */
+		, PHASE_POST = 3 /**< Level::handlePostTimer(). */
+	};
+	static constexpr int32_t s_nTotPhases = 4;
+	/** The recorded listener dispatches. */
+	enum DISPATCH
+	{
+		DISPATCH_BOARD_SCROLL = 0 /**< Level::boardScroll(). */
+		, DISPATCH_BOARD_INSERT = 1 /**< Level::boardInsert(). */
+		, DISPATCH_BOARD_MODIFY = 2 /**< Level::boardModify(). */
+		, DISPATCH_BOARD_DESTROY = 3 /**< Level::boardDestroy(). */
+		, DISPATCH_BLOCK_ADD = 4 /**< Level::blockAdd(). */
+		, DISPATCH_BLOCK_REMOVE = 5 /**< Level::blockRemove(). */
+		, DISPATCH_BLOCK_DESTROY = 6 /**< Level::blockDestroy(). */
+		, DISPATCH_BLOCK_FUSE = 7 /**< Level::blockFuse(). */
+		, DISPATCH_BLOCK_FREEZE = 8 /**< Level::blockFreeze(). */
+		, DISPATCH_BLOCK_UNFREEZE = 9 /**< Level::boabloUnfreeze(). */
+	};
+	static constexpr int32_t s_nTotDispatches = 10;
+	/** The maximum number of game ticks kept by getRecentTicks(). */
+	static constexpr int32_t s_nMaxRecentTicks = 256;
+
+	/** The durations of a game tick. */
+	struct Tick
+	{
+		int32_t m_nGameTick = -1; /**< The game tick as returned by GameProxy::gameElapsed(). */
+		int64_t m_nTotalNanosec = 0; /**< The duration of the whole game tick. */
+		int64_t m_aPhaseNanosec[s_nTotPhases] = {0, 0, 0, 0}; /**< The duration of each PHASE. */
+	};
+	/** The statistics of a phase. */
+	struct PhaseStats
+	{
+		int64_t m_nTotalNanosec = 0; /**< The sum of the phase durations in all ticks. */
+		int64_t m_nMaxNanosec = 0; /**< The longest duration of the phase in a tick. */
+	};
+	/** The statistics of an Event subclass. */
+	struct EventClassStats
+	{
+		std::string m_sClassName; /**< The (demangled if possible) class name. */
+		int64_t m_nTriggers = 0; /**< The number of times Event::trigger() was called. */
+		int64_t m_nNanosec = 0; /**< The time spent in Event::trigger(), including nested triggers. */
+	};
+	/** The statistics of a listener dispatch. */
+	struct DispatchStats
+	{
+		int64_t m_nDispatches = 0; /**< The number of times the action was performed. */
+		int64_t m_nListenerCalls = 0; /**< The number of listeners notified by the dispatches. */
+	};
+
+	TickStats() noexcept;
+
+	/** Clear all the statistics.
+	 * Must not be called within a game tick.
+	 */
+	void clear() noexcept;
+
+	/** The number of recorded game ticks.
+	 * @return The number of ticks.
+	 */
+	int64_t getTotTicks() const noexcept { return m_nTotTicks; }
+	/** The most recently recorded game ticks.
+	 * @return The ticks, the oldest first. At most s_nMaxRecentTicks.
+	 */
+	std::vector<Tick> getRecentTicks() const noexcept;
+	/** The statistics of a phase over all the recorded ticks.
+	 * @param ePhase The phase.
+	 * @return The statistics.
+	 */
+	const PhaseStats& getPhaseStats(PHASE ePhase) const noexcept;
+	/** The statistics of all the triggered Event subclasses.
+	 * @return The statistics in the order the classes were first triggered.
+	 */
+	const std::vector<EventClassStats>& getEventClassStats() const noexcept { return m_aEventClasses; }
+	/** The statistics of a listener dispatch.
+	 * @param eDispatch The dispatch.
+	 * @return The statistics.
+	 */
+	const DispatchStats& getDispatchStats(DISPATCH eDispatch) const noexcept;
+
+	/** The statistics as a JSON object.
+	 * @return The JSON string.
+	 */
+	std::string toJson() const noexcept;
+
+	/** Phase name as used by toJson().
+	 * @param ePhase The phase.
+	 * @return The name. Not empty.
+	 */
+	static const char* getPhaseName(PHASE ePhase) noexcept;
+	/** Dispatch name as used by toJson().
+	 * @param eDispatch The dispatch.
+	 * @return The name. Not empty.
+	 */
+	static const char* getDispatchName(DISPATCH eDispatch) noexcept;
+private:
+	friend class TickStatsRecorder;
+	Tick& tickBegin(int32_t nGameTick) noexcept;
+	void tickEnd(Tick& oTick, int64_t nTotalNanosec) noexcept;
+	int32_t eventClassIdx(const std::type_info& oTypeInfo) noexcept;
+private:
+	int64_t m_nTotTicks;
+	// Ring buffer of the recent ticks (allocated on first recorded tick)
+	std::vector<Tick> m_aRecentTicks;
+	int32_t m_nRecentTicksNext;
+	PhaseStats m_aPhases[s_nTotPhases];
+	std::vector<EventClassStats> m_aEventClasses;
+	std::unordered_map<std::type_index, int32_t> m_oEventClassIdx; // Key: class, Value: index into m_aEventClasses
+	DispatchStats m_aDispatches[s_nTotDispatches];
+private:
+	TickStats(const TickStats& oSource) = delete;
+	TickStats& operator=(const TickStats& oSource) = delete;
+};
+
+} // namespace stmg
+
+#endif //STMG_TICK_STATS
+
+#endif	/* STMG_TICK_STATS_H */
@@ -0,0 +1,128 @@
+/*
+ * Copyright © 2019-2020  Stefano Marsili, <stemars@gmx.ch>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>
+ */
+/*
+ * File:   classids.h
+ */
+
+#ifndef STMG_CLASS_IDS_H
+#define STMG_CLASS_IDS_H
+
+#include <atomic>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+#include <cassert>
+
+#include <stdint.h>
+
+namespace stmg
+{
+
+/** Dense ids for the subclasses of a base class.
+ * Each class gets its id the first time it is requested. The ids of a base class
+ * are consecutive and start from 0, so they can be used as indexes into
+ * a vector instead of using RTTI (typeid or dynamic_cast).
+ *
+ * The ids may differ between runs of the program.
+ *
+ * If the parent of each class is registered with setParent(), isA()
+ * can tell whether an id belongs to a subclass of another.
+ */
+template <class TBase>
+class ClassIds final
+{
+public:
+	/** The id of a class.
+	 * @return The id. Non negative.
+	 */
+	template <class TClass>
+	static int32_t get() noexcept
+	{
+		static_assert(std::is_base_of<TBase, TClass>::value, "Wrong type.");
+		static const int32_t s_nClassId = s_nTotClassIds.fetch_add(1);
+		return s_nClassId;
+	}
+	/** The number of ids assigned so far.
+	 * @return The number of ids.
+	 */
+	static int32_t getTotClassIds() noexcept
+	{
+		return s_nTotClassIds.load();
+	}
+	/** Registers the parent of a class.
+	 * Should be called at most once per class.
+	 * @param nClassId The class id. Must be valid.
+	 * @param nParentClassId The id of the nearest registered ancestor or -1 if none.
+	 */
+	static void setParent(int32_t nClassId, int32_t nParentClassId) noexcept
+	{
+		assert(nClassId >= 0);
+		assert(nParentClassId != nClassId);
+		Parents& oParents = parents();
+		std::lock_guard<std::mutex> oLock(oParents.m_oMutex);
+		if (nClassId >= static_cast<int32_t>(oParents.m_aParentIds.size())) {
+			oParents.m_aParentIds.resize(nClassId + 1, -1);
+		}
+		oParents.m_aParentIds[nClassId] = nParentClassId;
+	}
+	/** Whether a class is the same as or derived from another.
+	 * Only the parents registered with setParent() are followed.
+	 * @param nClassId The class id. Must be valid.
+	 * @param nAncestorClassId The possible ancestor class id. Must be valid.
+	 * @return Whether nClassId is nAncestorClassId or one of its subclasses.
+	 */
+	static bool isA(int32_t nClassId, int32_t nAncestorClassId) noexcept
+	{
+		assert(nClassId >= 0);
+		assert(nAncestorClassId >= 0);
+		if (nClassId == nAncestorClassId) {
+			return true; //-----------------------------------------------------
+		}
+		Parents& oParents = parents();
+		std::lock_guard<std::mutex> oLock(oParents.m_oMutex);
+		const int32_t nTotParentIds = static_cast<int32_t>(oParents.m_aParentIds.size());
+		while ((nClassId >= 0) && (nClassId < nTotParentIds)) {
+			nClassId = oParents.m_aParentIds[nClassId];
+			if (nClassId == nAncestorClassId) {
+				return true; //-------------------------------------------------
+			}
+		}
+		return false;
+	}
+private:
+	struct Parents
+	{
+		std::mutex m_oMutex;
+		std::vector<int32_t> m_aParentIds; // Index: class id, Value: parent class id or -1
+	};
+	static Parents& parents() noexcept
+	{
+		static Parents s_oParents;
+		return s_oParents;
+	}
+private:
+	static std::atomic<int32_t> s_nTotClassIds;
+private:
+	ClassIds() = delete;
+};
+
+template <class TBase>
+std::atomic<int32_t> ClassIds<TBase>::s_nTotClassIds{0};
+
+} // namespace stmg
+
+#endif	/* STMG_CLASS_IDS_H */
@@ -117,8 +117,17 @@ public:
 	 */
 	void inc(int32_t nInc) noexcept;
 	/** Tells whether the variable changed in the current game tick.
+	 * Outside of a game tick (from a view tick) tells whether the value
+	 * changed in the last game tick. A time relative variable only changes
+	 * when the elapsed game time crosses a unit of its time base or when set.
 	 */
 	bool isChanged() const noexcept;
+	/** The game time at which the value of a time relative variable changes next.
+	 * Setting the variable can of course change it earlier.
+	 * @return The elapsed game time in milliseconds or -1 if the variable
+	 *         isn't time relative or its value is frozen.
+	 */
+	int32_t getNextChangeMillisec() const noexcept;
 	/** Returns the type of the variable.
 	 * @return The type.
 	 */
@@ -133,6 +142,8 @@ private:
 	friend class Level;
 
 	int32_t calcElapsed() const noexcept;
+	int32_t calcElapsed(int32_t nElapsedMillisec) const noexcept;
+	int32_t calcNextChangeMillisec(int32_t nElapsedMillisec) const noexcept;
 
 	/* Value should freeze, even if time relative. */
 	void inhibit() noexcept;
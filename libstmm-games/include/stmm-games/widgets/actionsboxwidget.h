@@ -146,6 +146,7 @@ public:
 	: BoxWidget(std::move(oInit))
 	, m_oData(std::move(oInit))
 	{
+		setClassId(this);
 		adjustData();
 		checkActions();
 	}
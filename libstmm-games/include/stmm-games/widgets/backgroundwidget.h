@@ -68,6 +68,7 @@ public:
 	: ContainerWidget(std::move(oInit))
 	, m_oData(std::move(oInit))
 	{
+		setClassId(this);
 		assert(m_oData.m_nImgId >= 0);
 		assert(getChildren().size() == 1);
 	}
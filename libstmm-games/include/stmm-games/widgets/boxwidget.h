@@ -103,6 +103,7 @@ public:
 	: ContainerWidget(std::move(oInit))
 	, m_oData(std::move(oInit))
 	{
+		setClassId(this);
 		assert(getChildren().size() > 0);
 	}
 
@@ -53,6 +53,7 @@ public:
 	: BoxWidget(std::move(oInit))
 	, m_oData(std::move(oInit))
 	{
+		setClassId(this);
 		assert(!m_oData.m_sTargetWidgetName.empty());
 	}
 
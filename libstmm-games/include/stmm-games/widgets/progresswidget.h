@@ -105,6 +105,7 @@ public:
 	: RelSizedGameWidget(std::move(oInit))
 	, m_oData(std::move(oInit))
 	{
+		setClassId(this);
 		checkParams();
 //std::cout << "  ++++m_oData.m_nVarDigits=" << m_oData.m_nVarDigits << "  this=" << reinterpret_cast<int64_t>(this) << '\n';
 	}
@@ -48,6 +48,7 @@ public:
 	explicit TransparentWidget(Init&& oInit) noexcept
 	: RelSizedGameWidget(std::move(oInit))
 	{
+		setClassId(this);
 	}
 	void dump(int32_t nIndentSpaces, bool bHeader) const noexcept override;
 protected:
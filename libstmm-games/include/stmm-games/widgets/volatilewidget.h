@@ -86,6 +86,7 @@ public:
 	: ContainerWidget(std::move(oInit))
 	, m_oData(std::move(oInit))
 	{
+		setClassId(this);
 		reInitCommon();
 	}
 
@@ -37,6 +37,7 @@ BackgroundAnimation::BackgroundAnimation(const Init& oInit) noexcept
 , m_nImgId(-1)
 , m_nPosLastChangeTick(-1)
 {
+	setClassId(this);
 }
 void BackgroundAnimation::reInit(const Init& oInit) noexcept
 {
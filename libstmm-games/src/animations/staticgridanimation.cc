@@ -30,6 +30,7 @@ StaticGridAnimation::StaticGridAnimation(Init&& oInit) noexcept
 : LevelAnimation(oInit)
 , m_oLocalInit(std::move(oInit))
 {
+	setClassId(this);
 	commonInit();
 }
 void StaticGridAnimation::reInit(Init&& oInit) noexcept
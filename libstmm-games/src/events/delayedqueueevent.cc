@@ -42,6 +42,7 @@ void DelayedQueueEvent::reInit(Init&& oInit) noexcept
 {
 	Event::reInit(std::move(oInit));
 	m_oData = std::move(oInit);
+	m_aQueue.clear();
 	commonInit();
 }
 void DelayedQueueEvent::commonInit() noexcept
@@ -152,8 +152,9 @@ void PositionerEvent::trigger(int32_t nMsg, int32_t /*nValue*/, Event* p0Trigger
 void PositionerEvent::initTracking() noexcept
 {
 //std::cout << "PositionerEvent::initTracking()" << '\n';
-	auto aLBs = level().blocksGetAll();
-	for (LevelBlock*& p0LevelBlock : aLBs) {
+	level().blocksForEach([&](LevelBlock& oLevelBlock)
+	{
+		LevelBlock* p0LevelBlock = &oLevelBlock;
 		const int32_t nLevelPlayer = p0LevelBlock->getPlayer();
 //std::cout << "PositionerEvent::initTracking()  nLevelPlayer=" << nLevelPlayer << '\n';
 		if (nLevelPlayer >= 0) {
@@ -171,7 +172,7 @@ void PositionerEvent::initTracking() noexcept
 				aLBIds.push_back(nLBId);
 			}
 		}
-	}
+	});
 	level().blocksAddPlayerChangeListener(this);
 	for (auto& oShowPosition : m_aShowPositions) {
 		auto& p0LS = oShowPosition.m_p0LevelShow;
@@ -26,6 +26,7 @@
 #include <cassert>
 #include <iostream>
 #include <cmath>
+#include <mutex>
 #include <algorithm>
 #include <cstdint>
 #include <utility>
@@ -35,6 +36,7 @@ namespace stmg
 {
 
 std::vector<RandomEvent::SharedRandom> RandomEvent::m_aSharedRandoms{};
+std::mutex RandomEvent::s_oSharedRandomsMutex{};
 
 void RandomEvent::RandomSequence::initPartitions() noexcept
 {
@@ -182,6 +184,8 @@ shared_ptr<RandomEvent::RandomSequence> RandomEvent::getRandomSequence() noexcep
 }
 shared_ptr<RandomEvent::RandomSequence> RandomEvent::getSharedRandomSequence(int64_t nGameId, const std::string& sSharedName, int32_t nBufferSize) noexcept
 {
+	// The sequence itself is only used by the game with id nGameId
+	std::lock_guard<std::mutex> oLock(s_oSharedRandomsMutex);
 	int32_t nFreeIdx = -1;
 	const int32_t nSize = static_cast<int32_t>(m_aSharedRandoms.size());
 	for (int32_t nIdx = 0; nIdx < nSize; ++nIdx) {
@@ -45,7 +45,7 @@ namespace stmg { class TileAnimator; }
 namespace stmg
 {
 
-static std::string s_sTileAniRemoving = "TILEANI:REMOVING";
+static const std::string s_sTileAniRemoving = "TILEANI:REMOVING";
 
 ScrollerEvent::ScrollerEvent(Init&& oInit) noexcept
 : Event(std::move(oInit))
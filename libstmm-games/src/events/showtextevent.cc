@@ -36,7 +36,6 @@
 namespace stmg
 {
 
-Recycler<ShowTextEvent::PrivateTextAnimation, TextAnimation> ShowTextEvent::s_oTextAnimationRecycler{};
 
 ShowTextEvent::ShowTextEvent(Init&& oInit) noexcept
 : Event(std::move(oInit))
@@ -219,7 +218,7 @@ void ShowTextEvent::animationCreateShowText(std::vector<std::string>&& aLines, d
 	oInit.m_nZ = m_oData.m_nZ;
 	oInit.m_aLines = std::move(aLines);
 	oInit.m_fFontHeight = m_oData.m_fTextSize;
-	s_oTextAnimationRecycler.create(m_refCurrentShowText, std::move(oInit));
+	m_oTextAnimationRecycler.create(m_refCurrentShowText, std::move(oInit));
 
 	level().animationAdd(m_refCurrentShowText, m_oData.m_eRefSys, 0.0);
 }
@@ -47,14 +47,22 @@ namespace stmg
 {
 
 const int32_t TileAnimatorEvent::s_nMaxTry = 3;
+const int32_t TileAnimatorEvent::s_nWheelSize = 64;
 
 static const std::vector<int32_t> s_aEmptyVector{};
 
-template <class TValue>
-void vectorRemoveIndex(std::vector<TValue>& oV, int32_t nIdx) noexcept
+// Removes the value at nIdx by moving the last value in its place
+// Returns the moved value or -1 if nIdx was the last
+static int32_t vectorRemoveIndex(std::vector<int32_t>& aV, int32_t nIdx) noexcept
 {
-	oV[nIdx] = std::move(oV[oV.size() - 1]);
-	oV.pop_back();
+	const int32_t nLastIdx = static_cast<int32_t>(aV.size()) - 1;
+	int32_t nMoved = -1;
+	if (nIdx != nLastIdx) {
+		nMoved = aV[nLastIdx];
+		aV[nIdx] = nMoved;
+	}
+	aV.pop_back();
+	return nMoved;
 }
 
 TileAnimatorEvent::TileAnimatorEvent(Init&& oInit) noexcept
@@ -71,6 +79,8 @@ void TileAnimatorEvent::reInit(Init&& oInit) noexcept
 //std::cout << "                  nDurationFrom=" << nDurationFrom << "   nDurationTo=" << nDurationTo << '\n';
 //std::cout << "                  nPauseFrom=" << nPauseFrom << "   nPauseTo=" << nPauseTo << '\n';
 //std::cout << "                  nTotCountFrom=" << nTotCountFrom << "   nTotCountTo=" << nTotCountTo << '\n';
+	// A recycled event might still hold the slots of a running animator
+	deInit();
 	Event::reInit(std::move(oInit));
 	m_oInit = std::move(oInit);
 
@@ -85,6 +95,11 @@ void TileAnimatorEvent::commonInit() noexcept
 	m_nCounter = 0;
 	m_nLastReportedRunningAnis = 0;
 
+	m_nFreeSlot = -1;
+	m_nTotWaiting = 0;
+	m_nWheelTick = -1;
+	m_aWaitingWheel.resize(s_nWheelSize);
+
 	if (m_oInit.m_bDoBoard) {
 		assert((m_oInit.m_oArea.m_nX >= 0) && (m_oInit.m_oArea.m_nY >= 0));
 		assert((m_oInit.m_oArea.m_nX + 1 <= m_nBoardWidth) && (m_oInit.m_oArea.m_nY + 1 <= m_nBoardHeight));
@@ -108,15 +123,22 @@ void TileAnimatorEvent::commonInit() noexcept
 	assert((m_oInit.m_oPause.m_oMillisec.m_nFrom >= 0) && (m_oInit.m_oPause.m_oMillisec.m_nFrom <= m_oInit.m_oPause.m_oMillisec.m_nTo));
 	assert((m_oInit.m_oTotCount.m_nFrom > 0) && (m_oInit.m_oTotCount.m_nFrom <= m_oInit.m_oTotCount.m_nTo));
 	assert((m_oInit.m_nMaxParallel > 0) || (m_oInit.m_nMaxParallel == -1));
+
+	m_aBoardSlots.assign(m_oInit.m_bDoBoard ? m_nBoardWidth * m_nBoardHeight : 0, -1);
 }
 void TileAnimatorEvent::deInit() noexcept
 {
-	m_aNotAnisPos.clear();
-	m_aWaitingAnisPos.clear();
-	m_aWaitingAnisStart.clear();
-	m_aWaitingAnis.clear();
-	m_aRunningAnisPos.clear();
+	m_aSlots.clear();
+	m_nFreeSlot = -1;
+	m_aNotAnis.clear();
 	m_aRunningAnis.clear();
+	for (auto& aBucket : m_aWaitingWheel) {
+		aBucket.clear();
+	}
+	m_nTotWaiting = 0;
+	m_nWheelTick = -1;
+	m_aBoardSlots.assign(m_aBoardSlots.size(), -1);
+	m_oBlockSlots.clear();
 
 	m_eState = TILE_ANIMATOR_STATE_ACTIVATE;
 	m_nCounter = 0;
@@ -149,16 +171,16 @@ void TileAnimatorEvent::trigger(int32_t /*nMsg*/, int32_t /*nValue*/, Event* p0T
 		} // fallthrough
 		case TILE_ANIMATOR_STATE_INIT:
 		{
+			m_nWheelTick = nGameTick - 1;
 			if (m_oInit.m_bDoBoard) {
 				boardAddSelected(m_oInit.m_oArea);
 				oLevel.boardAddListener(this);
 			}
 			if (m_oInit.m_bDoBlocks) {
-				std::vector<LevelBlock*> aLBs = oLevel.blocksGetAll();
-				for (auto& p0LevelBlock : aLBs) {
-					assert(p0LevelBlock != nullptr);
-					blockAddSelected(*p0LevelBlock);
-				}
+				oLevel.blocksForEach([&](LevelBlock& oLevelBlock)
+				{
+					blockAddSelected(oLevelBlock);
+				});
 				oLevel.blocksAddBricksIdListener(this);
 			}
 			m_nCounter = 0;
@@ -172,7 +194,7 @@ void TileAnimatorEvent::trigger(int32_t /*nMsg*/, int32_t /*nValue*/, Event* p0T
 			}
 			const int32_t nLastReportedRunningAnis = m_nLastReportedRunningAnis;
 			const bool bTerminate = (m_oInit.m_nRepeat != -1) && (m_nCounter >= m_oInit.m_nRepeat);
-			const bool bFinished = bTerminate && (m_aWaitingAnisPos.size() + m_aRunningAnisPos.size() == 0);
+			const bool bFinished = bTerminate && (m_nTotWaiting + m_aRunningAnis.size() == 0);
 			if (bFinished) {
 				if (m_oInit.m_bDoBoard) {
 					oLevel.boardRemoveListener(this);
@@ -192,7 +214,7 @@ void TileAnimatorEvent::trigger(int32_t /*nMsg*/, int32_t /*nValue*/, Event* p0T
 				oLevel.activateEvent(this, nGameTick + 1);
 				//
 			}
-			const int32_t nNewRunningAnis = static_cast<int32_t>(m_aRunningAnisPos.size());
+			const int32_t nNewRunningAnis = static_cast<int32_t>(m_aRunningAnis.size());
 			if (nNewRunningAnis != nLastReportedRunningAnis) {
 				m_nLastReportedRunningAnis = nNewRunningAnis;
 				informListeners(LISTENER_GROUP_TILEANI_CHANGED, nNewRunningAnis);
@@ -210,85 +232,180 @@ void TileAnimatorEvent::trigger(int32_t /*nMsg*/, int32_t /*nValue*/, Event* p0T
 	}
 }
 
-bool TileAnimatorEvent::createTileAniBoard(int32_t nNotAniIdx, int32_t nGameTick, double fGameInterval, int32_t nX, int32_t nY) noexcept
+int32_t TileAnimatorEvent::slotAlloc(NPoint oPos) noexcept
 {
-//std::cout << "TileAnimatorEvent::createTileAniBoard  nX=" << nX << "  nY=" << nY << '\n';
-	Level& oLevel = level();
-	auto& oGame = oLevel.game();
-	assert((nX >= m_oInit.m_oArea.m_nX) && (nX < m_oInit.m_oArea.m_nX + m_oInit.m_oArea.m_nW));
-	assert((nY >= m_oInit.m_oArea.m_nY) && (nY < m_oInit.m_oArea.m_nY + m_oInit.m_oArea.m_nH));
-	if (oLevel.boardGetTileAnimator(nX, nY, m_oInit.m_nAniNameIdx) != nullptr) {
-//std::cout << "TileAnimatorEvent::createTileAniBoard  Exit already animated" << '\n';
-		return false; //--------------------------------------------------------
+	int32_t nSlot = m_nFreeSlot;
+	if (nSlot >= 0) {
+		m_nFreeSlot = m_aSlots[nSlot].m_nIdx;
+	} else {
+		nSlot = static_cast<int32_t>(m_aSlots.size());
+		m_aSlots.emplace_back();
+	}
+	AniSlot& oSlot = m_aSlots[nSlot];
+	oSlot.m_oPos = oPos;
+	oSlot.m_eState = ANI_STATE_FREE;
+	if (oPos.m_nX >= 0) {
+		boardSlot(oPos.m_nX, oPos.m_nY) = nSlot;
+	} else {
+		blockSetSlot(oPos.m_nY, -1 - oPos.m_nX, nSlot);
 	}
-	// create new TileAni
-	shared_ptr<TileAni> refTileAni = createTileAni(nullptr);
-	oLevel.boardSetTileAnimator(nX, nY, m_oInit.m_nAniNameIdx, refTileAni.operator->(), nX);
-
-	const NRange oInitialWait = m_oInit.m_oInitialWait.getCumulatedTicksRange(fGameInterval);
-	const int32_t nInitialWait = oGame.random(oInitialWait.m_nFrom, oInitialWait.m_nTo);
-	const int32_t nNextStartTick = nGameTick + nInitialWait;
-	// insert in waiting
-	m_aWaitingAnisPos.push_back(NPoint{nX, nY});
-	m_aWaitingAnisStart.push_back(nNextStartTick);
-	m_aWaitingAnis.push_back(std::move(refTileAni));
-
-	// remove
-	vectorRemoveIndex(m_aNotAnisPos, nNotAniIdx);
-	return true;
+	slotToNot(nSlot);
+	return nSlot;
+}
+void TileAnimatorEvent::slotFree(int32_t nSlot) noexcept
+{
+	slotUnlink(nSlot);
+	AniSlot& oSlot = m_aSlots[nSlot];
+	if (oSlot.m_oPos.m_nX >= 0) {
+		int32_t& nBoardSlot = boardSlot(oSlot.m_oPos.m_nX, oSlot.m_oPos.m_nY);
+		if (nBoardSlot == nSlot) {
+			nBoardSlot = -1;
+		}
+	} else {
+		if (blockSlot(oSlot.m_oPos.m_nY, -1 - oSlot.m_oPos.m_nX) == nSlot) {
+			blockSetSlot(oSlot.m_oPos.m_nY, -1 - oSlot.m_oPos.m_nX, -1);
+		}
+	}
+	oSlot.m_nIdx = m_nFreeSlot;
+	m_nFreeSlot = nSlot;
+}
+void TileAnimatorEvent::slotUnlink(int32_t nSlot) noexcept
+{
+	AniSlot& oSlot = m_aSlots[nSlot];
+	const int32_t nIdx = oSlot.m_nIdx;
+	int32_t nMovedSlot = -1;
+	switch (oSlot.m_eState) {
+	case ANI_STATE_NOT: nMovedSlot = vectorRemoveIndex(m_aNotAnis, nIdx); break;
+	case ANI_STATE_RUNNING: nMovedSlot = vectorRemoveIndex(m_aRunningAnis, nIdx); break;
+	case ANI_STATE_WAITING:
+	{
+		auto& aBucket = m_aWaitingWheel[oSlot.m_nStartTick & (s_nWheelSize - 1)];
+		nMovedSlot = vectorRemoveIndex(aBucket, nIdx);
+		--m_nTotWaiting;
+	}
+	break;
+	default: return; //---------------------------------------------------------
+	}
+	if (nMovedSlot >= 0) {
+		m_aSlots[nMovedSlot].m_nIdx = nIdx;
+	}
+	oSlot.m_eState = ANI_STATE_FREE;
 }
-bool TileAnimatorEvent::createTileAniBlock(int32_t nNotAniIdx, int32_t nGameTick, double fGameInterval, LevelBlock* p0LevelBlock, int32_t nBrick) noexcept
+void TileAnimatorEvent::slotToNot(int32_t nSlot) noexcept
+{
+	slotUnlink(nSlot);
+	AniSlot& oSlot = m_aSlots[nSlot];
+	oSlot.m_eState = ANI_STATE_NOT;
+	oSlot.m_nIdx = static_cast<int32_t>(m_aNotAnis.size());
+	m_aNotAnis.push_back(nSlot);
+}
+void TileAnimatorEvent::slotToWaiting(int32_t nSlot, int32_t nStartTick) noexcept
+{
+	slotUnlink(nSlot);
+	AniSlot& oSlot = m_aSlots[nSlot];
+	// The buckets up to m_nWheelTick were already processed, start at the earliest in the next
+	oSlot.m_nStartTick = ((nStartTick <= m_nWheelTick) ? m_nWheelTick + 1 : nStartTick);
+	oSlot.m_eState = ANI_STATE_WAITING;
+	auto& aBucket = m_aWaitingWheel[oSlot.m_nStartTick & (s_nWheelSize - 1)];
+	oSlot.m_nIdx = static_cast<int32_t>(aBucket.size());
+	aBucket.push_back(nSlot);
+	++m_nTotWaiting;
+}
+void TileAnimatorEvent::slotToRunning(int32_t nSlot) noexcept
+{
+	slotUnlink(nSlot);
+	AniSlot& oSlot = m_aSlots[nSlot];
+	oSlot.m_eState = ANI_STATE_RUNNING;
+	oSlot.m_nIdx = static_cast<int32_t>(m_aRunningAnis.size());
+	m_aRunningAnis.push_back(nSlot);
+}
+int32_t& TileAnimatorEvent::boardSlot(int32_t nX, int32_t nY) noexcept
+{
+	assert((nX >= 0) && (nX < m_nBoardWidth) && (nY >= 0) && (nY < m_nBoardHeight));
+	return m_aBoardSlots[nX + nY * m_nBoardWidth];
+}
+int32_t TileAnimatorEvent::blockSlot(int32_t nLBId, int32_t nBrickId) const noexcept
+{
+	assert(nBrickId >= 0);
+	auto itFind = m_oBlockSlots.find(nLBId);
+	if (itFind == m_oBlockSlots.end()) {
+		return -1; //-----------------------------------------------------------
+	}
+	const auto& aBrickSlots = itFind->second;
+	if (nBrickId >= static_cast<int32_t>(aBrickSlots.size())) {
+		return -1; //-----------------------------------------------------------
+	}
+	return aBrickSlots[nBrickId];
+}
+void TileAnimatorEvent::blockSetSlot(int32_t nLBId, int32_t nBrickId, int32_t nSlot) noexcept
+{
+	assert(nBrickId >= 0);
+	auto& aBrickSlots = m_oBlockSlots[nLBId];
+	if (nBrickId >= static_cast<int32_t>(aBrickSlots.size())) {
+		if (nSlot < 0) {
+			return; //----------------------------------------------------------
+		}
+		aBrickSlots.resize(nBrickId + 1, -1);
+	}
+	aBrickSlots[nBrickId] = nSlot;
+}
+
+bool TileAnimatorEvent::createTileAni(int32_t nSlot, int32_t nGameTick, double fGameInterval) noexcept
 {
 	Level& oLevel = level();
 	auto& oGame = oLevel.game();
-	if (p0LevelBlock->blockGetTileAnimator(nBrick, m_oInit.m_nAniNameIdx) != nullptr) {
-		return false;
+	AniSlot& oSlot = m_aSlots[nSlot];
+	assert(oSlot.m_eState == ANI_STATE_NOT);
+	const NPoint oXY = oSlot.m_oPos;
+	TileAni& oTileAni = oSlot.m_oTileAni;
+	if (oXY.m_nX >= 0) {
+//std::cout << "TileAnimatorEvent::createTileAni  nX=" << oXY.m_nX << "  nY=" << oXY.m_nY << '\n';
+		assert(m_oInit.m_oArea.containsPoint(oXY));
+		if (oLevel.boardGetTileAnimator(oXY.m_nX, oXY.m_nY, m_oInit.m_nAniNameIdx) != nullptr) {
+//std::cout << "TileAnimatorEvent::createTileAni  Exit already animated" << '\n';
+			return false; //----------------------------------------------------
+		}
+		oTileAni.m_p0LevelBlock = nullptr;
+		oLevel.boardSetTileAnimator(oXY.m_nX, oXY.m_nY, m_oInit.m_nAniNameIdx, &oTileAni, oXY.m_nX);
+	} else {
+		const int32_t nBrickId = - 1 - oXY.m_nX;
+		const int32_t nLBId = oXY.m_nY;
+		LevelBlock* p0LevelBlock = oLevel.blocksGet(nLBId);
+		assert(p0LevelBlock != nullptr);
+		if (p0LevelBlock->blockGetTileAnimator(nBrickId, m_oInit.m_nAniNameIdx) != nullptr) {
+			return false; //----------------------------------------------------
+		}
+		oTileAni.m_p0LevelBlock = p0LevelBlock;
+		p0LevelBlock->blockSetTileAnimator(nBrickId, m_oInit.m_nAniNameIdx, &oTileAni, nBrickId);
 	}
-	// create new TileAni
-	shared_ptr<TileAni> refTileAni = createTileAni(p0LevelBlock);
-	p0LevelBlock->blockSetTileAnimator(nBrick, m_oInit.m_nAniNameIdx, refTileAni.operator->(), nBrick);
-	//
+	oTileAni.m_bWaiting = true;
+	oTileAni.m_nCount = 0;
+	oTileAni.m_nTotCount = oGame.random(m_oInit.m_oTotCount.m_nFrom, m_oInit.m_oTotCount.m_nTo);
+	oTileAni.m_nTotTicks = -1;
+	oTileAni.m_nCountdown = -1;
+	oTileAni.m_nAniNameIdx = m_oInit.m_nAniNameIdx;
+
 	const NRange oInitialWait = m_oInit.m_oInitialWait.getCumulatedTicksRange(fGameInterval);
 	const int32_t nInitialWait = oGame.random(oInitialWait.m_nFrom, oInitialWait.m_nTo);
-	const int32_t nNextStartTick = nGameTick + nInitialWait;
-	// insert in waiting
-	m_aWaitingAnisPos.push_back(NPoint{-1 - nBrick, p0LevelBlock->blockGetId()});
-	m_aWaitingAnisStart.push_back(nNextStartTick);
-	m_aWaitingAnis.push_back(std::move(refTileAni));
-	// remove
-	vectorRemoveIndex(m_aNotAnisPos, nNotAniIdx);
+	slotToWaiting(nSlot, nGameTick + nInitialWait);
 	return true;
 }
 void TileAnimatorEvent::checkNewTileAnis(int32_t nGameTick, double fGameInterval) noexcept
 {
-//std::cout << "TileAnimatorEvent::checkNewTileAnis(" << nGameTick << ")   m_aNotAnisPos.size()=" << m_aNotAnisPos.size() << '\n';
-	Level& oLevel = level();
-	//TODO share code for (m_nMaxParallel == -1) and (m_nMaxParallel > 0)
+//std::cout << "TileAnimatorEvent::checkNewTileAnis(" << nGameTick << ")   m_aNotAnis.size()=" << m_aNotAnis.size() << '\n';
 	auto& oGame = level().game();
 	if (m_oInit.m_nMaxParallel == -1) {
 		int32_t nCur = 0;
-		while (nCur < static_cast<int32_t>(m_aNotAnisPos.size())) {
-			const NPoint oXY = m_aNotAnisPos[nCur];
-			const int32_t nXOrBrick = oXY.m_nX;
-			if (nXOrBrick >= 0) {
-				const bool bCreated = createTileAniBoard(nCur, nGameTick, fGameInterval, oXY.m_nX, oXY.m_nY);
-				if (! bCreated) {
-					++nCur;
-				}
-			} else {
-				const int32_t nBrickId = - 1 - nXOrBrick;
-				const int32_t nLBId = oXY.m_nY;
-				LevelBlock* p0LevelBlock = oLevel.blocksGet(nLBId);
-				assert(p0LevelBlock != nullptr);
-				const bool bCreated = createTileAniBlock(nCur, nGameTick, fGameInterval, p0LevelBlock, nBrickId);
-				if (! bCreated) {
-					++nCur;
-				}
+		while (nCur < static_cast<int32_t>(m_aNotAnis.size())) {
+			// if created the slot is removed from m_aNotAnis and nCur holds another one
+			const bool bCreated = createTileAni(m_aNotAnis[nCur], nGameTick, fGameInterval);
+			if (! bCreated) {
+				++nCur;
 			}
 		}
 	} else {
-		while (static_cast<int32_t>(m_aWaitingAnisPos.size() + m_aRunningAnisPos.size()) < m_oInit.m_nMaxParallel) {
-			const int32_t nNotAnis = static_cast<int32_t>(m_aNotAnisPos.size());
+		while (static_cast<int32_t>(m_nTotWaiting + m_aRunningAnis.size()) < m_oInit.m_nMaxParallel) {
+			const int32_t nNotAnis = static_cast<int32_t>(m_aNotAnis.size());
 //std::cout << "TileAnimatorEvent::checkNewTileAnis nNotAnis=" << nNotAnis << '\n';
 			if (nNotAnis <= 0) {
 				// There aren't selected "not yet animated" tiles to animate
@@ -297,26 +414,11 @@ void TileAnimatorEvent::checkNewTileAnis(int32_t nGameTick, double fGameInterval
 			int32_t nTry = s_nMaxTry; // TODO maybe std::min(s_nMaxTry, nTotNotAni)
 			while (nTry > 0) {
 				const int32_t nChosenNotAni = oGame.random(0, nNotAnis - 1);
-				const NPoint oXY = m_aNotAnisPos[nChosenNotAni];
-				const int32_t nXOrBrick = oXY.m_nX;
-				if (nXOrBrick >= 0) {
-					const bool bCreated = createTileAniBoard(nChosenNotAni, nGameTick, fGameInterval, oXY.m_nX, oXY.m_nY);
-					if (bCreated) {
-						break; // while (nTry > 0)
-					} else {
-						--nTry;
-					}
+				const bool bCreated = createTileAni(m_aNotAnis[nChosenNotAni], nGameTick, fGameInterval);
+				if (bCreated) {
+					break; // while (nTry > 0)
 				} else {
-					const int32_t nBrick = - 1 - nXOrBrick;
-					const int32_t nLBId = oXY.m_nY;
-					LevelBlock* p0LevelBlock = oLevel.blocksGet(nLBId);
-					assert(p0LevelBlock != nullptr);
-					const bool bCreated = createTileAniBlock(nChosenNotAni, nGameTick, fGameInterval, p0LevelBlock, nBrick);
-					if (bCreated) {
-						break; // while (nTry > 0)
-					} else {
-						--nTry;
-					}
+					--nTry;
 				}
 			}
 			if (nTry == 0) {
@@ -328,168 +430,99 @@ void TileAnimatorEvent::checkNewTileAnis(int32_t nGameTick, double fGameInterval
 }
 void TileAnimatorEvent::animate(int32_t nGameTick, double fGameInterval) noexcept
 {
-	if (m_aWaitingAnisPos.size() + m_aRunningAnisPos.size() == 0) {
+	if (m_nTotWaiting + m_aRunningAnis.size() == 0) {
+		m_nWheelTick = nGameTick;
 		return;
 	}
-//std::cout << "TileAnimatorEvent::animate(" << nGameTick << ")  Waiting=" << m_aWaitingAnisPos.size() << " Running=" << m_aRunningAnisPos.size() << '\n';
+//std::cout << "TileAnimatorEvent::animate(" << nGameTick << ")  Waiting=" << m_nTotWaiting << " Running=" << m_aRunningAnis.size() << '\n';
 	Level& oLevel = level();
 	auto& oGame = oLevel.game();
-	{
-	int32_t nCurIdx = 0;
-	while (true) {
-		const int32_t nTotWaiting = static_cast<int32_t>(m_aWaitingAnisStart.size());
-		if (nCurIdx >= nTotWaiting) {
-			break;
-		}
-		if (m_aWaitingAnisStart[nCurIdx] <= nGameTick) {
-			shared_ptr<TileAni>& refTileAni = m_aWaitingAnis[nCurIdx];
+	// start the waiting anis of the buckets of the ticks since the last call
+	// (normally just one) leaving those that start in a later round of the wheel
+	const int32_t nFromTick = std::max(m_nWheelTick + 1, nGameTick - s_nWheelSize + 1);
+	for (int32_t nTick = nFromTick; nTick <= nGameTick; ++nTick) {
+		auto& aBucket = m_aWaitingWheel[nTick & (s_nWheelSize - 1)];
+		int32_t nCurIdx = 0;
+		while (nCurIdx < static_cast<int32_t>(aBucket.size())) {
+			const int32_t nSlot = aBucket[nCurIdx];
+			AniSlot& oSlot = m_aSlots[nSlot];
+			if (oSlot.m_nStartTick > nGameTick) {
+				++nCurIdx;
+				continue; // while ------
+			}
 			// start tile ani
-			refTileAni->m_bWaiting = false;
+			TileAni& oTileAni = oSlot.m_oTileAni;
+			oTileAni.m_bWaiting = false;
 			const NRange oDuration = m_oInit.m_oDuration.getCumulatedTicksRange(fGameInterval);
 			const int32_t nDuration = oGame.random(oDuration.m_nFrom, oDuration.m_nTo);
-			refTileAni->m_nTotTicks = std::max(1, nDuration);
-			refTileAni->m_nCountdown = nDuration;
-			//
-			m_aRunningAnisPos.push_back(std::move(m_aWaitingAnisPos[nCurIdx]));
-			m_aWaitingAnisPos[nCurIdx] = m_aWaitingAnisPos[nTotWaiting - 1];
-			m_aWaitingAnisPos.pop_back();
-			//
-			m_aWaitingAnisStart[nCurIdx] = m_aWaitingAnisStart[nTotWaiting - 1];
-			m_aWaitingAnisStart.pop_back();
-			//
-			m_aRunningAnis.push_back(std::move(m_aWaitingAnis[nCurIdx]));
-			m_aWaitingAnis[nCurIdx] = m_aWaitingAnis[nTotWaiting - 1];
-			m_aWaitingAnis.pop_back();
-		} else {
-			++nCurIdx;
+			oTileAni.m_nTotTicks = std::max(1, nDuration);
+			oTileAni.m_nCountdown = nDuration;
+			// removes it from the bucket: nCurIdx now holds another slot
+			slotToRunning(nSlot);
 		}
 	}
-	}
+	m_nWheelTick = nGameTick;
 	// handle running anis
 	int32_t nCurIdx = 0;
-	while (true) {
-		const int32_t nTotRunning = static_cast<int32_t>(m_aRunningAnis.size());
-		if (nCurIdx >= nTotRunning) {
-			break;
-		}
-		shared_ptr<TileAni>& refTileAni = m_aRunningAnis[nCurIdx];
-		assert(refTileAni);
-		TileAni& oTileAni = *refTileAni;
+	while (nCurIdx < static_cast<int32_t>(m_aRunningAnis.size())) {
+		const int32_t nSlot = m_aRunningAnis[nCurIdx];
+		AniSlot& oSlot = m_aSlots[nSlot];
+		TileAni& oTileAni = oSlot.m_oTileAni;
 		assert(! oTileAni.m_bWaiting);
+		const NPoint oXY = oSlot.m_oPos;
 		LevelBlock* p0LevelBlock = oTileAni.m_p0LevelBlock;
-		if (p0LevelBlock == nullptr) {
-			// can be moved from
-			NPoint& oXY = m_aRunningAnisPos[nCurIdx];
+		const bool bBoard = (p0LevelBlock == nullptr);
+		#ifndef NDEBUG
+		if (bBoard) {
 			assert(m_oInit.m_oArea.containsPoint(oXY));
-			const int32_t nOldCountdown = oTileAni.m_nCountdown;
-			--oTileAni.m_nCountdown;
-			const bool bEnded = (nOldCountdown <= 0);
-			if (bEnded) {
-				const int32_t nX = oXY.m_nX;
-				const int32_t nY = oXY.m_nY;
-				//
-				++oTileAni.m_nCount;
-				const bool bDelete = (oTileAni.m_nCount == oTileAni.m_nTotCount);
-				if (bDelete) {
-					assert(oLevel.boardGetTileAnimator(nX, nY, m_oInit.m_nAniNameIdx) == refTileAni.operator->());
-					oLevel.boardSetTileAnimator(nX, nY, m_oInit.m_nAniNameIdx, nullptr, 0);
-					oLevel.boardAnimateTile(oXY);
-					m_aNotAnisPos.push_back(std::move(oXY));
-					//
-				} else {
-					oTileAni.m_bWaiting = true;
-					const NRange oPause = m_oInit.m_oPause.getCumulatedTicksRange(fGameInterval);
-					const int32_t nPause = oGame.random(oPause.m_nFrom, oPause.m_nTo);
-					const int32_t nNextStartTick = [&]()
-					{
-						if (nPause <= std::numeric_limits<int32_t>::max() - nGameTick) {
-							return nGameTick + nPause;
-						} else {
-							return std::numeric_limits<int32_t>::max();
-						}
-					}();
-					oLevel.boardAnimateTile(oXY);
-					// add to waiting
-					m_aWaitingAnisPos.push_back(std::move(oXY));
-					m_aWaitingAnisStart.push_back(nNextStartTick);
-					m_aWaitingAnis.push_back(std::move(refTileAni));
-				}
-				// remove from running
-				m_aRunningAnisPos[nCurIdx] = std::move(m_aRunningAnisPos[nTotRunning - 1]);
-				m_aRunningAnisPos.pop_back();
-				m_aRunningAnis[nCurIdx] = std::move(m_aRunningAnis[nTotRunning - 1]);
-				m_aRunningAnis.pop_back();
+		} else {
+			const int32_t nLBId = oXY.m_nY;
+			assert(nLBId == p0LevelBlock->blockGetId());
+		}
+		#endif //NDEBUG
+		const int32_t nOldCountdown = oTileAni.m_nCountdown;
+		--oTileAni.m_nCountdown;
+		const bool bEnded = (nOldCountdown <= 0);
+		if (bBoard) {
+			oLevel.boardAnimateTile(oXY);
+		} else {
+			// TODO add following method to Level! We shouldn't assume that blocks are redrawn each tick
+			//oLevel.blockAnimateTile(p0LevelBlock, nBrickId);
+		}
+		if (! bEnded) {
+			++nCurIdx;
+			continue; // while ------
+		}
+		++oTileAni.m_nCount;
+		const bool bDelete = (oTileAni.m_nCount == oTileAni.m_nTotCount);
+		if (bDelete) {
+			if (bBoard) {
+				assert(oLevel.boardGetTileAnimator(oXY.m_nX, oXY.m_nY, m_oInit.m_nAniNameIdx) == &oTileAni);
+				oLevel.boardSetTileAnimator(oXY.m_nX, oXY.m_nY, m_oInit.m_nAniNameIdx, nullptr, 0);
 			} else {
-				oLevel.boardAnimateTile(oXY);
-				++nCurIdx;
+				const int32_t nBrickId = -1 - oXY.m_nX;
+				assert(p0LevelBlock->blockGetTileAnimator(nBrickId, m_oInit.m_nAniNameIdx) == &oTileAni);
+				p0LevelBlock->blockSetTileAnimator(nBrickId, m_oInit.m_nAniNameIdx, nullptr, 0);
 			}
+			slotToNot(nSlot);
 		} else {
-			NPoint& oBrickLBId = m_aRunningAnisPos[nCurIdx];
-			const int32_t nBrickId = -1 - oBrickLBId.m_nX;
-			#ifndef NDEBUG
-			const int32_t nLBId = oBrickLBId.m_nY;
-			assert(nLBId == p0LevelBlock->blockGetId());
-			#endif //NDEBUG
-			const int32_t nOldCountdown = oTileAni.m_nCountdown;
-			--oTileAni.m_nCountdown;
-			const bool bEnded = (nOldCountdown <= 0);
-			if (bEnded) {
-				++oTileAni.m_nCount;
-				const bool bDelete = (oTileAni.m_nCount == oTileAni.m_nTotCount);
-				if (bDelete) {
-					assert(p0LevelBlock->blockGetTileAnimator(nBrickId, m_oInit.m_nAniNameIdx) == refTileAni.operator->());
-					p0LevelBlock->blockSetTileAnimator(nBrickId, m_oInit.m_nAniNameIdx, nullptr, 0);
-					//TODO oLevel.blockAnimateTile(oBloData.m_p0LevelBlock, nBrick);
-					m_aNotAnisPos.push_back(std::move(oBrickLBId));
-					//
+			oTileAni.m_bWaiting = true;
+			const NRange oPause = m_oInit.m_oPause.getCumulatedTicksRange(fGameInterval);
+			const int32_t nPause = oGame.random(oPause.m_nFrom, oPause.m_nTo);
+			const int32_t nNextStartTick = [&]()
+			{
+				if (nPause <= std::numeric_limits<int32_t>::max() - nGameTick) {
+					return nGameTick + nPause;
 				} else {
-					oTileAni.m_bWaiting = true;
-					const NRange oPause = m_oInit.m_oPause.getCumulatedTicksRange(fGameInterval);
-					const int32_t nPause = oGame.random(oPause.m_nFrom, oPause.m_nTo);
-					const int32_t nNextStartTick = [&]()
-					{
-						if (nPause <= std::numeric_limits<int32_t>::max() - nGameTick) {
-							return nGameTick + nPause;
-						} else {
-							return std::numeric_limits<int32_t>::max();
-						}
-					}();
-					// oLevel.blockAnimateTile(oXY);
-					// add to waiting
-					m_aWaitingAnisPos.push_back(std::move(oBrickLBId));
-					m_aWaitingAnisStart.push_back(nNextStartTick);
-					m_aWaitingAnis.push_back(std::move(refTileAni));
+					return std::numeric_limits<int32_t>::max();
 				}
-				// remove from running
-				m_aRunningAnisPos[nCurIdx] = std::move(m_aRunningAnisPos[nTotRunning - 1]);
-				m_aRunningAnisPos.pop_back();
-				m_aRunningAnis[nCurIdx] = std::move(m_aRunningAnis[nTotRunning - 1]);
-				m_aRunningAnis.pop_back();
-			} else {
-				// TODO add following method to Level! We shouldn't assume that blocks are redrawn each tick
-				//oLevel.blockAnimateTile(oBloData.m_p0LevelBlock, nIdx, 1, 1);
-				++nCurIdx;
-			}
+			}();
+			slotToWaiting(nSlot, nNextStartTick);
 		}
+		// the slot was removed from running: nCurIdx now holds another one
 	}
 }
 
-shared_ptr<TileAnimatorEvent::TileAni> TileAnimatorEvent::createTileAni(LevelBlock* p0LevelBlock) noexcept
-{
-	auto& oGame = level().game();
-	shared_ptr<TileAni> refTileAni;
-	m_oTileAniRecycler.create(refTileAni);
-	TileAni& oTileAni = *refTileAni;
-	oTileAni.m_p0LevelBlock = p0LevelBlock;
-	oTileAni.m_bWaiting = true;
-	oTileAni.m_nCount = 0;
-	oTileAni.m_nTotCount = oGame.random(m_oInit.m_oTotCount.m_nFrom, m_oInit.m_oTotCount.m_nTo);
-	oTileAni.m_nTotTicks = -1;
-	oTileAni.m_nCountdown = -1;
-	oTileAni.m_nAniNameIdx = m_oInit.m_nAniNameIdx;
-	return refTileAni;
-}
-
 double TileAnimatorEvent::TileAni::getCommonElapsed(int32_t nAni, int32_t nViewTick, int32_t nTotViewTicks) const noexcept
 {
 //std::cout << "TileAnimatorEvent::TileAni::getCommonElapsed()   nViewTick = " << nViewTick << "   nTotViewTicks=" << nTotViewTicks << '\n';
@@ -535,130 +568,72 @@ double TileAnimatorEvent::TileAni::getElapsed01(int32_t /*nHash*/, const LevelBl
 	return getCommonElapsed(nAni, nViewTick, nTotTicks);
 }
 
-void TileAnimatorEvent::boardRemoveSelected(const NRect& oRect) noexcept
+void TileAnimatorEvent::boardRemoveSelected(int32_t nX, int32_t nY) noexcept
 {
-	Level& oLevel = level();
-	int32_t nIdx = 0;
-	while (nIdx < static_cast<int32_t>(m_aNotAnisPos.size())) {
-		const NPoint& oXY = m_aNotAnisPos[nIdx];
-		if ((oXY.m_nX < 0) || (! oRect.containsPoint(oXY))) {
-			++nIdx;
-			continue;
-		}
-		vectorRemoveIndex(m_aNotAnisPos, nIdx);
+	const int32_t nSlot = boardSlot(nX, nY);
+	if (nSlot < 0) {
+		return; //--------------------------------------------------------------
 	}
-	nIdx = 0;
-	while (nIdx < static_cast<int32_t>(m_aWaitingAnisPos.size())) {
-		const NPoint& oXY = m_aWaitingAnisPos[nIdx];
-		if ((oXY.m_nX < 0) || (! oRect.containsPoint(oXY))) {
-			++nIdx;
-			continue;
+	Level& oLevel = level();
+	const ANI_STATE eState = m_aSlots[nSlot].m_eState;
+	if (eState != ANI_STATE_NOT) {
+		assert(oLevel.boardGetTileAnimator(nX, nY, m_oInit.m_nAniNameIdx) == &(m_aSlots[nSlot].m_oTileAni));
+		oLevel.boardSetTileAnimator(nX, nY, m_oInit.m_nAniNameIdx, nullptr, 0);
+		if (eState == ANI_STATE_RUNNING) {
+			oLevel.boardAnimateTile(NPoint{nX, nY});
 		}
-		#ifndef NDEBUG
-		shared_ptr<TileAni>& refTileAni = m_aWaitingAnis[nIdx];
-		#endif //NDEBUG
-		assert(oLevel.boardGetTileAnimator(oXY.m_nX, oXY.m_nY, m_oInit.m_nAniNameIdx) == refTileAni.operator->());
-		oLevel.boardSetTileAnimator(oXY.m_nX, oXY.m_nY, m_oInit.m_nAniNameIdx, nullptr, 0);
-		// do not animate !
-		vectorRemoveIndex(m_aWaitingAnisPos, nIdx);
-		vectorRemoveIndex(m_aWaitingAnisStart, nIdx);
-		vectorRemoveIndex(m_aWaitingAnis, nIdx);
+		// waiting: do not animate !
 	}
-	nIdx = 0;
-	while (nIdx < static_cast<int32_t>(m_aRunningAnisPos.size())) {
-		const NPoint& oXY = m_aRunningAnisPos[nIdx];
-		if ((oXY.m_nX < 0) || (! oRect.containsPoint(oXY))) {
-			++nIdx;
-			continue;
+	slotFree(nSlot);
+}
+void TileAnimatorEvent::boardRemoveSelected(const NRect& oRect) noexcept
+{
+	const NRect oInter = NRect::intersectionRect(oRect, m_oInit.m_oArea);
+	for (int32_t nY = oInter.m_nY; nY < oInter.m_nY + oInter.m_nH; ++nY) {
+		for (int32_t nX = oInter.m_nX; nX < oInter.m_nX + oInter.m_nW; ++nX) {
+			boardRemoveSelected(nX, nY);
 		}
-		#ifndef NDEBUG
-		shared_ptr<TileAni>& refTileAni = m_aRunningAnis[nIdx];
-		#endif //NDEBUG
-		assert(oLevel.boardGetTileAnimator(oXY.m_nX, oXY.m_nY, m_oInit.m_nAniNameIdx) == refTileAni.operator->());
-		oLevel.boardSetTileAnimator(oXY.m_nX, oXY.m_nY, m_oInit.m_nAniNameIdx, nullptr, 0);
-		oLevel.boardAnimateTile(oXY);
-		
-		vectorRemoveIndex(m_aRunningAnisPos, nIdx);
-		vectorRemoveIndex(m_aRunningAnis, nIdx);
 	}
 }
 void TileAnimatorEvent::boardRemoveSelected(const Coords& oCoords) noexcept
 {
-	Level& oLevel = level();
-	int32_t nIdx = 0;
-	while (nIdx < static_cast<int32_t>(m_aNotAnisPos.size())) {
-		const NPoint& oXY = m_aNotAnisPos[nIdx];
-		if ((oXY.m_nX < 0) || (! oCoords.contains(oXY))) {
-			++nIdx;
+	for (Coords::const_iterator it = oCoords.begin(); it != oCoords.end(); it.next()) {
+		const int32_t nX = it.x();
+		const int32_t nY = it.y();
+		if (! m_oInit.m_oArea.containsPoint(NPoint{nX, nY})) {
 			continue;
 		}
-		vectorRemoveIndex(m_aNotAnisPos, nIdx);
+		boardRemoveSelected(nX, nY);
 	}
-	nIdx = 0;
-	while (nIdx < static_cast<int32_t>(m_aWaitingAnisPos.size())) {
-		const NPoint& oXY = m_aWaitingAnisPos[nIdx];
-		if ((oXY.m_nX < 0) || (! oCoords.contains(oXY))) {
-			++nIdx;
-			continue;
-		}
-		#ifndef NDEBUG
-		shared_ptr<TileAni>& refTileAni = m_aWaitingAnis[nIdx];
-		#endif //NDEBUG
-		assert(oLevel.boardGetTileAnimator(oXY.m_nX, oXY.m_nY, m_oInit.m_nAniNameIdx) == refTileAni.operator->());
-		oLevel.boardSetTileAnimator(oXY.m_nX, oXY.m_nY, m_oInit.m_nAniNameIdx, nullptr, 0);
-		// do not animate !
-		vectorRemoveIndex(m_aWaitingAnisPos, nIdx);
-		vectorRemoveIndex(m_aWaitingAnisStart, nIdx);
-		vectorRemoveIndex(m_aWaitingAnis, nIdx);
+}
+void TileAnimatorEvent::boardAddSelected(int32_t nX, int32_t nY) noexcept
+{
+	if (boardSlot(nX, nY) >= 0) {
+		return; //--------------------------------------------------------------
 	}
-	nIdx = 0;
-	while (nIdx < static_cast<int32_t>(m_aRunningAnisPos.size())) {
-		const NPoint& oXY = m_aRunningAnisPos[nIdx];
-		if ((oXY.m_nX < 0) || (! oCoords.contains(oXY))) {
-			++nIdx;
-			continue;
-		}
-		#ifndef NDEBUG
-		shared_ptr<TileAni>& refTileAni = m_aRunningAnis[nIdx];
-		#endif //NDEBUG
-		assert(oLevel.boardGetTileAnimator(oXY.m_nX, oXY.m_nY, m_oInit.m_nAniNameIdx) == refTileAni.operator->());
-		oLevel.boardSetTileAnimator(oXY.m_nX, oXY.m_nY, m_oInit.m_nAniNameIdx, nullptr, 0);
-		oLevel.boardAnimateTile(oXY);
-		vectorRemoveIndex(m_aRunningAnisPos, nIdx);
-		vectorRemoveIndex(m_aRunningAnis, nIdx);
+	const Tile& oTile = level().boardGetTile(nX, nY);
+	if ((!oTile.isEmpty()) && ((!m_oInit.m_refSelect) || m_oInit.m_refSelect->select(oTile))) {
+		slotAlloc(NPoint{nX, nY});
 	}
 }
 void TileAnimatorEvent::boardAddSelected(const NRect& oRect) noexcept
 {
-	auto& oLevel = level();
-	for (int32_t nY = oRect.m_nY; nY < oRect.m_nY + oRect.m_nH; ++nY) {
-		if ((nY < m_oInit.m_oArea.m_nY) || (nY >= m_oInit.m_oArea.m_nY + m_oInit.m_oArea.m_nH)) {
-			continue;
-		}
-		for (int32_t nX = oRect.m_nX; nX < oRect.m_nX + oRect.m_nW; ++nX) {
-			if ((nX < m_oInit.m_oArea.m_nX) || (nX >= m_oInit.m_oArea.m_nX + m_oInit.m_oArea.m_nW)) {
-				continue;
-			}
-			const Tile& oTile = oLevel.boardGetTile(nX, nY);
-			if ((!oTile.isEmpty()) && ((!m_oInit.m_refSelect) || m_oInit.m_refSelect->select(oTile))) {
-				m_aNotAnisPos.push_back(NPoint{nX,  nY});
-			}
+	const NRect oInter = NRect::intersectionRect(oRect, m_oInit.m_oArea);
+	for (int32_t nY = oInter.m_nY; nY < oInter.m_nY + oInter.m_nH; ++nY) {
+		for (int32_t nX = oInter.m_nX; nX < oInter.m_nX + oInter.m_nW; ++nX) {
+			boardAddSelected(nX, nY);
 		}
 	}
 }
 void TileAnimatorEvent::boardAddSelected(const Coords& oCoords) noexcept
 {
-	auto& oLevel = level();
 	for (Coords::const_iterator it = oCoords.begin(); it != oCoords.end(); it.next()) {
 		const int32_t nX = it.x();
 		const int32_t nY = it.y();
 		if (! m_oInit.m_oArea.containsPoint(NPoint{nX, nY})) {
 			continue;
 		}
-		const Tile& oTile = oLevel.boardGetTile(nX, nY);
-		if ((!oTile.isEmpty()) && ((!m_oInit.m_refSelect) || m_oInit.m_refSelect->select(oTile))) {
-			m_aNotAnisPos.push_back(NPoint{nX,  nY});
-		}
+		boardAddSelected(nX, nY);
 	}
 }
 void TileAnimatorEvent::boardMoveSelected(const NRect& oRect, Direction::VALUE eDir) noexcept
@@ -666,69 +641,45 @@ void TileAnimatorEvent::boardMoveSelected(const NRect& oRect, Direction::VALUE e
 	const int32_t nDx = Direction::deltaX(eDir);
 	const int32_t nDy = Direction::deltaY(eDir);
 //std::cout << "boardMoveSelected  nDx=" << nDx << " nDy=" << nDy << '\n';
-	int32_t nIdx = 0;
-	while (nIdx < static_cast<int32_t>(m_aNotAnisPos.size())) {
-		NPoint& oXY = m_aNotAnisPos[nIdx];
-		if ((oXY.m_nX < 0) || (! oRect.containsPoint(oXY))) {
-			continue;
-		}
-		oXY.m_nX += nDx;
-		oXY.m_nY += nDy;
-//std::cout << "boardMoveSelected  m_aNotAnisPos  oXY=(" << oXY.m_nX << "," << oXY.m_nY << ")" << '\n';
-		if (! m_oInit.m_oArea.containsPoint(oXY)) {
-			vectorRemoveIndex(m_aNotAnisPos, nIdx);
-//std::cout << "boardMoveSelected  m_aNotAnisPos  out of area" << '\n';
-		} else {
-			++nIdx;
-		}
+	const NRect oInter = NRect::intersectionRect(oRect, m_oInit.m_oArea);
+	if ((oInter.m_nW <= 0) || (oInter.m_nH <= 0)) {
+		return; //--------------------------------------------------------------
 	}
 	auto& oLevel = level();
-	nIdx = 0;
-	while (nIdx < static_cast<int32_t>(m_aWaitingAnisPos.size())) {
-		NPoint& oXY = m_aWaitingAnisPos[nIdx];
-		if ((oXY.m_nX < 0) || (! oRect.containsPoint(oXY))) {
-			++nIdx;
-			continue;
-		}
-		oXY.m_nX += nDx;
-		oXY.m_nY += nDy;
-//std::cout << "boardMoveSelected  m_aWaitingAnisPos  oXY=(" << oXY.m_nX << "," << oXY.m_nY << ")" << '\n';
-		#ifndef NDEBUG
-		shared_ptr<TileAni>& refTileAni = m_aWaitingAnis[nIdx];
-		assert(oLevel.boardGetTileAnimator(oXY.m_nX, oXY.m_nY, m_oInit.m_nAniNameIdx) == refTileAni.operator->());
-		#endif //NDEBUG
-		if (! m_oInit.m_oArea.containsPoint(oXY)) {
-			oLevel.boardSetTileAnimator(oXY.m_nX, oXY.m_nY, m_oInit.m_nAniNameIdx, nullptr, 0);
-			vectorRemoveIndex(m_aWaitingAnisPos, nIdx);
-			vectorRemoveIndex(m_aWaitingAnisStart, nIdx);
-			vectorRemoveIndex(m_aWaitingAnis, nIdx);
-//std::cout << "boardMoveSelected  m_aWaitingAnisPos  out of area" << '\n';
-		} else {
-			++nIdx;
+	// Detach all the slots in the rect before reattaching them to the moved
+	// position since source and destination overlap
+	std::vector<int32_t> aMovedSlots;
+	for (int32_t nY = oInter.m_nY; nY < oInter.m_nY + oInter.m_nH; ++nY) {
+		for (int32_t nX = oInter.m_nX; nX < oInter.m_nX + oInter.m_nW; ++nX) {
+			int32_t& nSlot = boardSlot(nX, nY);
+			if (nSlot >= 0) {
+				aMovedSlots.push_back(nSlot);
+				nSlot = -1;
+			}
 		}
 	}
-	nIdx = 0;
-	while (nIdx < static_cast<int32_t>(m_aRunningAnisPos.size())) {
-		NPoint& oXY = m_aRunningAnisPos[nIdx];
-		if ((oXY.m_nX < 0) || (! oRect.containsPoint(oXY))) {
-			++nIdx;
-			continue;
-		}
+	for (const int32_t nSlot : aMovedSlots) {
+		AniSlot& oSlot = m_aSlots[nSlot];
+		NPoint& oXY = oSlot.m_oPos;
 		oXY.m_nX += nDx;
 		oXY.m_nY += nDy;
-//std::cout << "boardMoveSelected  m_aRunningAnisPos  oXY=(" << oXY.m_nX << "," << oXY.m_nY << ")" << '\n';
+//std::cout << "boardMoveSelected  oXY=(" << oXY.m_nX << "," << oXY.m_nY << ")" << '\n';
 		#ifndef NDEBUG
-		shared_ptr<TileAni>& refTileAni = m_aRunningAnis[nIdx];
-		assert(oLevel.boardGetTileAnimator(oXY.m_nX, oXY.m_nY, m_oInit.m_nAniNameIdx) == refTileAni.operator->());
+		if (oSlot.m_eState != ANI_STATE_NOT) {
+			assert(oLevel.boardGetTileAnimator(oXY.m_nX, oXY.m_nY, m_oInit.m_nAniNameIdx) == &oSlot.m_oTileAni);
+		}
 		#endif //NDEBUG
-		//oLevel.boardAnimateTile(oXY);
-		if (! m_oInit.m_oArea.containsPoint(oXY)) {
-			oLevel.boardSetTileAnimator(oXY.m_nX, oXY.m_nY, m_oInit.m_nAniNameIdx, nullptr, 0);
-			vectorRemoveIndex(m_aRunningAnisPos, nIdx);
-			vectorRemoveIndex(m_aRunningAnis, nIdx);
-//std::cout << "boardMoveSelected  m_aRunningAnisPos  out of area" << '\n';
+		if (m_oInit.m_oArea.containsPoint(oXY)) {
+			boardSlot(oXY.m_nX, oXY.m_nY) = nSlot;
 		} else {
-			++nIdx;
+//std::cout << "boardMoveSelected  out of area" << '\n';
+			if (oSlot.m_eState != ANI_STATE_NOT) {
+				oLevel.boardSetTileAnimator(oXY.m_nX, oXY.m_nY, m_oInit.m_nAniNameIdx, nullptr, 0);
+			}
+			// the board lookup was already cleared
+			slotUnlink(nSlot);
+			oSlot.m_nIdx = m_nFreeSlot;
+			m_nFreeSlot = nSlot;
 		}
 	}
 }
@@ -810,12 +761,15 @@ void TileAnimatorEvent::boardPostModify(const Coords& oCoords) noexcept
 void TileAnimatorEvent::blockAddSelectedBrick(LevelBlock& oLevelBlock, int32_t nBrickId, int32_t nBlockId) noexcept
 {
 //std::cout << "TileAnimatorEvent::blockAddSelectedBrick" << '\n';
+	if (blockSlot(nBlockId, nBrickId) >= 0) {
+		return; //--------------------------------------------------------------
+	}
 	const Tile& oTile = oLevelBlock.blockBrickTile(nBrickId);
 	assert(!oTile.isEmpty());
 	const bool bIsSelected = ((!m_oInit.m_refSelect) || m_oInit.m_refSelect->select(oTile));
 	if (bIsSelected) {
 		if (oLevelBlock.blockBrickVisible(nBrickId)) {
-			m_aNotAnisPos.push_back(NPoint{-1 - nBrickId,  nBlockId});
+			slotAlloc(NPoint{-1 - nBrickId,  nBlockId});
 		}
 	}
 }
@@ -829,67 +783,37 @@ void TileAnimatorEvent::blockAddSelected(LevelBlock& oLevelBlock) noexcept
 		blockAddSelectedBrick(oLevelBlock, nBrickId, nLBId);
 	}
 }
+void TileAnimatorEvent::blockRemoveSelectedBrick(LevelBlock& oLevelBlock, int32_t nBrickId) noexcept
+{
+	const int32_t nSlot = blockSlot(oLevelBlock.blockGetId(), nBrickId);
+	if (nSlot < 0) {
+		return; //--------------------------------------------------------------
+	}
+	if (m_aSlots[nSlot].m_eState != ANI_STATE_NOT) {
+		assert(oLevelBlock.blockGetTileAnimator(nBrickId, m_oInit.m_nAniNameIdx) == &(m_aSlots[nSlot].m_oTileAni));
+		oLevelBlock.blockSetTileAnimator(nBrickId, m_oInit.m_nAniNameIdx, nullptr, 0);
+	}
+	slotFree(nSlot);
+}
 void TileAnimatorEvent::blockRemoveSelected(LevelBlock& oLevelBlock, const std::vector<int32_t>& aRemoveBrickId) noexcept
 {
 	const bool bRemoveAll = aRemoveBrickId.empty();
-	const int32_t nLBId = oLevelBlock.blockGetId();
-	int32_t nIdx = 0;
-	while (nIdx < static_cast<int32_t>(m_aNotAnisPos.size())) {
-		const NPoint& oBrickBlockId = m_aNotAnisPos[nIdx];
-		if ((oBrickBlockId.m_nX >= 0) || (nLBId != oBrickBlockId.m_nY)) {
-			++nIdx;
-			continue;
-		}
-		const int32_t nBrickId = -1 - oBrickBlockId.m_nX;
-		if (bRemoveAll || Util::vectorContains(aRemoveBrickId, nBrickId)) {
-			vectorRemoveIndex(m_aNotAnisPos, nIdx);
-		} else {
-			++nIdx;
+	if (! bRemoveAll) {
+		for (const int32_t nBrickId : aRemoveBrickId) {
+			blockRemoveSelectedBrick(oLevelBlock, nBrickId);
 		}
+		return; //--------------------------------------------------------------
 	}
-	nIdx = 0;
-	while (nIdx < static_cast<int32_t>(m_aWaitingAnisPos.size())) {
-		const NPoint& oBrickBlockId = m_aWaitingAnisPos[nIdx];
-		if ((oBrickBlockId.m_nX >= 0) || (nLBId != oBrickBlockId.m_nY)) {
-			++nIdx;
-			continue;
-		}
-		const int32_t nBrickId = -1 - oBrickBlockId.m_nX;
-		if (bRemoveAll || Util::vectorContains(aRemoveBrickId, nBrickId)) {
-			#ifndef NDEBUG
-			shared_ptr<TileAni>& refTileAni = m_aWaitingAnis[nIdx];
-			#endif //NDEBUG
-			assert(oLevelBlock.blockGetTileAnimator(nBrickId, m_oInit.m_nAniNameIdx) == refTileAni.operator->());
-			oLevelBlock.blockSetTileAnimator(nBrickId, m_oInit.m_nAniNameIdx, nullptr, 0);
-			//
-			vectorRemoveIndex(m_aWaitingAnisPos, nIdx);
-			vectorRemoveIndex(m_aWaitingAnisStart, nIdx);
-			vectorRemoveIndex(m_aWaitingAnis, nIdx);
-		} else {
-			++nIdx;
-		}
+	const int32_t nLBId = oLevelBlock.blockGetId();
+	auto itFind = m_oBlockSlots.find(nLBId);
+	if (itFind == m_oBlockSlots.end()) {
+		return; //--------------------------------------------------------------
 	}
-	nIdx = 0;
-	while (nIdx < static_cast<int32_t>(m_aRunningAnisPos.size())) {
-		const NPoint& oBrickBlockId = m_aRunningAnisPos[nIdx];
-		if ((oBrickBlockId.m_nX >= 0) || (nLBId != oBrickBlockId.m_nY)) {
-			++nIdx;
-			continue;
-		}
-		const int32_t nBrickId = -1 - oBrickBlockId.m_nX;
-		if (bRemoveAll || Util::vectorContains(aRemoveBrickId, nBrickId)) {
-			#ifndef NDEBUG
-			shared_ptr<TileAni>& refTileAni = m_aRunningAnis[nIdx];
-			#endif //NDEBUG
-			assert(oLevelBlock.blockGetTileAnimator(nBrickId, m_oInit.m_nAniNameIdx) == refTileAni.operator->());
-			oLevelBlock.blockSetTileAnimator(nBrickId, m_oInit.m_nAniNameIdx, nullptr, 0);
-			//
-			vectorRemoveIndex(m_aRunningAnisPos, nIdx);
-			vectorRemoveIndex(m_aRunningAnis, nIdx);
-		} else {
-			++nIdx;
-		}
+	const int32_t nTotBrickSlots = static_cast<int32_t>(itFind->second.size());
+	for (int32_t nBrickId = 0; nBrickId < nTotBrickSlots; ++nBrickId) {
+		blockRemoveSelectedBrick(oLevelBlock, nBrickId);
 	}
+	m_oBlockSlots.erase(nLBId);
 }
 
 void TileAnimatorEvent::blockPreAdd(const LevelBlock& /*oBlock*/) noexcept
@@ -929,85 +853,44 @@ void TileAnimatorEvent::blockPostFuse(LevelBlock& oResBlock, const LevelBlock& o
 
 	const int32_t nResLBId = oResBlock.blockGetId();
 	const int32_t nFusedLBId = oFusedBlock.blockGetId();
-	for (NPoint& oBrickBlockId : m_aNotAnisPos) {
-		if (oBrickBlockId.m_nX >= 0) {
-			continue;
-		}
-		const int32_t nBrickId = -1 - oBrickBlockId.m_nX;
-		const int32_t nLBId = oBrickBlockId.m_nY;
-		if (nResLBId == nLBId) {
-			const auto itFind = oFusedToBrickIds.find(nBrickId);
-			assert(itFind != oFusedToBrickIds.end());
-			const int32_t nNewBrickId = itFind->second;
-			oBrickBlockId.m_nX = -1 - nNewBrickId;
-		} else if (nFusedLBId == nLBId) {
-			const auto itFind = oFusedBrickIds.find(nBrickId);
-			assert(itFind != oFusedBrickIds.end());
-			const int32_t nNewBrickId = itFind->second;
-			oBrickBlockId.m_nX = -1 - nNewBrickId;
-			oBrickBlockId.m_nY = nResLBId;
-		}
-	}
-	for (int32_t nIdx = 0; nIdx < static_cast<int32_t>(m_aWaitingAnisPos.size()); ++nIdx) {
-		NPoint& oBrickBlockId = m_aWaitingAnisPos[nIdx];
-		if (oBrickBlockId.m_nX >= 0) {
-			continue;
-		}
-		const int32_t nBrickId = -1 - oBrickBlockId.m_nX;
-		const int32_t nLBId = oBrickBlockId.m_nY;
-		if (nResLBId == nLBId) {
-			const auto itFind = oFusedToBrickIds.find(nBrickId);
-			assert(itFind != oFusedToBrickIds.end());
-			const int32_t nNewBrickId = itFind->second;
-			oBrickBlockId.m_nX = -1 - nNewBrickId;
-			shared_ptr<TileAni>& refTileAni = m_aWaitingAnis[nIdx];
-			#ifndef NDEBUG
-			assert(refTileAni->m_p0LevelBlock == &oResBlock);
-			assert(oResBlock.blockGetTileAnimator(nNewBrickId, m_oInit.m_nAniNameIdx) == nullptr);
-			#endif //NDEBUG
-			oResBlock.blockSetTileAnimator(nNewBrickId, m_oInit.m_nAniNameIdx, refTileAni.get(), 0);
-		} else if (nFusedLBId == nLBId) {
-			const auto itFind = oFusedBrickIds.find(nBrickId);
-			assert(itFind != oFusedBrickIds.end());
-			const int32_t nNewBrickId = itFind->second;
-			oBrickBlockId.m_nX = -1 - nNewBrickId;
-			oBrickBlockId.m_nY = nResLBId;
-			shared_ptr<TileAni>& refTileAni = m_aWaitingAnis[nIdx];
-			refTileAni->m_p0LevelBlock = &oResBlock;
-			assert(oResBlock.blockGetTileAnimator(nNewBrickId, m_oInit.m_nAniNameIdx) == nullptr);
-			oResBlock.blockSetTileAnimator(nNewBrickId, m_oInit.m_nAniNameIdx, refTileAni.get(), 0);
-		}
-	}
-	for (int32_t nIdx = 0; nIdx < static_cast<int32_t>(m_aRunningAnisPos.size()); ++nIdx) {
-		NPoint& oBrickBlockId = m_aRunningAnisPos[nIdx];
-		if (oBrickBlockId.m_nX >= 0) {
-			continue;
-		}
-		const int32_t nBrickId = -1 - oBrickBlockId.m_nX;
-		const int32_t nLBId = oBrickBlockId.m_nY;
-		if (nResLBId == nLBId) {
-			const auto itFind = oFusedToBrickIds.find(nBrickId);
-			assert(itFind != oFusedToBrickIds.end());
-			const int32_t nNewBrickId = itFind->second;
-			oBrickBlockId.m_nX = -1 - nNewBrickId;
-			shared_ptr<TileAni>& refTileAni = m_aRunningAnis[nIdx];
-			#ifndef NDEBUG
-			assert(refTileAni->m_p0LevelBlock == &oResBlock);
-			assert(oResBlock.blockGetTileAnimator(nNewBrickId, m_oInit.m_nAniNameIdx) == nullptr);
-			#endif //NDEBUG
-			oResBlock.blockSetTileAnimator(nNewBrickId, m_oInit.m_nAniNameIdx, refTileAni.get(), 0);
-		} else if (nFusedLBId == nLBId) {
-			const auto itFind = oFusedBrickIds.find(nBrickId);
-			assert(itFind != oFusedBrickIds.end());
-			const int32_t nNewBrickId = itFind->second;
+	// Detach the slots of both blocks before reattaching them with the new brick ids
+	std::vector<int32_t> aResSlots;
+	std::vector<int32_t> aFusedSlots;
+	auto itFind = m_oBlockSlots.find(nResLBId);
+	if (itFind != m_oBlockSlots.end()) {
+		aResSlots = std::move(itFind->second);
+		m_oBlockSlots.erase(itFind);
+	}
+	itFind = m_oBlockSlots.find(nFusedLBId);
+	if (itFind != m_oBlockSlots.end()) {
+		aFusedSlots = std::move(itFind->second);
+		m_oBlockSlots.erase(itFind);
+	}
+	const auto oReattach = [&](const std::vector<int32_t>& aSlots, const std::unordered_map<int32_t, int32_t>& oBrickIds)
+	{
+		for (const int32_t nSlot : aSlots) {
+			if (nSlot < 0) {
+				continue; // for ------
+			}
+			AniSlot& oSlot = m_aSlots[nSlot];
+			NPoint& oBrickBlockId = oSlot.m_oPos;
+			const int32_t nBrickId = -1 - oBrickBlockId.m_nX;
+			const auto itNewBrickId = oBrickIds.find(nBrickId);
+			assert(itNewBrickId != oBrickIds.end());
+			const int32_t nNewBrickId = itNewBrickId->second;
 			oBrickBlockId.m_nX = -1 - nNewBrickId;
 			oBrickBlockId.m_nY = nResLBId;
-			shared_ptr<TileAni>& refTileAni = m_aRunningAnis[nIdx];
-			refTileAni->m_p0LevelBlock = &oResBlock;
-			assert(oResBlock.blockGetTileAnimator(nNewBrickId, m_oInit.m_nAniNameIdx) == nullptr);
-			oResBlock.blockSetTileAnimator(nNewBrickId, m_oInit.m_nAniNameIdx, refTileAni.get(), 0);
+			blockSetSlot(nResLBId, nNewBrickId, nSlot);
+			if (oSlot.m_eState != ANI_STATE_NOT) {
+				TileAni& oTileAni = oSlot.m_oTileAni;
+				oTileAni.m_p0LevelBlock = &oResBlock;
+				assert(oResBlock.blockGetTileAnimator(nNewBrickId, m_oInit.m_nAniNameIdx) == nullptr);
+				oResBlock.blockSetTileAnimator(nNewBrickId, m_oInit.m_nAniNameIdx, &oTileAni, 0);
+			}
 		}
-	}
+	};
+	oReattach(aResSlots, oFusedToBrickIds);
+	oReattach(aFusedSlots, oFusedBrickIds);
 }
 void TileAnimatorEvent::blockPreModify(LevelBlock& oBlock
 										, const std::vector<int32_t>& aDeleteBrickId
@@ -1017,7 +900,9 @@ void TileAnimatorEvent::blockPreModify(LevelBlock& oBlock
 {
 //std::cout << "TileAnimatorEvent::blockPreModify" << '\n';
 
-	blockRemoveSelected(oBlock, aDeleteBrickId);
+	if (! aDeleteBrickId.empty()) {
+		blockRemoveSelected(oBlock, aDeleteBrickId);
+	}
 }
 void TileAnimatorEvent::blockPostModify(LevelBlock& oLevelBlock
 										, const std::vector<int32_t>& /*aDeletedBrickId*/
@@ -1028,110 +913,24 @@ void TileAnimatorEvent::blockPostModify(LevelBlock& oLevelBlock
 //std::cout << "TileAnimatorEvent::blockPostModify" << '\n';
 
 	const int32_t nLBId = oLevelBlock.blockGetId();
-	int32_t nIdx = 0;
-	while (nIdx < static_cast<int32_t>(m_aNotAnisPos.size())) {
-		const NPoint& oBrickBlockId = m_aNotAnisPos[nIdx];
-		if ((oBrickBlockId.m_nX >= 0) || (nLBId != oBrickBlockId.m_nY)) {
-			++nIdx;
-			continue;
+	for (const int32_t nBrickId : aModifiedPosBrickId) {
+		if (blockSlot(nLBId, nBrickId) < 0) {
+			continue; // for ------
 		}
-		const int32_t nBrickId = -1 - oBrickBlockId.m_nX;
-		if (Util::vectorContains(aModifiedPosBrickId, nBrickId)) {
-			if (! oLevelBlock.blockBrickVisible(nBrickId)) {
-				vectorRemoveIndex(m_aNotAnisPos, nIdx);
-				continue;
-			}
-		}
-		if (Util::vectorContains(aModifiedTileBrickId, nBrickId)) {
-			const Tile& oTile = oLevelBlock.blockBrickTile(nBrickId);
-			assert(!oTile.isEmpty());
-			const bool bIsSelected = ((!m_oInit.m_refSelect) || m_oInit.m_refSelect->select(oTile));
-			if ((! bIsSelected) || ! oLevelBlock.blockBrickVisible(nBrickId)) {
-				vectorRemoveIndex(m_aNotAnisPos, nIdx);
-				continue;
-			}
+		if (! oLevelBlock.blockBrickVisible(nBrickId)) {
+			blockRemoveSelectedBrick(oLevelBlock, nBrickId);
 		}
-		++nIdx;
 	}
-	nIdx = 0;
-	while (nIdx < static_cast<int32_t>(m_aWaitingAnisPos.size())) {
-		const NPoint& oBrickBlockId = m_aWaitingAnisPos[nIdx];
-		if ((oBrickBlockId.m_nX >= 0) || (nLBId != oBrickBlockId.m_nY)) {
-			++nIdx;
-			continue;
+	for (const int32_t nBrickId : aModifiedTileBrickId) {
+		if (blockSlot(nLBId, nBrickId) < 0) {
+			continue; // for ------
 		}
-		const int32_t nBrickId = -1 - oBrickBlockId.m_nX;
-		if (Util::vectorContains(aModifiedPosBrickId, nBrickId)) {
-			if (! oLevelBlock.blockBrickVisible(nBrickId)) {
-				#ifndef NDEBUG
-				shared_ptr<TileAni>& refTileAni = m_aWaitingAnis[nIdx];
-				#endif //NDEBUG
-				assert(oLevelBlock.blockGetTileAnimator(nBrickId, m_oInit.m_nAniNameIdx) == refTileAni.operator->());
-				oLevelBlock.blockSetTileAnimator(nBrickId, m_oInit.m_nAniNameIdx, nullptr, 0);
-				//
-				vectorRemoveIndex(m_aWaitingAnisPos, nIdx);
-				vectorRemoveIndex(m_aWaitingAnisStart, nIdx);
-				vectorRemoveIndex(m_aWaitingAnis, nIdx);
-				continue;
-			}
-		}
-		if (Util::vectorContains(aModifiedTileBrickId, nBrickId)) {
-			const Tile& oTile = oLevelBlock.blockBrickTile(nBrickId);
-			assert(!oTile.isEmpty());
-			const bool bIsSelected = ((!m_oInit.m_refSelect) || m_oInit.m_refSelect->select(oTile));
-			if ((! bIsSelected) || ! oLevelBlock.blockBrickVisible(nBrickId)) {
-				#ifndef NDEBUG
-				shared_ptr<TileAni>& refTileAni = m_aWaitingAnis[nIdx];
-				#endif //NDEBUG
-				assert(oLevelBlock.blockGetTileAnimator(nBrickId, m_oInit.m_nAniNameIdx) == refTileAni.operator->());
-				oLevelBlock.blockSetTileAnimator(nBrickId, m_oInit.m_nAniNameIdx, nullptr, 0);
-				//
-				vectorRemoveIndex(m_aWaitingAnisPos, nIdx);
-				vectorRemoveIndex(m_aWaitingAnisStart, nIdx);
-				vectorRemoveIndex(m_aWaitingAnis, nIdx);
-				continue;
-			}
-		}
-		++nIdx;
-	}
-	nIdx = 0;
-	while (nIdx < static_cast<int32_t>(m_aRunningAnisPos.size())) {
-		const NPoint& oBrickBlockId = m_aRunningAnisPos[nIdx];
-		if ((oBrickBlockId.m_nX >= 0) || (nLBId != oBrickBlockId.m_nY)) {
-			++nIdx;
-			continue;
-		}
-		const int32_t nBrickId = -1 - oBrickBlockId.m_nX;
-		if (Util::vectorContains(aModifiedPosBrickId, nBrickId)) {
-			if (! oLevelBlock.blockBrickVisible(nBrickId)) {
-				#ifndef NDEBUG
-				shared_ptr<TileAni>& refTileAni = m_aRunningAnis[nIdx];
-				#endif //NDEBUG
-				assert(oLevelBlock.blockGetTileAnimator(nBrickId, m_oInit.m_nAniNameIdx) == refTileAni.operator->());
-				oLevelBlock.blockSetTileAnimator(nBrickId, m_oInit.m_nAniNameIdx, nullptr, 0);
-				//
-				vectorRemoveIndex(m_aRunningAnisPos, nIdx);
-				vectorRemoveIndex(m_aRunningAnis, nIdx);
-				continue;
-			}
-		}
-		if (Util::vectorContains(aModifiedTileBrickId, nBrickId)) {
-			const Tile& oTile = oLevelBlock.blockBrickTile(nBrickId);
-			assert(!oTile.isEmpty());
-			const bool bIsSelected = ((!m_oInit.m_refSelect) || m_oInit.m_refSelect->select(oTile));
-			if ((! bIsSelected) || ! oLevelBlock.blockBrickVisible(nBrickId)) {
-				#ifndef NDEBUG
-				shared_ptr<TileAni>& refTileAni = m_aRunningAnis[nIdx];
-				#endif //NDEBUG
-				assert(oLevelBlock.blockGetTileAnimator(nBrickId, m_oInit.m_nAniNameIdx) == refTileAni.operator->());
-				oLevelBlock.blockSetTileAnimator(nBrickId, m_oInit.m_nAniNameIdx, nullptr, 0);
-				//
-				vectorRemoveIndex(m_aRunningAnisPos, nIdx);
-				vectorRemoveIndex(m_aRunningAnis, nIdx);
-				continue;
-			}
+		const Tile& oTile = oLevelBlock.blockBrickTile(nBrickId);
+		assert(!oTile.isEmpty());
+		const bool bIsSelected = ((!m_oInit.m_refSelect) || m_oInit.m_refSelect->select(oTile));
+		if ((! bIsSelected) || ! oLevelBlock.blockBrickVisible(nBrickId)) {
+			blockRemoveSelectedBrick(oLevelBlock, nBrickId);
 		}
-		++nIdx;
 	}
 
 	//
@@ -31,6 +31,7 @@
 #include "keyactionevent.h"
 #include "layout.h"
 #include "util/basictypes.h"
+#include "private-tickstatsrec.h"
 
 #include <stmm-input/event.h>
 #include <stmm-input/capability.h>
@@ -72,6 +73,7 @@ int32_t Game::getNewGameId() noexcept
 }
 
 Game::Game(Init&& oInit, CreateLevelCallback& oCreateLevelCallback, const Level::Init& oLevelInit) noexcept
+: m_oKeyActionRing(s_nKeyActionRingCapacity)
 {
 	reInit(std::move(oInit), oCreateLevelCallback, oLevelInit);
 }
@@ -101,8 +103,22 @@ void Game::reInit(Init&& oInit, CreateLevelCallback& oCreateLevelCallback, const
 	m_bGameEndedEmitted = false;
 
 	m_bInGameTick = false;
+	m_bInInputSubTick = false;
 	m_nTick = 0;
 
+	m_bLowLatencyInput = oInit.m_bLowLatencyInput;
+	m_nLastTickTimeUsec = -1;
+	m_fLastTickInterval = 0.0;
+
+	m_aLevelWorklist.clear();
+	m_nLevelWorklistNext = 0;
+
+	m_oKeyActionRing.clear();
+
+	#ifdef STMG_TICK_STATS
+	m_oTickStats.clear();
+	#endif //STMG_TICK_STATS
+
 	if (!oInit.m_refRandomSource) {
 		m_refRandomSource = std::make_unique<StdRandomSource>();
 	} else {
@@ -119,6 +135,7 @@ void Game::reInit(Init&& oInit, CreateLevelCallback& oCreateLevelCallback, const
 	m_fLastInterval = std::max(oInit.m_fInitialGameInterval, oInit.m_fMinGameInterval);
 	m_fNextInterval = m_fLastInterval;
 	m_fElapsedTime = 0.0;
+	m_fPrevElapsedTime = 0.0;
 
 	m_fSoundScaleX = oInit.m_fSoundScaleX;
 	m_fSoundScaleY = oInit.m_fSoundScaleY;
@@ -207,6 +224,8 @@ void Game::reInit(Init&& oInit, CreateLevelCallback& oCreateLevelCallback, const
 		refLevel->variablesInit(m_oTeamVariableTypes, m_oPlayerVariableTypes);
 		++nLevel;
 	}
+	m_aLevelInWorklist.assign(nTotLevels, false);
+	m_aLevelWorklist.reserve(nTotLevels);
 
 	m_refLayout = std::move(oInit.m_refLayout);
 //#ifndef NDEBUG
@@ -215,6 +234,9 @@ void Game::reInit(Init&& oInit, CreateLevelCallback& oCreateLevelCallback, const
 //}
 //#endif //NDEBUG
 	assert(m_refLayout->isValid());
+	for (auto& aOpenKeyActions : m_aOpenKeyActions) {
+		aOpenKeyActions.clear();
+	}
 	m_aOpenKeyActions.resize(refAppConfig->getTotKeyActions());
 	m_bHasKeyActions = !m_aOpenKeyActions.empty();
 	m_bIsEventAssignedToActivePlayer = refAppConfig->isEventAssignedToActivePlayer();
@@ -271,6 +293,8 @@ void Game::start() noexcept
 	m_nRankFailed = nTotTeams;
 	m_nTick = 0;
 	m_fElapsedTime = 0.0;
+	m_fPrevElapsedTime = 0.0;
+	m_nLastTickTimeUsec = -1;
 	//
 	if (!m_refInGameHighscore) {
 		m_refInGameHighscore = std::make_unique<RecycledHighscore>(m_refHighscoresDefinition, "", "");
@@ -430,25 +454,15 @@ void Game::createKeyAction(int32_t nLevel, int32_t nLevelTeam, int32_t nMate
 	} else {
 		return; //--------------------------------------------------------------
 	}
-	shared_ptr<KeyActionEvent> refKAEvent;
-	for (auto& refFreeEvent : m_aInputRecycle) {
-		if (refFreeEvent.use_count() == 1) {
-			refKAEvent = refFreeEvent;
-			break; //for ------
-		}
-	}
 	const int64_t nTimeUsec = refEvent->getTimeUsec();
-	if (!refKAEvent) {
-		refKAEvent = std::make_shared<KeyActionEvent>(nTimeUsec, shared_ptr<stmi::Accessor>{}, refEvent->getCapability()
-													, eType, nKeyActionId);
-		m_aInputRecycle.push_back(refKAEvent);
-	} else {
-		refKAEvent->setTimeUsec(nTimeUsec);
-		refKAEvent->setType(eType);
-		refKAEvent->setKeyAction(nKeyActionId);
-		refKAEvent->setCapability(refEvent->getCapability());
-	}
-	level(nLevel)->handleKeyActionInput(nLevelTeam, nMate, refKAEvent);
+	const double fTickOffset = calcTickOffset(nTimeUsec);
+	// Both in a sub-tick and at the start of the next game tick the elapsed
+	// time is the one of the next game tick
+	const double fGameMillisec = ((fTickOffset < 0.0) ? m_fElapsedTime
+														: m_fPrevElapsedTime + fTickOffset * m_fLastTickInterval);
+	const KeyActionRing::Handle oKeyAction = m_oKeyActionRing.write(nTimeUsec, refEvent->getCapability(), eType, nKeyActionId
+																	, fTickOffset, fGameMillisec);
+	level(nLevel)->handleKeyActionInput(nLevelTeam, nMate, oKeyAction);
 }
 void Game::handleInput(const shared_ptr<stmi::Event>& refEvent) noexcept
 {
@@ -460,11 +474,95 @@ void Game::handleInput(const shared_ptr<stmi::Event>& refEvent) noexcept
 	if (bDispatch) {
 		// Within the game tick there's no need to queue
 		dispatchInput(refEvent);
+	} else if (m_bLowLatencyInput && canDispatchInSubTick(refEvent)) {
+		dispatchInputInSubTick(refEvent);
 	} else {
 		// queue the event
 		m_aInputQueue.push_back(refEvent);
 	}
 }
+bool Game::canDispatchInSubTick(const shared_ptr<stmi::Event>& refEvent) noexcept
+{
+	if (!m_aInputQueue.empty()) {
+		// Overtaking queued events would change the order of dispatch
+		return false; //--------------------------------------------------------
+	}
+	const auto& oEvClass = refEvent->getEventClass();
+	if (oEvClass.isXYEvent()) {
+		// The game view's widgets aren't prepared for sub-ticks
+		return false; //--------------------------------------------------------
+	}
+	// Mirrors the recipients of dispatchInput()
+	const int32_t nCapabilityId = refEvent->getCapabilityId();
+	int32_t nLevel, nLevelTeam;
+	int32_t nPrefTeam, nMate;
+	if (m_bHasKeyActions) {
+		stmi::HARDWARE_KEY eKey;
+		stmi::Event::AS_KEY_INPUT_TYPE eType;
+		bool bMoreThanOne;
+		if (refEvent->getAsKey(eKey, eType, bMoreThanOne)) {
+			int32_t nKeyActionId;
+			if (!bMoreThanOne) {
+				if (m_refPrefs->getPlayerKeyActionFromCapabilityKey(nCapabilityId, eKey, nPrefTeam, nMate, nKeyActionId)) {
+					convertPrefToLevelTeam(nPrefTeam, nLevel, nLevelTeam);
+					if (!level(nLevel)->isSubTickInputCapable(nLevelTeam, nMate)) {
+						return false; //--------------------------------------------
+					}
+				}
+			} else {
+				const std::vector< std::pair<stmi::HARDWARE_KEY, stmi::Event::AS_KEY_INPUT_TYPE> > aKeys = refEvent->getAsKeys();
+				for (const auto& oPair : aKeys) {
+					if (m_refPrefs->getPlayerKeyActionFromCapabilityKey(nCapabilityId, oPair.first, nPrefTeam, nMate, nKeyActionId)) {
+						convertPrefToLevelTeam(nPrefTeam, nLevel, nLevelTeam);
+						if (!level(nLevel)->isSubTickInputCapable(nLevelTeam, nMate)) {
+							return false; //----------------------------------------
+						}
+					}
+				}
+			}
+		}
+	}
+	nLevel = -1;
+	nLevelTeam = -1;
+	nMate = -1;
+	const bool bAssigned = m_refPrefs->getCapabilityPlayer(nCapabilityId, nPrefTeam, nMate);
+	if (bAssigned) {
+		convertPrefToLevelTeam(nPrefTeam, nLevel, nLevelTeam);
+	} else if (!m_bIsEventAssignedToActivePlayer) {
+		return true; //---------------------------------------------------------
+	} else {
+		const bool bFoundPlayer = getUniqueActiveHumanPlayer(nLevel, nLevelTeam, nMate);
+		if (!bFoundPlayer) {
+			return true; //-----------------------------------------------------
+		}
+	}
+	return level(nLevel)->isSubTickInputCapable(nLevelTeam, nMate);
+}
+void Game::dispatchInputInSubTick(const shared_ptr<stmi::Event>& refEvent) noexcept
+{
+	// The recipients must find the game as it will be at the start of the
+	// next game tick, when the event would otherwise be dispatched
+	const double fLastInterval = m_fLastInterval;
+	m_fLastInterval = m_fNextInterval;
+	m_bInGameTick = true;
+	m_bInInputSubTick = true;
+	dispatchInput(refEvent);
+	m_bInInputSubTick = false;
+	m_bInGameTick = false;
+	m_fLastInterval = fLastInterval;
+	if (m_bGameEnded && !m_bGameEndedEmitted) {
+		m_bGameEndedEmitted = true;
+		m_p0GameOwner->gameEnded();
+	}
+}
+double Game::calcTickOffset(int64_t nTimeUsec) const noexcept
+{
+	if ((m_nLastTickTimeUsec < 0) || (nTimeUsec < 0)) {
+		return -1.0; //---------------------------------------------------------
+	}
+	const double fOffset = (nTimeUsec - m_nLastTickTimeUsec) / (m_fLastTickInterval * 1000.0);
+	return std::max(0.0, std::min(1.0, fOffset));
+}
 void Game::dispatchInput(const shared_ptr<stmi::Event>& refEvent) noexcept
 {
 //std::cout << "Game::dispatchInput  " << refEvent->getTimeUsec() << "  m_bHasKeyActions=" << m_bHasKeyActions << '\n';
@@ -618,51 +716,78 @@ void Game::convertPrefToLevelTeam(int32_t nPrefTeam, int32_t& nLevel, int32_t& n
 }
 
 void Game::handleTimer() noexcept
+{
+	handleTimer(-1);
+}
+void Game::handleTimer(int64_t nTimeUsec) noexcept
 {
 //std::cout << "Game::handleTimer(" << gameElapsed() << ")"<< '\n';
+	STMG_TICK_STATS_TICK(m_oTickStats, m_nTick);
 	m_fLastInterval = m_fNextInterval;
 	for (auto& refLevel : m_aLevel) {
 		refLevel->handlePreTimer();
 	}
 	//
 	m_bInGameTick = true;
-	dispatchInputs();
+	{
+		STMG_TICK_STATS_PHASE(PHASE_INPUTS);
+		dispatchInputs();
+	}
 	// handles blocks
 	const int32_t nTotLevels = static_cast<int32_t>(m_aLevel.size());
 	if (nTotLevels == 1) {
 		auto& refLevel = m_aLevel[0];
-		refLevel->handleTimer();
+		{
+			STMG_TICK_STATS_PHASE(PHASE_BLOCKS);
+			refLevel->handleTimer();
+		}
+		STMG_TICK_STATS_PHASE(PHASE_EVENTS);
 		refLevel->handleTimerEvents();
 	} else {
-		for (auto& refLevel : m_aLevel) {
-			refLevel->handleTimer();
+		{
+			STMG_TICK_STATS_PHASE(PHASE_BLOCKS);
+			for (auto& refLevel : m_aLevel) {
+				refLevel->handleTimer();
+			}
 		}
+		STMG_TICK_STATS_PHASE(PHASE_EVENTS);
 		// More than one level: events can call othersSend and trigger events
-		// to be handled in this game tick
-		int32_t nLevel = 0;
-		do {
-			auto& refLevel = m_aLevel[nLevel];
-			if (refLevel->eventsQueueIsDirty()) {
-				refLevel->handleTimerEvents();
-				// restart
-				nLevel = 0;
-			} else {
-				++nLevel;
+		// to be handled in this game tick. Only the levels with pending work
+		// are (re)processed, in the order they got it.
+		for (int32_t nLevel = 0; nLevel < nTotLevels; ++nLevel) {
+			if (m_aLevel[nLevel]->eventsQueueIsDirty()) {
+				levelWorklistAdd(nLevel);
 			}
-		} while (nLevel < nTotLevels);
+		}
+		while (m_nLevelWorklistNext < static_cast<int32_t>(m_aLevelWorklist.size())) {
+			const int32_t nLevel = m_aLevelWorklist[m_nLevelWorklistNext];
+			++m_nLevelWorklistNext;
+			m_aLevelInWorklist[nLevel] = false;
+			auto& refLevel = m_aLevel[nLevel];
+			refLevel->othersInboxDeliver();
+			refLevel->handleTimerEvents();
+		}
+		m_aLevelWorklist.clear();
+		m_nLevelWorklistNext = 0;
 	}
 	m_bInGameTick = false;
 	//
-	for (auto& refLevel : m_aLevel) {
-		assert(! refLevel->eventsQueueIsDirty());
-		refLevel->handlePostTimer();
+	{
+		STMG_TICK_STATS_PHASE(PHASE_POST);
+		for (auto& refLevel : m_aLevel) {
+			assert(! refLevel->eventsQueueIsDirty());
+			refLevel->handlePostTimer();
+		}
 	}
 	if (m_bGameEnded && !m_bGameEndedEmitted) {
 		m_bGameEndedEmitted = true;
 		m_p0GameOwner->gameEnded();
 	}
 	++m_nTick;
+	m_fPrevElapsedTime = m_fElapsedTime;
 	m_fElapsedTime += m_fLastInterval;
+	m_nLastTickTimeUsec = nTimeUsec;
+	m_fLastTickInterval = m_fLastInterval;
 }
 void Game::interrupt(GameProxy::INTERRUPT_TYPE eInterruptType) noexcept
 {
@@ -846,13 +971,27 @@ void Game::othersSend(int32_t nSenderLevel, int32_t nMsg, int32_t nValue) noexce
 {
 //std::cout << "Game::othersSend  nMsg=" << nMsg << "  nValue=" << nValue << '\n';
 	const int32_t nTotLevels = static_cast<int32_t>(m_aLevel.size());
+	const int32_t nDepth = m_aLevel[nSenderLevel]->othersDeliveringDepth() + 1;
 	for (int32_t nLevel = 0; nLevel < nTotLevels; ++nLevel) {
 		if (nSenderLevel != nLevel) {
 			auto& refLevel = m_aLevel[nLevel];
-			refLevel->othersReceive(nSenderLevel, nMsg, nValue);
+			refLevel->othersReceive(nSenderLevel, nMsg, nValue, nDepth);
+			if (m_bInGameTick) {
+				levelWorklistAdd(nLevel);
+			} else {
+				refLevel->othersInboxDeliver();
+			}
 		}
 	}
 }
+void Game::levelWorklistAdd(int32_t nLevel) noexcept
+{
+	if (m_aLevelInWorklist[nLevel]) {
+		return; //--------------------------------------------------------------
+	}
+	m_aLevelInWorklist[nLevel] = true;
+	m_aLevelWorklist.push_back(nLevel);
+}
 shared_ptr<GameSound> Game::createSound(int32_t nSoundIdx, int32_t nTeam, int32_t nMate
 										, FPoint oXYPos, double fZPos, bool bListenerRelative
 										, double fVolume01, bool bLooping) noexcept
@@ -77,6 +77,10 @@ bool GameProxy::isInGameTick() const noexcept
 {
 	return m_p0Game->isInGameTick();
 }
+bool GameProxy::isInInputSubTick() const noexcept
+{
+	return m_p0Game->isInInputSubTick();
+}
 void GameProxy::changedInterval(int32_t nLevel) noexcept
 {
 	m_p0Game->changedInterval(nLevel);
@@ -192,5 +196,11 @@ Highscore const& GameProxy::getInGameHighscore() const noexcept
 {
 	return m_p0Game->getInGameHighscore();
 }
+#ifdef STMG_TICK_STATS
+TickStats const& GameProxy::getTickStats() const noexcept
+{
+	return m_p0Game->getTickStats();
+}
+#endif //STMG_TICK_STATS
 
 } // namespace stmg
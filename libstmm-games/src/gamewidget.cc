@@ -71,6 +71,7 @@ WidgetAxisFit GameWidget::getWidgetVertAxisFit(int32_t nLayoutConfig) const noex
 }
 GameWidget::GameWidget(Init&& oData) noexcept
 : m_oData(std::move(oData))
+, m_nClassId(classId<GameWidget>())
 {
 	commonInit();
 }
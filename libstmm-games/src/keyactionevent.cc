@@ -40,6 +40,8 @@ KeyActionEvent::KeyActionEvent(int64_t nTimeUsec, const shared_ptr<stmi::Accesso
 , m_eType(eType)
 , m_nKeyAction(nKeyAction)
 , m_refCapability(refCapability)
+, m_fTickOffset(-1.0)
+, m_fGameMillisec(0.0)
 {
 	assert(nKeyAction >= 0);
 }
@@ -62,9 +64,15 @@ void KeyActionEvent::setKeyAction(int32_t nKeyAction) noexcept
 }
 void KeyActionEvent::setCapability(const shared_ptr<stmi::Capability>& refCapability) noexcept
 {
-	assert(refCapability);
 	m_refCapability = refCapability;
-	setCapabilityId(refCapability->getId());
+	setCapabilityId(refCapability ? refCapability->getId() : -1);
+}
+void KeyActionEvent::setTickOffset(double fTickOffset, double fGameMillisec) noexcept
+{
+	assert((fTickOffset == -1.0) || ((fTickOffset >= 0.0) && (fTickOffset <= 1.0)));
+	assert(fGameMillisec >= 0.0);
+	m_fTickOffset = fTickOffset;
+	m_fGameMillisec = fGameMillisec;
 }
 
 } // namespace stmg
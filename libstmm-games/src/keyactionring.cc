@@ -0,0 +1,99 @@
+/*
+ * Copyright © 2019-2020  Stefano Marsili, <stemars@gmx.ch>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>
+ */
+/*
+ * File:   keyactionring.cc
+ */
+
+#include "keyactionring.h"
+
+#include <stmm-input/capability.h>
+
+#include <cassert>
+//#include <iostream>
+
+namespace stmi { class Accessor; }
+
+namespace stmg
+{
+
+KeyActionRing::Handle::Handle() noexcept
+: m_p0Ring(nullptr)
+, m_nSlot(-1)
+, m_nSerial(0)
+{
+}
+KeyActionRing::Handle::Handle(const KeyActionRing* p0Ring, int32_t nSlot, int64_t nSerial) noexcept
+: m_p0Ring(p0Ring)
+, m_nSlot(nSlot)
+, m_nSerial(nSerial)
+{
+}
+bool KeyActionRing::Handle::isValid() const noexcept
+{
+	if (m_p0Ring == nullptr) {
+		return false; //--------------------------------------------------------
+	}
+	return (m_p0Ring->m_aSerials[m_nSlot] == m_nSerial);
+}
+const KeyActionEvent& KeyActionRing::Handle::get() const noexcept
+{
+	assert(isValid());
+	return *(m_p0Ring->m_aEvents[m_nSlot]);
+}
+
+KeyActionRing::KeyActionRing(int32_t nCapacity) noexcept
+: m_nNextSlot(0)
+, m_nLastSerial(0)
+{
+	assert(nCapacity > 0);
+	m_aEvents.reserve(nCapacity);
+	for (int32_t nSlot = 0; nSlot < nCapacity; ++nSlot) {
+		m_aEvents.push_back(std::make_unique<KeyActionEvent>(0, shared_ptr<stmi::Accessor>{}
+															, shared_ptr<stmi::Capability>{}, stmi::Event::AS_KEY_PRESS, 0));
+	}
+	m_aSerials.resize(nCapacity, 0);
+}
+int32_t KeyActionRing::capacity() const noexcept
+{
+	return static_cast<int32_t>(m_aEvents.size());
+}
+void KeyActionRing::clear() noexcept
+{
+	m_aSerials.assign(m_aSerials.size(), 0);
+	m_nNextSlot = 0;
+}
+KeyActionRing::Handle KeyActionRing::write(int64_t nTimeUsec, const shared_ptr<stmi::Capability>& refCapability
+											, stmi::Event::AS_KEY_INPUT_TYPE eType, int32_t nKeyAction
+											, double fTickOffset, double fGameMillisec) noexcept
+{
+	const int32_t nSlot = m_nNextSlot;
+	++m_nNextSlot;
+	if (m_nNextSlot == capacity()) {
+		m_nNextSlot = 0;
+	}
+	KeyActionEvent& oEvent = *(m_aEvents[nSlot]);
+	oEvent.setTimeUsec(nTimeUsec);
+	oEvent.setType(eType);
+	oEvent.setKeyAction(nKeyAction);
+	oEvent.setCapability(refCapability);
+	oEvent.setTickOffset(fTickOffset, fGameMillisec);
+	++m_nLastSerial;
+	m_aSerials[nSlot] = m_nLastSerial;
+	return Handle(this, nSlot, m_nLastSerial);
+}
+
+} // namespace stmg
@@ -32,6 +32,7 @@
 #include "util/namedindex.h"
 #include "utile/tilecoords.h"
 #include "utile/tilerect.h"
+#include "private-tickstatsrec.h"
 
 #include <cassert>
 #include <limits>
@@ -42,7 +43,6 @@
 #include <tuple>
 #include <type_traits>
 
-namespace stmg { class KeyActionEvent; }
 namespace stmi { class Event; }
 
 
@@ -68,26 +68,37 @@ void Level::Cell::clearOnlyTileAnis(int32_t nTileAnis) noexcept
 const int32_t Level::s_nZObjectZShowText = 100000;
 const int32_t Level::s_nZObjectZGameOver = std::numeric_limits<int32_t>::max();
 
-Recycler<Level::PrivateTextAnimation, TextAnimation> Level::s_oTextAnimationRecycler{};
-Recycler<TileCoords> Level::s_oTileCoordsRecycler{};
-
 Level::Level(Game* p0Game, int32_t nLevel, const shared_ptr<AppPreferences>& refPreferences, const Init& oInit) noexcept
 {
 	reInit(p0Game, nLevel, refPreferences, oInit);
 }
 void Level::deInit() noexcept
 {
+	m_oEventIds.clear();
 	m_aEvents.clear();
 	m_oActiveEvents.clear();
 	m_oInactiveEvents.clear();
 	m_nOthersNestedCalls = 0;
 	m_oOthersListeners.clear();
+	m_aOthersInbox.clear();
+	m_aOthersDelivering.clear();
 	m_aDelayedLevAniIds.clear();
 	m_aDelayedScrAniIds.clear();
 	m_aDelayedLevAnis.clear();
 	m_aDelayedScrAnis.clear();
 	m_oActiveLevAnis.clear();
 	m_oActiveScrolledAnis.clear();
+	m_oAllLevelBlocks.clear();
+	m_aLevelBlocks.clear();
+	m_nLevelBlocksHoles = 0;
+	m_nLevelBlocksIterating = 0;
+	// The events that registered themselves as listeners were just destroyed
+	m_oBoaBloListenerStk.clear();
+	m_oBoardListenerStk.clear();
+	m_oBoardScrollListenerStk.clear();
+	m_oBlocksListenerStk.clear();
+	m_oBlocksBricksIdListenerStk.clear();
+	m_aBlocksPlayerChangeListener.clear();
 }
 Event* Level::getEventById(const std::string& sId) noexcept
 {
@@ -227,12 +238,17 @@ void Level::reInit(Game* p0Game, int32_t nLevel, const shared_ptr<AppPreferences
 		}
 	}
 
+	// When recycled the cells keep the capacity of their tile animation vectors
 	m_aBoard.resize(m_nW * m_nH, Cell());
-	m_aOwner.resize(m_nW * m_nH, nullptr);
+	m_aOwner.assign(m_nW * m_nH, nullptr);
+	m_nOffsetX = 0;
+	m_nOffsetY = 0;
 	const int32_t nTotCellsToCopy = std::min(m_nW * m_nH, static_cast<int32_t>(oInit.m_aBoard.size()));
 	for (int32_t nIdx = 0; nIdx <  nTotCellsToCopy; ++nIdx) {
 		m_aBoard[nIdx].m_oTile = oInit.m_aBoard[nIdx];
-		m_aOwner[nIdx] = nullptr;
+	}
+	for (int32_t nIdx = nTotCellsToCopy; nIdx < m_nW * m_nH; ++nIdx) {
+		m_aBoard[nIdx].m_oTile.clear();
 	}
 
 	m_fInterval = m_p0Game->gameInterval();
@@ -310,13 +326,22 @@ void Level::handleInput(int32_t nLevelTeam, int32_t nMate, const shared_ptr<stmi
 		p0Controlled->handleInput(refEvent);
 	}
 }
-void Level::handleKeyActionInput(int32_t nLevelTeam, int32_t nMate, const shared_ptr<KeyActionEvent>& refEvent) noexcept
+void Level::handleKeyActionInput(int32_t nLevelTeam, int32_t nMate, const KeyActionRing::Handle& oKeyAction) noexcept
 {
 	LevelBlock* p0Controlled = getControlled(nLevelTeam, nMate);
 	if (p0Controlled != nullptr) {
-		p0Controlled->handleKeyActionInput(refEvent);
+		p0Controlled->handleKeyActionInput(oKeyAction);
 	}
 }
+bool Level::isSubTickInputCapable(int32_t nLevelTeam, int32_t nMate) const noexcept
+{
+	assert(!game().isInGameTick());
+	assert((nLevelTeam >= 0) && (nLevelTeam < m_nTotLevelTeams));
+	const TeamData& oTeamData = m_aTeamData[nLevelTeam];
+	assert((nMate >= 0) && (nMate < oTeamData.m_nTotTeammates));
+	const LevelBlock* p0Controlled = oTeamData.m_aTeammate[nMate].m_p0Controlled;
+	return (p0Controlled == nullptr) || p0Controlled->isSubTickInputCapable();
+}
 const std::vector< std::pair<int32_t, int32_t> >& Level::getActiveHumanPlayers() noexcept
 {
 	m_aActiveHumanPlayers.clear();
@@ -342,36 +367,28 @@ void Level::handleTimer() noexcept
 	const int32_t nGameTick = game().gameElapsed();
 	const int32_t nFallEachTicks = m_nFallEachTicks;
 //std::cout << "Level::handleTimer() nGameTick=" << nGameTick << '\n';
-	{
-	auto itBlock = m_oAllLevelBlocks.begin();
-	while (itBlock != m_oAllLevelBlocks.end()) {
-		LevelBlock* pLevelBlock = itBlock->second;
-		if (pLevelBlock->m_nLastTimerCall < nGameTick) {
-			pLevelBlock->m_nLastTimerCall = nGameTick;
-			pLevelBlock->handleTimer();
-			// handleTimer() may have caused additions or deletions
-			// in m_oAllLevelBlocks: restart!
-			itBlock = m_oAllLevelBlocks.begin();
-		} else {
-			++itBlock;
+	// Blocks added while iterating are appended and therefore also handled,
+	// the tick stamps prevent a block that is removed and added again from
+	// being handled twice in the same tick
+	++m_nLevelBlocksIterating;
+	// The size might grow while iterating
+	for (std::size_t nIdx = 0; nIdx < m_aLevelBlocks.size(); ++nIdx) {
+		LevelBlock* p0LevelBlock = m_aLevelBlocks[nIdx];
+		if ((p0LevelBlock != nullptr) && (p0LevelBlock->m_nLastTimerCall < nGameTick)) {
+			p0LevelBlock->m_nLastTimerCall = nGameTick;
+			p0LevelBlock->handleTimer();
 		}
 	}
-	}
 	if (nGameTick % nFallEachTicks == 0) {
-		auto itBlock = m_oAllLevelBlocks.begin();
-		while (itBlock != m_oAllLevelBlocks.end()) {
-			LevelBlock* pLevelBlock = itBlock->second;
-			if (pLevelBlock->m_nLastFallCall < nGameTick) {
-				pLevelBlock->m_nLastFallCall = nGameTick;
-				pLevelBlock->fall();
-				// fall() may have caused additions or deletions
-				// in m_aLevelBlocks: restart!
-				itBlock = m_oAllLevelBlocks.begin();
-			} else {
-				++itBlock;
+		for (std::size_t nIdx = 0; nIdx < m_aLevelBlocks.size(); ++nIdx) {
+			LevelBlock* p0LevelBlock = m_aLevelBlocks[nIdx];
+			if ((p0LevelBlock != nullptr) && (p0LevelBlock->m_nLastFallCall < nGameTick)) {
+				p0LevelBlock->m_nLastFallCall = nGameTick;
+				p0LevelBlock->fall();
 			}
 		}
 	}
+	blocksIterationEnd();
 }
 void Level::handleTimerEvents() noexcept
 {
@@ -408,6 +425,7 @@ void Level::triggerEvent(Event* p0Event, int32_t nMsg, int32_t nValue, Event* p0
 	}
 	deactivateEvent(p0Event, true);
 	eventsQueueSetDirty(true);
+	STMG_TICK_STATS_EVENT(*p0Event);
 	p0Event->trigger(nMsg, nValue, p0TriggeringEvent);
 }
 void Level::eventsQueueSetDirty(bool bDirty) noexcept
@@ -422,20 +440,37 @@ void Level::othersReceive(int32_t
 						#ifndef NDEBUG
 						nSenderLevel
 						#endif //NDEBUG
-						, int32_t nMsg, int32_t nValue) noexcept
+						, int32_t nMsg, int32_t nValue, int32_t nDepth) noexcept
 {
 //std::cout << "Level::othersReceive(" << nMsg << ", " << nValue << ")    nSenderLevel=" << nSenderLevel << '\n';
 	assert(nSenderLevel != getLevel());
-	++m_nOthersNestedCalls;
-	if (m_nOthersNestedCalls >= 10) {
+	assert(nDepth > 0);
+	if (nDepth >= 10) {
 		std::cout << "Level::othersReceive: Too many nested calls ... ignoring" << '\n';
-	} else {
-		for (const auto& p0OthersListener : m_oOthersListeners) {
-			assert(p0OthersListener != nullptr);
-			triggerEvent(p0OthersListener, nMsg, nValue, p0OthersListener);
+		return; //--------------------------------------------------------------
+	}
+	m_aOthersInbox.push_back(OthersMsg{nMsg, nValue, nDepth});
+}
+void Level::othersInboxDeliver() noexcept
+{
+	if (m_nOthersNestedCalls > 0) {
+		// Outside of a game tick a message can come back while delivering:
+		// the outer call delivers it
+		return; //--------------------------------------------------------------
+	}
+	while (!m_aOthersInbox.empty()) {
+		assert(m_aOthersDelivering.empty());
+		m_aOthersDelivering.swap(m_aOthersInbox);
+		for (const auto& oOthersMsg : m_aOthersDelivering) {
+			m_nOthersNestedCalls = oOthersMsg.m_nDepth;
+			for (const auto& p0OthersListener : m_oOthersListeners) {
+				assert(p0OthersListener != nullptr);
+				triggerEvent(p0OthersListener, oOthersMsg.m_nMsg, oOthersMsg.m_nValue, p0OthersListener);
+			}
 		}
+		m_nOthersNestedCalls = 0;
+		m_aOthersDelivering.clear();
 	}
-	--m_nOthersNestedCalls;
 }
 bool Level::othersAddListener(Event* p0Listener) noexcept
 {
@@ -484,7 +519,7 @@ void Level::boardSetTile(int32_t nX, int32_t nY, const Tile& oTile) noexcept
 		return;
 	}
 	shared_ptr<TileCoords> refTileCoords;
-	s_oTileCoordsRecycler.create(refTileCoords, 1);
+	m_oTileCoordsRecycler.create(refTileCoords, 1);
 	refTileCoords->add(nX, nY, oTile);
 	boardModify(*refTileCoords);
 }
@@ -584,47 +619,103 @@ void Level::boardMoveVector(std::vector<TTT>& aVec, Direction::VALUE eDir
 							, NRect oArea
 							, int32_t& nInsertX, int32_t& nInsertY) noexcept
 {
+	// Cells are swapped rather than copied: the cell that is shifted out
+	// ends up at the insert position, where it is overwritten by the caller
 	const auto& nX = oArea.m_nX;
 	const auto& nY = oArea.m_nY;
 	const auto& nW = oArea.m_nW;
 	const auto& nH = oArea.m_nH;
 	nInsertX = -1;
 	nInsertY = -1;
+	// The columns of the area within a ring buffer row
+	// (the second segment is non empty if the area wraps around)
+	const int32_t nRingX = calcRingX(nX);
+	const int32_t nLen1 = std::min(nW, m_nW - nRingX);
+	const int32_t nLen2 = nW - nLen1;
 	if ((eDir == Direction::UP) || (eDir == Direction::DOWN)) {
+		auto swapRows = [&](int32_t nY1, int32_t nY2)
+		{
+			const auto itRow1 = aVec.begin() + calcRingY(nY1) * m_nW;
+			const auto itRow2 = aVec.begin() + calcRingY(nY2) * m_nW;
+			std::swap_ranges(itRow1 + nRingX, itRow1 + nRingX + nLen1, itRow2 + nRingX);
+			if (nLen2 > 0) {
+				std::swap_ranges(itRow1, itRow1 + nLen2, itRow2);
+			}
+		};
 		if (eDir == Direction::DOWN) {
 			nInsertY = nY;
 			for (int32_t nCurY = nY + nH - 1; nCurY > nInsertY; --nCurY) {
-				for (int32_t nCurX = nX; nCurX < nX + nW; ++nCurX) {
-					aVec[calcIndex(nCurX, nCurY)] = aVec[calcIndex(nCurX, nCurY - 1)];
-				}
+				swapRows(nCurY, nCurY - 1);
 			}
 		} else {
 			nInsertY = nY + nH - 1;
 			for (int32_t nCurY = nY; nCurY < nInsertY; ++nCurY) {
-				for (int32_t nCurX = nX; nCurX < nX + nW; ++nCurX) {
-					aVec[calcIndex(nCurX, nCurY)] = aVec[calcIndex(nCurX, nCurY + 1)];
-				}
+				swapRows(nCurY, nCurY + 1);
 			}
 		}
 	} else {
 		assert((eDir == Direction::RIGHT) || (eDir == Direction::LEFT));
-		if (eDir == Direction::RIGHT) {
+		const bool bRight = (eDir == Direction::RIGHT);
+		if (bRight) {
 			nInsertX = nX;
-			for (int32_t nCurX = nX + nW - 1; nCurX > nInsertX; --nCurX) {
-				for (int32_t nCurY = nY; nCurY < nY + nH; ++nCurY) {
-					aVec[calcIndex(nCurX, nCurY)] = aVec[calcIndex(nCurX - 1, nCurY)];
-				}
-			}
 		} else {
 			nInsertX = nX + nW - 1;
-			for (int32_t nCurX = nX; nCurX < nInsertX; ++nCurX) {
-				for (int32_t nCurY = nY; nCurY < nY + nH; ++nCurY) {
-					aVec[calcIndex(nCurX, nCurY)] = aVec[calcIndex(nCurX + 1, nCurY)];
+		}
+		for (int32_t nCurY = nY; nCurY < nY + nH; ++nCurY) {
+			const auto itRow = aVec.begin() + calcRingY(nCurY) * m_nW;
+			if (nLen2 == 0) {
+				const auto itFirst = itRow + nRingX;
+				const auto itLast = itFirst + nW;
+				if (bRight) {
+					std::rotate(itFirst, itLast - 1, itLast);
+				} else {
+					std::rotate(itFirst, itFirst + 1, itLast);
+				}
+			} else if (bRight) {
+				for (int32_t nCurX = nX + nW - 1; nCurX > nInsertX; --nCurX) {
+					std::swap(aVec[calcIndex(nCurX, nCurY)], aVec[calcIndex(nCurX - 1, nCurY)]);
+				}
+			} else {
+				for (int32_t nCurX = nX; nCurX < nInsertX; ++nCurX) {
+					std::swap(aVec[calcIndex(nCurX, nCurY)], aVec[calcIndex(nCurX + 1, nCurY)]);
 				}
 			}
 		}
 	}
 }
+void Level::boardMoveOffsets(Direction::VALUE eDir, int32_t& nInsertX, int32_t& nInsertY) noexcept
+{
+	// Moving the offsets in the opposite direction of the scroll
+	// makes the row (or column) that is scrolled out the inserted one
+	nInsertX = -1;
+	nInsertY = -1;
+	switch (eDir) {
+	case Direction::DOWN:
+	{
+		m_nOffsetY = ((m_nOffsetY == 0) ? m_nH : m_nOffsetY) - 1;
+		nInsertY = 0;
+	} break;
+	case Direction::UP:
+	{
+		m_nOffsetY = ((m_nOffsetY + 1 == m_nH) ? 0 : m_nOffsetY + 1);
+		nInsertY = m_nH - 1;
+	} break;
+	case Direction::RIGHT:
+	{
+		m_nOffsetX = ((m_nOffsetX == 0) ? m_nW : m_nOffsetX) - 1;
+		nInsertX = 0;
+	} break;
+	case Direction::LEFT:
+	{
+		m_nOffsetX = ((m_nOffsetX + 1 == m_nW) ? 0 : m_nOffsetX + 1);
+		nInsertX = m_nW - 1;
+	} break;
+	default:
+	{
+		assert(false);
+	} break;
+	}
+}
 void Level::boardSetInserted(NRect oArea
 							, int32_t nInsertX, int32_t nInsertY, const shared_ptr<TileRect>& refTiles) noexcept
 {
@@ -670,6 +761,7 @@ void Level::boardScroll(Direction::VALUE eDir, const shared_ptr<TileRect>& refTi
 	}
 	m_bBoardAllowOnlyModify = true;
 
+	STMG_TICK_STATS_DISPATCH(DISPATCH_BOARD_SCROLL, m_oBoardScrollListenerStk.getTotListeners());
 	auto itPreCalled = m_oBoardScrollListenerStk.grabPreCalled();
 	m_oBoardScrollListenerStk.callPre(itPreCalled, &BoardScrollListener::boardPreScroll, eDir, refTiles);
 
@@ -729,9 +821,9 @@ void Level::boardScroll(Direction::VALUE eDir, const shared_ptr<TileRect>& refTi
 	NRect oArea;
 	oArea.m_nW = m_nW;
 	oArea.m_nH = m_nH;
-	boardMoveVector(m_aBoard, eDir, oArea, nInsertX, nInsertY);
+	// Both m_aBoard and m_aOwner are scrolled
+	boardMoveOffsets(eDir, nInsertX, nInsertY);
 	boardSetInserted(oArea, nInsertX, nInsertY, refTiles);
-	boardMoveVector(m_aOwner, eDir, oArea, nInsertX, nInsertY);
 	if (nInsertY >= 0) {
 		assert(nInsertX < 0);
 		for (int32_t nC = 0; nC < oArea.m_nW; ++nC) {
@@ -749,10 +841,10 @@ void Level::boardScroll(Direction::VALUE eDir, const shared_ptr<TileRect>& refTi
 	// Move LevelBlock if blockIsAutoScrolled()
 	const int32_t nDeltaX = Direction::deltaX(eDir);
 	const int32_t nDeltaY = Direction::deltaY(eDir);
-	for (auto& oLBPair : m_oAllLevelBlocks) {
-		//const int32_t nId = oLBPair.first;
-		LevelBlock* p0LevelBlock = oLBPair.second;
-		assert(p0LevelBlock != nullptr);
+	for (LevelBlock* p0LevelBlock : m_aLevelBlocks) {
+		if (p0LevelBlock == nullptr) {
+			continue; // for p0LevelBlock
+		}
 		if (p0LevelBlock->blockIsAutoScrolled()) {
 			p0LevelBlock->m_nScrolledUnique = nScrolledUnique;
 			p0LevelBlock->m_nPosX += nDeltaX;
@@ -777,13 +869,12 @@ void Level::boardScroll(Direction::VALUE eDir, const shared_ptr<TileRect>& refTi
 
 	m_bBoardAllowOnlyModify = false;
 
-	for (auto& oLBPair : m_oAllLevelBlocks) {
-		LevelBlock* p0LevelBlock = oLBPair.second;
-		assert(p0LevelBlock != nullptr);
-		if (p0LevelBlock->blockIsAutoScrolled() && (p0LevelBlock->m_nScrolledUnique == nScrolledUnique)) {
-			p0LevelBlock->onScrolled(eDir);
+	blocksForEach([&](LevelBlock& oLevelBlock)
+	{
+		if (oLevelBlock.blockIsAutoScrolled() && (oLevelBlock.m_nScrolledUnique == nScrolledUnique)) {
+			oLevelBlock.onScrolled(eDir);
 		}
-	}
+	});
 	for (auto& oIdSAPair : m_oActiveScrolledAnis) {
 		shared_ptr<LevelAnimation>& refLevelAnimation = oIdSAPair.second;
 		if (refLevelAnimation->m_nScrolledUnique == nScrolledUnique) {
@@ -802,6 +893,7 @@ void Level::boardInsert(Direction::VALUE eDir, NRect oArea, const shared_ptr<Til
 	}
 	m_bBoardAllowOnlyModify = true;
 
+	STMG_TICK_STATS_DISPATCH(DISPATCH_BOARD_INSERT, m_oBoardListenerStk.getTotListeners());
 	auto itPreCalled = m_oBoardListenerStk.grabPreCalled();
 	m_oBoardListenerStk.callPre(itPreCalled, &BoardListener::boardPreInsert, eDir, oArea, refTiles);
 
@@ -826,6 +918,7 @@ void Level::boardModify(const TileCoords& oTileCoords) noexcept
 {
 //std::cout << "Level::boardModify  oTileCoords.size()=" << oTileCoords.size() << '\n';
 
+	STMG_TICK_STATS_DISPATCH(DISPATCH_BOARD_MODIFY, m_oBoardListenerStk.getTotListeners());
 	auto itPreCalled = m_oBoardListenerStk.grabPreCalled();
 	m_oBoardListenerStk.callPre(itPreCalled, &BoardListener::boardPreModify, oTileCoords);
 
@@ -854,6 +947,7 @@ void Level::boardDestroy(const Coords& oCoords) noexcept
 //std::cout << "Level::boardDestroy(Coords)" << '\n';
 	assert(oCoords.size() >= 0);
 
+	STMG_TICK_STATS_DISPATCH(DISPATCH_BOARD_DESTROY, m_oBoardListenerStk.getTotListeners());
 	auto itPreCalled = m_oBoardListenerStk.grabPreCalled();
 	m_oBoardListenerStk.callPre(itPreCalled, &BoardListener::boardPreDestroy, oCoords);
 
@@ -996,6 +1090,7 @@ bool Level::blockAdd(LevelBlock* p0LevelBlock, LevelBlock::MGMT_TYPE eMgmtType)
 	assert(! p0LevelBlock->m_bNestedModificationLock);
 	p0LevelBlock->m_bNestedModificationLock = true;
 
+	STMG_TICK_STATS_DISPATCH(DISPATCH_BLOCK_ADD, m_oBlocksListenerStk.getTotListeners());
 	auto itPreCalled = m_oBlocksListenerStk.grabPreCalled();
 	m_oBlocksListenerStk.callPre(itPreCalled, &BlocksListener::blockPreAdd, *p0LevelBlock);
 
@@ -1036,6 +1131,7 @@ bool Level::boabloUnfreeze(const Coords& oCoords
 		}
 	}
 
+	STMG_TICK_STATS_DISPATCH(DISPATCH_BLOCK_UNFREEZE, m_oBoaBloListenerStk.getTotListeners());
 	auto itPreCalled = m_oBoaBloListenerStk.grabPreCalled();
 	m_oBoaBloListenerStk.callPre(itPreCalled, &BoaBloListener::boabloPreUnfreeze, oCoords);
 
@@ -1053,6 +1149,9 @@ bool Level::boabloUnfreeze(const Coords& oCoords
 	const int32_t nPosX = oRect.m_nX;
 	const int32_t nPosY = oRect.m_nY;
 	int32_t nBrick = 0;
+	// Empty all the cells with a single board modification
+	shared_ptr<TileCoords> refEmptied;
+	m_oTileCoordsRecycler.create(refEmptied, nTotBricks);
 	for (Coords::const_iterator it = oCoords.begin(); it != oCoords.end(); it.next()) {
 		const int32_t nX = it.x();
 		const int32_t nY = it.y();
@@ -1064,9 +1163,10 @@ bool Level::boabloUnfreeze(const Coords& oCoords
 		if (bAutoOwner) {
 			assert(boardGetOwner(nX, nY) == nullptr);
 		}
-		boardSetTile(nX, nY, Tile::s_oEmptyTile);
+		refEmptied->add(nX, nY, Tile::s_oEmptyTile);
 		++nBrick;
 	}
+	boardModify(*refEmptied);
 	assert(nBrick == nTotBricks);
 	Block oBlock(nTotBricks, aBrick, 1, {aBrickPos});
 
@@ -1112,6 +1212,8 @@ void Level::blockAddCommon(LevelBlock* p0LevelBlock) noexcept
 	const int32_t nId = p0LevelBlock->blockGetId();
 	assert(m_oAllLevelBlocks.find(nId) == m_oAllLevelBlocks.end());
 	m_oAllLevelBlocks[nId] = p0LevelBlock;
+	p0LevelBlock->m_nLevelBlockIdx = static_cast<int32_t>(m_aLevelBlocks.size());
+	m_aLevelBlocks.push_back(p0LevelBlock);
 
 	//p0LevelBlock->m_bControllable = p0LevelBlock->isPlayerControllable();
 	if (!p0LevelBlock->m_bControllable) {
@@ -1235,6 +1337,7 @@ void Level::blockRemove(LevelBlock* p0LevelBlock) noexcept
 
 	p0LevelBlock->m_bNestedModificationLock = true;
 
+	STMG_TICK_STATS_DISPATCH(DISPATCH_BLOCK_REMOVE, m_oBlocksListenerStk.getTotListeners());
 	auto itPreCalled = m_oBlocksListenerStk.grabPreCalled();
 	m_oBlocksListenerStk.callPre(itPreCalled, &BlocksListener::blockPreRemove, *p0LevelBlock);
 
@@ -1271,6 +1374,7 @@ void Level::blockDestroy(LevelBlock* p0LevelBlock) noexcept
 
 	p0LevelBlock->m_bNestedModificationLock = true;
 
+	STMG_TICK_STATS_DISPATCH(DISPATCH_BLOCK_DESTROY, m_oBlocksListenerStk.getTotListeners());
 	auto itPreCalled = m_oBlocksListenerStk.grabPreCalled();
 	m_oBlocksListenerStk.callPre(itPreCalled, &BlocksListener::blockPreDestroy, *p0LevelBlock);
 
@@ -1307,6 +1411,7 @@ void Level::blockFreeze(LevelBlock* p0LevelBlock) noexcept
 
 	p0LevelBlock->m_bNestedModificationLock = true;
 
+	STMG_TICK_STATS_DISPATCH(DISPATCH_BLOCK_FREEZE, m_oBoaBloListenerStk.getTotListeners());
 	auto itPreCalled = m_oBoaBloListenerStk.grabPreCalled();
 	m_oBoaBloListenerStk.callPre(itPreCalled, &BoaBloListener::boabloPreFreeze, *p0LevelBlock);
 
@@ -1354,6 +1459,15 @@ void Level::blockRemoveCommon(LevelBlock* p0LevelBlock) noexcept
 	auto itRemove = m_oAllLevelBlocks.find(nId);
 	assert(itRemove != m_oAllLevelBlocks.end());
 	m_oAllLevelBlocks.erase(itRemove);
+	const int32_t nIdx = p0LevelBlock->m_nLevelBlockIdx;
+	assert((nIdx >= 0) && (nIdx < static_cast<int32_t>(m_aLevelBlocks.size())));
+	assert(m_aLevelBlocks[nIdx] == p0LevelBlock);
+	m_aLevelBlocks[nIdx] = nullptr;
+	p0LevelBlock->m_nLevelBlockIdx = -1;
+	++m_nLevelBlocksHoles;
+	if (m_nLevelBlocksIterating == 0) {
+		blocksCompactIfSparse();
+	}
 
 	LevelBlock* p0NewControlled = nullptr;
 	const int32_t nPlayer = p0LevelBlock->m_nPlayer;
@@ -1463,6 +1577,7 @@ void Level::blockFuse(LevelBlock* p0Master, LevelBlock* p0Victim) noexcept
 	p0Master->m_bNestedModificationLock = true;
 	p0Victim->m_bNestedModificationLock = true;
 
+	STMG_TICK_STATS_DISPATCH(DISPATCH_BLOCK_FUSE, m_oBlocksListenerStk.getTotListeners());
 	auto itPreCalled = m_oBlocksListenerStk.grabPreCalled();
 	m_oBlocksListenerStk.callPre(itPreCalled, &BlocksListener::blockPreFuse, *p0Master, *p0Victim);
 
@@ -1711,19 +1826,56 @@ LevelBlock* Level::blocksGet(int32_t nId) noexcept
 std::vector<int32_t> Level::blocksGetAllIds() noexcept
 {
 	std::vector<int32_t> aSet;
-	for (auto& it : m_oAllLevelBlocks) {
-		aSet.push_back(it.first);
+	aSet.reserve(m_aLevelBlocks.size() - m_nLevelBlocksHoles);
+	for (LevelBlock* p0LevelBlock : m_aLevelBlocks) {
+		if (p0LevelBlock != nullptr) {
+			aSet.push_back(p0LevelBlock->blockGetId());
+		}
 	}
 	return aSet;
 }
 std::vector<LevelBlock*> Level::blocksGetAll() noexcept
 {
 	std::vector<LevelBlock*> aSet;
-	for (auto& it : m_oAllLevelBlocks) {
-		aSet.push_back(it.second);
+	aSet.reserve(m_aLevelBlocks.size() - m_nLevelBlocksHoles);
+	for (LevelBlock* p0LevelBlock : m_aLevelBlocks) {
+		if (p0LevelBlock != nullptr) {
+			aSet.push_back(p0LevelBlock);
+		}
 	}
 	return aSet;
 }
+void Level::blocksIterationEnd() noexcept
+{
+	assert(m_nLevelBlocksIterating > 0);
+	--m_nLevelBlocksIterating;
+	if (m_nLevelBlocksIterating == 0) {
+		blocksCompactIfSparse();
+	}
+}
+void Level::blocksCompactIfSparse() noexcept
+{
+	assert(m_nLevelBlocksIterating == 0);
+	// Compacting only when at least half are holes keeps removal amortized O(1)
+	if (2 * m_nLevelBlocksHoles < static_cast<int32_t>(m_aLevelBlocks.size())) {
+		return; //--------------------------------------------------------------
+	}
+	const int32_t nTotSlots = static_cast<int32_t>(m_aLevelBlocks.size());
+	int32_t nTo = 0;
+	for (int32_t nFrom = 0; nFrom < nTotSlots; ++nFrom) {
+		LevelBlock* p0LevelBlock = m_aLevelBlocks[nFrom];
+		if (p0LevelBlock == nullptr) {
+			continue; // for nFrom
+		}
+		if (nTo != nFrom) {
+			m_aLevelBlocks[nTo] = p0LevelBlock;
+			p0LevelBlock->m_nLevelBlockIdx = nTo;
+		}
+		++nTo;
+	}
+	m_aLevelBlocks.resize(nTo);
+	m_nLevelBlocksHoles = 0;
+}
 
 bool Level::coordsCanPlaceOnBoard(const Coords& oCoords, bool bStrict) const noexcept
 {
@@ -2110,7 +2262,7 @@ void Level::animationCreateShowTextCommon(LevelAnimation::REFSYS eRefSys, int32_
 	oInit.m_nZ = nZ;
 	oInit.m_aLines = std::move(aLines);
 	oInit.m_fFontHeight = fTextSize;
-	s_oTextAnimationRecycler.create(refShowText, std::move(oInit));
+	m_oTextAnimationRecycler.create(refShowText, std::move(oInit));
 //std::cout << "Level::animationCreateShowTextCommon  id=" << refShowText->getId() << "   nNamedIdx=" << nNamedIdx << '\n';
 
 	animationPrivAddCommon(refShowText, eRefSys, 0.0);
@@ -2489,9 +2641,11 @@ void Level::dump(bool bDumpBoard, bool bDumpLevelBlocks, bool bDumpTileAni, bool
 	if (bDumpLevelBlocks) {
 		std::cout << "Level::dump()  LevelBlock[Id]=(PosX, PosY, ShapeId)  bricks (RelX,RelY,BrickId).." << '\n';
 		std::cout << "                       contacts DIR (RelX,RelY,BrickId).." << '\n';
-		for (auto& it : m_oAllLevelBlocks) {
-			const int32_t nId = it.first;
-			LevelBlock* p0LevelBlock = it.second;
+		for (LevelBlock* p0LevelBlock : m_aLevelBlocks) {
+			if (p0LevelBlock == nullptr) {
+				continue; // for p0LevelBlock
+			}
+			const int32_t nId = p0LevelBlock->blockGetId();
 			const int32_t nShapeId = p0LevelBlock->m_nShapeId;
 			std::cout << "    LevelBlock[" << nId << "]=(" << p0LevelBlock->m_nPosX << "," << p0LevelBlock->m_nPosY << "," << nShapeId;
 			std::cout << ")  bricks ";
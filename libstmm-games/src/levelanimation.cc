@@ -28,7 +28,7 @@
 namespace stmg
 {
 
-int32_t LevelAnimation::s_nId = 0;
+std::atomic<int32_t> LevelAnimation::s_nId(0);
 
 const double LevelAnimation::s_fDurationUndefined = -1.0;
 const double LevelAnimation::s_fDurationInfinity = 10000000000.0;
@@ -36,6 +36,7 @@ const double LevelAnimation::s_fDurationInfinity = 10000000000.0;
 LevelAnimation::LevelAnimation(const Init& oInit) noexcept
 : m_nId(++s_nId)
 , m_nAnimationIdx(oInit.m_nAnimationNamedIdx)
+, m_nClassId(classId<LevelAnimation>())
 , m_fDuration(oInit.m_fDuration)
 , m_oPos(oInit.m_oPos)
 , m_nZ(oInit.m_nZ)
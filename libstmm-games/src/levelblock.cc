@@ -42,14 +42,13 @@
 
 #include <stdint.h>
 
-namespace stmg { class KeyActionEvent; }
 namespace stmi { class Event; }
 
 
 namespace stmg
 {
 
-int32_t LevelBlock::s_nId = 0;
+std::atomic<int32_t> LevelBlock::s_nId(0);
 
 LevelBlock::LevelBlock(bool bRemoveEmptyShapes) noexcept
 : m_nId(++s_nId)
@@ -66,6 +65,7 @@ LevelBlock::LevelBlock(bool bRemoveEmptyShapes) noexcept
 , m_nControllerTeam(-1)
 , m_nLastTimerCall(-1)
 , m_nLastFallCall(-1)
+, m_nLevelBlockIdx(-1)
 , m_nScrolledUnique(0)
 , m_bRemoveEmptyShapes(bRemoveEmptyShapes)
 {
@@ -76,9 +76,13 @@ LevelBlock::LevelBlock(bool bRemoveEmptyShapes) noexcept
 void LevelBlock::handleInput(const shared_ptr<stmi::Event>& /*refEvent*/) noexcept
 {
 }
-void LevelBlock::handleKeyActionInput(const shared_ptr<KeyActionEvent>& /*refEvent*/) noexcept
+void LevelBlock::handleKeyActionInput(const KeyActionRing::Handle& /*oKeyAction*/) noexcept
 {
 }
+bool LevelBlock::isSubTickInputCapable() const noexcept
+{
+	return false;
+}
 const std::vector<int32_t>& LevelBlock::blockBrickIds() const noexcept
 {
 	if (m_aCachedBrickId.empty()) {
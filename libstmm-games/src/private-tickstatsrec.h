@@ -0,0 +1,115 @@
+/*
+ * Copyright © 2019-2020  Stefano Marsili, <stemars@gmx.ch>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>
+ */
+/*
+ * File:   private-tickstatsrec.h
+ */
+
+#ifndef STMG_PRIVATE_TICK_STATS_REC_H
+#define STMG_PRIVATE_TICK_STATS_REC_H
+
+#ifdef STMG_TICK_STATS
+
+#include "tickstats.h"
+
+#include <chrono>
+#include <typeinfo>
+
+#include <stdint.h>
+
+namespace stmg
+{
+
+/** Records to the TickStats of the game tick currently running in this thread.
+ * Use the STMG_TICK_STATS_XXX macros rather than this class directly
+ * so that recording is compiled out when STMG_TICK_STATS is not defined.
+ */
+class TickStatsRecorder
+{
+public:
+	/** Makes a TickStats current for the duration of a game tick. */
+	class TickScope
+	{
+	public:
+		TickScope(TickStats& oTickStats, int32_t nGameTick) noexcept;
+		~TickScope() noexcept;
+	private:
+		TickStats* m_p0PrevStats;
+		TickStats::Tick* m_p0PrevTick;
+		int64_t m_nStart;
+	};
+	/** Adds the duration of the scope to a phase of the current tick. */
+	class PhaseScope
+	{
+	public:
+		explicit PhaseScope(TickStats::PHASE ePhase) noexcept;
+		~PhaseScope() noexcept;
+	private:
+		TickStats::PHASE m_ePhase;
+		int64_t m_nStart;
+	};
+	/** Counts an Event::trigger() call and adds the duration of the scope. */
+	class EventScope
+	{
+	public:
+		explicit EventScope(const std::type_info& oTypeInfo) noexcept;
+		~EventScope() noexcept;
+	private:
+		TickStats* m_p0Stats;
+		int32_t m_nIdx;
+		int64_t m_nStart;
+	};
+	/** Counts a listener dispatch.
+	 * @param eDispatch The dispatch.
+	 * @param nTotListeners The number of listeners notified.
+	 */
+	static void dispatch(TickStats::DISPATCH eDispatch, int32_t nTotListeners) noexcept
+	{
+		if (s_p0Current == nullptr) {
+			return; //----------------------------------------------------------
+		}
+		auto& oDispatch = s_p0Current->m_aDispatches[eDispatch];
+		++oDispatch.m_nDispatches;
+		oDispatch.m_nListenerCalls += nTotListeners;
+	}
+private:
+	static int64_t now() noexcept
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+								std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+private:
+	static thread_local TickStats* s_p0Current;
+	static thread_local TickStats::Tick* s_p0CurrentTick;
+};
+
+} // namespace stmg
+
+#define STMG_TICK_STATS_TICK(oTickStats, nGameTick) TickStatsRecorder::TickScope oTickStatsTickScope((oTickStats), (nGameTick))
+#define STMG_TICK_STATS_PHASE(ePhase) TickStatsRecorder::PhaseScope oTickStatsPhaseScope(TickStats::ePhase)
+#define STMG_TICK_STATS_EVENT(oEvent) TickStatsRecorder::EventScope oTickStatsEventScope(typeid(oEvent))
+#define STMG_TICK_STATS_DISPATCH(eDispatch, nTotListeners) TickStatsRecorder::dispatch(TickStats::eDispatch, (nTotListeners))
+
+#else //STMG_TICK_STATS
+
+#define STMG_TICK_STATS_TICK(oTickStats, nGameTick)
+#define STMG_TICK_STATS_PHASE(ePhase)
+#define STMG_TICK_STATS_EVENT(oEvent)
+#define STMG_TICK_STATS_DISPATCH(eDispatch, nTotListeners)
+
+#endif //STMG_TICK_STATS
+
+#endif	/* STMG_PRIVATE_TICK_STATS_REC_H */
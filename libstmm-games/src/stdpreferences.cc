@@ -656,6 +656,9 @@ StdPreferences& StdPreferences::operator=(const StdPreferences& oSource) noexcep
 	} else {
 		m_refDefaultPlayer.reset();
 	}
+	if (!m_bEditMode) {
+		compileKeyActionTable();
+	}
 	// Note: initListenToDeviceMgmt() must not be called since done in constructor
 	return *this;
 }
@@ -764,6 +767,10 @@ void StdPreferences::deviceAdded(const shared_ptr<stmi::Device>& refDevice) noex
 			}
 		}
 	}
+	if (!m_bEditMode) {
+		// the capability ids have changed
+		compileKeyActionTable();
+	}
 }
 void StdPreferences::removeReferencesToCapability(int32_t nClassIdx, int32_t nCapaIdx, CapabilityData& oCapabilityData) noexcept
 {
@@ -909,6 +916,8 @@ void StdPreferences::deviceRemoved(const shared_ptr<stmi::Device>& refDevice) no
 		// nedded because removeReferencesToCapability() might have set m_bUndefinedKeyActions
 		populatePlayersKeyActions();
 		recalcStuff();
+	} else {
+		compileKeyActionTable();
 	}
 }
 void StdPreferences::setEditMode(bool bInEditMode) noexcept
@@ -919,9 +928,13 @@ void StdPreferences::setEditMode(bool bInEditMode) noexcept
 	if (!bInEditMode) {
 		// to runtime mode
 		m_bEditMode = false;
+		// players and key actions can't change until back in edit mode
+		compileKeyActionTable();
 		return; //--------------------------------------------------------------
 	}
 	m_bEditMode = true;
+	m_aKeyActionTableCapabilities.clear();
+	m_aKeyActionTable.clear();
 	// runtime mode to edit mode.
 	const int32_t nTotClasses = static_cast<int32_t>(m_aCapabilityClass.size());
 	for (int32_t nClassIdx = 0; nClassIdx < nTotClasses; ++nClassIdx) {
@@ -1994,6 +2007,15 @@ bool StdPreferences::setTotPlayers(int32_t nTotPlayers, int32_t nForceTeam) noex
 bool StdPreferences::getPlayerKeyActionFromCapabilityKey(int32_t nCapabilityId, stmi::HARDWARE_KEY eKey
 														, shared_ptr<PrefPlayer>& refPlayer, int32_t& nKeyActionId) const noexcept
 {
+	if (!m_bEditMode) {
+		const KeyActionTableEntry* p0Entry = getKeyActionTableEntry(nCapabilityId, eKey);
+		if (p0Entry == nullptr) {
+			return false; //----------------------------------------------------
+		}
+		nKeyActionId = p0Entry->m_nKeyActionId;
+		refPlayer = m_aTeam[p0Entry->m_nTeam]->m_aTeammate[p0Entry->m_nMate];
+		return true; //---------------------------------------------------------
+	}
 	std::unordered_map<stmi::HARDWARE_KEY, std::pair< shared_ptr<Player>, int32_t > >::const_iterator itFindKey;
 	const bool bFound = getPlayerKeyActionFromCapabilityKey(nCapabilityId, eKey, itFindKey);
 	if (!bFound) {
@@ -2007,6 +2029,16 @@ bool StdPreferences::getPlayerKeyActionFromCapabilityKey(int32_t nCapabilityId,
 bool StdPreferences::getPlayerKeyActionFromCapabilityKey(int32_t nCapabilityId, stmi::HARDWARE_KEY eKey
 														, int32_t& nTeam, int32_t& nMate, int32_t& nKeyActionId) const noexcept
 {
+	if (!m_bEditMode) {
+		const KeyActionTableEntry* p0Entry = getKeyActionTableEntry(nCapabilityId, eKey);
+		if (p0Entry == nullptr) {
+			return false; //----------------------------------------------------
+		}
+		nKeyActionId = p0Entry->m_nKeyActionId;
+		nMate = p0Entry->m_nMate;
+		nTeam = p0Entry->m_nTeam;
+		return true; //---------------------------------------------------------
+	}
 	std::unordered_map<stmi::HARDWARE_KEY, std::pair< shared_ptr<Player>, int32_t > >::const_iterator itFindKey;
 	const bool bFound = getPlayerKeyActionFromCapabilityKey(nCapabilityId, eKey, itFindKey);
 	if (!bFound) {
@@ -2037,6 +2069,61 @@ bool StdPreferences::getPlayerKeyActionFromCapabilityKey(int32_t nCapabilityId,
 	}
 	return true;
 }
+const StdPreferences::KeyActionTableEntry* StdPreferences::getKeyActionTableEntry(int32_t nCapabilityId
+																				, stmi::HARDWARE_KEY eKey) const noexcept
+{
+	assert(!m_bEditMode);
+	assert(eKey != stmi::HK_NULL);
+	if ((nCapabilityId < 0) || (nCapabilityId >= static_cast<int32_t>(m_aKeyActionTableCapabilities.size()))) {
+		return nullptr; //------------------------------------------------------
+	}
+	const KeyActionTableCapability& oCapa = m_aKeyActionTableCapabilities[nCapabilityId];
+	const int32_t nKey = static_cast<int32_t>(eKey);
+	if ((nKey < 0) || (nKey >= oCapa.m_nTotKeys)) {
+		return nullptr; //------------------------------------------------------
+	}
+	const KeyActionTableEntry& oEntry = m_aKeyActionTable[oCapa.m_nStart + nKey];
+	if (oEntry.m_nKeyActionId < 0) {
+		return nullptr; //------------------------------------------------------
+	}
+	return &oEntry;
+}
+void StdPreferences::compileKeyActionTable() noexcept
+{
+	assert(!m_bEditMode);
+	m_aKeyActionTableCapabilities.clear();
+	m_aKeyActionTable.clear();
+	for (const auto& oCapabilityClassData : m_aCapabilityClassData) {
+		for (const auto& oCapabilityData : oCapabilityClassData.m_aCapabilityData) {
+			if ((!oCapabilityData.m_refCapability) || oCapabilityData.m_oHKPlayerKeyAction.empty()) {
+				// removed or no key actions
+				continue; // for oCapabilityData ------
+			}
+			const int32_t nCapabilityId = oCapabilityData.m_refCapability->getId();
+			assert(nCapabilityId >= 0);
+			int32_t nMaxKey = -1;
+			for (const auto& oPair : oCapabilityData.m_oHKPlayerKeyAction) {
+				nMaxKey = std::max(nMaxKey, static_cast<int32_t>(oPair.first));
+			}
+			KeyActionTableCapability oCapa;
+			oCapa.m_nStart = static_cast<int32_t>(m_aKeyActionTable.size());
+			oCapa.m_nTotKeys = nMaxKey + 1;
+			m_aKeyActionTable.resize(oCapa.m_nStart + oCapa.m_nTotKeys);
+			for (const auto& oPair : oCapabilityData.m_oHKPlayerKeyAction) {
+				const auto& oPlayerActionPair = oPair.second;
+				const shared_ptr<Player>& refPlayer = oPlayerActionPair.first;
+				KeyActionTableEntry& oEntry = m_aKeyActionTable[oCapa.m_nStart + static_cast<int32_t>(oPair.first)];
+				oEntry.m_nTeam = refPlayer->m_p0Team->m_nTeam;
+				oEntry.m_nMate = refPlayer->m_nMate;
+				oEntry.m_nKeyActionId = oPlayerActionPair.second;
+			}
+			if (nCapabilityId >= static_cast<int32_t>(m_aKeyActionTableCapabilities.size())) {
+				m_aKeyActionTableCapabilities.resize(nCapabilityId + 1);
+			}
+			m_aKeyActionTableCapabilities[nCapabilityId] = oCapa;
+		}
+	}
+}
 bool StdPreferences::getCapabilityPlayer(int32_t nCapabilityId
 										, shared_ptr<PrefPlayer>& refPlayer) const noexcept
 {
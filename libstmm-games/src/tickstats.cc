@@ -0,0 +1,297 @@
+/*
+ * Copyright © 2019-2020  Stefano Marsili, <stemars@gmx.ch>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>
+ */
+/*
+ * File:   tickstats.cc
+ */
+
+#ifdef STMG_TICK_STATS
+
+#include "tickstats.h"
+#include "private-tickstatsrec.h"
+
+#include <cassert>
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <typeinfo>
+
+#ifdef __GNUG__
+#include <cxxabi.h>
+#endif //__GNUG__
+
+namespace stmg
+{
+
+namespace Private
+{
+static std::string demangledName(const std::type_info& oTypeInfo) noexcept
+{
+	const char* p0Name = oTypeInfo.name();
+	#ifdef __GNUG__
+	int nStatus = -1;
+	char* p0Demangled = abi::__cxa_demangle(p0Name, nullptr, nullptr, &nStatus);
+	if (p0Demangled != nullptr) {
+		std::string sName = ((nStatus == 0) ? std::string(p0Demangled) : std::string(p0Name));
+		std::free(p0Demangled);
+		return sName; //--------------------------------------------------------
+	}
+	#endif //__GNUG__
+	return std::string(p0Name);
+}
+static void appendJsonString(std::string& sJson, const std::string& sStr) noexcept
+{
+	sJson.push_back('"');
+	for (const char c : sStr) {
+		if ((c == '"') || (c == '\\')) {
+			sJson.push_back('\\');
+			sJson.push_back(c);
+		} else if (static_cast<unsigned char>(c) < 0x20) {
+			sJson.push_back(' ');
+		} else {
+			sJson.push_back(c);
+		}
+	}
+	sJson.push_back('"');
+}
+} // namespace Private
+
+constexpr int32_t TickStats::s_nTotPhases;
+constexpr int32_t TickStats::s_nTotDispatches;
+constexpr int32_t TickStats::s_nMaxRecentTicks;
+
+TickStats::TickStats() noexcept
+: m_nTotTicks(0)
+, m_nRecentTicksNext(0)
+{
+}
+void TickStats::clear() noexcept
+{
+	m_nTotTicks = 0;
+	m_aRecentTicks.clear();
+	m_nRecentTicksNext = 0;
+	for (auto& oPhase : m_aPhases) {
+		oPhase = PhaseStats{};
+	}
+	m_aEventClasses.clear();
+	m_oEventClassIdx.clear();
+	for (auto& oDispatch : m_aDispatches) {
+		oDispatch = DispatchStats{};
+	}
+}
+std::vector<TickStats::Tick> TickStats::getRecentTicks() const noexcept
+{
+	const int32_t nTotRecent = static_cast<int32_t>(std::min<int64_t>(m_nTotTicks, s_nMaxRecentTicks));
+	std::vector<Tick> aTicks;
+	aTicks.reserve(nTotRecent);
+	// The oldest tick is the one that will be overwritten next
+	const int32_t nOldest = ((nTotRecent < s_nMaxRecentTicks) ? 0 : m_nRecentTicksNext);
+	for (int32_t nCount = 0; nCount < nTotRecent; ++nCount) {
+		aTicks.push_back(m_aRecentTicks[(nOldest + nCount) % s_nMaxRecentTicks]);
+	}
+	return aTicks;
+}
+const TickStats::PhaseStats& TickStats::getPhaseStats(PHASE ePhase) const noexcept
+{
+	assert((ePhase >= 0) && (ePhase < s_nTotPhases));
+	return m_aPhases[ePhase];
+}
+const TickStats::DispatchStats& TickStats::getDispatchStats(DISPATCH eDispatch) const noexcept
+{
+	assert((eDispatch >= 0) && (eDispatch < s_nTotDispatches));
+	return m_aDispatches[eDispatch];
+}
+const char* TickStats::getPhaseName(PHASE ePhase) noexcept
+{
+	switch (ePhase) {
+	case PHASE_INPUTS: return "inputs";
+	case PHASE_BLOCKS: return "blocks";
+	case PHASE_EVENTS: return "events";
+	case PHASE_POST: return "post";
+	}
+	assert(false);
+	return "?";
+}
+const char* TickStats::getDispatchName(DISPATCH eDispatch) noexcept
+{
+	switch (eDispatch) {
+	case DISPATCH_BOARD_SCROLL: return "boardScroll";
+	case DISPATCH_BOARD_INSERT: return "boardInsert";
+	case DISPATCH_BOARD_MODIFY: return "boardModify";
+	case DISPATCH_BOARD_DESTROY: return "boardDestroy";
+	case DISPATCH_BLOCK_ADD: return "blockAdd";
+	case DISPATCH_BLOCK_REMOVE: return "blockRemove";
+	case DISPATCH_BLOCK_DESTROY: return "blockDestroy";
+	case DISPATCH_BLOCK_FUSE: return "blockFuse";
+	case DISPATCH_BLOCK_FREEZE: return "blockFreeze";
+	case DISPATCH_BLOCK_UNFREEZE: return "blockUnfreeze";
+	}
+	assert(false);
+	return "?";
+}
+std::string TickStats::toJson() const noexcept
+{
+	std::string sJson = "{";
+	sJson += "\"totTicks\":" + std::to_string(m_nTotTicks);
+	//
+	sJson += ",\"phases\":{";
+	for (int32_t nPhase = 0; nPhase < s_nTotPhases; ++nPhase) {
+		const auto ePhase = static_cast<PHASE>(nPhase);
+		const PhaseStats& oPhase = m_aPhases[nPhase];
+		if (nPhase > 0) {
+			sJson += ",";
+		}
+		sJson += "\"" + std::string(getPhaseName(ePhase)) + "\":{";
+		sJson += "\"totalNs\":" + std::to_string(oPhase.m_nTotalNanosec);
+		sJson += ",\"maxNs\":" + std::to_string(oPhase.m_nMaxNanosec);
+		sJson += "}";
+	}
+	sJson += "}";
+	//
+	sJson += ",\"recentTicks\":[";
+	bool bFirst = true;
+	for (const Tick& oTick : getRecentTicks()) {
+		if (bFirst) {
+			bFirst = false;
+		} else {
+			sJson += ",";
+		}
+		sJson += "{\"tick\":" + std::to_string(oTick.m_nGameTick);
+		sJson += ",\"totalNs\":" + std::to_string(oTick.m_nTotalNanosec);
+		for (int32_t nPhase = 0; nPhase < s_nTotPhases; ++nPhase) {
+			sJson += ",\"" + std::string(getPhaseName(static_cast<PHASE>(nPhase))) + "Ns\":";
+			sJson += std::to_string(oTick.m_aPhaseNanosec[nPhase]);
+		}
+		sJson += "}";
+	}
+	sJson += "]";
+	//
+	sJson += ",\"eventClasses\":[";
+	bFirst = true;
+	for (const EventClassStats& oEventClass : m_aEventClasses) {
+		if (bFirst) {
+			bFirst = false;
+		} else {
+			sJson += ",";
+		}
+		sJson += "{\"class\":";
+		Private::appendJsonString(sJson, oEventClass.m_sClassName);
+		sJson += ",\"triggers\":" + std::to_string(oEventClass.m_nTriggers);
+		sJson += ",\"totalNs\":" + std::to_string(oEventClass.m_nNanosec);
+		sJson += "}";
+	}
+	sJson += "]";
+	//
+	sJson += ",\"dispatches\":{";
+	for (int32_t nDispatch = 0; nDispatch < s_nTotDispatches; ++nDispatch) {
+		const auto eDispatch = static_cast<DISPATCH>(nDispatch);
+		const DispatchStats& oDispatch = m_aDispatches[nDispatch];
+		if (nDispatch > 0) {
+			sJson += ",";
+		}
+		sJson += "\"" + std::string(getDispatchName(eDispatch)) + "\":{";
+		sJson += "\"dispatches\":" + std::to_string(oDispatch.m_nDispatches);
+		sJson += ",\"listenerCalls\":" + std::to_string(oDispatch.m_nListenerCalls);
+		sJson += "}";
+	}
+	sJson += "}";
+	sJson += "}";
+	return sJson;
+}
+TickStats::Tick& TickStats::tickBegin(int32_t nGameTick) noexcept
+{
+	if (m_aRecentTicks.empty()) {
+		m_aRecentTicks.resize(s_nMaxRecentTicks);
+		m_nRecentTicksNext = 0;
+	}
+	Tick& oTick = m_aRecentTicks[m_nRecentTicksNext];
+	oTick = Tick{};
+	oTick.m_nGameTick = nGameTick;
+	m_nRecentTicksNext = (m_nRecentTicksNext + 1) % s_nMaxRecentTicks;
+	return oTick;
+}
+void TickStats::tickEnd(Tick& oTick, int64_t nTotalNanosec) noexcept
+{
+	oTick.m_nTotalNanosec = nTotalNanosec;
+	for (int32_t nPhase = 0; nPhase < s_nTotPhases; ++nPhase) {
+		PhaseStats& oPhase = m_aPhases[nPhase];
+		const int64_t nNanosec = oTick.m_aPhaseNanosec[nPhase];
+		oPhase.m_nTotalNanosec += nNanosec;
+		oPhase.m_nMaxNanosec = std::max(oPhase.m_nMaxNanosec, nNanosec);
+	}
+	++m_nTotTicks;
+}
+int32_t TickStats::eventClassIdx(const std::type_info& oTypeInfo) noexcept
+{
+	const std::type_index oTypeIndex(oTypeInfo);
+	auto itFind = m_oEventClassIdx.find(oTypeIndex);
+	if (itFind != m_oEventClassIdx.end()) {
+		return itFind->second; //-----------------------------------------------
+	}
+	const int32_t nIdx = static_cast<int32_t>(m_aEventClasses.size());
+	m_aEventClasses.emplace_back();
+	m_aEventClasses.back().m_sClassName = Private::demangledName(oTypeInfo);
+	m_oEventClassIdx.emplace(oTypeIndex, nIdx);
+	return nIdx;
+}
+
+thread_local TickStats* TickStatsRecorder::s_p0Current = nullptr;
+thread_local TickStats::Tick* TickStatsRecorder::s_p0CurrentTick = nullptr;
+
+TickStatsRecorder::TickScope::TickScope(TickStats& oTickStats, int32_t nGameTick) noexcept
+: m_p0PrevStats(s_p0Current)
+, m_p0PrevTick(s_p0CurrentTick)
+, m_nStart(now())
+{
+	s_p0Current = &oTickStats;
+	s_p0CurrentTick = &oTickStats.tickBegin(nGameTick);
+}
+TickStatsRecorder::TickScope::~TickScope() noexcept
+{
+	s_p0Current->tickEnd(*s_p0CurrentTick, now() - m_nStart);
+	s_p0Current = m_p0PrevStats;
+	s_p0CurrentTick = m_p0PrevTick;
+}
+TickStatsRecorder::PhaseScope::PhaseScope(TickStats::PHASE ePhase) noexcept
+: m_ePhase(ePhase)
+, m_nStart(now())
+{
+}
+TickStatsRecorder::PhaseScope::~PhaseScope() noexcept
+{
+	if (s_p0CurrentTick != nullptr) {
+		s_p0CurrentTick->m_aPhaseNanosec[m_ePhase] += now() - m_nStart;
+	}
+}
+TickStatsRecorder::EventScope::EventScope(const std::type_info& oTypeInfo) noexcept
+: m_p0Stats(s_p0Current)
+, m_nIdx((s_p0Current == nullptr) ? -1 : s_p0Current->eventClassIdx(oTypeInfo))
+, m_nStart(now())
+{
+}
+TickStatsRecorder::EventScope::~EventScope() noexcept
+{
+	if (m_p0Stats != nullptr) {
+		// Nested triggers might have added classes: access by index
+		auto& oEventClass = m_p0Stats->m_aEventClasses[m_nIdx];
+		++oEventClass.m_nTriggers;
+		oEventClass.m_nNanosec += now() - m_nStart;
+	}
+}
+
+} // namespace stmg
+
+#endif //STMG_TICK_STATS
@@ -50,6 +50,10 @@ int32_t Variable::calcElapsed() const noexcept
 		nElapsed = static_cast<int32_t>(m_p0Game->gameElapsedMillisec());
 		assert(nElapsed >= 0);
 	}
+	return calcElapsed(nElapsed);
+}
+int32_t Variable::calcElapsed(int32_t nElapsed) const noexcept
+{
 	if (m_p0VarType->m_eTimeBase == VARIABLE_TIME_BASE_MIN) {
 		nElapsed = nElapsed / 60 / 1000;
 	} else if (m_p0VarType->m_eTimeBase == VARIABLE_TIME_BASE_SEC) {
@@ -113,17 +117,43 @@ void Variable::inhibit() noexcept
 bool Variable::isChanged() const noexcept
 {
 	assert(m_p0VarType != nullptr);
-	if (m_p0VarType->m_bTimeRelative) {
-		return true; //---------------------------------------------------------
-	}
 	assert(m_p0Game != nullptr);
 	const int32_t nElapsed = m_p0Game->gameElapsed();
 	if (m_p0Game->isInGameTick()) {
+		// The elapsed time is the same as in the view ticks preceding this game tick
 		return (nElapsed <= m_nLastChangeTime);
-	} else {
-		// asking from a view tick, => elapsed ticks was incremented
-		return (nElapsed - 1 <= m_nLastChangeTime);
 	}
+	// asking from a view tick, => elapsed ticks was incremented
+	if (nElapsed - 1 <= m_nLastChangeTime) {
+		return true; //---------------------------------------------------------
+	}
+	if (m_p0VarType->m_bTimeRelative && (m_nInhibitTimeMillisec < 0)) {
+		// The value changes only when the elapsed time crosses a time base unit
+		const int32_t nNowMillisec = static_cast<int32_t>(m_p0Game->gameElapsedMillisec());
+		const int32_t nPrevMillisec = static_cast<int32_t>(m_p0Game->gamePrevElapsedMillisec());
+		return (calcNextChangeMillisec(nPrevMillisec) <= nNowMillisec);
+	}
+	return false;
+}
+int32_t Variable::getNextChangeMillisec() const noexcept
+{
+	assert(m_p0VarType != nullptr);
+	if ((! m_p0VarType->m_bTimeRelative) || (m_nInhibitTimeMillisec >= 0)) {
+		return -1; //-----------------------------------------------------------
+	}
+	assert(m_p0Game != nullptr);
+	return calcNextChangeMillisec(static_cast<int32_t>(m_p0Game->gameElapsedMillisec()));
+}
+int32_t Variable::calcNextChangeMillisec(int32_t nElapsedMillisec) const noexcept
+{
+	assert(nElapsedMillisec >= 0);
+	int32_t nUnitMillisec = 1;
+	if (m_p0VarType->m_eTimeBase == VARIABLE_TIME_BASE_MIN) {
+		nUnitMillisec = 60 * 1000;
+	} else if (m_p0VarType->m_eTimeBase == VARIABLE_TIME_BASE_SEC) {
+		nUnitMillisec = 1000;
+	}
+	return (nElapsedMillisec / nUnitMillisec + 1) * nUnitMillisec;
 }
 std::string variableValueToString(int32_t nValue, Variable::VARIABLE_FORMAT eFormat) noexcept
 {
@@ -41,6 +41,7 @@ ActionWidget::ActionWidget(Init&& oInit) noexcept
 , m_p0Event(nullptr)
 , m_bEventChecked(false)
 {
+	setClassId(this);
 	checkData();
 }
 void ActionWidget::reInit(Init&& oInit) noexcept
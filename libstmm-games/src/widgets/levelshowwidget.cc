@@ -36,6 +36,7 @@ LevelShowWidget::LevelShowWidget(Init&& oInit) noexcept
 : GameWidget(std::move(oInit))
 , m_oData(std::move(oInit))
 {
+	setClassId(this);
 	commonInit();
 }
 void LevelShowWidget::reInit(Init&& oInit) noexcept
@@ -38,6 +38,7 @@ PreviewWidget::PreviewWidget(Init&& oInit) noexcept
 , m_oData(std::move(oInit))
 , m_nChangeGameTick(-1)
 {
+	setClassId(this);
 }
 void PreviewWidget::reInit(Init&& oInit) noexcept
 {
@@ -0,0 +1,181 @@
+/*
+ * Copyright © 2019-2020  Stefano Marsili, <stemars@gmx.ch>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see <http://www.gnu.org/licenses/>
+ */
+/*
+ * File:   testBoardUnfreeze.cxx
+ */
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+
+#include "levellisteners.h"
+#include "utile/tilecoords.h"
+
+#include "stmm-games-fake/fixtureGame.h"
+#include "stmm-games-fake/dumbblockevent.h"
+
+namespace stmg
+{
+
+using std::shared_ptr;
+using std::unique_ptr;
+using std::make_unique;
+
+namespace testing
+{
+
+class BoardUnfreezeGameFixture : public GameFixture
+							//default , public FixtureVariantDevicesKeys_Two, public FixtureVariantDevicesJoystick_Two
+							, public FixtureVariantPrefsTeams<1>
+							//default , public FixtureVariantPrefsMates<0,2>
+							//default , public FixtureVariantMatesPerTeamMax_Three, public FixtureVariantAIMatesPerTeamMax_Zero
+							//default , public FixtureVariantAllowMixedAIHumanTeam_False, public FixtureVariantPlayersMax_Six
+							//default , public FixtureVariantTeamsMin_One, public FixtureVariantTeamsMax_Two
+							//default , public FixtureVariantKeyActions_AllCapabilityClassesDefaults
+							//default , public FixtureVariantLayoutTeamDistribution_AllTeamsInOneLevel
+							//default , public FixtureVariantLayoutShowMode_Show
+							//default , public FixtureVariantLayoutCreateVarWidgetsFromVariables_False
+							//default , public FixtureVariantLayoutCreateActionWidgetsFromKeyActions_False
+							, public FixtureVariantVariablesGame_Time
+							//, public FixtureVariantVariablesTeam
+							, public FixtureVariantVariablesPlayer_Lives<3>
+							//default , public FixtureVariantLevelInitBoardWidth<10>
+							//default , public FixtureVariantLevelInitBoardHeight<6>
+							//default , public FixtureVariantLevelInitShowWidth<10>
+							//default , public FixtureVariantLevelInitShowHeight<6>
+{
+protected:
+	void setup() override
+	{
+		GameFixture::setup();
+	}
+	void teardown() override
+	{
+		GameFixture::teardown();
+	}
+};
+// Counts the board modifications and checks the pre/post pairing
+class CountingBoardListener : public BoardListener
+{
+public:
+	void boardPreScroll(Direction::VALUE /*eDir*/, const shared_ptr<TileRect>& /*refTiles*/) noexcept override {}
+	void boardPostScroll(Direction::VALUE /*eDir*/) noexcept override {}
+	void boabloPreFreeze(LevelBlock& /*oBlock*/) noexcept override {}
+	void boabloPostFreeze(const Coords& /*oCoords*/) noexcept override {}
+	void boabloPreUnfreeze(const Coords& /*oCoords*/) noexcept override {}
+	void boabloPostUnfreeze(LevelBlock& /*oBlock*/) noexcept override {}
+	void boardPreInsert(Direction::VALUE /*eDir*/, NRect /*oArea*/, const shared_ptr<TileRect>& /*refTiles*/) noexcept override {}
+	void boardPostInsert(Direction::VALUE /*eDir*/, NRect /*oArea*/) noexcept override {}
+	void boardPreDestroy(const Coords& /*oCoords*/) noexcept override {}
+	void boardPostDestroy(const Coords& /*oCoords*/) noexcept override {}
+	void boardPreModify(const TileCoords& oTileCoords) noexcept override
+	{
+		REQUIRE_FALSE( m_bInModify );
+		m_bInModify = true;
+		++m_nTotPreModify;
+		m_nLastModifySize = oTileCoords.size();
+	}
+	void boardPostModify(const Coords& /*oCoords*/) noexcept override
+	{
+		REQUIRE( m_bInModify );
+		m_bInModify = false;
+		++m_nTotPostModify;
+	}
+	bool m_bInModify = false;
+	int32_t m_nTotPreModify = 0;
+	int32_t m_nTotPostModify = 0;
+	int32_t m_nLastModifySize = -1;
+};
+
+// Checks that the unfrozen cells are already empty when the block is added
+class UnfreezeBoardListener : public CountingBoardListener
+{
+public:
+	explicit UnfreezeBoardListener(Level* p0Level) noexcept
+	: m_p0Level(p0Level)
+	{
+	}
+	void boabloPostUnfreeze(LevelBlock& oBlock) noexcept override
+	{
+		++m_nTotPostUnfreeze;
+		m_bCellsEmpty = m_p0Level->boardGetTile(2, 3).isEmpty() && m_p0Level->boardGetTile(3, 3).isEmpty();
+		m_bBlockAdded = (oBlock.blockBricksTot() == 2);
+	}
+	Level* m_p0Level;
+	int32_t m_nTotPostUnfreeze = 0;
+	bool m_bCellsEmpty = false;
+	bool m_bBlockAdded = false;
+};
+class UnfreezeCreator : public Level::LevelBlockCreator
+{
+public:
+	explicit UnfreezeCreator(LevelBlock* p0LevelBlock) noexcept
+	: m_p0LevelBlock(p0LevelBlock)
+	{
+	}
+	LevelBlock* create() noexcept override
+	{
+		return m_p0LevelBlock;
+	}
+	LevelBlock* m_p0LevelBlock;
+};
+
+TEST_CASE_METHOD(STFX<BoardUnfreezeGameFixture>, "UnfreezeSingleModify")
+{
+	Level* p0Level = m_refGame->level(0).get();
+	Tile oTileA;
+	oTileA.getTileChar().setChar(65);
+	// The block that will receive the unfrozen bricks (not added to the level yet)
+	DumbBlockEvent::Init oDInit;
+	oDInit.m_p0Level = p0Level;
+	oDInit.m_oBlock.brickAdd(oTileA, 0, 0, true);
+	oDInit.m_oInitPos = NPoint{0, 0};
+	auto refDumbBlockEvent = make_unique<DumbBlockEvent>(std::move(oDInit));
+	DumbBlockEvent* p0DumbBlockEvent = refDumbBlockEvent.get();
+	p0Level->addEvent(std::move(refDumbBlockEvent));
+	m_refGame->start();
+
+	TileCoords oTileCoords;
+	oTileCoords.add(2, 3, oTileA);
+	oTileCoords.add(3, 3, oTileA);
+	oTileCoords.add(4, 3, oTileA);
+	p0Level->boardModify(oTileCoords);
+
+	UnfreezeBoardListener oListener(p0Level);
+	p0Level->boardAddListener(&oListener);
+
+	Coords oCoords;
+	oCoords.add(2, 3);
+	oCoords.add(3, 3);
+	UnfreezeCreator oCreator(p0DumbBlockEvent);
+	const bool bUnfrozen = p0Level->boabloUnfreeze(oCoords, oCreator, LevelBlock::MGMT_TYPE_NORMAL);
+	REQUIRE( bUnfrozen );
+	REQUIRE( oListener.m_nTotPostUnfreeze == 1 );
+	REQUIRE( oListener.m_bBlockAdded );
+	// The bricks were removed from the board before the block was added
+	REQUIRE( oListener.m_bCellsEmpty );
+	// All the cells were emptied with a single modification
+	REQUIRE( oListener.m_nTotPreModify == 1 );
+	REQUIRE( oListener.m_nTotPostModify == 1 );
+	REQUIRE( oListener.m_nLastModifySize == 2 );
+	REQUIRE( p0Level->boardGetTile(4, 3) == oTileA );
+
+	p0Level->boardRemoveListener(&oListener);
+}
+
+} // namespace testing
+
+} // namespace stmg
@@ -0,0 +1,116 @@
+/*
+ * Copyright © 2019-2020  Stefano Marsili, <stemars@gmx.ch>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see <http://www.gnu.org/licenses/>
+ */
+/*
+ * File:   testClassIds.cxx
+ */
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+
+#include "util/classids.h"
+#include "animations/explosionanimation.h"
+#include "animations/imagesequenceanimation.h"
+
+namespace stmg
+{
+
+namespace testing
+{
+
+struct TestClassIdsBase
+{
+};
+struct TestClassIdsA : public TestClassIdsBase
+{
+};
+struct TestClassIdsB : public TestClassIdsBase
+{
+};
+
+class TestClassIdsExplosion : public ExplosionAnimation
+{
+public:
+	explicit TestClassIdsExplosion(const Init& oInit) noexcept
+	: ExplosionAnimation(oInit)
+	{
+	}
+};
+class TestClassIdsOwnExplosion : public ExplosionAnimation
+{
+public:
+	explicit TestClassIdsOwnExplosion(const Init& oInit) noexcept
+	: ExplosionAnimation(oInit)
+	{
+		setClassId(this);
+	}
+};
+
+TEST_CASE("testClassIds, Dense")
+{
+	const int32_t nIdA = ClassIds<TestClassIdsBase>::get<TestClassIdsA>();
+	const int32_t nIdB = ClassIds<TestClassIdsBase>::get<TestClassIdsB>();
+	const int32_t nIdBase = ClassIds<TestClassIdsBase>::get<TestClassIdsBase>();
+	REQUIRE(nIdA == 0);
+	REQUIRE(nIdB == 1);
+	REQUIRE(nIdBase == 2);
+	REQUIRE(ClassIds<TestClassIdsBase>::get<TestClassIdsA>() == nIdA);
+	REQUIRE(ClassIds<TestClassIdsBase>::getTotClassIds() == 3);
+}
+
+TEST_CASE("testClassIds, LevelAnimation")
+{
+	ExplosionAnimation::Init oInit;
+	ExplosionAnimation oExplosion(oInit);
+	REQUIRE(oExplosion.getClassId() == LevelAnimation::classId<ExplosionAnimation>());
+	REQUIRE(oExplosion.getClassId() != LevelAnimation::classId<LevelAnimation>());
+	REQUIRE(oExplosion.getClassId() != LevelAnimation::classId<ImageSequenceAnimation>());
+
+	// Inherits the id of the nearest registered ancestor
+	TestClassIdsExplosion oSubExplosion(oInit);
+	REQUIRE(oSubExplosion.getClassId() == LevelAnimation::classId<ExplosionAnimation>());
+
+	TestClassIdsOwnExplosion oOwnExplosion(oInit);
+	REQUIRE(oOwnExplosion.getClassId() == LevelAnimation::classId<TestClassIdsOwnExplosion>());
+	REQUIRE(oOwnExplosion.getClassId() != LevelAnimation::classId<ExplosionAnimation>());
+}
+
+TEST_CASE("testClassIds, IsA")
+{
+	ExplosionAnimation::Init oInit;
+	TestClassIdsOwnExplosion oOwnExplosion(oInit);
+	const int32_t nOwnId = oOwnExplosion.getClassId();
+	const int32_t nExplosionId = LevelAnimation::classId<ExplosionAnimation>();
+	const int32_t nBaseId = LevelAnimation::classId<LevelAnimation>();
+	REQUIRE(ClassIds<LevelAnimation>::isA(nOwnId, nOwnId));
+	REQUIRE(ClassIds<LevelAnimation>::isA(nOwnId, nExplosionId));
+	REQUIRE(ClassIds<LevelAnimation>::isA(nOwnId, nBaseId));
+	REQUIRE(ClassIds<LevelAnimation>::isA(nExplosionId, nBaseId));
+	REQUIRE_FALSE(ClassIds<LevelAnimation>::isA(nExplosionId, nOwnId));
+	REQUIRE_FALSE(ClassIds<LevelAnimation>::isA(nBaseId, nExplosionId));
+	REQUIRE_FALSE(ClassIds<LevelAnimation>::isA(nOwnId, LevelAnimation::classId<ImageSequenceAnimation>()));
+
+	// Ids without a registered parent are only themselves
+	const int32_t nIdA = ClassIds<TestClassIdsBase>::get<TestClassIdsA>();
+	const int32_t nIdBase = ClassIds<TestClassIdsBase>::get<TestClassIdsBase>();
+	REQUIRE_FALSE(ClassIds<TestClassIdsBase>::isA(nIdA, nIdBase));
+	ClassIds<TestClassIdsBase>::setParent(nIdA, nIdBase);
+	REQUIRE(ClassIds<TestClassIdsBase>::isA(nIdA, nIdBase));
+}
+
+} // namespace testing
+
+} // namespace stmg
@@ -0,0 +1,172 @@
+/*
+ * Copyright © 2019-2020  Stefano Marsili, <stemars@gmx.ch>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see <http://www.gnu.org/licenses/>
+ */
+/*
+ * File:   testConcurrentGames.cxx
+ */
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+
+#include "events/randomevent.h"
+#include "events/logevent.h"
+#include "events/showtextevent.h"
+
+#include "stmm-games-fake/mockevent.h"
+#include "stmm-games-fake/fixtureGame.h"
+
+#include <thread>
+#include <vector>
+
+namespace stmg
+{
+
+using std::shared_ptr;
+using std::unique_ptr;
+using std::make_unique;
+
+namespace testing
+{
+
+class ConcurrentGameFixture : public GameFixture
+							//default , public FixtureVariantDevicesKeys_Two, public FixtureVariantDevicesJoystick_Two
+							, public FixtureVariantPrefsTeams<1>
+							//default , public FixtureVariantPrefsMates<0,2>
+							//default , public FixtureVariantMatesPerTeamMax_Three, public FixtureVariantAIMatesPerTeamMax_Zero
+							//default , public FixtureVariantAllowMixedAIHumanTeam_False, public FixtureVariantPlayersMax_Six
+							//default , public FixtureVariantTeamsMin_One, public FixtureVariantTeamsMax_Two
+							//default , public FixtureVariantKeyActions_AllCapabilityClassesDefaults
+							//default , public FixtureVariantLayoutTeamDistribution_AllTeamsInOneLevel
+							//default , public FixtureVariantLayoutShowMode_Show
+							//default , public FixtureVariantLayoutCreateVarWidgetsFromVariables_False
+							//default , public FixtureVariantLayoutCreateActionWidgetsFromKeyActions_False
+							, public FixtureVariantVariablesGame_Time
+							//, public FixtureVariantVariablesTeam
+							, public FixtureVariantVariablesPlayer_Lives<3>
+							//default , public FixtureVariantLevelInitBoardWidth<10>
+							//default , public FixtureVariantLevelInitBoardHeight<6>
+							//default , public FixtureVariantLevelInitShowWidth<10>
+							//default , public FixtureVariantLevelInitShowHeight<6>
+{
+protected:
+	void setup() override
+	{
+		GameFixture::setup();
+	}
+	void teardown() override
+	{
+		GameFixture::teardown();
+	}
+};
+
+struct ConcurrentGameResult
+{
+	int32_t m_nTotTicks = 0;
+	int32_t m_nTotLogEntries = 0;
+	int32_t m_nTotBadEntries = 0;
+};
+
+// Runs a game with random, log and show text events in the current thread
+static void runConcurrentGame(int32_t nTotTicks, ConcurrentGameResult& oResult) noexcept
+{
+	STFX<ConcurrentGameFixture> oFixture;
+	shared_ptr<Game>& refGame = oFixture.m_refGame;
+
+	LogEvent::msgLog().reset();
+
+	Level* p0Level = refGame->level(0).get();
+	RandomEvent::Init oRInit;
+	oRInit.m_p0Level = p0Level;
+	oRInit.m_nFrom = 0;
+	oRInit.m_nTo = 9;
+	// All the games use the same name but each gets its own sequence
+	oRInit.m_sSharedName = "Shared";
+	auto refRandomEvent = make_unique<RandomEvent>(std::move(oRInit));
+	RandomEvent* p0RandomEvent = refRandomEvent.get();
+	p0Level->addEvent(std::move(refRandomEvent));
+
+	LogEvent::Init oLInit;
+	oLInit.m_p0Level = p0Level;
+	oLInit.m_bToStdOut = false;
+	oLInit.m_nTag = 3737;
+	auto refLogEvent = make_unique<LogEvent>(std::move(oLInit));
+	LogEvent* p0LogEvent = refLogEvent.get();
+	p0Level->addEvent(std::move(refLogEvent));
+
+	ShowTextEvent::Init oSInit;
+	oSInit.m_p0Level = p0Level;
+	oSInit.m_aSobstLines.push_back("Tick");
+	oSInit.m_oRect = FRect{0, 0, 4, 1};
+	oSInit.m_nDuration = 1000;
+	auto refShowTextEvent = make_unique<ShowTextEvent>(std::move(oSInit));
+	ShowTextEvent* p0ShowTextEvent = refShowTextEvent.get();
+	p0Level->addEvent(std::move(refShowTextEvent));
+
+	p0RandomEvent->addListener(RandomEvent::LISTENER_GROUP_RANDOM, p0LogEvent, 1001);
+
+	MockEvent::Init oMockInit;
+	oMockInit.m_p0Level = p0Level;
+	auto refMockEvent = make_unique<MockEvent>(std::move(oMockInit));
+	MockEvent* p0MockEvent = refMockEvent.get();
+	p0Level->addEvent(std::move(refMockEvent));
+
+	p0MockEvent->addListener(77, p0RandomEvent, RandomEvent::MESSAGE_GENERATE);
+	// Replaces the text animation each tick (exercises the level's recyclers)
+	p0MockEvent->addListener(77, p0ShowTextEvent, ShowTextEvent::MESSAGE_STOP_ANIMATION);
+	p0MockEvent->addListener(77, p0ShowTextEvent, 0);
+
+	refGame->start();
+	for (int32_t nTick = 0; nTick < nTotTicks; ++nTick) {
+		p0MockEvent->setTriggerValue(77, 0, 0);
+		refGame->handleTimer();
+	}
+	oResult.m_nTotTicks = refGame->gameElapsed();
+	const LogEvent::MsgLog& oMsgLog = LogEvent::msgLog();
+	oResult.m_nTotLogEntries = oMsgLog.totEntries();
+	const int32_t nTotBuffered = oMsgLog.totBuffered();
+	for (int32_t nIdx = 0; nIdx < nTotBuffered; ++nIdx) {
+		const LogEvent::MsgLog::Entry& oEntry = oMsgLog.last(nIdx);
+		if ((oEntry.m_nTag != 3737) || (oEntry.m_nValue < 0) || (oEntry.m_nValue > 9)
+				|| (oEntry.m_nTriggeringEventAddr != reinterpret_cast<int64_t>(p0RandomEvent))) {
+			++oResult.m_nTotBadEntries;
+		}
+	}
+}
+
+TEST_CASE("ConcurrentGames")
+{
+	constexpr int32_t nTotThreads = 4;
+	constexpr int32_t nTotTicks = 300;
+	std::vector<ConcurrentGameResult> aResults(nTotThreads);
+	std::vector<std::thread> aThreads;
+	for (int32_t nThread = 0; nThread < nTotThreads; ++nThread) {
+		aThreads.emplace_back(runConcurrentGame, nTotTicks, std::ref(aResults[nThread]));
+	}
+	for (auto& oThread : aThreads) {
+		oThread.join();
+	}
+	// Catch2 assertions are not thread safe: check in the main thread
+	for (const auto& oResult : aResults) {
+		REQUIRE( oResult.m_nTotTicks == nTotTicks );
+		// Each thread has its own log
+		REQUIRE( oResult.m_nTotLogEntries == nTotTicks );
+		REQUIRE( oResult.m_nTotBadEntries == 0 );
+	}
+}
+
+} // namespace testing
+
+} // namespace stmg
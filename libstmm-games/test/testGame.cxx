@@ -23,14 +23,27 @@
 
 #include "game.h"
 #include "event.h"
+#include "keyactionevent.h"
+#include "stdpreferences.h"
+#include "util/recycler.h"
+#include "events/tileanimatorevent.h"
+#include "traitsets/tiletraitsets.h"
+
+#include "stmm-games-fake/dumbblockevent.h"
+#include "stmm-games-fake/mockevent.h"
 
 #include "stmm-games-fake/fixtureLayoutAuto.h"
 #include "stmm-games-fake/fixtureGameOwner.h"
 
+#include <stmm-input-ev/keycapability.h>
+#include <stmm-input-ev/keyevent.h>
+
 namespace stmg
 {
 
 using std::shared_ptr;
+using std::unique_ptr;
+using std::make_unique;
 
 namespace testing
 {
@@ -147,6 +160,416 @@ TEST_CASE_METHOD(STFX<GameLayoutAutoFixture>, "Constructor")
 	}
 }
 
+TEST_CASE_METHOD(STFX<GameLayoutAutoFixture>, "TimeVariableChanges")
+{
+	GameOwnerFixture::resetGameOwner();
+
+	Level::Init oLevelInit;
+	oLevelInit.m_nBoardW = 10;
+	oLevelInit.m_nBoardH = 8;
+	oLevelInit.m_nShowW = 10;
+	oLevelInit.m_nShowH = 8;
+	Game::Init oGameInit;
+	oGameInit.m_sName = std::string{"Test"};
+	oGameInit.m_p0GameOwner = this;
+	oGameInit.m_oGameVariableTypes = getVariablesGame();
+	oGameInit.m_oTeamVariableTypes = getVariablesTeam();
+	oGameInit.m_oPlayerVariableTypes = getVariablesPlayer();
+	oGameInit.m_refLayout = m_refLayout;
+	oGameInit.m_fInitialGameInterval = 100.0;
+	Game oGame{std::move(oGameInit), *this, oLevelInit};
+	oGame.start();
+	const int32_t nGameTimeId = getVariablesGame().getIndex("Time");
+	const Variable& oTime = oGame.variable(nGameTimeId);
+	REQUIRE( oTime.getType().m_bTimeRelative );
+	REQUIRE( oTime.getType().m_eTimeBase == Variable::VARIABLE_TIME_BASE_SEC );
+	const int32_t nPlayerLivesId = getVariablesPlayer().getIndex("Lives");
+	REQUIRE( oGame.variable(nPlayerLivesId, 0, 0, 0).getNextChangeMillisec() == -1 );
+
+	oGame.handleTimer();
+	// The first game tick always counts as a change
+	REQUIRE( oTime.isChanged() );
+	for (int32_t nTick = 1; nTick < 25; ++nTick) {
+		oGame.handleTimer();
+		// Elapsed game time is now (nTick + 1) * 100 millisec
+		const int32_t nElapsed = (nTick + 1) * 100;
+		REQUIRE( oTime.get() == nElapsed / 1000 );
+		REQUIRE( oTime.isChanged() == (nElapsed % 1000 == 0) );
+		REQUIRE( oTime.getNextChangeMillisec() == (nElapsed / 1000 + 1) * 1000 );
+	}
+	oGame.end();
+}
+
+// Recycles the levels no longer used by a game
+class GameRecycledLevelsFixture : public GameLayoutAutoFixture
+{
+public:
+	shared_ptr<Level> createLevel(Game* p0Game, int32_t nLevel
+									, const shared_ptr<AppPreferences>& refPreferences
+									, const Level::Init& oInit) noexcept override
+	{
+		assert(p0Game != nullptr);
+		for (auto& refLevel : m_aLevels) {
+			if (refLevel.use_count() == 1) {
+				refLevel->reInit(p0Game, nLevel, refPreferences, oInit);
+				return refLevel; //---------------------------------------------
+			}
+		}
+		m_aLevels.push_back(std::make_shared<PrivateLevel>(p0Game, nLevel, refPreferences, oInit));
+		return m_aLevels.back();
+	}
+	void createGame(Recycler<Game>& oGames, shared_ptr<Game>& refGame, const Level::Init& oLevelInit)
+	{
+		Game::Init oGameInit;
+		oGameInit.m_sName = std::string{"Test"};
+		oGameInit.m_p0GameOwner = this;
+		oGameInit.m_oGameVariableTypes = getVariablesGame();
+		oGameInit.m_oTeamVariableTypes = getVariablesTeam();
+		oGameInit.m_oPlayerVariableTypes = getVariablesPlayer();
+		oGameInit.m_refLayout = m_refLayout;
+		oGames.create(refGame, std::move(oGameInit), *this, oLevelInit);
+	}
+	std::vector< unique_ptr<Event> > extractAllEvents(Level* p0Level) noexcept
+	{
+		return static_cast<PrivateLevel*>(p0Level)->extractAllEvents();
+	}
+private:
+	class PrivateLevel : public Level
+	{
+	public:
+		using Level::Level;
+		void reInit(Game* p0Game, int32_t nLevel, const shared_ptr<AppPreferences>& refPreferences, const Init& oInit) noexcept
+		{
+			Level::reInit(p0Game, nLevel, refPreferences, oInit);
+		}
+		std::vector< unique_ptr<Event> > extractAllEvents() noexcept
+		{
+			return Level::extractAllEvents();
+		}
+	};
+	std::vector< shared_ptr<PrivateLevel> > m_aLevels;
+};
+
+// Tile animator that can be reinitialized by the test
+class RecyclableTileAnimatorEvent : public TileAnimatorEvent
+{
+public:
+	using TileAnimatorEvent::TileAnimatorEvent;
+	void reInit(Init&& oInit) noexcept
+	{
+		TileAnimatorEvent::reInit(std::move(oInit));
+	}
+};
+
+TEST_CASE_METHOD(STFX<GameRecycledLevelsFixture>, "RestartRecycled")
+{
+	GameOwnerFixture::resetGameOwner();
+
+	Level::Init oLevelInit;
+	oLevelInit.m_nBoardW = 10;
+	oLevelInit.m_nBoardH = 8;
+	oLevelInit.m_nShowW = 10;
+	oLevelInit.m_nShowH = 8;
+	Tile oTile;
+	oTile.getTileChar().setChar(65);
+	oLevelInit.m_aBoard.push_back(oTile);
+
+	Recycler<Game> oGames;
+	shared_ptr<Game> refGame;
+	createGame(oGames, refGame, oLevelInit);
+	Game* p0Game = refGame.get();
+	Level* p0Level = refGame->level(0).get();
+	REQUIRE( p0Level->boardGetTile(0, 0) == oTile );
+
+	oLevelInit.m_aBoard.clear();
+	// The tile animator is extracted from the level while running and reused in the next game
+	unique_ptr<Event> refRecycledTA;
+	RecyclableTileAnimatorEvent* p0PrevTA = nullptr;
+	for (int32_t nRestart = 0; nRestart < 1000; ++nRestart) {
+		{
+			MockEvent::Init oInit;
+			oInit.m_p0Level = p0Level;
+			p0Level->addEvent("Ev", make_unique<MockEvent>(std::move(oInit)));
+		}
+		REQUIRE( p0Level->getEventById("Ev") != nullptr );
+		const int32_t nTileAniIdx = refGame->getNamed().tileAnis().addName("TestTileAni");
+		RecyclableTileAnimatorEvent* p0TA = nullptr;
+		{
+			TileAnimatorEvent::Init oInit;
+			oInit.m_p0Level = p0Level;
+			oInit.m_nAniNameIdx = nTileAniIdx;
+			oInit.m_oDuration.m_oTicks.m_nFrom = 10;
+			oInit.m_oDuration.m_oTicks.m_nTo = 10;
+			auto refCTS = make_unique<CharTraitSet>(make_unique<CharUcs4TraitSet>(65));
+			oInit.m_refSelect = make_unique<TileSelector>(make_unique<TileSelector::Trait>(false, std::move(refCTS)));
+			if (refRecycledTA) {
+				p0TA = static_cast<RecyclableTileAnimatorEvent*>(refRecycledTA.get());
+				REQUIRE( p0TA == p0PrevTA );
+				p0TA->reInit(std::move(oInit));
+				p0Level->addEvent(std::move(refRecycledTA));
+			} else {
+				auto refTA = make_unique<RecyclableTileAnimatorEvent>(std::move(oInit));
+				p0TA = refTA.get();
+				p0Level->addEvent(std::move(refTA));
+			}
+		}
+		p0Level->activateEvent(p0TA, 1);
+		refGame->start();
+		p0Level->boardSetTile(3, 4, oTile);
+		refGame->handleTimer();
+		refGame->handleTimer();
+		// Restart while the cell is being animated
+		REQUIRE( p0Level->boardGetTileAnimator(3, 4, nTileAniIdx) != nullptr );
+		refGame->end();
+		auto aEvents = extractAllEvents(p0Level);
+		for (auto& refEvent : aEvents) {
+			if (refEvent.get() == p0TA) {
+				refRecycledTA = std::move(refEvent);
+			}
+		}
+		REQUIRE( refRecycledTA );
+		p0PrevTA = p0TA;
+		refGame.reset();
+		createGame(oGames, refGame, oLevelInit);
+		// The same instances are reinitialized
+		REQUIRE( refGame.get() == p0Game );
+		REQUIRE( refGame->level(0).get() == p0Level );
+		REQUIRE( p0Level->getEventById("Ev") == nullptr );
+		REQUIRE( p0Level->boardGetTile(0, 0).isEmpty() );
+	}
+}
+
+// Controllable dumb block that logs the key actions
+class SubTickBlockEvent : public DumbBlockEvent
+{
+public:
+	struct Received
+	{
+		int32_t m_nKeyAction;
+		stmi::Event::AS_KEY_INPUT_TYPE m_eType;
+		double m_fTickOffset;
+		double m_fGameMillisec;
+		bool m_bInSubTick;
+		int32_t m_nGameTick;
+		KeyActionRing::Handle m_oKeyAction;
+	};
+	SubTickBlockEvent(Init&& oInit, std::vector<Received>& aReceived) noexcept
+	: DumbBlockEvent(std::move(oInit))
+	, m_aReceived(aReceived)
+	{
+	}
+	void handleKeyActionInput(const KeyActionRing::Handle& oKeyAction) noexcept override
+	{
+		const auto& oGame = level().game();
+		m_aReceived.push_back(Received{oKeyAction->getKeyAction(), oKeyAction->getType(), oKeyAction->getTickOffset()
+										, oKeyAction->getGameMillisec(), oGame.isInInputSubTick(), oGame.gameElapsed()
+										, oKeyAction});
+		DumbBlockEvent::handleKeyActionInput(oKeyAction);
+	}
+private:
+	std::vector<Received>& m_aReceived;
+};
+
+class GameSubTickFixture : public GameLayoutAutoFixture
+{
+public:
+	void createGame(bool bLowLatencyInput, double fRepeatMillisec = 0.0)
+	{
+		Level::Init oLevelInit;
+		oLevelInit.m_nBoardW = 10;
+		oLevelInit.m_nBoardH = 8;
+		oLevelInit.m_nShowW = 10;
+		oLevelInit.m_nShowH = 8;
+		Game::Init oGameInit;
+		oGameInit.m_sName = std::string{"Test"};
+		oGameInit.m_p0GameOwner = this;
+		oGameInit.m_oGameVariableTypes = getVariablesGame();
+		oGameInit.m_oTeamVariableTypes = getVariablesTeam();
+		oGameInit.m_oPlayerVariableTypes = getVariablesPlayer();
+		oGameInit.m_refLayout = m_refLayout;
+		oGameInit.m_fInitialGameInterval = 100.0;
+		oGameInit.m_bLowLatencyInput = bLowLatencyInput;
+		m_refGame = std::make_unique<Game>(std::move(oGameInit), *this, oLevelInit);
+
+		const int32_t nMoveUpId = m_refStdConfig->getKeyActionId("MoveUp");
+		Level* p0Level = m_refGame->level(0).get();
+		// One block for each of the two mates
+		for (int32_t nX = 2; nX <= 6; nX += 4) {
+			Block oBlock;
+			Tile oTile;
+			oTile.getTileChar().setChar(65);
+			oBlock.brickAdd(oTile, 0, 0, true);
+			DumbBlockEvent::Init oDInit;
+			oDInit.m_p0Level = p0Level;
+			oDInit.m_oBlock = std::move(oBlock);
+			oDInit.m_oInitPos = NPoint{nX, 6};
+			oDInit.m_bControllable = true;
+			oDInit.m_nMoveUpKeyActionId = nMoveUpId;
+			oDInit.m_fRepeatMillisec = fRepeatMillisec;
+			auto refBlock = make_unique<SubTickBlockEvent>(std::move(oDInit), m_aReceived);
+			m_aBlocks.push_back(refBlock.get());
+			p0Level->addEvent(std::move(refBlock));
+			p0Level->activateEvent(m_aBlocks.back(), 0);
+		}
+	}
+	// The key capability and key player 0 uses for MoveUp
+	std::pair<shared_ptr<stmi::KeyCapability>, stmi::HARDWARE_KEY> getMoveUpKey()
+	{
+		const int32_t nMoveUpId = m_refStdConfig->getKeyActionId("MoveUp");
+		const auto oPair = m_refPrefs->getPlayerFull(0)->getKeyValue(nMoveUpId);
+		for (const int32_t nDeviceId : m_aKeyDeviceIds) {
+			shared_ptr<stmi::KeyCapability> refKeyCapa;
+			m_refDM->getDevice(nDeviceId)->getCapability(refKeyCapa);
+			if (refKeyCapa.get() == oPair.first) {
+				return std::make_pair(refKeyCapa, oPair.second);
+			}
+		}
+		return std::make_pair(shared_ptr<stmi::KeyCapability>{}, oPair.second);
+	}
+	int32_t getTotBlocksY() const
+	{
+		int32_t nTotY = 0;
+		for (const auto& p0Block : m_aBlocks) {
+			nTotY += p0Block->blockPos().m_nY;
+		}
+		return nTotY;
+	}
+public:
+	unique_ptr<Game> m_refGame;
+	std::vector<SubTickBlockEvent*> m_aBlocks;
+	std::vector<SubTickBlockEvent::Received> m_aReceived;
+};
+
+TEST_CASE_METHOD(STFX<GameSubTickFixture>, "InputSubTick")
+{
+	GameOwnerFixture::resetGameOwner();
+
+	const int64_t nTick0Usec = 1000000;
+	const int64_t nTick1Usec = nTick0Usec + 100 * 1000;
+	const auto oKey = getMoveUpKey();
+	REQUIRE( oKey.first );
+	auto refPress = std::make_shared<stmi::KeyEvent>(nTick0Usec + 30 * 1000, shared_ptr<stmi::Accessor>{}
+													, oKey.first, stmi::KeyEvent::KEY_PRESS, oKey.second);
+	auto refRelease = std::make_shared<stmi::KeyEvent>(nTick0Usec + 60 * 1000, shared_ptr<stmi::Accessor>{}
+													, oKey.first, stmi::KeyEvent::KEY_RELEASE, oKey.second);
+	int32_t nQueuedTotY = 0;
+	std::vector<SubTickBlockEvent::Received> aQueuedReceived;
+	{
+		createGame(false);
+		m_refGame->start();
+		m_refGame->handleTimer(nTick0Usec);
+		const int32_t nInitialTotY = getTotBlocksY();
+		m_refGame->handleInput(refPress);
+		m_refGame->handleInput(refRelease);
+		// Queued till the next game tick
+		REQUIRE( m_aReceived.empty() );
+		REQUIRE( getTotBlocksY() == nInitialTotY );
+		m_refGame->handleTimer(nTick1Usec);
+		REQUIRE( m_aReceived.size() == 2 );
+		REQUIRE( getTotBlocksY() == nInitialTotY - 1 );
+		for (const auto& oReceived : m_aReceived) {
+			REQUIRE_FALSE( oReceived.m_bInSubTick );
+			REQUIRE( oReceived.m_nGameTick == 1 );
+		}
+		nQueuedTotY = getTotBlocksY();
+		aQueuedReceived = m_aReceived;
+		m_refGame->end();
+		m_refGame.reset();
+		m_aBlocks.clear();
+		m_aReceived.clear();
+	}
+	{
+		createGame(true);
+		m_refGame->start();
+		m_refGame->handleTimer(nTick0Usec);
+		REQUIRE( m_aBlocks[0]->isSubTickInputCapable() );
+		const int32_t nInitialTotY = getTotBlocksY();
+		m_refGame->handleInput(refPress);
+		// Received immediately
+		REQUIRE( m_aReceived.size() == 1 );
+		REQUIRE( getTotBlocksY() == nInitialTotY - 1 );
+		REQUIRE_FALSE( m_refGame->isInGameTick() );
+		m_refGame->handleInput(refRelease);
+		REQUIRE( m_aReceived.size() == 2 );
+		for (const auto& oReceived : m_aReceived) {
+			REQUIRE( oReceived.m_bInSubTick );
+			REQUIRE( oReceived.m_nGameTick == 1 );
+		}
+		m_refGame->handleTimer(nTick1Usec);
+		REQUIRE( m_aReceived.size() == 2 );
+		// Same outcome as when dispatched at the game tick
+		REQUIRE( getTotBlocksY() == nQueuedTotY );
+		// The handles kept by the block are still valid after the game tick
+		for (const auto& oReceived : m_aReceived) {
+			REQUIRE( oReceived.m_oKeyAction.isValid() );
+			REQUIRE( oReceived.m_oKeyAction->getKeyAction() == oReceived.m_nKeyAction );
+			REQUIRE( oReceived.m_oKeyAction->getType() == oReceived.m_eType );
+		}
+		m_refGame->end();
+	}
+	REQUIRE( aQueuedReceived.size() == m_aReceived.size() );
+	for (std::size_t nIdx = 0; nIdx < m_aReceived.size(); ++nIdx) {
+		REQUIRE( aQueuedReceived[nIdx].m_nKeyAction == m_aReceived[nIdx].m_nKeyAction );
+		REQUIRE( aQueuedReceived[nIdx].m_eType == m_aReceived[nIdx].m_eType );
+		REQUIRE( aQueuedReceived[nIdx].m_fTickOffset == m_aReceived[nIdx].m_fTickOffset );
+		REQUIRE( aQueuedReceived[nIdx].m_fGameMillisec == m_aReceived[nIdx].m_fGameMillisec );
+	}
+	REQUIRE( m_aReceived[0].m_eType == stmi::Event::AS_KEY_PRESS );
+	REQUIRE( m_aReceived[0].m_fTickOffset == Approx(0.3) );
+	REQUIRE( m_aReceived[0].m_fGameMillisec == Approx(30.0) );
+	REQUIRE( m_aReceived[1].m_eType == stmi::Event::AS_KEY_RELEASE );
+	REQUIRE( m_aReceived[1].m_fTickOffset == Approx(0.6) );
+	REQUIRE( m_aReceived[1].m_fGameMillisec == Approx(60.0) );
+}
+
+TEST_CASE_METHOD(STFX<GameSubTickFixture>, "InputSubTickRepeat")
+{
+	GameOwnerFixture::resetGameOwner();
+
+	// Game interval is 100 millisec
+	const int64_t nTick0Usec = 1000000;
+	const int64_t nTickUsec = 100 * 1000;
+	const auto oKey = getMoveUpKey();
+	REQUIRE( oKey.first );
+	// Held from game time 30 to 260 millisec: the press moves, then a repeat
+	// each 50 millisec at 80, 130, 180 and 230
+	auto refPress = std::make_shared<stmi::KeyEvent>(nTick0Usec + 30 * 1000, shared_ptr<stmi::Accessor>{}
+													, oKey.first, stmi::KeyEvent::KEY_PRESS, oKey.second);
+	auto refRelease = std::make_shared<stmi::KeyEvent>(nTick0Usec + 2 * nTickUsec + 60 * 1000, shared_ptr<stmi::Accessor>{}
+													, oKey.first, stmi::KeyEvent::KEY_RELEASE, oKey.second);
+	const int32_t nTotMoves = 5;
+	for (const bool bLowLatencyInput : {false, true}) {
+		createGame(bLowLatencyInput, 50.0);
+		m_refGame->start();
+		m_refGame->handleTimer(nTick0Usec);
+		const int32_t nInitialTotY = getTotBlocksY();
+		m_refGame->handleInput(refPress);
+		// In low latency mode the press moves the block before the next game tick
+		REQUIRE( getTotBlocksY() == nInitialTotY - (bLowLatencyInput ? 1 : 0) );
+		m_refGame->handleTimer(nTick0Usec + nTickUsec);
+		// game time 100: press and repeat at 80
+		REQUIRE( getTotBlocksY() == nInitialTotY - 2 );
+		m_refGame->handleTimer(nTick0Usec + 2 * nTickUsec);
+		// game time 200: repeats at 130 and 180
+		REQUIRE( getTotBlocksY() == nInitialTotY - 4 );
+		m_refGame->handleInput(refRelease);
+		// The release in a sub-tick catches up with the repeat at 230
+		REQUIRE( getTotBlocksY() == nInitialTotY - 4 - (bLowLatencyInput ? 1 : 0) );
+		m_refGame->handleTimer(nTick0Usec + 3 * nTickUsec);
+		m_refGame->handleTimer(nTick0Usec + 4 * nTickUsec);
+		// No more repeats after the release
+		REQUIRE( getTotBlocksY() == nInitialTotY - nTotMoves );
+		REQUIRE( m_aReceived.size() == 2 );
+		REQUIRE( m_aReceived[0].m_fGameMillisec == Approx(30.0) );
+		REQUIRE( m_aReceived[1].m_fGameMillisec == Approx(260.0) );
+		REQUIRE( m_aReceived[1].m_bInSubTick == bLowLatencyInput );
+		m_refGame->end();
+		m_refGame.reset();
+		m_aBlocks.clear();
+		m_aReceived.clear();
+	}
+}
+
 } // namespace testing
 
 } // namespace stmg
@@ -0,0 +1,131 @@
+/*
+ * Copyright © 2019-2020  Stefano Marsili, <stemars@gmx.ch>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see <http://www.gnu.org/licenses/>
+ */
+/*
+ * File:   testKeyActionRing.cxx
+ */
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+
+#include "keyactionring.h"
+
+#include <vector>
+
+namespace stmg
+{
+
+using std::shared_ptr;
+
+namespace testing
+{
+
+namespace
+{
+KeyActionRing::Handle writeKeyAction(KeyActionRing& oRing, int32_t nKeyAction)
+{
+	return oRing.write(1000 * nKeyAction, shared_ptr<stmi::Capability>{}, stmi::Event::AS_KEY_PRESS, nKeyAction
+						, 0.5, 10.0 * nKeyAction);
+}
+} // namespace
+
+TEST_CASE("testKeyActionRing, Constructor")
+{
+	KeyActionRing oRing(3);
+	REQUIRE( oRing.capacity() == 3 );
+	KeyActionRing::Handle oHandle;
+	REQUIRE_FALSE( oHandle.isValid() );
+}
+
+TEST_CASE("testKeyActionRing, Write")
+{
+	KeyActionRing oRing(3);
+	const KeyActionRing::Handle oHandle = oRing.write(7000, shared_ptr<stmi::Capability>{}, stmi::Event::AS_KEY_RELEASE, 7
+														, 0.25, 32.5);
+	REQUIRE( oHandle.isValid() );
+	const KeyActionEvent& oEvent = oHandle.get();
+	REQUIRE( oEvent.getTimeUsec() == 7000 );
+	REQUIRE( oEvent.getType() == stmi::Event::AS_KEY_RELEASE );
+	REQUIRE( oEvent.getKeyAction() == 7 );
+	REQUIRE( oEvent.getTickOffset() == 0.25 );
+	REQUIRE( oEvent.getGameMillisec() == 32.5 );
+	REQUIRE( oEvent.getCapabilityId() == -1 );
+	// Copies refer to the same event
+	const KeyActionRing::Handle oCopy = oHandle;
+	REQUIRE( oCopy.isValid() );
+	REQUIRE( &(oCopy.get()) == &oEvent );
+}
+
+TEST_CASE("testKeyActionRing, WrapAround")
+{
+	KeyActionRing oRing(3);
+	std::vector<KeyActionRing::Handle> aHandles;
+	for (int32_t nKeyAction = 0; nKeyAction < 3; ++nKeyAction) {
+		aHandles.push_back(writeKeyAction(oRing, nKeyAction));
+	}
+	for (int32_t nKeyAction = 0; nKeyAction < 3; ++nKeyAction) {
+		REQUIRE( aHandles[nKeyAction].isValid() );
+		REQUIRE( aHandles[nKeyAction]->getKeyAction() == nKeyAction );
+	}
+	// Overwrites the oldest slot
+	aHandles.push_back(writeKeyAction(oRing, 3));
+	REQUIRE_FALSE( aHandles[0].isValid() );
+	REQUIRE( aHandles[1].isValid() );
+	REQUIRE( aHandles[2].isValid() );
+	REQUIRE( aHandles[3].isValid() );
+	REQUIRE( aHandles[3]->getKeyAction() == 3 );
+	REQUIRE( aHandles[3]->getGameMillisec() == 30.0 );
+	const KeyActionRing::Handle oHandle4 = writeKeyAction(oRing, 4);
+	REQUIRE( oHandle4.isValid() );
+	REQUIRE( oHandle4->getKeyAction() == 4 );
+	REQUIRE_FALSE( aHandles[1].isValid() );
+	REQUIRE( aHandles[2].isValid() );
+	REQUIRE( aHandles[2]->getKeyAction() == 2 );
+}
+
+TEST_CASE("testKeyActionRing, HeldPastWrites")
+{
+	KeyActionRing oRing(4);
+	const KeyActionRing::Handle oHeld = writeKeyAction(oRing, 1);
+	// Fewer than capacity() writes, as in a later tick with few key actions
+	for (int32_t nKeyAction = 2; nKeyAction < 5; ++nKeyAction) {
+		writeKeyAction(oRing, nKeyAction);
+		REQUIRE( oHeld.isValid() );
+		REQUIRE( oHeld->getKeyAction() == 1 );
+		REQUIRE( oHeld->getTimeUsec() == 1000 );
+	}
+	// The slot comes round again: the held handle doesn't see the new event
+	const KeyActionRing::Handle oNew = writeKeyAction(oRing, 5);
+	REQUIRE_FALSE( oHeld.isValid() );
+	REQUIRE( oNew.isValid() );
+	REQUIRE( oNew->getKeyAction() == 5 );
+}
+
+TEST_CASE("testKeyActionRing, Clear")
+{
+	KeyActionRing oRing(2);
+	const KeyActionRing::Handle oHandle = writeKeyAction(oRing, 1);
+	oRing.clear();
+	REQUIRE_FALSE( oHandle.isValid() );
+	// Writing into the same slot again doesn't revive the old handle
+	const KeyActionRing::Handle oNew = writeKeyAction(oRing, 1);
+	REQUIRE( oNew.isValid() );
+	REQUIRE_FALSE( oHandle.isValid() );
+}
+
+} // namespace testing
+
+} // namespace stmg
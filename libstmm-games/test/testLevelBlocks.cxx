@@ -0,0 +1,181 @@
+/*
+ * Copyright © 2019-2020  Stefano Marsili, <stemars@gmx.ch>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see <http://www.gnu.org/licenses/>
+ */
+/*
+ * File:   testLevelBlocks.cxx
+ */
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+
+#include "stmm-games-fake/fixtureGame.h"
+#include "stmm-games-fake/dumbblockevent.h"
+
+namespace stmg
+{
+
+using std::shared_ptr;
+using std::unique_ptr;
+using std::make_unique;
+
+namespace testing
+{
+
+class LevelBlocksGameFixture : public GameFixture
+							//default , public FixtureVariantDevicesKeys_Two, public FixtureVariantDevicesJoystick_Two
+							, public FixtureVariantPrefsTeams<1>
+							//default , public FixtureVariantPrefsMates<0,2>
+							//default , public FixtureVariantMatesPerTeamMax_Three, public FixtureVariantAIMatesPerTeamMax_Zero
+							//default , public FixtureVariantAllowMixedAIHumanTeam_False, public FixtureVariantPlayersMax_Six
+							//default , public FixtureVariantTeamsMin_One, public FixtureVariantTeamsMax_Two
+							//default , public FixtureVariantKeyActions_AllCapabilityClassesDefaults
+							//default , public FixtureVariantLayoutTeamDistribution_AllTeamsInOneLevel
+							//default , public FixtureVariantLayoutShowMode_Show
+							//default , public FixtureVariantLayoutCreateVarWidgetsFromVariables_False
+							//default , public FixtureVariantLayoutCreateActionWidgetsFromKeyActions_False
+							, public FixtureVariantVariablesGame_Time
+							//, public FixtureVariantVariablesTeam
+							, public FixtureVariantVariablesPlayer_Lives<3>
+							//default , public FixtureVariantLevelInitBoardWidth<10>
+							//default , public FixtureVariantLevelInitBoardHeight<6>
+							//default , public FixtureVariantLevelInitShowWidth<10>
+							//default , public FixtureVariantLevelInitShowHeight<6>
+{
+protected:
+	void setup() override
+	{
+		GameFixture::setup();
+	}
+	void teardown() override
+	{
+		GameFixture::teardown();
+	}
+};
+
+// Counts the handleTimer() calls and can remove another block when called
+class CountingBlockEvent : public DumbBlockEvent
+{
+public:
+	explicit CountingBlockEvent(Init&& oInit) noexcept
+	: DumbBlockEvent(std::move(oInit))
+	{
+	}
+	void handleTimer() noexcept override
+	{
+		++m_nTotTimerCalls;
+		if (m_p0Victim != nullptr) {
+			LevelBlock* p0Victim = m_p0Victim;
+			m_p0Victim = nullptr;
+			p0Victim->remove();
+		}
+	}
+	int32_t m_nTotTimerCalls = 0;
+	LevelBlock* m_p0Victim = nullptr;
+};
+
+static CountingBlockEvent* addCountingBlock(Level* p0Level, NPoint oPos) noexcept
+{
+	Block oBlock;
+	Tile oTile;
+	oTile.getTileChar().setChar(65);
+	oBlock.brickAdd(oTile, 0, 0, true);
+	DumbBlockEvent::Init oDInit;
+	oDInit.m_p0Level = p0Level;
+	oDInit.m_oBlock = std::move(oBlock);
+	oDInit.m_oInitPos = oPos;
+	auto refCountingBlockEvent = make_unique<CountingBlockEvent>(std::move(oDInit));
+	CountingBlockEvent* p0CountingBlockEvent = refCountingBlockEvent.get();
+	p0Level->addEvent(std::move(refCountingBlockEvent));
+	p0Level->activateEvent(p0CountingBlockEvent, 1);
+	return p0CountingBlockEvent;
+}
+
+TEST_CASE_METHOD(STFX<LevelBlocksGameFixture>, "RemoveWhileHandlingTimer")
+{
+	Level* p0Level = m_refGame->level(0).get();
+	CountingBlockEvent* p0A = addCountingBlock(p0Level, NPoint{1, 4});
+	CountingBlockEvent* p0B = addCountingBlock(p0Level, NPoint{3, 4});
+	CountingBlockEvent* p0C = addCountingBlock(p0Level, NPoint{5, 4});
+	m_refGame->start();
+	m_refGame->handleTimer();
+	m_refGame->handleTimer();
+	REQUIRE( m_refGame->gameElapsed() == 2 );
+
+	auto aBlocks = p0Level->blocksGetAll();
+	REQUIRE( aBlocks.size() == 3 );
+	// The first handled removes the last, the second removes the already handled first
+	CountingBlockEvent* p0First = static_cast<CountingBlockEvent*>(aBlocks[0]);
+	CountingBlockEvent* p0Second = static_cast<CountingBlockEvent*>(aBlocks[1]);
+	CountingBlockEvent* p0Last = static_cast<CountingBlockEvent*>(aBlocks[2]);
+	REQUIRE( ((p0First == p0A) || (p0First == p0B) || (p0First == p0C)) );
+	REQUIRE( ((p0Second == p0A) || (p0Second == p0B) || (p0Second == p0C)) );
+	REQUIRE( ((p0Last == p0A) || (p0Last == p0B) || (p0Last == p0C)) );
+	const int32_t nTotFirstCalls = p0First->m_nTotTimerCalls;
+	REQUIRE( p0Second->m_nTotTimerCalls == nTotFirstCalls );
+	REQUIRE( p0Last->m_nTotTimerCalls == nTotFirstCalls );
+	p0First->m_p0Victim = p0Last;
+	p0Second->m_p0Victim = p0First;
+
+	m_refGame->handleTimer();
+	REQUIRE( p0First->m_nTotTimerCalls == nTotFirstCalls + 1 );
+	REQUIRE( p0Second->m_nTotTimerCalls == nTotFirstCalls + 1 );
+	// Removed before being visited
+	REQUIRE( p0Last->m_nTotTimerCalls == nTotFirstCalls );
+	aBlocks = p0Level->blocksGetAll();
+	REQUIRE( aBlocks.size() == 1 );
+	REQUIRE( aBlocks[0] == p0Second );
+	REQUIRE( p0Level->blocksGet(p0Second->blockGetId()) == p0Second );
+	REQUIRE( p0Level->blocksGet(p0First->blockGetId()) == nullptr );
+	REQUIRE( p0Level->blocksGet(p0Last->blockGetId()) == nullptr );
+
+	m_refGame->handleTimer();
+	REQUIRE( p0Second->m_nTotTimerCalls == nTotFirstCalls + 2 );
+}
+
+TEST_CASE_METHOD(STFX<LevelBlocksGameFixture>, "ForEachInAddOrder")
+{
+	Level* p0Level = m_refGame->level(0).get();
+	addCountingBlock(p0Level, NPoint{1, 4});
+	addCountingBlock(p0Level, NPoint{3, 4});
+	addCountingBlock(p0Level, NPoint{5, 4});
+	m_refGame->start();
+	m_refGame->handleTimer();
+	m_refGame->handleTimer();
+
+	const std::vector<int32_t> aIds = p0Level->blocksGetAllIds();
+	REQUIRE( aIds.size() == 3 );
+	std::vector<int32_t> aForEachIds;
+	p0Level->blocksForEach([&](LevelBlock& oLevelBlock)
+	{
+		aForEachIds.push_back(oLevelBlock.blockGetId());
+	});
+	REQUIRE( aForEachIds == aIds );
+	// Removing within the iteration
+	int32_t nTotVisited = 0;
+	p0Level->blocksForEach([&](LevelBlock& oLevelBlock)
+	{
+		++nTotVisited;
+		if (oLevelBlock.blockGetId() == aIds[0]) {
+			p0Level->blocksGet(aIds[1])->remove();
+		}
+	});
+	REQUIRE( nTotVisited == 2 );
+	REQUIRE( p0Level->blocksGetAllIds() == std::vector<int32_t>{aIds[0], aIds[2]} );
+}
+
+} // namespace testing
+
+} // namespace stmg
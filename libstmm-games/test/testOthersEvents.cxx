@@ -0,0 +1,265 @@
+/*
+ * Copyright © 2019-2020  Stefano Marsili, <stemars@gmx.ch>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see <http://www.gnu.org/licenses/>
+ */
+/*
+ * File:   testOthersEvents.cxx
+ */
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+
+#include "events/othersevent.h"
+
+#include "stmm-games-fake/fixtureGame.h"
+
+#include <vector>
+
+namespace stmg
+{
+
+using std::shared_ptr;
+using std::unique_ptr;
+using std::make_unique;
+
+namespace testing
+{
+
+class OthersEventsGameFixture : public GameFixture
+							//default , public FixtureVariantDevicesKeys_Two, public FixtureVariantDevicesJoystick_Two
+							, public FixtureVariantPrefsTeams<8>
+							, public FixtureVariantPrefsMates<0,1>
+							, public FixtureVariantPrefsMates<1,1>
+							, public FixtureVariantPrefsMates<2,1>
+							, public FixtureVariantPrefsMates<3,1>
+							//default , public FixtureVariantMatesPerTeamMax_Three, public FixtureVariantAIMatesPerTeamMax_Zero
+							, public FixtureVariantPlayersMax_Height
+							//default , public FixtureVariantAllowMixedAIHumanTeam_False
+							, public FixtureVariantTeamsMax_Eight
+							//default , public FixtureVariantTeamsMin_One
+							//default , public FixtureVariantKeyActions_AllCapabilityClassesDefaults
+							, public FixtureVariantLayoutTeamDistribution_OneTeamPerLevel
+							//default , public FixtureVariantLayoutShowMode_Show
+							//default , public FixtureVariantLayoutCreateVarWidgetsFromVariables_False
+							//default , public FixtureVariantLayoutCreateActionWidgetsFromKeyActions_False
+							, public FixtureVariantVariablesGame_Time
+							//, public FixtureVariantVariablesTeam
+							, public FixtureVariantVariablesPlayer_Lives<3>
+							//default , public FixtureVariantLevelInitBoardWidth<10>
+							//default , public FixtureVariantLevelInitBoardHeight<6>
+							//default , public FixtureVariantLevelInitShowWidth<10>
+							//default , public FixtureVariantLevelInitShowHeight<6>
+{
+protected:
+	void setup() override
+	{
+		GameFixture::setup();
+	}
+	void teardown() override
+	{
+		GameFixture::teardown();
+	}
+};
+
+struct OthersRecord
+{
+	int32_t m_nLevel;
+	int32_t m_nValue;
+	int32_t m_nTick;
+	bool operator==(const OthersRecord& oOther) const noexcept
+	{
+		return (m_nLevel == oOther.m_nLevel) && (m_nValue == oOther.m_nValue) && (m_nTick == oOther.m_nTick);
+	}
+};
+
+// When activated informs its relay group with its start value.
+// When triggered by another event records the value and, if it is this
+// level's turn, informs its relay group with the incremented value.
+class RelayEvent : public Event
+{
+public:
+	static constexpr int32_t s_nGroupRelay = 100;
+	RelayEvent(Init&& oInit, std::vector<OthersRecord>& aRecords) noexcept
+	: Event(std::move(oInit))
+	, m_aRecords(aRecords)
+	{
+	}
+	void trigger(int32_t /*nMsg*/, int32_t nValue, Event* p0TriggeringEvent) noexcept override
+	{
+		Level& oLevel = level();
+		if (p0TriggeringEvent == nullptr) {
+			if (m_nStartValue >= 0) {
+				informListeners(s_nGroupRelay, m_nStartValue);
+			}
+			return; //----------------------------------------------------------
+		}
+		const int32_t nLevel = oLevel.getLevel();
+		m_aRecords.push_back(OthersRecord{nLevel, nValue, oLevel.game().gameElapsed()});
+		const int32_t nNextValue = nValue + 1;
+		if ((nNextValue < m_nMaxValue) && ((nNextValue % oLevel.game().getTotLevels()) == nLevel)) {
+			informListeners(s_nGroupRelay, nNextValue);
+		}
+	}
+	int32_t m_nStartValue = -1;
+	int32_t m_nMaxValue = 0;
+private:
+	std::vector<OthersRecord>& m_aRecords;
+};
+
+constexpr int32_t RelayEvent::s_nGroupRelay;
+
+static constexpr int32_t s_nOthersMsg = 5;
+
+// Adds to each level a receiver, a relay and a sender chained together
+static std::vector<OthersSenderEvent*> addRelays(Game& oGame, std::vector<OthersRecord>& aRecords, int32_t nMaxValue) noexcept
+{
+	std::vector<OthersSenderEvent*> aSenders;
+	const int32_t nTotLevels = oGame.getTotLevels();
+	for (int32_t nLevel = 0; nLevel < nTotLevels; ++nLevel) {
+		Level* p0Level = oGame.level(nLevel).get();
+
+		OthersReceiverEvent::Init oRInit;
+		oRInit.m_p0Level = p0Level;
+		auto refReceiver = make_unique<OthersReceiverEvent>(std::move(oRInit));
+		OthersReceiverEvent* p0Receiver = refReceiver.get();
+		p0Level->addEvent(std::move(refReceiver));
+		// installs itself
+		p0Level->activateEvent(p0Receiver, 0);
+
+		Event::Init oInit;
+		oInit.m_p0Level = p0Level;
+		auto refRelay = make_unique<RelayEvent>(std::move(oInit), aRecords);
+		RelayEvent* p0Relay = refRelay.get();
+		p0Relay->m_nMaxValue = nMaxValue;
+		p0Level->addEvent(std::move(refRelay));
+
+		OthersSenderEvent::Init oSInit;
+		oSInit.m_p0Level = p0Level;
+		auto refSender = make_unique<OthersSenderEvent>(std::move(oSInit));
+		OthersSenderEvent* p0Sender = refSender.get();
+		p0Level->addEvent(std::move(refSender));
+
+		p0Receiver->addListener(s_nOthersMsg, p0Relay, 0);
+		p0Relay->addListener(RelayEvent::s_nGroupRelay, p0Sender, s_nOthersMsg);
+		aSenders.push_back(p0Sender);
+	}
+	return aSenders;
+}
+// Adds an event that starts sending through the sender at game tick 1
+// (a separate event because the relay is deactivated when triggered by the receiver)
+static void addStarter(Level* p0Level, OthersSenderEvent* p0Sender, int32_t nStartValue, std::vector<OthersRecord>& aRecords) noexcept
+{
+	Event::Init oInit;
+	oInit.m_p0Level = p0Level;
+	auto refStarter = make_unique<RelayEvent>(std::move(oInit), aRecords);
+	RelayEvent* p0Starter = refStarter.get();
+	p0Starter->m_nStartValue = nStartValue;
+	p0Level->addEvent(std::move(refStarter));
+	p0Starter->addListener(RelayEvent::s_nGroupRelay, p0Sender, s_nOthersMsg);
+	p0Level->activateEvent(p0Starter, 1);
+}
+
+static std::vector<OthersRecord> runRelayChain(int32_t nMaxValue) noexcept
+{
+	STFX<OthersEventsGameFixture> oFixture;
+	Game& oGame = *oFixture.m_refGame;
+	std::vector<OthersRecord> aRecords;
+	std::vector<OthersSenderEvent*> aSenders = addRelays(oGame, aRecords, nMaxValue);
+	addStarter(oGame.level(0).get(), aSenders[0], 0, aRecords);
+	oGame.start();
+	oGame.handleTimer();
+	oGame.handleTimer();
+	oGame.handleTimer();
+	return aRecords;
+}
+
+TEST_CASE_METHOD(STFX<OthersEventsGameFixture>, "Constraints")
+{
+	REQUIRE( m_refGame->getTotLevels() == 8 );
+	REQUIRE_FALSE( m_refGame->isAllTeamsInOneLevel() );
+}
+
+TEST_CASE_METHOD(STFX<OthersEventsGameFixture>, "EveryLevelSendsOnce")
+{
+	const int32_t nTotLevels = m_refGame->getTotLevels();
+	std::vector<OthersRecord> aRecords;
+	std::vector<OthersSenderEvent*> aSenders = addRelays(*m_refGame, aRecords, 0);
+	for (int32_t nLevel = 0; nLevel < nTotLevels; ++nLevel) {
+		addStarter(m_refGame->level(nLevel).get(), aSenders[nLevel], nLevel, aRecords);
+	}
+	m_refGame->start();
+	m_refGame->handleTimer();
+	REQUIRE( aRecords.empty() );
+	m_refGame->handleTimer();
+	// Each message is delivered exactly once to each other level within the tick
+	REQUIRE( static_cast<int32_t>(aRecords.size()) == nTotLevels * (nTotLevels - 1) );
+	for (int32_t nLevel = 0; nLevel < nTotLevels; ++nLevel) {
+		int32_t nExpectedSender = ((nLevel == 0) ? 1 : 0);
+		for (const auto& oRecord : aRecords) {
+			REQUIRE( oRecord.m_nTick == 1 );
+			if (oRecord.m_nLevel != nLevel) {
+				continue; // for oRecord
+			}
+			// In the order the levels sent them
+			REQUIRE( oRecord.m_nValue == nExpectedSender );
+			++nExpectedSender;
+			if (nExpectedSender == nLevel) {
+				++nExpectedSender;
+			}
+		}
+		REQUIRE( nExpectedSender == nTotLevels );
+	}
+	m_refGame->handleTimer();
+	REQUIRE( static_cast<int32_t>(aRecords.size()) == nTotLevels * (nTotLevels - 1) );
+}
+
+TEST_CASE("RelayChainAcrossAllLevels")
+{
+	constexpr int32_t nTotLevels = 8;
+	const std::vector<OthersRecord> aRecords = runRelayChain(nTotLevels);
+	// Each hop is broadcast to the other levels
+	REQUIRE( static_cast<int32_t>(aRecords.size()) == nTotLevels * (nTotLevels - 1) );
+	std::vector<int32_t> aLastValue(nTotLevels, -1);
+	for (const auto& oRecord : aRecords) {
+		REQUIRE( oRecord.m_nTick == 1 );
+		// The sender doesn't receive its own message
+		REQUIRE( (oRecord.m_nValue % nTotLevels) != oRecord.m_nLevel );
+		// Each level gets the hops in order
+		REQUIRE( oRecord.m_nValue > aLastValue[oRecord.m_nLevel] );
+		aLastValue[oRecord.m_nLevel] = oRecord.m_nValue;
+	}
+	// Deterministic
+	REQUIRE( runRelayChain(nTotLevels) == aRecords );
+}
+
+TEST_CASE("RelayChainNestedLimit")
+{
+	constexpr int32_t nTotLevels = 8;
+	// Would relay forever
+	const std::vector<OthersRecord> aRecords = runRelayChain(std::numeric_limits<int32_t>::max());
+	REQUIRE_FALSE( aRecords.empty() );
+	int32_t nMaxValue = 0;
+	for (const auto& oRecord : aRecords) {
+		REQUIRE( oRecord.m_nTick == 1 );
+		nMaxValue = std::max(nMaxValue, oRecord.m_nValue);
+	}
+	// Messages sent by the ninth nested delivery are ignored
+	REQUIRE( nMaxValue == 8 );
+	REQUIRE( static_cast<int32_t>(aRecords.size()) == (nMaxValue + 1) * (nTotLevels - 1) );
+}
+
+} // namespace testing
+
+} // namespace stmg
@@ -24,6 +24,8 @@
 #include "events/scrollerevent.h"
 
 #include "utile/tileselector.h"
+#include "utile/tilebuffer.h"
+#include "utile/tilecoords.h"
 
 #include "stmm-games-fake/fixtureGame.h"
 #include "stmm-games-fake/fakelevelview.h"
@@ -355,6 +357,113 @@ TEST_CASE_METHOD(STFX<ScrollerEmptyBoardInhibitorsFixture>, "ScrollEachTickInhib
 
 }
 
+TEST_CASE_METHOD(STFX<ScrollerEmptyBoardFixture>, "BoardScrollAndInsert")
+{
+	Level* p0Level = m_refLevel.get();
+
+	const int32_t nBoardW = p0Level->boardWidth();
+	const int32_t nBoardH = p0Level->boardHeight();
+
+	m_refGame->start();
+
+	// The expected board, -1 is the empty tile, otherwise the color palette index
+	std::vector<int32_t> aExpected(nBoardW * nBoardH, -1);
+	int32_t nNextPal = 0;
+	auto oTileFromPal = [](int32_t nPal)
+	{
+		Tile oTile;
+		if (nPal >= 0) {
+			oTile.getTileColor().setColorPal(nPal);
+		}
+		return oTile;
+	};
+	{
+		TileCoords oTileCoords(nBoardW * nBoardH);
+		for (int32_t nY = 0; nY < nBoardH; ++nY) {
+			for (int32_t nX = 0; nX < nBoardW; ++nX) {
+				aExpected[nX + nY * nBoardW] = nNextPal;
+				oTileCoords.add(nX, nY, oTileFromPal(nNextPal));
+				++nNextPal;
+			}
+		}
+		p0Level->boardModify(oTileCoords);
+	}
+	auto oCheckBoard = [&]()
+	{
+		for (int32_t nY = 0; nY < nBoardH; ++nY) {
+			for (int32_t nX = 0; nX < nBoardW; ++nX) {
+				const Tile& oTile = p0Level->boardGetTile(nX, nY);
+				const int32_t nPal = aExpected[nX + nY * nBoardW];
+				if (nPal < 0) {
+					REQUIRE( oTile.isEmpty() );
+				} else {
+					REQUIRE( oTile.getTileColor().getColorPal() == nPal );
+				}
+			}
+		}
+	};
+	// Moves the tiles in the area of the expected board and inserts the new ones
+	auto oMoveExpected = [&](Direction::VALUE eDir, NRect oArea, const shared_ptr<TileBuffer>& refTiles)
+	{
+		const int32_t nDx = Direction::deltaX(eDir);
+		const int32_t nDy = Direction::deltaY(eDir);
+		const std::vector<int32_t> aOld = aExpected;
+		for (int32_t nY = oArea.m_nY; nY < oArea.m_nY + oArea.m_nH; ++nY) {
+			for (int32_t nX = oArea.m_nX; nX < oArea.m_nX + oArea.m_nW; ++nX) {
+				const int32_t nFromX = nX - nDx;
+				const int32_t nFromY = nY - nDy;
+				int32_t nPal;
+				if (oArea.containsPoint(NPoint{nFromX, nFromY})) {
+					nPal = aOld[nFromX + nFromY * nBoardW];
+				} else if (! refTiles) {
+					nPal = -1;
+				} else {
+					// A row is inserted when moving vertically, a column otherwise
+					const NPoint oTilePos = ((nDy != 0) ? NPoint{nX - oArea.m_nX, 0} : NPoint{0, nY - oArea.m_nY});
+					const Tile& oTile = refTiles->get(oTilePos);
+					nPal = oTile.getTileColor().getColorPal();
+				}
+				aExpected[nX + nY * nBoardW] = nPal;
+			}
+		}
+	};
+	auto oCreateTiles = [&]()
+	{
+		const int32_t nSize = std::max(nBoardW, nBoardH);
+		auto refTiles = std::make_shared<TileBuffer>(NSize{nSize, nSize});
+		for (int32_t nC = 0; nC < nSize; ++nC) {
+			refTiles->set(NPoint{nC, 0}, oTileFromPal(nNextPal));
+			refTiles->set(NPoint{0, nC}, oTileFromPal(nNextPal));
+			++nNextPal;
+		}
+		return refTiles;
+	};
+	const NRect oBoardArea{0, 0, nBoardW, nBoardH};
+	const Direction::VALUE aScrollDirs[] = {Direction::LEFT, Direction::LEFT, Direction::UP, Direction::RIGHT
+											, Direction::UP, Direction::DOWN, Direction::LEFT, Direction::UP};
+	for (const auto eDir : aScrollDirs) {
+		const auto refTiles = oCreateTiles();
+		p0Level->boardScroll(eDir, refTiles);
+		oMoveExpected(eDir, oBoardArea, refTiles);
+		oCheckBoard();
+	}
+	// Partial areas after the scrolls must correctly wrap around
+	const NRect aAreas[] = {NRect{0, 0, nBoardW, nBoardH}, NRect{1, 1, nBoardW - 2, nBoardH - 2}
+							, NRect{nBoardW - 3, 0, 3, nBoardH}, NRect{0, nBoardH - 2, nBoardW, 2}, NRect{4, 2, 1, 1}};
+	const Direction::VALUE aInsertDirs[] = {Direction::RIGHT, Direction::DOWN, Direction::LEFT, Direction::UP};
+	for (const auto& oArea : aAreas) {
+		for (const auto eDir : aInsertDirs) {
+			const auto refTiles = oCreateTiles();
+			p0Level->boardInsert(eDir, oArea, refTiles);
+			oMoveExpected(eDir, oArea, refTiles);
+			oCheckBoard();
+		}
+		p0Level->boardScroll(Direction::LEFT, shared_ptr<TileRect>{});
+		oMoveExpected(Direction::LEFT, oBoardArea, shared_ptr<TileBuffer>{});
+		oCheckBoard();
+	}
+}
+
 } // namespace testing
 
 } // namespace stmg
@@ -372,12 +372,33 @@ TEST_CASE_METHOD(STFX<LocalStdConfigFixture>, "RuntimeCapabilities")
 
 	refPrefs->setEditMode(false);
 
+	const auto refPlayer0 = refPrefs->getPlayerFull(0);
+	const int32_t nMoveUpId = m_refStdConfig->getKeyActionId("MoveUp");
+	shared_ptr<AppPreferences::PrefPlayer> refResPlayer;
+	int32_t nResKeyActionId = -1;
+	int32_t nResTeam = -1;
+	int32_t nResMate = -1;
+	{
+	const bool bFound = refPrefs->getPlayerKeyActionFromCapabilityKey(refKeyCapa1->getId(), stmi::HK_UP, refResPlayer, nResKeyActionId);
+	REQUIRE(bFound);
+	REQUIRE(refResPlayer == refPlayer0);
+	REQUIRE(nResKeyActionId == nMoveUpId);
+	const bool bFound2 = refPrefs->getPlayerKeyActionFromCapabilityKey(refKeyCapa1->getId(), stmi::HK_UP, nResTeam, nResMate, nResKeyActionId);
+	REQUIRE(bFound2);
+	REQUIRE(nResTeam == refPlayer0->getTeam()->get());
+	REQUIRE(nResMate == refPlayer0->getMate());
+	REQUIRE(nResKeyActionId == nMoveUpId);
+	}
+
 	const bool bDone1 = m_refDM->simulateRemoveDevice(nKeyDeviceId1);
 	REQUIRE(bDone1);
 
+	{
+	const bool bFound = refPrefs->getPlayerKeyActionFromCapabilityKey(refKeyCapa1->getId(), stmi::HK_UP, nResTeam, nResMate, nResKeyActionId);
+	REQUIRE_FALSE(bFound);
+	}
+
 	//--- player 0
-	const auto refPlayer0 = refPrefs->getPlayerFull(0);
-	const int32_t nMoveUpId = m_refStdConfig->getKeyActionId("MoveUp");
 	auto oPair = refPlayer0->getKeyValue(nMoveUpId);
 	stmi::Capability* p0Capa = oPair.first;
 	stmi::HARDWARE_KEY eKey = oPair.second;
@@ -410,6 +431,13 @@ TEST_CASE_METHOD(STFX<LocalStdConfigFixture>, "RuntimeCapabilities")
 	REQUIRE(p0Capa == refKeyCapa1b.get());
 	REQUIRE(eKey == stmi::HK_DOWN);
 
+	{
+	const bool bFound = refPrefs->getPlayerKeyActionFromCapabilityKey(refKeyCapa1b->getId(), stmi::HK_DOWN, refResPlayer, nResKeyActionId);
+	REQUIRE(bFound);
+	REQUIRE(refResPlayer == refPlayer0);
+	REQUIRE(nResKeyActionId == nMoveDownId);
+	}
+
 	const bool bDone3 = m_refDM->simulateRemoveDevice(nKeyDeviceId1b);
 	REQUIRE(bDone3);
 
@@ -0,0 +1,152 @@
+/*
+ * Copyright © 2019-2020  Stefano Marsili, <stemars@gmx.ch>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see <http://www.gnu.org/licenses/>
+ */
+/*
+ * File:   testTickStats.cxx
+ */
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+
+#include "tickstats.h"
+#include "events/alarmsevent.h"
+#include "events/logevent.h"
+
+#include "stmm-games-fake/fixtureGame.h"
+
+namespace stmg
+{
+
+using std::shared_ptr;
+using std::unique_ptr;
+using std::make_unique;
+
+namespace testing
+{
+
+class TickStatsGameFixture : public GameFixture
+							//default , public FixtureVariantDevicesKeys_Two, public FixtureVariantDevicesJoystick_Two
+							, public FixtureVariantPrefsTeams<1>
+							//default , public FixtureVariantPrefsMates<0,2>
+							//default , public FixtureVariantMatesPerTeamMax_Three, public FixtureVariantAIMatesPerTeamMax_Zero
+							//default , public FixtureVariantAllowMixedAIHumanTeam_False, public FixtureVariantPlayersMax_Six
+							//default , public FixtureVariantTeamsMin_One, public FixtureVariantTeamsMax_Two
+							//default , public FixtureVariantKeyActions_AllCapabilityClassesDefaults
+							//default , public FixtureVariantLayoutTeamDistribution_AllTeamsInOneLevel
+							//default , public FixtureVariantLayoutShowMode_Show
+							//default , public FixtureVariantLayoutCreateVarWidgetsFromVariables_False
+							//default , public FixtureVariantLayoutCreateActionWidgetsFromKeyActions_False
+							, public FixtureVariantVariablesGame_Time
+							//, public FixtureVariantVariablesTeam
+							, public FixtureVariantVariablesPlayer_Lives<3>
+							//default , public FixtureVariantLevelInitBoardWidth<10>
+							//default , public FixtureVariantLevelInitBoardHeight<6>
+							//default , public FixtureVariantLevelInitShowWidth<10>
+							//default , public FixtureVariantLevelInitShowHeight<6>
+{
+protected:
+	void setup() override
+	{
+		GameFixture::setup();
+	}
+	void teardown() override
+	{
+		GameFixture::teardown();
+	}
+	// Adds an alarm that times out each tick and a log event that listens to it
+	void addAlarmsAndLog(Level* p0Level)
+	{
+		AlarmsEvent::Init oAInit;
+		oAInit.m_p0Level = p0Level;
+		AlarmsEvent::AlarmsStage oAlarmsStage;
+		oAlarmsStage.m_nRepeat = 3;
+		oAlarmsStage.m_eAlarmsStageType = AlarmsEvent::ALARMS_STAGE_SET_TICKS;
+		oAlarmsStage.m_nChange = 1;
+		oAInit.m_aAlarmsStages.push_back(std::move(oAlarmsStage));
+		auto refAlarmsEvent = make_unique<AlarmsEvent>(std::move(oAInit));
+		AlarmsEvent* p0AlarmsEvent = refAlarmsEvent.get();
+		p0Level->addEvent(std::move(refAlarmsEvent));
+		p0Level->activateEvent(p0AlarmsEvent, 1);
+
+		LogEvent::Init oLInit;
+		oLInit.m_p0Level = p0Level;
+		oLInit.m_bToStdOut = false;
+		oLInit.m_nTag = 82235;
+		auto refLogEvent = make_unique<LogEvent>(std::move(oLInit));
+		LogEvent* p0LogEvent = refLogEvent.get();
+		p0Level->addEvent(std::move(refLogEvent));
+
+		p0AlarmsEvent->addListener(AlarmsEvent::LISTENER_GROUP_TIMEOUT, p0LogEvent, 1001);
+		p0AlarmsEvent->addListener(AlarmsEvent::LISTENER_GROUP_TIMEOUT, p0AlarmsEvent, AlarmsEvent::MESSAGE_ALARMS_NEXT);
+	}
+};
+
+// Only built when the library is built with BUILD_WITH_TICK_STATS (see scripts/testall.py)
+TEST_CASE_METHOD(STFX<TickStatsGameFixture>, "Enabled")
+{
+	LogEvent::msgLog().reset();
+
+	Level* p0Level = m_refGame->level(0).get();
+	addAlarmsAndLog(p0Level);
+
+	const TickStats& oTickStats = p0Level->game().getTickStats();
+	REQUIRE( oTickStats.getTotTicks() == 0 );
+
+	m_refGame->start();
+	const int32_t nTotTicks = 5;
+	for (int32_t nTick = 0; nTick < nTotTicks; ++nTick) {
+		m_refGame->handleTimer();
+	}
+	const int32_t nTotLogEntries = LogEvent::msgLog().totEntries();
+	REQUIRE( nTotLogEntries > 0 );
+
+	const std::string sJson = oTickStats.toJson();
+	REQUIRE( sJson.front() == '{' );
+	REQUIRE( sJson.back() == '}' );
+	REQUIRE( sJson.find(TickStats::getPhaseName(TickStats::PHASE_EVENTS)) != std::string::npos );
+
+	REQUIRE( oTickStats.getTotTicks() == nTotTicks );
+	const auto aTicks = oTickStats.getRecentTicks();
+	REQUIRE( static_cast<int32_t>(aTicks.size()) == nTotTicks );
+	for (int32_t nTick = 0; nTick < nTotTicks; ++nTick) {
+		const TickStats::Tick& oTick = aTicks[nTick];
+		REQUIRE( oTick.m_nGameTick == nTick );
+		// The phases are nested within the tick
+		for (int32_t nPhase = 0; nPhase < TickStats::s_nTotPhases; ++nPhase) {
+			REQUIRE( oTick.m_aPhaseNanosec[nPhase] >= 0 );
+			REQUIRE( oTick.m_aPhaseNanosec[nPhase] <= oTick.m_nTotalNanosec );
+		}
+	}
+	const auto& oEventsPhase = oTickStats.getPhaseStats(TickStats::PHASE_EVENTS);
+	REQUIRE( oEventsPhase.m_nMaxNanosec <= oEventsPhase.m_nTotalNanosec );
+
+	const auto& aEventClasses = oTickStats.getEventClassStats();
+	int64_t nAlarmsTriggers = 0;
+	int64_t nLogTriggers = 0;
+	for (const auto& oEventClass : aEventClasses) {
+		if (oEventClass.m_sClassName.find("AlarmsEvent") != std::string::npos) {
+			nAlarmsTriggers = oEventClass.m_nTriggers;
+		} else if (oEventClass.m_sClassName.find("LogEvent") != std::string::npos) {
+			nLogTriggers = oEventClass.m_nTriggers;
+		}
+	}
+	REQUIRE( nAlarmsTriggers >= nTotLogEntries );
+	REQUIRE( nLogTriggers == nTotLogEntries );
+}
+
+} // namespace testing
+
+} // namespace stmg
@@ -376,6 +376,40 @@ TEST_CASE_METHOD(STFX<TAEManyTileGameFixture>, "InsertUpAnimatedSubArea")
 	REQUIRE( p0TA == nullptr );
 }
 
+TEST_CASE_METHOD(STFX<TAEOneTileGameFixture>, "RepeatWithLongPause")
+{
+	REQUIRE_FALSE( m_refGame->isRunning() );
+	auto& refLevel = m_refGame->level(0);
+	assert(refLevel);
+	Level* p0Level = refLevel.get();
+	TileAnimatorEvent::Init oInit;
+	oInit.m_p0Level = p0Level;
+	const int32_t nTileAniCharA = m_refGame->getNamed().tileAnis().addName("TestTileAni");
+	oInit.m_nAniNameIdx = nTileAniCharA;
+	oInit.m_oDuration.m_oTicks.m_nFrom = 3;
+	oInit.m_oDuration.m_oTicks.m_nTo = 3;
+	// longer than a round of the internal timing wheel
+	oInit.m_oPause.m_oTicks.m_nFrom = 100;
+	oInit.m_oPause.m_oTicks.m_nTo = 100;
+	oInit.m_oTotCount.m_nFrom = 2;
+	oInit.m_oTotCount.m_nTo = 2;
+	auto refCTS = make_unique<CharTraitSet>(make_unique<CharUcs4TraitSet>(65));
+	oInit.m_refSelect = make_unique<TileSelector>(make_unique<TileSelector::Trait>(false, std::move(refCTS)));
+	auto refTileAnimatorEvent = make_unique<TileAnimatorEvent>(std::move(oInit));
+	TileAnimatorEvent* p0TileAnimatorEvent = refTileAnimatorEvent.get();
+	p0Level->addEvent(std::move(refTileAnimatorEvent));
+	p0Level->activateEvent(p0TileAnimatorEvent, 1);
+	m_refGame->start();
+	std::vector<int32_t> aActiveTicks;
+	for (int32_t nTick = 0; nTick < 250; ++nTick) {
+		m_refGame->handleTimer();
+		if (p0Level->boardGetTileAniElapsed(9, 5, nTileAniCharA) != TileAnimator::s_fInactiveElapsed) {
+			aActiveTicks.push_back(m_refGame->gameElapsed());
+		}
+	}
+	REQUIRE( aActiveTicks == std::vector<int32_t>{2, 3, 4, 105, 106, 107, 109, 110, 111, 212, 213, 214, 216, 217, 218} );
+}
+
 } // namespace testing
 
 } // namespace stmg
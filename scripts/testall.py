@@ -62,6 +62,18 @@ def testAll(sBuildType, sInstallDir, sSudo, bBuildStatic, bSanitize):
 		raise RuntimeError("Error: libstmm-games_doxy.log not empty")
 	os.chdir("../..")
 
+	if (not bSanitize):
+		# the tick statistics are compiled out by default, test them in a separate (not installed) build
+		os.chdir("libstmm-games")
+		if not os.path.isdir("build-tickstats"):
+			os.mkdir("build-tickstats")
+		os.chdir("build-tickstats")
+		subprocess.check_call("cmake -D CMAKE_BUILD_TYPE={} -D BUILD_SHARED_LIBS={} -D BUILD_TESTING=ON -D BUILD_DOCS=OFF -D BUILD_WITH_TICK_STATS=ON .."\
+								.format(sBuildType, sBuildSharedLibs).split())
+		subprocess.check_call("make".split())
+		subprocess.check_call("make test".split())
+		os.chdir("../..")
+
 	#os.chdir("libstmm-games-fake/build")
 	#subprocess.check_call(sSanitizeOptions + " make test", shell=True)
 	#if os.path.getsize("libstmm-games-fake_doxy.log") > 0: